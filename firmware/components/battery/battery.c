@@ -113,6 +113,20 @@ int battery_percentage(battery_t *const battery)
     return battery_percentage;
 }
 
+/**
+ * @brief Battery voltage from the last reading
+ *
+ * @param battery   pointer to a const battery object
+ * @return int battery voltage in mV
+ * @note   Uses battery.value, call battery_read() first
+ */
+int battery_voltage(battery_t *const battery)
+{
+    /* Raw adc to pin voltage, then undo the divider */
+    int vpin = voltage_to_adc(battery->value, battery);
+    return (vpin * (R2 + R3)) / R3;
+}
+
 /**
  * @brief Battery object constructor
  *
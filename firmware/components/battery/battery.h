@@ -55,4 +55,6 @@ int battery_read(battery_t *const battery);
 
 int battery_percentage(battery_t *const battery);
 
+int battery_voltage(battery_t *const battery);
+
 #endif
\ No newline at end of file
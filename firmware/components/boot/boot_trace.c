@@ -0,0 +1,159 @@
+/**
+ * @file boot_trace.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Start and end time of every bring-up stage
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+#include "boot_trace.h"
+
+/**
+ * @brief Name the stages of a trace, none reached yet
+ *
+ * @param trace pointer to trace
+ * @param names stage names, by index
+ * @param count number of stages
+ * @return int 0, -1 if count exceeds BOOT_MAX_STAGES
+ */
+int boot_trace_init(boot_trace_t *const trace, const char *const *names, uint8_t count)
+{
+    if (count > BOOT_MAX_STAGES)
+    {
+        return -1;
+    }
+    memset(trace, 0, sizeof(*trace));
+    for (uint8_t i = 0; i < count; i++)
+    {
+        trace->stage[i] = (boot_stage_t){.name = names[i], .start_us = -1, .end_us = -1, .result = -1};
+    }
+    trace->count = count;
+    return 0;
+}
+
+/**
+ * @brief Record the start of a stage
+ *
+ * @param trace     pointer to trace
+ * @param stage     stage index
+ * @param core      core running the stage
+ * @param now_us    monotonic time
+ */
+void boot_stage_begin(boot_trace_t *const trace, uint8_t stage, uint8_t core, int64_t now_us)
+{
+    if (stage < trace->count)
+    {
+        trace->stage[stage].start_us = now_us;
+        trace->stage[stage].core = core;
+    }
+}
+
+/**
+ * @brief Record the end of a stage
+ *
+ * @param trace     pointer to trace
+ * @param stage     stage index
+ * @param result    0 on success
+ * @param now_us    monotonic time
+ */
+void boot_stage_end(boot_trace_t *const trace, uint8_t stage, int result, int64_t now_us)
+{
+    if (stage < trace->count)
+    {
+        trace->stage[stage].end_us = now_us;
+        trace->stage[stage].result = (int8_t)(result == 0 ? 0 : -1);
+    }
+}
+
+/**
+ * @brief Record a stage that is a single point in time, like a first sample
+ *
+ * @param trace     pointer to trace
+ * @param stage     stage index
+ * @param core      core reaching it
+ * @param now_us    monotonic time
+ */
+void boot_stage_mark(boot_trace_t *const trace, uint8_t stage, uint8_t core, int64_t now_us)
+{
+    boot_stage_begin(trace, stage, core, now_us);
+    boot_stage_end(trace, stage, 0, now_us);
+}
+
+/**
+ * @brief Latest end of any stage
+ *
+ * @param trace pointer to trace
+ * @return int64_t us, -1 when no stage ended
+ */
+int64_t boot_trace_span(const boot_trace_t *const trace)
+{
+    int64_t span = -1;
+    for (uint8_t i = 0; i < trace->count; i++)
+    {
+        span = trace->stage[i].end_us > span ? trace->stage[i].end_us : span;
+    }
+    return span;
+}
+
+/**
+ * @brief Stage as a text timeline, '#' while it runs, '|' for a point
+ *
+ * Bars of all stages drawn with the same span line up, so overlapping
+ * stages show as overlapping bars.
+ *
+ * @param trace     pointer to trace
+ * @param stage     stage index
+ * @param span_us   time at the right edge, @see boot_trace_span()
+ * @param out       destination, width + 1 bytes
+ * @param width     characters
+ * @return size_t width
+ */
+size_t boot_trace_bar(const boot_trace_t *const trace, uint8_t stage, int64_t span_us, char *out, size_t width)
+{
+    const boot_stage_t *s = &trace->stage[stage];
+    bool reached = stage < trace->count && s->start_us >= 0 && s->end_us >= s->start_us && span_us > 0;
+
+    for (size_t i = 0; i < width; i++)
+    {
+        /* Cell i covers [from, to) */
+        int64_t from = span_us * (int64_t)i / (int64_t)width;
+        int64_t to = span_us * (int64_t)(i + 1) / (int64_t)width;
+        char c = '.';
+        if (reached && s->start_us < to && s->end_us >= from)
+        {
+            c = s->end_us == s->start_us ? '|' : '#';
+        }
+        out[i] = c;
+    }
+    out[width] = '\0';
+    return width;
+}
+
+/**
+ * @brief Wire form of a stage
+ *
+ * @param trace     pointer to trace
+ * @param stage     stage index
+ * @param record    destination
+ */
+void boot_trace_encode(const boot_trace_t *const trace, uint8_t stage, boot_record_t *record)
+{
+    const boot_stage_t *s = &trace->stage[stage];
+    bool reached = s->end_us >= 0;
+
+    memset(record, 0, sizeof(*record));
+    record->start_us = (uint32_t)(s->start_us >= 0 ? s->start_us : 0);
+    record->end_us = (uint32_t)(reached ? s->end_us : 0);
+    record->index = stage;
+    record->core = s->core;
+    record->result = reached ? s->result : -1;
+    if (s->name != NULL)
+    {
+        size_t len = strlen(s->name);
+        memcpy(record->name, s->name, len < BOOT_NAME_MAX ? len : BOOT_NAME_MAX);
+    }
+}
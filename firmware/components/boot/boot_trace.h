@@ -0,0 +1,93 @@
+/**
+ * @file boot_trace.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Start and end time of every bring-up stage
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _BOOT_TRACE_H_
+#define _BOOT_TRACE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOT_MAX_STAGES 12 /*!< Stages per trace */
+#define BOOT_NAME_MAX 14   /*!< Stage name bytes on the wire, not terminated when full */
+
+/**
+ * @struct boot_stage_t boot_trace.h
+ * @brief One stage, times in us on the monotonic clock, -1 until reached
+ */
+typedef struct
+{
+    const char *name; /*!< Stage name */
+    int64_t start_us; /*!< Stage began */
+    int64_t end_us;   /*!< Stage finished */
+    int8_t result;    /*!< 0 on success */
+    uint8_t core;     /*!< Core the stage ran on */
+} boot_stage_t;
+
+/**
+ * @struct boot_trace_t boot_trace.h
+ * @brief Stages of one boot
+ *
+ * Each stage is written by the one task that runs it and read once every
+ * stage has ended, so the trace needs no lock of its own: the event that
+ * tells the reader a stage ended orders the writes.
+ *
+ * ### Example
+ * ~~~.c
+ * static const char *const names[] = {"sensors", "storage"};
+ * boot_trace_t trace;
+ * boot_trace_init(&trace, names, 2);
+ * boot_stage_begin(&trace, 0, core, now_us());
+ * boot_stage_end(&trace, 0, 0, now_us());
+ * ~~~
+ */
+typedef struct
+{
+    boot_stage_t stage[BOOT_MAX_STAGES]; /*!< Stages by index */
+    uint8_t count;                       /*!< Stages in use */
+} boot_trace_t;
+
+/**
+ * @struct boot_record_t boot_trace.h
+ * @brief One stage on the telemetry stream, TELEMETRY_BOOT, decoded by tools/boot.py
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t start_us;          /*!< Stage began */
+    uint32_t end_us;            /*!< Stage finished */
+    uint8_t index;              /*!< Stage index */
+    uint8_t core;               /*!< Core */
+    int8_t result;              /*!< 0 on success, -1 not reached */
+    char name[BOOT_NAME_MAX];   /*!< Stage name, zero padded */
+} boot_record_t;
+
+int boot_trace_init(boot_trace_t *const trace, const char *const *names, uint8_t count);
+
+void boot_stage_begin(boot_trace_t *const trace, uint8_t stage, uint8_t core, int64_t now_us);
+
+void boot_stage_end(boot_trace_t *const trace, uint8_t stage, int result, int64_t now_us);
+
+void boot_stage_mark(boot_trace_t *const trace, uint8_t stage, uint8_t core, int64_t now_us);
+
+int64_t boot_trace_span(const boot_trace_t *const trace);
+
+size_t boot_trace_bar(const boot_trace_t *const trace, uint8_t stage, int64_t span_us, char *out, size_t width);
+
+void boot_trace_encode(const boot_trace_t *const trace, uint8_t stage, boot_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * @file crc32.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief CRC-32 (IEEE 802.3) checksum
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CRC32_H_
+#define _CRC32_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t crc32_update(uint32_t crc, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
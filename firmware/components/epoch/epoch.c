@@ -0,0 +1,185 @@
+/**
+ * @file epoch.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Microsecond Unix time, calendar conversion and the wall clock
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Calendar conversion after Howard Hinnant's days_from_civil and
+ * civil_from_days: years are counted from March so the leap day is last,
+ * and 400 year eras make every step integer arithmetic on small unsigned
+ * values, without tables, loops or time zones. Unlike mktime() and gmtime()
+ * nothing here takes a lock or reads TZ.
+ */
+
+#include "epoch.h"
+
+#define EPOCH_DAYS_PER_ERA 146097   /* days in 400 years */
+#define EPOCH_DAYS_TO_1970 719468   /* 0000-03-01 to 1970-01-01 */
+
+/**
+ * @brief Days since 1970-01-01 of a calendar date
+ *
+ * @param year      proleptic Gregorian year, 1 BC is 0
+ * @param month     1..12
+ * @param day       1..31, not checked against the month
+ * @return int32_t days, negative before 1970
+ */
+int32_t days_from_civil(int32_t year, uint32_t month, uint32_t day)
+{
+    /* Year starting in March */
+    int32_t y = year - (month <= 2);
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yoe = (uint32_t)(y - era * 400);                                      /* [0, 399] */
+    uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1; /* [0, 365] */
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                          /* [0, 146096] */
+    return era * EPOCH_DAYS_PER_ERA + (int32_t)doe - EPOCH_DAYS_TO_1970;
+}
+
+/**
+ * @brief Calendar date of a day count since 1970-01-01
+ *
+ * @param days      days, negative before 1970
+ * @param year      year out
+ * @param month     month out, 1..12
+ * @param day       day out, 1..31
+ */
+void civil_from_days(int32_t days, int32_t *year, uint32_t *month, uint32_t *day)
+{
+    int32_t z = days + EPOCH_DAYS_TO_1970;
+    int32_t era = (z >= 0 ? z : z - (EPOCH_DAYS_PER_ERA - 1)) / EPOCH_DAYS_PER_ERA;
+    uint32_t doe = (uint32_t)(z - era * EPOCH_DAYS_PER_ERA);              /* [0, 146096] */
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; /* [0, 399] */
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);               /* [0, 365] */
+    uint32_t mp = (5 * doy + 2) / 153;                                    /* [0, 11], March is 0 */
+
+    *day = doy - (153 * mp + 2) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year = (int32_t)yoe + era * 400 + (*month <= 2);
+}
+
+/**
+ * @brief Unix time of a calendar time
+ *
+ * @param civil     UTC fields, year within +-5 million
+ * @return int64_t microseconds since 1970
+ */
+int64_t epoch_from_civil(const civil_time_t *civil)
+{
+    int64_t days = days_from_civil(civil->year, civil->month, civil->day);
+    int32_t seconds = civil->hour * 3600 + civil->minute * 60 + civil->second;
+    return (days * EPOCH_SECONDS_PER_DAY + seconds) * EPOCH_US_PER_SECOND + civil->usec;
+}
+
+/**
+ * @brief Calendar time of a Unix time
+ *
+ * One 64-bit division; the day split runs on 32 bits, which covers the
+ * years -6700 to 10600.
+ *
+ * @param us        microseconds since 1970
+ * @param civil     UTC fields out
+ */
+void epoch_to_civil(int64_t us, civil_time_t *civil)
+{
+    int64_t seconds = us / EPOCH_US_PER_SECOND;
+    int32_t usec = (int32_t)(us - seconds * EPOCH_US_PER_SECOND);
+    if (usec < 0)
+    {
+        usec += EPOCH_US_PER_SECOND;
+        seconds--;
+    }
+
+    /* 86400 = 128 * 675: shifting first floors and brings the rest to 32 bits */
+    int32_t blocks = (int32_t)(seconds >> 7);
+    int32_t days = (blocks >= 0 ? blocks : blocks - 674) / 675;
+    uint32_t sod = (uint32_t)(seconds - (int64_t)days * EPOCH_SECONDS_PER_DAY);
+
+    uint32_t month, day;
+    civil_from_days(days, &civil->year, &month, &day);
+    civil->month = (uint8_t)month;
+    civil->day = (uint8_t)day;
+    civil->hour = (uint8_t)(sod / 3600);
+    civil->minute = (uint8_t)(sod / 60 % 60);
+    civil->second = (uint8_t)(sod % 60);
+    civil->usec = (uint32_t)usec;
+}
+
+/**
+ * @brief Unix time as "YYYY-MM-DD hh:mm:ss" with an optional fraction
+ *
+ * @param out       destination, EPOCH_TEXT_MAX bytes
+ * @param us        microseconds since 1970, years 0..9999
+ * @param decimals  digits of the fraction, 0..6
+ * @return size_t length written, without the terminator
+ */
+size_t epoch_format(char *out, int64_t us, uint8_t decimals)
+{
+    static const uint32_t scale[7] = {1000000, 100000, 10000, 1000, 100, 10, 1};
+    civil_time_t civil;
+
+    epoch_to_civil(us, &civil);
+    size_t len = fmt_datetime(out, civil.year, civil.month, civil.day, civil.hour, civil.minute, civil.second);
+    if (decimals > 0)
+    {
+        decimals = decimals > 6 ? 6 : decimals;
+        out[len++] = '.';
+        len += fmt_uint(out + len, civil.usec / scale[decimals], decimals, '0');
+    }
+    return len;
+}
+
+/**
+ * @brief Apply a reading of the time source
+ *
+ * @param clock         clock
+ * @param epoch_us      reading, truncated to its resolution
+ * @param resolution_us resolution of the source, EPOCH_US_PER_SECOND for an RTC
+ * @param mono_us       monotonic time the reading belongs to
+ * @return int64_t correction applied in us, 0 when the clock agreed
+ */
+int64_t epoch_clock_sync(epoch_clock_t *const clock, int64_t epoch_us, int64_t resolution_us, int64_t mono_us)
+{
+    int64_t predicted = mono_us + clock->offset_us;
+    int64_t step = 0;
+
+    if (!clock->valid)
+    {
+        /* Middle of the window */
+        step = epoch_us + resolution_us / 2 - predicted;
+        clock->valid = true;
+    }
+    else if (predicted < epoch_us)
+    {
+        step = epoch_us - predicted;
+    }
+    else if (predicted >= epoch_us + resolution_us)
+    {
+        step = epoch_us + resolution_us - 1 - predicted;
+    }
+
+    if (clock->syncs > 0 && step != 0)
+    {
+        int64_t size = step < 0 ? -step : step;
+        clock->steps++;
+        clock->max_step_us = size > clock->max_step_us ? size : clock->max_step_us;
+    }
+    clock->offset_us += step;
+    clock->synced_us = mono_us;
+    clock->syncs++;
+    return step;
+}
+
+/**
+ * @brief Unix time at a monotonic time
+ *
+ * @param clock     clock
+ * @param mono_us   monotonic time
+ * @return int64_t microseconds since 1970, or @p mono_us before the first sync
+ */
+int64_t epoch_clock_now(const epoch_clock_t *const clock, int64_t mono_us)
+{
+    return mono_us + clock->offset_us;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file epoch.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Microsecond Unix time, calendar conversion and the wall clock
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Timestamps are int64_t microseconds since 1970-01-01 00:00:00 UTC, in the
+ * proleptic Gregorian calendar, without leap seconds. Calendar fields exist
+ * only at the edges: the RTC sync, file names and text output.
+ */
+#ifndef _EPOCH_H_
+#define _EPOCH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "fmt/fmt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EPOCH_US_PER_SECOND 1000000LL
+#define EPOCH_SECONDS_PER_DAY 86400
+#define EPOCH_TEXT_MAX (FMT_DATETIME_LEN + 8) /*!< "YYYY-MM-DD hh:mm:ss.uuuuuu" with terminator */
+
+/**
+ * @struct civil_time_t epoch.h
+ * @brief Broken-down UTC time
+ *
+ * ### Example
+ * ~~~.c
+ * civil_time_t civil = {.year = 2022, .month = 11, .day = 26, .hour = 19, .minute = 7};
+ * int64_t us = epoch_from_civil(&civil);
+ * epoch_to_civil(us + 86400 * EPOCH_US_PER_SECOND, &civil); // 2022-11-27 19:07:00
+ * ~~~
+ */
+typedef struct
+{
+    int32_t year;    /*!< Year, 1 BC is 0 */
+    uint8_t month;   /*!< 1..12 */
+    uint8_t day;     /*!< 1..31 */
+    uint8_t hour;    /*!< 0..23 */
+    uint8_t minute;  /*!< 0..59 */
+    uint8_t second;  /*!< 0..59 */
+    uint32_t usec;   /*!< 0..999999 */
+} civil_time_t;
+
+/**
+ * @struct epoch_clock_t epoch.h
+ * @brief Unix time from a monotonic clock, disciplined by a coarse time source
+ *
+ * Holds the offset from a monotonic microsecond clock (esp_timer) to Unix
+ * time. A reading with a resolution of one second only says the true time
+ * lies in [reading, reading + 1 s): the offset is kept while the prediction
+ * stays in that window and moved to its nearest edge when it leaves, so
+ * timestamps stay smooth and never step by more than the clocks disagree.
+ *
+ * Not locked: a clock shared between tasks needs the caller's lock.
+ *
+ * ### Example
+ * ~~~.c
+ * epoch_clock_t clock = {0};
+ * epoch_clock_sync(&clock, rtc_us, EPOCH_US_PER_SECOND, esp_timer_get_time());
+ * int64_t now = epoch_clock_now(&clock, esp_timer_get_time());
+ * ~~~
+ */
+typedef struct
+{
+    int64_t offset_us;   /*!< Unix time minus monotonic time */
+    int64_t synced_us;   /*!< Monotonic time of the last sync */
+    int64_t max_step_us; /*!< Largest correction after the first sync */
+    uint32_t syncs;      /*!< Readings applied */
+    uint32_t steps;      /*!< Readings that moved the offset */
+    bool valid;          /*!< Synced at least once */
+} epoch_clock_t;
+
+int32_t days_from_civil(int32_t year, uint32_t month, uint32_t day);
+
+void civil_from_days(int32_t days, int32_t *year, uint32_t *month, uint32_t *day);
+
+int64_t epoch_from_civil(const civil_time_t *civil);
+
+void epoch_to_civil(int64_t us, civil_time_t *civil);
+
+size_t epoch_format(char *out, int64_t us, uint8_t decimals);
+
+int64_t epoch_clock_sync(epoch_clock_t *const clock, int64_t epoch_us, int64_t resolution_us, int64_t mono_us);
+
+int64_t epoch_clock_now(const epoch_clock_t *const clock, int64_t mono_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,235 @@
+/**
+ * @file fmt.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Integer, fixed-point and timestamp to text without stdio
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Digits are produced two at a time from a 200 byte table, with 32-bit
+ * divisions only: 64-bit values are split into 9 digit groups first, since
+ * the ESP32 has no 64-bit divider.
+ */
+
+#include <string.h>
+#include "fmt.h"
+
+static const char fmt_pairs[200] = "00010203040506070809"
+                                   "10111213141516171819"
+                                   "20212223242526272829"
+                                   "30313233343536373839"
+                                   "40414243444546474849"
+                                   "50515253545556575859"
+                                   "60616263646566676869"
+                                   "70717273747576777879"
+                                   "80818283848586878889"
+                                   "90919293949596979899";
+
+static const uint32_t fmt_pow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/**
+ * @brief Number of decimal digits of a 32-bit value
+ */
+static unsigned fmt_digits32(uint32_t value)
+{
+    unsigned n = 1;
+    while (n < 10 && value >= fmt_pow10[n])
+    {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Write exactly @p n digits of @p value, ending just before @p end
+ */
+static void fmt_write32(char *end, uint32_t value, unsigned n)
+{
+    while (n >= 2)
+    {
+        uint32_t q = value / 100;
+        end -= 2;
+        memcpy(end, &fmt_pairs[(value - q * 100) * 2], 2);
+        value = q;
+        n -= 2;
+    }
+    if (n)
+    {
+        *--end = (char)('0' + value % 10);
+    }
+}
+
+/**
+ * @brief Digits of an unsigned 64-bit value, at least @p min_digits with leading zeros
+ *
+ * @return size_t digits written to out
+ */
+static size_t fmt_digits(char *out, uint64_t value, unsigned min_digits)
+{
+    uint32_t group[3];
+    unsigned groups = 0;
+
+    /* 9 digit groups, least significant first; 32-bit values need no 64-bit division */
+    while (value > UINT32_MAX)
+    {
+        uint64_t q = value / 1000000000u;
+        group[groups++] = (uint32_t)(value - q * 1000000000u);
+        value = q;
+    }
+    group[groups++] = (uint32_t)value;
+
+    /* Most significant group without padding, the others 9 digits each */
+    unsigned top = fmt_digits32(group[groups - 1]);
+    unsigned n = top + 9 * (groups - 1);
+    unsigned zeros = min_digits > n ? min_digits - n : 0;
+    memset(out, '0', zeros);
+    char *end = out + zeros + n;
+    for (unsigned g = 0; g + 1 < groups; g++)
+    {
+        fmt_write32(end, group[g], 9);
+        end -= 9;
+    }
+    fmt_write32(end, group[groups - 1], top);
+    return zeros + n;
+}
+
+/**
+ * @brief Write sign and body into a field of |width| characters
+ *
+ * @param out       destination
+ * @param negative  prefix a minus sign
+ * @param body      digits (and point), not terminated
+ * @param len       length of body
+ * @param width     field width, negative to left-align
+ * @param pad       ' ' or '0'
+ * @return size_t   length written
+ */
+static size_t fmt_field(char *out, int negative, const char *body, size_t len, int width, char pad)
+{
+    size_t used = len + (negative ? 1 : 0);
+    size_t field = (size_t)(width < 0 ? -width : width);
+    size_t fill = field > used ? field - used : 0;
+    char *p = out;
+
+    if (width > 0 && pad != '0')
+    {
+        memset(p, ' ', fill);
+        p += fill;
+    }
+    if (negative)
+    {
+        *p++ = '-';
+    }
+    if (width > 0 && pad == '0')
+    {
+        memset(p, '0', fill);
+        p += fill;
+    }
+    memmove(p, body, len);
+    p += len;
+    if (width < 0)
+    {
+        memset(p, ' ', fill);
+        p += fill;
+    }
+    *p = '\0';
+    return (size_t)(p - out);
+}
+
+/**
+ * @brief Unsigned integer, like "%*llu"
+ *
+ * @param out       destination, FMT_INT_MAX bytes or |width| + 1
+ * @param value     value
+ * @param width     field width, negative to left-align, 0 for none
+ * @param pad       ' ' or '0'
+ * @return size_t length written, excluding the terminator
+ */
+size_t fmt_uint(char *out, uint64_t value, int width, char pad)
+{
+    char body[FMT_INT_MAX];
+    return fmt_field(out, 0, body, fmt_digits(body, value, 1), width, pad);
+}
+
+/**
+ * @brief Signed integer, like "%*lld"
+ *
+ * @param out       destination, FMT_INT_MAX bytes or |width| + 1
+ * @param value     value
+ * @param width     field width, negative to left-align, 0 for none
+ * @param pad       ' ' or '0'
+ * @return size_t length written, excluding the terminator
+ */
+size_t fmt_int(char *out, int64_t value, int width, char pad)
+{
+    char body[FMT_INT_MAX];
+    uint64_t magnitude = value < 0 ? 0u - (uint64_t)value : (uint64_t)value;
+    return fmt_field(out, value < 0, body, fmt_digits(body, magnitude, 1), width, pad);
+}
+
+/**
+ * @brief Fixed-point value with an implied decimal point, 2150 with 2 decimals is "21.50"
+ *
+ * @param out       destination, FMT_INT_MAX bytes or |width| + 1
+ * @param value     value in units of 10^-decimals
+ * @param decimals  digits after the point, at most 18; 0 prints an integer
+ * @param width     field width, negative to left-align, 0 for none
+ * @param pad       ' ' or '0'
+ * @return size_t length written, excluding the terminator
+ */
+size_t fmt_fixed(char *out, int64_t value, uint8_t decimals, int width, char pad)
+{
+    char body[FMT_INT_MAX + 1];
+    uint64_t magnitude = value < 0 ? 0u - (uint64_t)value : (uint64_t)value;
+
+    if (decimals > 18)
+    {
+        decimals = 18;
+    }
+    /* At least one digit before the point: 5 with 2 decimals is 0.05 */
+    size_t n = fmt_digits(body, magnitude, decimals + 1u);
+    if (decimals > 0)
+    {
+        memmove(body + n - decimals + 1, body + n - decimals, decimals);
+        body[n - decimals] = '.';
+        n++;
+    }
+    return fmt_field(out, value < 0, body, n, width, pad);
+}
+
+/**
+ * @brief Timestamp as "YYYY-MM-DD hh:mm:ss"
+ *
+ * Fields are printed as given, out of range values are clamped to the digits
+ * available.
+ *
+ * @param out       destination, FMT_DATETIME_LEN + 1 bytes
+ * @param year      0..9999
+ * @param month     1..12
+ * @param day       1..31
+ * @param hour      0..23
+ * @param minute    0..59
+ * @param second    0..60
+ * @return size_t FMT_DATETIME_LEN
+ */
+size_t fmt_datetime(char *out, int year, int month, int day, int hour, int minute, int second)
+{
+    const int fields[6] = {year, month, day, hour, minute, second};
+    static const char separators[6] = {'-', '-', ' ', ':', ':', '\0'};
+    char *p = out;
+
+    for (int i = 0; i < 6; i++)
+    {
+        unsigned digits = i == 0 ? 4 : 2;
+        uint32_t value = fields[i] < 0 ? 0u : (uint32_t)fields[i];
+        if (value >= fmt_pow10[digits])
+        {
+            value = fmt_pow10[digits] - 1;
+        }
+        fmt_write32(p + digits, value, digits);
+        p += digits;
+        *p++ = separators[i];
+    }
+    return FMT_DATETIME_LEN;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file fmt.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Integer, fixed-point and timestamp to text without stdio
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every function writes a null terminated string and returns its length.
+ * Widths follow printf: a positive width right-aligns with @p pad (' ' or
+ * '0', zeros go after the sign like "%05d"), a negative width left-aligns
+ * with spaces like "%-5d". Output never exceeds the larger of the number and
+ * |width|, so FMT_INT_MAX bytes are enough for |width| < FMT_INT_MAX.
+ */
+#ifndef _FMT_H_
+#define _FMT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FMT_INT_MAX 22      /*!< Longest 64-bit number, fixed point included, with terminator */
+#define FMT_DATETIME_LEN 19 /*!< Length of "YYYY-MM-DD hh:mm:ss" */
+
+size_t fmt_uint(char *out, uint64_t value, int width, char pad);
+
+size_t fmt_int(char *out, int64_t value, int width, char pad);
+
+size_t fmt_fixed(char *out, int64_t value, uint8_t decimals, int width, char pad);
+
+size_t fmt_datetime(char *out, int year, int month, int day, int hour, int minute, int second);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,25 +9,34 @@
  *
  */
 
-#include <stdio.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_idf_version.h"
 #include "esp_lcd.h"
+#include "fmt/fmt.h"
 
 #define LCD_DATA 0        /*!< LCD data */
 #define LCD_CMD 1         /*!< LCD command */
 #define GPIO_STATE_LOW 0  /*!< Logic low */
 #define GPIO_STATE_HIGH 1 /*!< Logic high */
 
-/* Default pinout  */
+/* Default pinout, set in menuconfig under "Sensor Data Logger" */
+#ifdef CONFIG_LOGGER_LCD
+#define DATA_0_PIN CONFIG_LOGGER_LCD_PIN_D4          /*!< DATA 0 */
+#define DATA_1_PIN CONFIG_LOGGER_LCD_PIN_D5          /*!< DATA 1 */
+#define DATA_2_PIN CONFIG_LOGGER_LCD_PIN_D6          /*!< DATA 2 */
+#define DATA_3_PIN CONFIG_LOGGER_LCD_PIN_D7          /*!< DATA 3 */
+#define ENABLE_PIN CONFIG_LOGGER_LCD_PIN_EN          /*!< Enable  */
+#define REGISTER_SELECT_PIN CONFIG_LOGGER_LCD_PIN_RS /*!< Register Select  */
+#else
 #define DATA_0_PIN 19          /*!< DATA 0 */
-#define DATA_1_PIN 18          /*!< DATA 0 */
-#define DATA_2_PIN 17          /*!< DATA 0 */
-#define DATA_3_PIN 16          /*!< DATA 0 */
+#define DATA_1_PIN 18          /*!< DATA 1 */
+#define DATA_2_PIN 17          /*!< DATA 2 */
+#define DATA_3_PIN 16          /*!< DATA 3 */
 #define ENABLE_PIN 22          /*!< Enable  */
 #define REGISTER_SELECT_PIN 23 /*!< Register Select  */
+#endif
 
 /**
  * @brief Trigger LCD enable pin
@@ -283,8 +292,8 @@ lcd_err_t lcdSetInt(lcd_t *const lcd, int val, int x, int y)
     if (lcd->state == LCD_ACTIVE)
     {
         /* Store integer to buffer */
-        char buffer[16];
-        sprintf(buffer, "%d", val);
+        char buffer[FMT_INT_MAX];
+        fmt_int(buffer, val, 0, ' ');
         /* Set integer */
         lcdSetText(lcd, buffer, x, y);
     }
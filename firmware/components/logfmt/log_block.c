@@ -0,0 +1,160 @@
+/**
+ * @file log_block.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sector sized, CRC protected block of log records
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "log_block.h"
+#include "log_columns.h"
+#include "crc/crc32.h"
+
+/**
+ * @brief Start an empty block
+ *
+ * @param block pointer to block
+ * @param seq   block sequence number
+ */
+void log_block_init(log_block_t *const block, uint32_t seq)
+{
+    memset(block, 0, sizeof(*block));
+    block->header.magic = LOG_BLOCK_MAGIC;
+    block->header.version = LOG_BLOCK_VERSION;
+    block->header.layout = LOG_LAYOUT_ROW;
+    block->header.seq = seq;
+}
+
+/**
+ * @brief Next free record slot, so producers can fill the block in place
+ *
+ * @param block pointer to block
+ * @return log_record_t* slot to fill, NULL if the block is full
+ * @note   The slot becomes part of the block on log_block_commit()
+ */
+log_record_t *log_block_reserve(log_block_t *const block)
+{
+    if (block->header.count >= LOG_BLOCK_RECORDS)
+    {
+        return NULL;
+    }
+    return (log_record_t *)&block->payload[block->header.count * sizeof(log_record_t)];
+}
+
+/**
+ * @brief Commit the slot returned by log_block_reserve()
+ *
+ * @param block pointer to block
+ */
+void log_block_commit(log_block_t *const block)
+{
+    log_block_header_t *header = &block->header;
+    const log_record_t *record = (const log_record_t *)&block->payload[header->count * sizeof(log_record_t)];
+
+    if (header->count == 0)
+    {
+        header->first_us = record->time_us;
+    }
+    header->last_us = record->time_us;
+    header->count++;
+}
+
+/**
+ * @brief Append a copy of a record
+ *
+ * @param block     pointer to block
+ * @param record    record to append
+ * @return true     record stored
+ * @return false    block full, nothing stored
+ */
+bool log_block_append(log_block_t *const block, const log_record_t *record)
+{
+    log_record_t *slot = log_block_reserve(block);
+
+    if (slot == NULL)
+    {
+        return false;
+    }
+    memcpy(slot, record, sizeof(log_record_t));
+    log_block_commit(block);
+    return true;
+}
+
+/**
+ * @brief Check if the block has room for another record
+ *
+ * @param block pointer to block
+ * @return true block full
+ */
+bool log_block_full(const log_block_t *const block)
+{
+    return block->header.count >= LOG_BLOCK_RECORDS;
+}
+
+/**
+ * @brief Compute the block CRC, the crc field itself is skipped
+ *
+ * @param block pointer to block
+ * @return uint32_t crc
+ */
+uint32_t log_block_crc(const log_block_t *const block)
+{
+    const uint8_t *bytes = (const uint8_t *)block;
+    const size_t crc_at = offsetof(log_block_header_t, crc);
+    const size_t after = crc_at + sizeof(uint32_t);
+
+    uint32_t crc = crc32_update(0, bytes, crc_at);
+    return crc32_update(crc, bytes + after, LOG_BLOCK_SIZE - after);
+}
+
+/**
+ * @brief Finish a block before it is written
+ *
+ * @param block pointer to block
+ */
+void log_block_seal(log_block_t *const block)
+{
+    block->header.crc = log_block_crc(block);
+}
+
+/**
+ * @brief Validate magic, version, layout, count and CRC of a block read back
+ *
+ * The CRC only says the block is as written: a known layout and a count
+ * within it keep readers inside the payload whatever a writer stored.
+ *
+ * @param block pointer to block
+ * @return true block is intact
+ */
+bool log_block_verify(const log_block_t *const block)
+{
+    const log_block_header_t *header = &block->header;
+
+    if (header->magic != LOG_BLOCK_MAGIC || header->version != LOG_BLOCK_VERSION)
+    {
+        return false;
+    }
+    if (header->layout == LOG_LAYOUT_ROW ? header->count > LOG_BLOCK_RECORDS
+                                         : header->layout != LOG_LAYOUT_COLUMNAR || header->count > LOG_COLUMNS_ROWS)
+    {
+        return false;
+    }
+    return log_block_crc(block) == header->crc;
+}
+
+/**
+ * @brief Copy one record out of a row layout block
+ *
+ * @param block     pointer to block
+ * @param index     record index, less than header.count
+ * @param record    destination
+ */
+void log_block_record(const log_block_t *const block, uint16_t index, log_record_t *record)
+{
+    memcpy(record, &block->payload[index * sizeof(log_record_t)], sizeof(log_record_t));
+}
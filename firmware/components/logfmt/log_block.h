@@ -0,0 +1,112 @@
+/**
+ * @file log_block.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sector sized, CRC protected block of log records
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Log files and raw regions are a plain sequence of LOG_BLOCK_SIZE blocks, so
+ * a reader can split them at any multiple of LOG_BLOCK_SIZE and check every
+ * block on its own.
+ */
+#ifndef _LOG_BLOCK_H_
+#define _LOG_BLOCK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "log_record.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOG_BLOCK_SIZE 512            /*!< One SD sector */
+#define LOG_BLOCK_MAGIC 0x424C4453u   /*!< "SDLB" little endian */
+#define LOG_BLOCK_VERSION 1           /*!< Format version */
+#define LOG_BLOCK_HEADER_SIZE 32      /*!< Header size in bytes */
+#define LOG_BLOCK_PAYLOAD (LOG_BLOCK_SIZE - LOG_BLOCK_HEADER_SIZE) /*!< Payload size in bytes */
+#define LOG_BLOCK_RECORDS (LOG_BLOCK_PAYLOAD / sizeof(log_record_t)) /*!< Rows per block */
+
+/**
+ * @enum log_layout_t log_block.h
+ * @brief Payload layout
+ */
+typedef enum
+{
+    LOG_LAYOUT_ROW = 0,      /*!< Array of log_record_t */
+    LOG_LAYOUT_COLUMNAR = 1, /*!< One encoded column per field @see log_columns.h */
+} log_layout_t;
+
+/**
+ * @struct log_block_header_t log_block.h
+ * @brief Block header, little endian
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      uint32_t magic;
+ *      uint8_t version;
+ *      uint8_t layout;
+ *      uint16_t count;
+ *      uint32_t seq;
+ *      uint32_t crc;
+ *      int64_t first_us;
+ *      int64_t last_us;
+ * }log_block_header_t;
+ * ~~~
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;   /*!< LOG_BLOCK_MAGIC */
+    uint8_t version;  /*!< LOG_BLOCK_VERSION */
+    uint8_t layout;   /*!< Payload layout @see log_layout_t */
+    uint16_t count;   /*!< Number of records */
+    uint32_t seq;     /*!< Block sequence number */
+    uint32_t crc;     /*!< CRC-32 of the block with this field skipped */
+    int64_t first_us; /*!< Time of the first record */
+    int64_t last_us;  /*!< Time of the last record */
+} log_block_header_t;
+
+/**
+ * @struct log_block_t log_block.h
+ * @brief One block as stored on the card
+ */
+typedef struct
+{
+    log_block_header_t header;               /*!< Block header */
+    uint8_t payload[LOG_BLOCK_PAYLOAD];      /*!< Records */
+} log_block_t;
+
+#ifdef __cplusplus
+static_assert(sizeof(log_block_header_t) == LOG_BLOCK_HEADER_SIZE, "header size");
+static_assert(sizeof(log_block_t) == LOG_BLOCK_SIZE, "block size");
+#else
+_Static_assert(sizeof(log_block_header_t) == LOG_BLOCK_HEADER_SIZE, "header size");
+_Static_assert(sizeof(log_block_t) == LOG_BLOCK_SIZE, "block size");
+#endif
+
+void log_block_init(log_block_t *const block, uint32_t seq);
+
+log_record_t *log_block_reserve(log_block_t *const block);
+
+void log_block_commit(log_block_t *const block);
+
+bool log_block_append(log_block_t *const block, const log_record_t *record);
+
+bool log_block_full(const log_block_t *const block);
+
+void log_block_seal(log_block_t *const block);
+
+uint32_t log_block_crc(const log_block_t *const block);
+
+bool log_block_verify(const log_block_t *const block);
+
+void log_block_record(const log_block_t *const block, uint16_t index, log_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
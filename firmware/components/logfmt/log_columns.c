@@ -0,0 +1,525 @@
+/**
+ * @file log_columns.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Columnar log block: one encoded column per record field
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The fields of a log change slowly from one record to the next: time steps
+ * by the sample period, type and flags hardly ever change, and battery,
+ * temperature and pressure drift. Stored as columns they encode to a few
+ * bytes per record instead of 20, and a query on one field reads that
+ * field's bytes only.
+ *
+ * A record is encoded when it is committed, so the builder always knows
+ * how much room is left. It stops taking records once the worst case next
+ * record might not fit.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "log_columns.h"
+
+/**
+ * @brief Codec of each column, and the most bytes one record can add to it
+ *
+ * A new run adds a value of at most 2 bytes and a length of at most 3.
+ */
+static const struct
+{
+    uint8_t codec;
+    uint8_t worst;
+} log_columns_spec[LOG_COLUMN_COUNT] = {
+    [LOG_COLUMN_TIME] = {LOG_CODEC_DELTA2, 10},
+    [LOG_COLUMN_TYPE] = {LOG_CODEC_RLE, 5},
+    [LOG_COLUMN_FLAGS] = {LOG_CODEC_RLE, 5},
+    [LOG_COLUMN_BATTERY] = {LOG_CODEC_DELTA, 3},
+    [LOG_COLUMN_TEMPERATURE] = {LOG_CODEC_DELTA, 5},
+    [LOG_COLUMN_PRESSURE] = {LOG_CODEC_DELTA, 5},
+};
+
+/**
+ * @brief Field of a record
+ *
+ * @param record    pointer to record
+ * @param column    field
+ * @return int64_t value
+ */
+static int64_t log_columns_get(const log_record_t *record, log_column_t column)
+{
+    switch (column)
+    {
+    case LOG_COLUMN_TIME:
+        return record->time_us;
+    case LOG_COLUMN_TYPE:
+        return record->type;
+    case LOG_COLUMN_FLAGS:
+        return record->flags;
+    case LOG_COLUMN_BATTERY:
+        return record->battery_mv;
+    case LOG_COLUMN_TEMPERATURE:
+        return record->temperature;
+    case LOG_COLUMN_PRESSURE:
+        return record->pressure;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Set one field of consecutive records
+ *
+ * @param records   pointer to records
+ * @param column    field
+ * @param values    values, truncated to the field
+ * @param count     number of records
+ */
+static void log_columns_scatter(log_record_t *records, log_column_t column, const int64_t *values, uint16_t count)
+{
+    /* One loop per field, so the field is not looked up per value */
+    switch (column)
+    {
+    case LOG_COLUMN_TIME:
+        for (uint16_t i = 0; i < count; i++)
+        {
+            records[i].time_us = values[i];
+        }
+        break;
+    case LOG_COLUMN_TYPE:
+        for (uint16_t i = 0; i < count; i++)
+        {
+            records[i].type = (uint8_t)values[i];
+        }
+        break;
+    case LOG_COLUMN_FLAGS:
+        for (uint16_t i = 0; i < count; i++)
+        {
+            records[i].flags = (uint8_t)values[i];
+        }
+        break;
+    case LOG_COLUMN_BATTERY:
+        for (uint16_t i = 0; i < count; i++)
+        {
+            records[i].battery_mv = (uint16_t)values[i];
+        }
+        break;
+    case LOG_COLUMN_TEMPERATURE:
+        for (uint16_t i = 0; i < count; i++)
+        {
+            records[i].temperature = (int32_t)values[i];
+        }
+        break;
+    case LOG_COLUMN_PRESSURE:
+        for (uint16_t i = 0; i < count; i++)
+        {
+            records[i].pressure = (uint32_t)values[i];
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Map signed to unsigned so small magnitudes of either sign stay small
+ */
+static uint64_t log_columns_zigzag(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+/**
+ * @brief Inverse of log_columns_zigzag()
+ */
+static int64_t log_columns_unzigzag(uint64_t value)
+{
+    return (int64_t)((value >> 1) ^ (0 - (value & 1)));
+}
+
+/**
+ * @brief Bytes of a LEB128 varint
+ *
+ * @param value value
+ * @return uint16_t 1 to 10
+ */
+static uint16_t log_columns_varint_size(uint64_t value)
+{
+    uint16_t size = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+/**
+ * @brief Append a LEB128 varint to a column
+ *
+ * @param cols      pointer to builder
+ * @param column    column
+ * @param value     value
+ */
+static void log_columns_put(log_columns_t *const cols, log_column_t column, uint64_t value)
+{
+    uint8_t *p = &cols->data[column][cols->size[column]];
+    uint16_t size = 0;
+
+    while (value >= 0x80)
+    {
+        p[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    p[size++] = (uint8_t)value;
+    cols->size[column] += size;
+}
+
+/**
+ * @brief Read a LEB128 varint
+ *
+ * @param p     position, advanced past the varint
+ * @param end   end of the column
+ * @param value destination
+ * @return true varint complete within the column
+ */
+static bool log_columns_get_varint(const uint8_t **p, const uint8_t *end, uint64_t *value)
+{
+    uint64_t v = 0;
+
+    /* Most values of a slowly changing column take one byte */
+    if (*p < end && **p < 0x80)
+    {
+        *value = *(*p)++;
+        return true;
+    }
+    for (unsigned shift = 0; shift < 64 && *p < end; shift += 7)
+    {
+        uint8_t byte = *(*p)++;
+        v |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            *value = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Start an empty columnar block
+ *
+ * @param cols  pointer to builder
+ * @param block pointer to block, owned by the builder until log_columns_seal()
+ * @param seq   block sequence number
+ */
+void log_columns_init(log_columns_t *const cols, log_block_t *const block, uint32_t seq)
+{
+    log_block_init(block, seq);
+    block->header.layout = LOG_LAYOUT_COLUMNAR;
+    cols->block = block;
+    memset(cols->last, 0, sizeof(cols->last));
+    memset(cols->delta, 0, sizeof(cols->delta));
+    memset(cols->run, 0, sizeof(cols->run));
+    memset(cols->size, 0, sizeof(cols->size));
+}
+
+/**
+ * @brief Record to fill, the counterpart of log_block_reserve()
+ *
+ * @param cols  pointer to builder
+ * @return log_record_t* zeroed record, NULL if the block is full
+ * @note   The record is encoded into the block on log_columns_commit()
+ */
+log_record_t *log_columns_reserve(log_columns_t *const cols)
+{
+    if (log_columns_full(cols))
+    {
+        return NULL;
+    }
+    memset(&cols->record, 0, sizeof(cols->record));
+    return &cols->record;
+}
+
+/**
+ * @brief Encode the record returned by log_columns_reserve()
+ *
+ * @param cols  pointer to builder
+ */
+void log_columns_commit(log_columns_t *const cols)
+{
+    log_block_header_t *header = &cols->block->header;
+
+    for (int c = 0; c < LOG_COLUMN_COUNT; c++)
+    {
+        int64_t value = log_columns_get(&cols->record, (log_column_t)c);
+        switch (log_columns_spec[c].codec)
+        {
+        case LOG_CODEC_DELTA:
+            log_columns_put(cols, (log_column_t)c, log_columns_zigzag(value - cols->last[c]));
+            break;
+        case LOG_CODEC_DELTA2:
+            if (header->count == 0)
+            {
+                log_columns_put(cols, (log_column_t)c, log_columns_zigzag(value));
+            }
+            else
+            {
+                /* Wrapping arithmetic, the reader undoes it the same way */
+                int64_t delta = (int64_t)((uint64_t)value - (uint64_t)cols->last[c]);
+                log_columns_put(cols, (log_column_t)c,
+                                log_columns_zigzag((int64_t)((uint64_t)delta - (uint64_t)cols->delta[c])));
+                cols->delta[c] = delta;
+            }
+            break;
+        case LOG_CODEC_RLE:
+            if (cols->run[c] > 0 && value == cols->last[c])
+            {
+                cols->run[c]++;
+                break;
+            }
+            if (cols->run[c] > 0)
+            {
+                log_columns_put(cols, (log_column_t)c, (uint64_t)cols->last[c]);
+                log_columns_put(cols, (log_column_t)c, cols->run[c]);
+            }
+            cols->run[c] = 1;
+            break;
+        default:
+            break;
+        }
+        cols->last[c] = value;
+    }
+
+    if (header->count == 0)
+    {
+        header->first_us = cols->record.time_us;
+    }
+    header->last_us = cols->record.time_us;
+    header->count++;
+}
+
+/**
+ * @brief Check if the block might not take another record
+ *
+ * @param cols  pointer to builder
+ * @return true block full
+ */
+bool log_columns_full(const log_columns_t *const cols)
+{
+    size_t need = 0;
+
+    if (cols->block->header.count >= LOG_COLUMNS_ROWS)
+    {
+        return true;
+    }
+    for (int c = 0; c < LOG_COLUMN_COUNT; c++)
+    {
+        need += cols->size[c] + log_columns_spec[c].worst;
+        if (cols->run[c] > 0)
+        {
+            need += log_columns_varint_size((uint64_t)cols->last[c]) + log_columns_varint_size(cols->run[c]);
+        }
+    }
+    return need > LOG_COLUMNS_DATA;
+}
+
+/**
+ * @brief Close the open runs, lay out directory and columns, and seal the block
+ *
+ * @param cols  pointer to builder
+ */
+void log_columns_seal(log_columns_t *const cols)
+{
+    log_block_t *block = cols->block;
+    log_column_entry_t *directory = (log_column_entry_t *)block->payload;
+    uint8_t *p = block->payload + LOG_COLUMNS_DIRECTORY;
+
+    for (int c = 0; c < LOG_COLUMN_COUNT; c++)
+    {
+        if (cols->run[c] > 0)
+        {
+            log_columns_put(cols, (log_column_t)c, (uint64_t)cols->last[c]);
+            log_columns_put(cols, (log_column_t)c, cols->run[c]);
+            cols->run[c] = 0;
+        }
+        directory[c] = (log_column_entry_t){.codec = log_columns_spec[c].codec, .size = cols->size[c]};
+        memcpy(p, cols->data[c], cols->size[c]);
+        p += cols->size[c];
+    }
+    log_block_seal(block);
+}
+
+/**
+ * @brief Decode one column
+ *
+ * @param entry     directory entry of the column
+ * @param p         column bytes
+ * @param count     number of values
+ * @param values    destination
+ * @return int 0, -1 if the column is malformed
+ */
+static int log_columns_unpack(const log_column_entry_t *entry, const uint8_t *p, uint16_t count, int64_t *values)
+{
+    const uint8_t *end = p + entry->size;
+    uint64_t raw;
+    uint64_t run;
+    uint64_t value = 0;
+    uint64_t delta = 0;
+
+    switch (entry->codec)
+    {
+    case LOG_CODEC_DELTA:
+        for (uint16_t i = 0; i < count; i++)
+        {
+            if (!log_columns_get_varint(&p, end, &raw))
+            {
+                return -1;
+            }
+            value += (uint64_t)log_columns_unzigzag(raw);
+            values[i] = (int64_t)value;
+        }
+        break;
+    case LOG_CODEC_DELTA2:
+        for (uint16_t i = 0; i < count; i++)
+        {
+            if (!log_columns_get_varint(&p, end, &raw))
+            {
+                return -1;
+            }
+            if (i == 0)
+            {
+                value = (uint64_t)log_columns_unzigzag(raw);
+            }
+            else
+            {
+                delta += (uint64_t)log_columns_unzigzag(raw);
+                value += delta;
+            }
+            values[i] = (int64_t)value;
+        }
+        break;
+    case LOG_CODEC_RLE:
+        for (uint16_t i = 0; i < count;)
+        {
+            if (!log_columns_get_varint(&p, end, &value) || !log_columns_get_varint(&p, end, &run) || run == 0 ||
+                run > (uint64_t)(count - i))
+            {
+                return -1;
+            }
+            for (; run > 0; run--)
+            {
+                values[i++] = (int64_t)value;
+            }
+        }
+        break;
+    default:
+        return -1;
+    }
+    return p == end ? 0 : -1;
+}
+
+/**
+ * @brief Check the record count and, for a columnar block, the directory
+ *
+ * @param block pointer to block, verified
+ * @return true block can be decoded
+ */
+static bool log_columns_valid(const log_block_t *const block)
+{
+    const log_column_entry_t *directory = (const log_column_entry_t *)block->payload;
+    size_t size = 0;
+
+    if (block->header.layout == LOG_LAYOUT_ROW)
+    {
+        return block->header.count <= LOG_BLOCK_RECORDS;
+    }
+    if (block->header.layout != LOG_LAYOUT_COLUMNAR || block->header.count > LOG_COLUMNS_ROWS)
+    {
+        return false;
+    }
+    for (int c = 0; c < LOG_COLUMN_COUNT; c++)
+    {
+        size += directory[c].size;
+    }
+    return size <= LOG_COLUMNS_DATA;
+}
+
+/**
+ * @brief Values of one field of every record, from a block of either layout
+ *
+ * A columnar block is read from its directory and the one column only.
+ *
+ * @param block     pointer to block, verified
+ * @param column    field
+ * @param values    destination, room for header.count, at most LOG_COLUMNS_ROWS
+ * @return int number of values, -1 if the block is malformed
+ */
+int log_columns_read(const log_block_t *const block, log_column_t column, int64_t *values)
+{
+    const log_column_entry_t *directory = (const log_column_entry_t *)block->payload;
+    uint16_t count = block->header.count;
+
+    if ((unsigned)column >= LOG_COLUMN_COUNT || !log_columns_valid(block))
+    {
+        return -1;
+    }
+    if (block->header.layout == LOG_LAYOUT_ROW)
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            log_record_t record;
+            log_block_record(block, i, &record);
+            values[i] = log_columns_get(&record, column);
+        }
+        return count;
+    }
+
+    size_t offset = LOG_COLUMNS_DIRECTORY;
+    for (int c = 0; c < (int)column; c++)
+    {
+        offset += directory[c].size;
+    }
+    if (log_columns_unpack(&directory[column], block->payload + offset, count, values) != 0)
+    {
+        return -1;
+    }
+    return count;
+}
+
+/**
+ * @brief Every record of a block of either layout
+ *
+ * @param block     pointer to block, verified
+ * @param records   destination, room for header.count, at most LOG_COLUMNS_ROWS
+ * @return int number of records, -1 if the block is malformed
+ */
+int log_columns_decode(const log_block_t *const block, log_record_t *records)
+{
+    const log_column_entry_t *directory = (const log_column_entry_t *)block->payload;
+    const uint8_t *p = block->payload + LOG_COLUMNS_DIRECTORY;
+    uint16_t count = block->header.count;
+
+    if (!log_columns_valid(block))
+    {
+        return -1;
+    }
+    if (block->header.layout == LOG_LAYOUT_ROW)
+    {
+        memcpy(records, block->payload, count * sizeof(log_record_t));
+        return count;
+    }
+
+    int64_t values[LOG_COLUMNS_ROWS];
+    for (int c = 0; c < LOG_COLUMN_COUNT; c++)
+    {
+        if (log_columns_unpack(&directory[c], p, count, values) != 0)
+        {
+            return -1;
+        }
+        p += directory[c].size;
+        log_columns_scatter(records, (log_column_t)c, values, count);
+    }
+    return count;
+}
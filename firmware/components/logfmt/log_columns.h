@@ -0,0 +1,135 @@
+/**
+ * @file log_columns.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Columnar log block: one encoded column per record field
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A LOG_LAYOUT_COLUMNAR payload starts with a directory of LOG_COLUMN_COUNT
+ * entries, then holds the columns back to back in log_column_t order. Each
+ * column stores header.count values with its own codec, so a reader after
+ * one field decodes the directory and that column only.
+ */
+#ifndef _LOG_COLUMNS_H_
+#define _LOG_COLUMNS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "log_block.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum log_column_t log_columns.h
+ * @brief Columns of a columnar block, in payload order
+ */
+typedef enum
+{
+    LOG_COLUMN_TIME = 0,        /*!< log_record_t.time_us */
+    LOG_COLUMN_TYPE = 1,        /*!< log_record_t.type */
+    LOG_COLUMN_FLAGS = 2,       /*!< log_record_t.flags */
+    LOG_COLUMN_BATTERY = 3,     /*!< log_record_t.battery_mv */
+    LOG_COLUMN_TEMPERATURE = 4, /*!< log_record_t.temperature */
+    LOG_COLUMN_PRESSURE = 5,    /*!< log_record_t.pressure */
+    LOG_COLUMN_COUNT = 6,       /*!< Number of columns */
+} log_column_t;
+
+/**
+ * @enum log_codec_t log_columns.h
+ * @brief Column encodings, integers are zigzag LEB128 varints
+ */
+typedef enum
+{
+    LOG_CODEC_DELTA = 1,  /*!< Difference to the previous value, the first to 0 */
+    LOG_CODEC_DELTA2 = 2, /*!< First value, then difference of the differences */
+    LOG_CODEC_RLE = 3,    /*!< Runs of equal values as value, length pairs */
+} log_codec_t;
+
+/**
+ * @struct log_column_entry_t log_columns.h
+ * @brief Directory entry of one column, little endian
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      uint8_t codec;
+ *      uint8_t reserved;
+ *      uint16_t size;
+ * }log_column_entry_t;
+ * ~~~
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t codec;    /*!< Encoding @see log_codec_t */
+    uint8_t reserved; /*!< 0 */
+    uint16_t size;    /*!< Column size in bytes */
+} log_column_entry_t;
+
+#define LOG_COLUMNS_DIRECTORY (LOG_COLUMN_COUNT * sizeof(log_column_entry_t)) /*!< Directory size in bytes */
+#define LOG_COLUMNS_DATA (LOG_BLOCK_PAYLOAD - LOG_COLUMNS_DIRECTORY)        /*!< Bytes for the columns */
+#define LOG_COLUMNS_ROWS (LOG_COLUMNS_DATA / 4) /*!< Most records in a block of either layout */
+
+#ifdef __cplusplus
+static_assert(sizeof(log_column_entry_t) == 4, "directory entry size");
+static_assert(LOG_COLUMNS_ROWS >= LOG_BLOCK_RECORDS, "row blocks fit the readers");
+#else
+_Static_assert(sizeof(log_column_entry_t) == 4, "directory entry size");
+_Static_assert(LOG_COLUMNS_ROWS >= LOG_BLOCK_RECORDS, "row blocks fit the readers");
+#endif
+
+/**
+ * @struct log_columns_t log_columns.h
+ * @brief Builds a columnar block one record at a time
+ *
+ * Records are encoded on commit into per-column buffers, and laid out in
+ * the block when it is sealed. Until then only the header of the block is
+ * up to date.
+ *
+ * ### Example
+ * ~~~.c
+ * log_columns_t cols;
+ * log_columns_init(&cols, &block, seq);
+ * while (!log_columns_full(&cols))
+ * {
+ *     log_record_t *r = log_columns_reserve(&cols);
+ *     r->time_us = now_us;
+ *     ...
+ *     log_columns_commit(&cols);
+ * }
+ * log_columns_seal(&cols);
+ * ~~~
+ */
+typedef struct
+{
+    log_block_t *block;                               /*!< Block being built */
+    log_record_t record;                              /*!< Slot returned by log_columns_reserve() */
+    int64_t last[LOG_COLUMN_COUNT];                   /*!< Previous value of each column */
+    int64_t delta[LOG_COLUMN_COUNT];                  /*!< Previous difference of LOG_CODEC_DELTA2 columns */
+    uint16_t run[LOG_COLUMN_COUNT];                   /*!< Length of the open run of LOG_CODEC_RLE columns */
+    uint16_t size[LOG_COLUMN_COUNT];                  /*!< Encoded bytes of each column */
+    uint8_t data[LOG_COLUMN_COUNT][LOG_COLUMNS_DATA]; /*!< Encoded columns */
+} log_columns_t;
+
+void log_columns_init(log_columns_t *const cols, log_block_t *const block, uint32_t seq);
+
+log_record_t *log_columns_reserve(log_columns_t *const cols);
+
+void log_columns_commit(log_columns_t *const cols);
+
+bool log_columns_full(const log_columns_t *const cols);
+
+void log_columns_seal(log_columns_t *const cols);
+
+int log_columns_read(const log_block_t *const block, log_column_t column, int64_t *values);
+
+int log_columns_decode(const log_block_t *const block, log_record_t *records);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file log_record.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Fixed size sample record shared by the firmware and the host tools
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _LOG_RECORD_H_
+#define _LOG_RECORD_H_
+
+#include <stdint.h>
+
+/**
+ * @enum log_record_type_t log_record.h
+ * @brief Record type
+ */
+typedef enum
+{
+    LOG_RECORD_SAMPLE = 0, /*!< Sensor sample */
+    LOG_RECORD_RATE = 1,   /*!< Sampling period change */
+} log_record_type_t;
+
+/**
+ * @struct log_record_t log_record.h
+ * @brief One logged row, little endian, 20 bytes
+ *
+ * Values are kept as integers so no float formatting is needed on the device.
+ * A LOG_RECORD_RATE record marks a new sampling period from time_us on:
+ * pressure holds the new period and temperature the old one, both in ms,
+ * and flags the reason bits of adaptive_rate_reason_t.
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      int64_t time_us;
+ *      uint8_t type;
+ *      uint8_t flags;
+ *      uint16_t battery_mv;
+ *      int32_t temperature;
+ *      uint32_t pressure;
+ * }log_record_t;
+ * ~~~
+ */
+typedef struct __attribute__((packed))
+{
+    int64_t time_us;     /*!< Unix epoch time in microseconds */
+    uint8_t type;        /*!< Record type @see log_record_type_t */
+    uint8_t flags;       /*!< Record flags */
+    uint16_t battery_mv; /*!< Battery voltage in mV, 0 if unknown */
+    int32_t temperature; /*!< Temperature in 0.01 degrees Celsius */
+    uint32_t pressure;   /*!< Pressure in Pa */
+} log_record_t;
+
+#ifdef __cplusplus
+static_assert(sizeof(log_record_t) == 20, "log_record_t must stay 20 bytes");
+#else
+_Static_assert(sizeof(log_record_t) == 20, "log_record_t must stay 20 bytes");
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file block_pool.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Fixed pool of log blocks with O(1) alloc and free
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stddef.h>
+#include "block_pool.h"
+
+/**
+ * @brief Initialize a pool with every block free
+ *
+ * @param pool      pointer to pool
+ * @param blocks    block storage, @p count entries
+ * @param ring      index storage, @p count entries
+ * @param count     number of blocks
+ */
+void block_pool_init(block_pool_t *const pool, log_block_t *blocks, uint16_t *ring, uint16_t count)
+{
+    pool->blocks = blocks;
+    pool->ring = ring;
+    pool->count = count;
+    pool->head = 0;
+    pool->available = count;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        ring[i] = i;
+    }
+}
+
+/**
+ * @brief Take a free block
+ *
+ * @param pool  pointer to pool
+ * @return log_block_t* block, NULL if the pool is empty
+ */
+log_block_t *block_pool_alloc(block_pool_t *const pool)
+{
+    if (pool->available == 0)
+    {
+        return NULL;
+    }
+    uint16_t index = pool->ring[pool->head];
+    pool->head = (uint16_t)((pool->head + 1) % pool->count);
+    pool->available--;
+    return &pool->blocks[index];
+}
+
+/**
+ * @brief Return a block to the pool
+ *
+ * @param pool  pointer to pool
+ * @param block block previously taken with block_pool_alloc()
+ */
+void block_pool_free(block_pool_t *const pool, log_block_t *block)
+{
+    uint16_t tail = (uint16_t)((pool->head + pool->available) % pool->count);
+    pool->ring[tail] = (uint16_t)(block - pool->blocks);
+    pool->available++;
+}
+
+/**
+ * @brief Number of free blocks
+ *
+ * @param pool  pointer to pool
+ * @return uint16_t free blocks
+ */
+uint16_t block_pool_available(const block_pool_t *const pool)
+{
+    return pool->available;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file block_pool.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Fixed pool of log blocks with O(1) alloc and free
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _BLOCK_POOL_H_
+#define _BLOCK_POOL_H_
+
+#include <stdint.h>
+#include "logfmt/log_block.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct block_pool_t block_pool.h
+ * @brief Pool of caller provided blocks
+ *
+ * Free blocks are kept in a FIFO of indices, so blocks are handed out in
+ * memory order and consecutive full blocks are usually adjacent. The pool is
+ * not locked; callers sharing it between tasks guard alloc and free.
+ *
+ * ### Example
+ * ~~~.c
+ * static log_block_t blocks[16];
+ * static uint16_t ring[16];
+ * block_pool_t pool;
+ * block_pool_init(&pool, blocks, ring, 16);
+ * ~~~
+ */
+typedef struct
+{
+    log_block_t *blocks; /*!< Block storage */
+    uint16_t *ring;      /*!< Free index FIFO, one entry per block */
+    uint16_t count;      /*!< Number of blocks */
+    uint16_t head;       /*!< Next index to allocate */
+    uint16_t available;  /*!< Number of free blocks */
+} block_pool_t;
+
+void block_pool_init(block_pool_t *const pool, log_block_t *blocks, uint16_t *ring, uint16_t count);
+
+log_block_t *block_pool_alloc(block_pool_t *const pool);
+
+void block_pool_free(block_pool_t *const pool, log_block_t *block);
+
+uint16_t block_pool_available(const block_pool_t *const pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
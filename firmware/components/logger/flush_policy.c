@@ -0,0 +1,159 @@
+/**
+ * @file flush_policy.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief When to seal, write and sync log blocks, from pool fill, battery and events
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every write wakes the card and every sync rewrites the FAT and the
+ * directory entry, so batching saves energy; everything not yet synced is
+ * lost on a power cut, so batching costs durability. The battery decides
+ * which matters more. Decisions are pure functions of a flush_view_t so the
+ * same code runs in the logger and in tools/sim/flush_sim.c.
+ */
+
+#include "flush_policy.h"
+
+/**
+ * @brief Mode for a battery state, no hysteresis
+ *
+ * @param policy        pointer to policy
+ * @param percentage    battery percentage
+ * @param battery_mv    battery voltage, 0 if unknown
+ * @return flush_mode_t mode
+ */
+static flush_mode_t flush_classify(const flush_policy_t *const policy, int percentage, uint16_t battery_mv)
+{
+    if (percentage <= policy->critical_percentage ||
+        (policy->brownout_mv > 0 && battery_mv > 0 && battery_mv <= policy->brownout_mv))
+    {
+        return FLUSH_EAGER;
+    }
+    if (percentage <= policy->low_percentage)
+    {
+        return FLUSH_BALANCED;
+    }
+    return FLUSH_BULK;
+}
+
+/**
+ * @brief Mode for the current battery state
+ *
+ * Moves to a more eager mode as soon as a threshold is crossed, back to a
+ * cheaper one only once the battery is policy->hysteresis points above it.
+ *
+ * @param policy        pointer to policy
+ * @param current       mode in use
+ * @param percentage    battery percentage, @see battery_percentage()
+ * @param battery_mv    battery voltage, 0 if unknown
+ * @param event         an event is being held
+ * @return flush_mode_t mode to use
+ */
+flush_mode_t flush_mode(const flush_policy_t *const policy, flush_mode_t current, uint8_t percentage,
+                        uint16_t battery_mv, bool event)
+{
+    if (event)
+    {
+        return FLUSH_EAGER;
+    }
+
+    flush_mode_t target = flush_classify(policy, percentage, battery_mv);
+    if (target >= current)
+    {
+        return target;
+    }
+    /* Leaving for a cheaper mode: thresholds raised by the hysteresis */
+    flush_mode_t sticky = flush_classify(policy, (int)percentage - policy->hysteresis, battery_mv);
+    return sticky < current ? sticky : current;
+}
+
+/**
+ * @brief Actions due now
+ *
+ * The producer and the writer each see part of the logger: the producer
+ * asks with the block it fills (open_records) to learn whether to seal it,
+ * the writer with the sealed blocks to learn whether to write and sync.
+ *
+ * @param policy    pointer to policy
+ * @param mode      mode in use, @see flush_mode()
+ * @param view      logger state
+ * @return unsigned flush_action_t bits
+ */
+unsigned flush_decide(const flush_policy_t *const policy, flush_mode_t mode, const flush_view_t *const view)
+{
+    const flush_tier_t *tier = &policy->tier[mode];
+    unsigned actions = FLUSH_NONE;
+    bool pending = view->sealed > 0 || view->open_records > 0;
+    bool old = pending && (uint32_t)(view->now_ms - view->oldest_ms) >= tier->max_age_ms;
+
+    if (view->open_records > 0 && (view->urgent || old))
+    {
+        actions |= FLUSH_SEAL;
+    }
+
+    uint16_t sealed = view->sealed + ((actions & FLUSH_SEAL) ? 1 : 0);
+    if (sealed > 0 && (view->urgent || old || sealed >= tier->batch_blocks || view->free <= policy->reserve_blocks))
+    {
+        actions |= FLUSH_WRITE;
+    }
+
+    if (view->unsynced || (actions & FLUSH_WRITE))
+    {
+        bool due = view->unsynced && (uint32_t)(view->now_ms - view->written_ms) >= tier->sync_ms;
+        if (view->urgent || tier->sync_ms == 0 || due)
+        {
+            actions |= FLUSH_SYNC;
+        }
+    }
+    return actions;
+}
+
+/**
+ * @brief Time until flush_decide() has something to do without new blocks
+ *
+ * @param policy    pointer to policy
+ * @param mode      mode in use
+ * @param view      logger state after the last actions
+ * @return uint32_t ms, 0 if due now, FLUSH_WAIT_FOREVER if nothing is pending
+ */
+uint32_t flush_wait_ms(const flush_policy_t *const policy, flush_mode_t mode, const flush_view_t *const view)
+{
+    const flush_tier_t *tier = &policy->tier[mode];
+    uint32_t wait = FLUSH_WAIT_FOREVER;
+
+    if (view->sealed > 0 || view->open_records > 0)
+    {
+        uint32_t age = view->now_ms - view->oldest_ms;
+        wait = age >= tier->max_age_ms ? 0 : tier->max_age_ms - age;
+    }
+    if (view->unsynced)
+    {
+        uint32_t age = view->now_ms - view->written_ms;
+        uint32_t sync = age >= tier->sync_ms ? 0 : tier->sync_ms - age;
+        wait = sync < wait ? sync : wait;
+    }
+    return wait;
+}
+
+/**
+ * @brief Name of a mode
+ *
+ * @param mode  mode
+ * @return const char* "bulk", "balanced" or "eager"
+ */
+const char *flush_mode_name(flush_mode_t mode)
+{
+    switch (mode)
+    {
+    case FLUSH_BULK:
+        return "bulk";
+    case FLUSH_BALANCED:
+        return "balanced";
+    case FLUSH_EAGER:
+        return "eager";
+    default:
+        return "?";
+    }
+}
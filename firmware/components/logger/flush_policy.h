@@ -0,0 +1,135 @@
+/**
+ * @file flush_policy.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief When to seal, write and sync log blocks, from pool fill, battery and events
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _FLUSH_POLICY_H_
+#define _FLUSH_POLICY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLUSH_MODES 3                 /*!< Number of flush_mode_t */
+#define FLUSH_WAIT_FOREVER UINT32_MAX /*!< flush_wait_ms(): no deadline pending */
+
+/**
+ * @enum flush_mode_t flush_policy.h
+ * @brief How much unwritten data the logger may hold
+ */
+typedef enum
+{
+    FLUSH_BULK = 0,     /*!< Healthy battery: few large writes, rare syncs */
+    FLUSH_BALANCED = 1, /*!< Low battery: smaller batches, bounded age */
+    FLUSH_EAGER = 2,    /*!< Critical battery, brown-out risk or an event: write and sync right away */
+} flush_mode_t;
+
+/**
+ * @enum flush_action_t flush_policy.h
+ * @brief Actions returned by flush_decide(), combined as bits
+ */
+typedef enum
+{
+    FLUSH_NONE = 0,       /*!< Keep buffering */
+    FLUSH_SEAL = 1 << 0,  /*!< Hand the block being filled to the writer */
+    FLUSH_WRITE = 1 << 1, /*!< Write every sealed block */
+    FLUSH_SYNC = 1 << 2,  /*!< Commit written data to the media */
+} flush_action_t;
+
+/**
+ * @struct flush_tier_t flush_policy.h
+ * @brief Limits of one mode
+ */
+typedef struct
+{
+    uint16_t batch_blocks; /*!< Write once this many sealed blocks wait */
+    uint32_t max_age_ms;   /*!< Seal and write once the oldest unwritten record is this old */
+    uint32_t sync_ms;      /*!< Sync once the oldest unsynced write is this old, 0 after every write */
+} flush_tier_t;
+
+/**
+ * @struct flush_policy_t flush_policy.h
+ * @brief Mode limits and the thresholds that pick a mode
+ *
+ * The battery picks the mode: BULK above low_percentage, BALANCED down to
+ * critical_percentage, EAGER below it or under brownout_mv. A mode is only
+ * left for a cheaper one once the battery is hysteresis points above the
+ * threshold, so ADC noise does not toggle it. A flagged event forces EAGER
+ * for event_hold_ms. Whatever the mode, sealed blocks are written once the
+ * pool has no more than reserve_blocks free, so the producer never drops.
+ *
+ * ### Example
+ * ~~~.c
+ * flush_policy_t policy = FLUSH_POLICY_DEFAULT();
+ * flush_mode_t mode = flush_mode(&policy, FLUSH_BULK, percentage, battery_mv, false);
+ * unsigned actions = flush_decide(&policy, mode, &view);
+ * ~~~
+ */
+typedef struct
+{
+    flush_tier_t tier[FLUSH_MODES]; /*!< Limits by mode */
+    uint8_t low_percentage;         /*!< BALANCED at or below */
+    uint8_t critical_percentage;    /*!< EAGER at or below */
+    uint8_t hysteresis;             /*!< Percentage points above a threshold before leaving its mode */
+    uint16_t brownout_mv;           /*!< EAGER at or below, 0 to ignore the voltage */
+    uint16_t reserve_blocks;        /*!< Write regardless once this few blocks are free */
+    uint32_t event_hold_ms;         /*!< EAGER this long after an event */
+} flush_policy_t;
+
+/**
+ * Defaults for 1 Hz records, about 24 s per block: a healthy battery puts at
+ * most 5 min of data at risk, a critical one 5 s.
+ */
+#define FLUSH_POLICY_DEFAULT()                                                             \
+    {                                                                                      \
+        .tier = {                                                                          \
+            [FLUSH_BULK] = {.batch_blocks = 8, .max_age_ms = 300000, .sync_ms = 300000},   \
+            [FLUSH_BALANCED] = {.batch_blocks = 2, .max_age_ms = 60000, .sync_ms = 60000}, \
+            [FLUSH_EAGER] = {.batch_blocks = 1, .max_age_ms = 5000, .sync_ms = 0},         \
+        },                                                                                 \
+        .low_percentage = 40,                                                              \
+        .critical_percentage = 15,                                                         \
+        .hysteresis = 3,                                                                   \
+        .brownout_mv = 3450,                                                               \
+        .reserve_blocks = 4,                                                               \
+        .event_hold_ms = 60000,                                                            \
+    }
+
+/**
+ * @struct flush_view_t flush_policy.h
+ * @brief State of the logger a decision is made on, times in ms on any wrapping clock
+ */
+typedef struct
+{
+    uint32_t now_ms;       /*!< Current time */
+    uint16_t sealed;       /*!< Sealed blocks waiting for the writer */
+    uint16_t free;         /*!< Free blocks in the pool */
+    uint16_t open_records; /*!< Records in the block being filled */
+    uint32_t oldest_ms;    /*!< Commit time of the oldest unwritten record, when sealed or open_records */
+    bool unsynced;         /*!< Written since the last sync */
+    uint32_t written_ms;   /*!< Oldest write since the last sync, when unsynced */
+    bool urgent;           /*!< An event was flagged: seal, write and sync now */
+} flush_view_t;
+
+flush_mode_t flush_mode(const flush_policy_t *const policy, flush_mode_t current, uint8_t percentage,
+                        uint16_t battery_mv, bool event);
+
+unsigned flush_decide(const flush_policy_t *const policy, flush_mode_t mode, const flush_view_t *const view);
+
+uint32_t flush_wait_ms(const flush_policy_t *const policy, flush_mode_t mode, const flush_view_t *const view);
+
+const char *flush_mode_name(flush_mode_t mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,228 @@
+/**
+ * @file log_dir.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Log files of a directory tree, listed in order and read by block
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The logger names files MOUNT_POINT/YYYYMMDD/hhmmss.BIN once the clock is
+ * known, MOUNT_POINT/LOGnnnnn.BIN before, and MOUNT_POINT/SPILLnnn.BIN for
+ * blocks drained from flash. Anything else on the card is skipped.
+ */
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "log_dir.h"
+
+/**
+ * @brief Log file name: ends in .BIN, any case
+ */
+static bool log_dir_is_log(const char *name)
+{
+    size_t len = strlen(name);
+    return len > 4 && strcasecmp(&name[len - 4], ".BIN") == 0;
+}
+
+/**
+ * @brief Day directory name: 8 digits
+ */
+static bool log_dir_is_day(const char *name)
+{
+    size_t len = 0;
+    while (name[len] >= '0' && name[len] <= '9')
+    {
+        len++;
+    }
+    return len == 8 && name[len] == '\0';
+}
+
+/**
+ * @brief Drop the walk cursor, the next walk starts over
+ */
+static void log_dir_rewind(log_dir_t *dir)
+{
+    if (dir->day != NULL)
+    {
+        closedir(dir->day);
+        dir->day = NULL;
+    }
+    if (dir->top != NULL)
+    {
+        closedir(dir->top);
+        dir->top = NULL;
+    }
+    dir->next = 0;
+}
+
+/**
+ * @brief Name of the next log file in walk order
+ *
+ * @return int 0 found, -1 no more files or root unreadable
+ */
+static int log_dir_next(log_dir_t *dir, char *name, size_t size)
+{
+    char path[LOG_DIR_PATH_MAX];
+
+    if (dir->top == NULL && dir->next == 0)
+    {
+        dir->top = opendir(dir->root);
+    }
+    while (dir->top != NULL)
+    {
+        struct dirent *entry;
+        if (dir->day != NULL)
+        {
+            entry = readdir(dir->day);
+            if (entry == NULL)
+            {
+                closedir(dir->day);
+                dir->day = NULL;
+            }
+            else if (entry->d_type != DT_DIR && log_dir_is_log(entry->d_name))
+            {
+                snprintf(name, size, "%s/%s", dir->day_name, entry->d_name);
+                return 0;
+            }
+            continue;
+        }
+
+        entry = readdir(dir->top);
+        if (entry == NULL)
+        {
+            return -1;
+        }
+        if (entry->d_type == DT_DIR)
+        {
+            /* Descend into day directories only */
+            if (log_dir_is_day(entry->d_name))
+            {
+                snprintf(path, sizeof(path), "%s/%s", dir->root, entry->d_name);
+                strcpy(dir->day_name, entry->d_name);
+                dir->day = opendir(path);
+            }
+        }
+        else if (log_dir_is_log(entry->d_name))
+        {
+            snprintf(name, size, "%s", entry->d_name);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Set up a listing of a root directory, nothing is opened yet
+ *
+ * @param dir   pointer to listing
+ * @param root  directory path, kept by reference
+ */
+void log_dir_init(log_dir_t *dir, const char *root)
+{
+    memset(dir, 0, sizeof(*dir));
+    dir->root = root;
+    dir->fd = -1;
+}
+
+/**
+ * @brief Name and size of a log file
+ *
+ * @param dir       pointer to listing
+ * @param index     segment number, 0 first in directory order
+ * @param name      destination for the path relative to the root, LOG_DIR_NAME_MAX bytes
+ * @param size      size of name
+ * @param blocks    whole blocks in the file
+ * @return int 0 success, -1 no such segment
+ */
+int log_dir_segment(log_dir_t *dir, uint16_t index, char *name, size_t size, uint32_t *blocks)
+{
+    char path[LOG_DIR_PATH_MAX];
+    struct stat st;
+
+    if (index < dir->next)
+    {
+        log_dir_rewind(dir);
+    }
+    while (dir->next <= index)
+    {
+        if (log_dir_next(dir, name, size) != 0)
+        {
+            return -1;
+        }
+        dir->next++;
+    }
+
+    snprintf(path, sizeof(path), "%s/%s", dir->root, name);
+    if (stat(path, &st) != 0)
+    {
+        return -1;
+    }
+    *blocks = (uint32_t)(st.st_size / LOG_BLOCK_SIZE);
+    return 0;
+}
+
+/**
+ * @brief Read one block of a log file
+ *
+ * The file stays open for the next read of the same segment.
+ *
+ * @param dir       pointer to listing
+ * @param index     segment number @see log_dir_segment()
+ * @param block     block number in the file
+ * @param dst       destination
+ * @return int 0 success, -1 no such segment, block or read error
+ */
+int log_dir_read(log_dir_t *dir, uint16_t index, uint32_t block, log_block_t *dst)
+{
+    if (dir->fd < 0 || dir->fd_index != index)
+    {
+        char name[LOG_DIR_NAME_MAX];
+        char path[LOG_DIR_PATH_MAX];
+        uint32_t blocks;
+
+        if (dir->fd >= 0)
+        {
+            close(dir->fd);
+            dir->fd = -1;
+        }
+        if (log_dir_segment(dir, index, name, sizeof(name), &blocks) != 0)
+        {
+            return -1;
+        }
+        snprintf(path, sizeof(path), "%s/%s", dir->root, name);
+        dir->fd = open(path, O_RDONLY);
+        if (dir->fd < 0)
+        {
+            return -1;
+        }
+        dir->fd_index = index;
+    }
+
+    if (lseek(dir->fd, (off_t)block * LOG_BLOCK_SIZE, SEEK_SET) < 0 ||
+        read(dir->fd, dst, LOG_BLOCK_SIZE) != LOG_BLOCK_SIZE)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Close the open file and the walk cursor
+ *
+ * @param dir   pointer to listing
+ */
+void log_dir_close(log_dir_t *dir)
+{
+    log_dir_rewind(dir);
+    if (dir->fd >= 0)
+    {
+        close(dir->fd);
+        dir->fd = -1;
+    }
+}
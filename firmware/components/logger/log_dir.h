@@ -0,0 +1,73 @@
+/**
+ * @file log_dir.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Log files of a directory tree, listed in order and read by block
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _LOG_DIR_H_
+#define _LOG_DIR_H_
+
+#include <dirent.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "logfmt/log_block.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOG_DIR_PATH_MAX 64 /*!< Longest path, root included */
+#define LOG_DIR_NAME_MAX 24 /*!< Longest name relative to the root, "YYYYMMDD/hhmmss.BIN" */
+
+/**
+ * @struct log_dir_t log_dir.h
+ * @brief Log files under a root directory
+ *
+ * Segments are the *.BIN files of the root and of its YYYYMMDD day
+ * directories, numbered in directory order. Listing them in order walks
+ * the tree once; the cursor restarts only when an earlier index is asked
+ * for. Uses the POSIX calls the ESP-IDF VFS provides, so the same code
+ * serves a card on the device and a directory on the host. Not locked:
+ * close it before the filesystem goes away.
+ *
+ * ### Example
+ * ~~~.c
+ * log_dir_t dir;
+ * char name[LOG_DIR_NAME_MAX];
+ * uint32_t blocks;
+ * log_dir_init(&dir, "/sdcard");
+ * for (uint16_t i = 0; log_dir_segment(&dir, i, name, sizeof(name), &blocks) == 0; i++)
+ * {
+ *      printf("%s: %u blocks\n", name, blocks);
+ * }
+ * log_dir_close(&dir);
+ * ~~~
+ */
+typedef struct
+{
+    const char *root;  /*!< Directory holding the logs, no trailing '/' */
+    DIR *top;          /*!< Cursor in root, NULL before the first walk */
+    DIR *day;          /*!< Cursor in a day directory, NULL outside one */
+    char day_name[12]; /*!< Name of the day directory */
+    uint16_t next;     /*!< Index the cursor returns next */
+    int fd;            /*!< Open segment, -1 for none */
+    uint16_t fd_index; /*!< Index of the open segment */
+} log_dir_t;
+
+void log_dir_init(log_dir_t *dir, const char *root);
+
+int log_dir_segment(log_dir_t *dir, uint16_t index, char *name, size_t size, uint32_t *blocks);
+
+int log_dir_read(log_dir_t *dir, uint16_t index, uint32_t block, log_block_t *dst);
+
+void log_dir_close(log_dir_t *dir);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
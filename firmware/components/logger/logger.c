@@ -0,0 +1,583 @@
+/**
+ * @file logger.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Zero-copy record logger built on a pool of sector sized blocks
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The producer builds each record in place inside a block taken from a static
+ * DMA capable pool. A full block is sealed and only its pointer travels to
+ * logger_run(), which hands it to the sink and returns it to the pool. The
+ * record bytes are written once, by the producer, and read once, by the SD
+ * card DMA.
+ *
+ * When blocks are sealed, written and synced is left to flush_policy.h:
+ * the producer asks it whether to seal a block early, the writer whether
+ * enough has queued to write and sync. The battery level and flagged events
+ * pick how much unwritten data may be held. At slow sample rates the next
+ * record may come after the age limit, so the writer also seals an open block
+ * that went stale, whenever the producer is not between reserve and commit.
+ *
+ * With CONFIG_LOGGER_LOG_COLUMNAR the record is filled in log_columns_t
+ * instead and encoded into its columns on commit, one small copy that buys
+ * several times as many records per block.
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include "logger.h"
+#include "block_pool.h"
+#if CONFIG_LOGGER_LOG_COLUMNAR
+#include "logfmt/log_columns.h"
+#endif
+
+static DMA_ATTR log_block_t logger_blocks[LOGGER_POOL_BLOCKS]; /* Block storage, internal RAM */
+static uint16_t logger_ring[LOGGER_POOL_BLOCKS];              /* Free block indices */
+static block_pool_t logger_pool;                              /* Free blocks */
+static portMUX_TYPE logger_lock = portMUX_INITIALIZER_UNLOCKED; /* Guards logger_pool and the flush state */
+static uint32_t logger_block_ms[LOGGER_POOL_BLOCKS];           /* Commit time of each block's first record */
+
+static uint8_t logger_queue_storage[LOGGER_POOL_BLOCKS * sizeof(log_block_t *)];
+static StaticQueue_t logger_queue_control;
+static QueueHandle_t logger_queue = NULL; /* Full blocks, oldest first */
+
+static StaticSemaphore_t logger_wake_buffer;
+static SemaphoreHandle_t logger_wake = NULL; /* Given on every handoff and event */
+
+static log_block_t *logger_current = NULL; /* Block being filled, producer only while logger_filling */
+static bool logger_filling;               /* Producer between reserve and commit, under logger_lock */
+static bool logger_passed;                /* Writer passed over the open block while filling, under logger_lock */
+#if CONFIG_LOGGER_LOG_COLUMNAR
+static log_columns_t logger_columns;      /* Encoder of logger_current, producer only */
+#endif
+static uint32_t logger_seq;               /* Next block sequence number */
+static logger_stats_t logger_stats;       /* Counters */
+static flush_view_t logger_view;          /* What the writer knows between passes, writer only */
+
+static const flush_policy_t logger_policy = FLUSH_POLICY_DEFAULT();
+static flush_mode_t logger_mode;     /* Mode in use, under logger_lock */
+static uint8_t logger_percentage;    /* Latest battery percentage, under logger_lock */
+static uint16_t logger_battery_mv;   /* Latest battery voltage, 0 until known, under logger_lock */
+static bool logger_event;            /* Event held, under logger_lock */
+static uint32_t logger_event_ms;     /* Time of the last event, under logger_lock */
+static bool logger_urgent;           /* Event not yet written, under logger_lock */
+
+/**
+ * @brief Millisecond clock of the flush decisions, wraps every 49 days
+ *
+ * @return uint32_t ms since boot
+ */
+static uint32_t logger_now_ms(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+/**
+ * @brief Recompute the flush mode, ending an event hold once it expired
+ *
+ * @param now_ms    current time
+ * @return flush_mode_t mode to use
+ * @note   Call with logger_lock held
+ */
+static flush_mode_t logger_update_mode(uint32_t now_ms)
+{
+    if (logger_event && now_ms - logger_event_ms >= logger_policy.event_hold_ms)
+    {
+        logger_event = false;
+    }
+    logger_mode = flush_mode(&logger_policy, logger_mode, logger_percentage, logger_battery_mv, logger_event);
+    return logger_mode;
+}
+
+/**
+ * @brief Take a block from the pool
+ *
+ * @return log_block_t* block, NULL if the pool is empty
+ */
+static log_block_t *logger_alloc(void)
+{
+    portENTER_CRITICAL(&logger_lock);
+    log_block_t *block = block_pool_alloc(&logger_pool);
+    uint16_t available = block_pool_available(&logger_pool);
+    if (available < logger_stats.low)
+    {
+        logger_stats.low = available;
+    }
+    portEXIT_CRITICAL(&logger_lock);
+    return block;
+}
+
+/**
+ * @brief Return a block to the pool
+ *
+ * @param block block taken with logger_alloc()
+ */
+static void logger_free(log_block_t *block)
+{
+    portENTER_CRITICAL(&logger_lock);
+    block_pool_free(&logger_pool, block);
+    portEXIT_CRITICAL(&logger_lock);
+}
+
+/**
+ * @brief Claim or release logger_current for the producer
+ *
+ * @param filling   true while the producer works on the open block
+ * @return true the writer passed over the open block meanwhile and should look again
+ */
+static bool logger_set_filling(bool filling)
+{
+    portENTER_CRITICAL(&logger_lock);
+    logger_filling = filling;
+    bool passed = logger_passed;
+    logger_passed = false;
+    portEXIT_CRITICAL(&logger_lock);
+    return passed;
+}
+
+/**
+ * @brief Seal the current block and queue it for the writer
+ */
+static void logger_handoff(void)
+{
+#if CONFIG_LOGGER_LOG_COLUMNAR
+    log_columns_seal(&logger_columns);
+#else
+    log_block_seal(logger_current);
+#endif
+    /* Queue holds every block of the pool, this never waits */
+    xQueueSendToBack(logger_queue, &logger_current, 0);
+    logger_current = NULL;
+    xSemaphoreGive(logger_wake);
+}
+
+/**
+ * @brief Initialize the block pool and the full block queue
+ *
+ * @return esp_err_t status
+ */
+esp_err_t logger_init(void)
+{
+    block_pool_init(&logger_pool, logger_blocks, logger_ring, LOGGER_POOL_BLOCKS);
+    logger_queue = xQueueCreateStatic(LOGGER_POOL_BLOCKS, sizeof(log_block_t *), logger_queue_storage,
+                                      &logger_queue_control);
+    logger_wake = xSemaphoreCreateBinaryStatic(&logger_wake_buffer);
+    if (logger_queue == NULL || logger_wake == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    logger_current = NULL;
+    logger_filling = false;
+    logger_passed = false;
+    logger_seq = 0;
+    logger_stats = (logger_stats_t){.low = LOGGER_POOL_BLOCKS};
+    logger_view = (flush_view_t){0};
+    /* Battery unknown until the first reading: assume it is healthy */
+    logger_mode = FLUSH_BULK;
+    logger_percentage = 100;
+    logger_battery_mv = 0;
+    logger_event = false;
+    logger_urgent = false;
+    return ESP_OK;
+}
+
+/**
+ * @brief Slot for the next record, inside the block being filled
+ *
+ * @return log_record_t* record to fill, NULL if every block is waiting on the sink
+ * @note   Single producer. Fill the record, then call logger_commit()
+ */
+log_record_t *logger_reserve(void)
+{
+    logger_set_filling(true);
+    if (logger_current == NULL)
+    {
+        logger_current = logger_alloc();
+        if (logger_current == NULL)
+        {
+            logger_stats.dropped++;
+            logger_set_filling(false);
+            return NULL;
+        }
+#if CONFIG_LOGGER_LOG_COLUMNAR
+        log_columns_init(&logger_columns, logger_current, logger_seq++);
+#else
+        log_block_init(logger_current, logger_seq++);
+#endif
+    }
+#if CONFIG_LOGGER_LOG_COLUMNAR
+    return log_columns_reserve(&logger_columns);
+#else
+    return log_block_reserve(logger_current);
+#endif
+}
+
+/**
+ * @brief Commit the record returned by logger_reserve()
+ *
+ * Hands the block to the writer as soon as it is full, or earlier once its
+ * first record is older than the flush mode allows.
+ */
+void logger_commit(void)
+{
+    uint32_t now = logger_now_ms();
+    size_t index = (size_t)(logger_current - logger_blocks);
+
+#if CONFIG_LOGGER_LOG_COLUMNAR
+    log_columns_commit(&logger_columns);
+    bool full = log_columns_full(&logger_columns);
+#else
+    log_block_commit(logger_current);
+    bool full = log_block_full(logger_current);
+#endif
+    logger_stats.records++;
+    bool first = logger_current->header.count == 1;
+    if (first)
+    {
+        logger_block_ms[index] = now;
+    }
+    if (full)
+    {
+        logger_handoff();
+        logger_set_filling(false);
+        return;
+    }
+
+    portENTER_CRITICAL(&logger_lock);
+    flush_mode_t mode = logger_mode;
+    uint16_t available = block_pool_available(&logger_pool);
+    portEXIT_CRITICAL(&logger_lock);
+    flush_view_t view = {
+        .now_ms = now,
+        .free = available,
+        .open_records = logger_current->header.count,
+        .oldest_ms = logger_block_ms[index],
+    };
+    if (flush_decide(&logger_policy, mode, &view) & FLUSH_SEAL)
+    {
+        logger_stats.partial++;
+        logger_handoff();
+    }
+    bool passed = logger_set_filling(false);
+
+    /* A new open block, or one the writer could not look at: it takes up the age deadline */
+    if ((first || passed) && logger_current != NULL)
+    {
+        xSemaphoreGive(logger_wake);
+    }
+}
+
+/**
+ * @brief Hand a partially filled block to the writer
+ *
+ * @note Producer only
+ */
+void logger_flush(void)
+{
+    logger_set_filling(true);
+    if (logger_current != NULL && logger_current->header.count > 0)
+    {
+        logger_stats.partial++;
+        logger_handoff();
+    }
+    logger_set_filling(false);
+}
+
+/**
+ * @brief Battery state that picks the flush mode
+ *
+ * @param percentage    battery percentage, @see battery_percentage()
+ * @param battery_mv    battery voltage in mV
+ */
+void logger_set_battery(uint8_t percentage, uint16_t battery_mv)
+{
+    portENTER_CRITICAL(&logger_lock);
+    logger_percentage = percentage;
+    logger_battery_mv = battery_mv;
+    flush_mode_t before = logger_mode;
+    bool eager = logger_update_mode(logger_now_ms()) > before;
+    portEXIT_CRITICAL(&logger_lock);
+
+    /* Let the writer apply a more eager mode to what it holds */
+    if (eager)
+    {
+        xSemaphoreGive(logger_wake);
+    }
+}
+
+/**
+ * @brief Mark the data logged so far as critical
+ *
+ * Seals the block being filled, has the writer write and sync everything
+ * now, and holds FLUSH_EAGER for the policy's event_hold_ms.
+ *
+ * @note Producer only
+ */
+void logger_flag_event(void)
+{
+    logger_flush();
+    portENTER_CRITICAL(&logger_lock);
+    logger_event = true;
+    logger_event_ms = logger_now_ms();
+    logger_urgent = true;
+    logger_update_mode(logger_event_ms);
+    portEXIT_CRITICAL(&logger_lock);
+    xSemaphoreGive(logger_wake);
+}
+
+/**
+ * @brief Seal the open block from the writer, unless the producer holds it
+ *
+ * @return true a block was sealed and queued
+ */
+static bool logger_seal_stale(void)
+{
+    log_block_t *block = NULL;
+
+    /* Sealing is a CRC over one block, short enough for the critical section */
+    portENTER_CRITICAL(&logger_lock);
+    if (!logger_filling && logger_current != NULL && logger_current->header.count > 0)
+    {
+#if CONFIG_LOGGER_LOG_COLUMNAR
+        log_columns_seal(&logger_columns);
+#else
+        log_block_seal(logger_current);
+#endif
+        block = logger_current;
+        logger_current = NULL;
+        logger_stats.partial++;
+    }
+    portEXIT_CRITICAL(&logger_lock);
+
+    if (block == NULL)
+    {
+        return false;
+    }
+    xQueueSendToBack(logger_queue, &block, 0);
+    return true;
+}
+
+/**
+ * @brief Write every queued block, adjacent blocks in one call
+ *
+ * @param sink  pointer to sink
+ */
+static void logger_write_queued(const log_sink_t *sink)
+{
+    log_block_t *batch[LOGGER_WRITE_BLOCKS];
+
+    while (xQueueReceive(logger_queue, &batch[0], 0) == pdPASS)
+    {
+        /* Gather blocks adjacent in memory */
+        size_t count = 1;
+        while (count < LOGGER_WRITE_BLOCKS && xQueuePeek(logger_queue, &batch[count], 0) == pdPASS &&
+               batch[count] == batch[count - 1] + 1)
+        {
+            xQueueReceive(logger_queue, &batch[count], 0);
+            count++;
+        }
+
+        if (sink->write(sink->ctx, batch[0], count) == ESP_OK)
+        {
+            logger_stats.writes++;
+            logger_stats.blocks += count;
+        }
+        else
+        {
+            logger_stats.errors++;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            logger_free(batch[i]);
+        }
+    }
+}
+
+/**
+ * @brief One pass of the writer: seal a stale open block, write and sync as due
+ *
+ * Seals, writes and syncs as flush_decide() says. Blocks that follow each
+ * other in the pool are passed in one write() so the sink can issue
+ * multi-sector transfers.
+ *
+ * @param sink  pointer to sink
+ * @return uint32_t ms until the next pass is due, FLUSH_WAIT_FOREVER if only a new block or event makes one
+ * @note   Writer only, logger_run() calls it in a loop; a host driving the logger on its own clock calls it directly
+ */
+uint32_t logger_step(const log_sink_t *sink)
+{
+    flush_view_t *view = &logger_view;
+    log_block_t *head;
+
+    view->now_ms = logger_now_ms();
+    view->sealed = (uint16_t)uxQueueMessagesWaiting(logger_queue);
+    if (view->sealed > 0 && xQueuePeek(logger_queue, &head, 0) == pdPASS)
+    {
+        view->oldest_ms = logger_block_ms[head - logger_blocks];
+    }
+
+    portENTER_CRITICAL(&logger_lock);
+    flush_mode_t mode = logger_update_mode(view->now_ms);
+    view->free = block_pool_available(&logger_pool);
+    view->urgent = logger_urgent;
+    logger_urgent = false;
+    /* The open block counts too, unless the producer is adding to it */
+    bool open = !logger_filling && logger_current != NULL && logger_current->header.count > 0;
+    logger_passed = logger_filling;
+    view->open_records = open ? logger_current->header.count : 0;
+    uint32_t open_ms = open ? logger_block_ms[logger_current - logger_blocks] : 0;
+    portEXIT_CRITICAL(&logger_lock);
+    if (view->sealed == 0 && open)
+    {
+        view->oldest_ms = open_ms;
+    }
+
+    unsigned actions = flush_decide(&logger_policy, mode, view);
+    if (actions & FLUSH_SEAL)
+    {
+        if (logger_seal_stale())
+        {
+            view->sealed++;
+        }
+        else if (view->sealed == 0)
+        {
+            actions &= ~FLUSH_WRITE; /* the producer took it back, nothing to write */
+        }
+    }
+    view->open_records = 0;
+    if (actions & FLUSH_WRITE)
+    {
+        logger_write_queued(sink);
+        if (!view->unsynced)
+        {
+            view->unsynced = true;
+            view->written_ms = view->now_ms;
+        }
+        view->sealed = 0;
+    }
+    if (actions & FLUSH_SYNC)
+    {
+        if (sink->sync(sink->ctx) == ESP_OK)
+        {
+            logger_stats.syncs++;
+        }
+        else
+        {
+            logger_stats.errors++;
+        }
+        view->unsynced = false;
+    }
+
+    /* Next deadline, or sink work */
+    view->urgent = false;
+    uint32_t wait = flush_wait_ms(&logger_policy, mode, view);
+    if (sink->service != NULL)
+    {
+        uint32_t again = sink->service(sink->ctx, logger_now_ms());
+        wait = again < wait ? again : wait;
+    }
+    return wait;
+}
+
+/**
+ * @brief Writer loop, hands sealed blocks to a sink and returns them to the pool
+ *
+ * Sleeps until a block is sealed, an event is flagged or a deadline of the
+ * flush mode passes, then runs logger_step().
+ *
+ * @param sink  pointer to sink
+ * @note   Never returns, run it from the storage task
+ */
+void logger_run(const log_sink_t *sink)
+{
+    while (1)
+    {
+        uint32_t wait = logger_step(sink);
+        xSemaphoreTake(logger_wake, wait == FLUSH_WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(wait) + 1);
+    }
+}
+
+/**
+ * @brief Write blocks to a file descriptor
+ *
+ * @param ctx       file descriptor
+ * @param blocks    blocks to write
+ * @param count     number of blocks
+ * @return esp_err_t status
+ */
+static esp_err_t logger_file_write(void *ctx, const log_block_t *blocks, size_t count)
+{
+    size_t size = count * sizeof(log_block_t);
+    return write((int)(intptr_t)ctx, blocks, size) == (ssize_t)size ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Commit file data and directory entry
+ *
+ * @param ctx   file descriptor
+ * @return esp_err_t status
+ */
+static esp_err_t logger_file_sync(void *ctx)
+{
+    return fsync((int)(intptr_t)ctx) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Open a file sink
+ *
+ * Uses the POSIX calls rather than stdio, so no FILE buffer sits between the
+ * pool and FATFS. Whole sector writes at sector aligned offsets go from the
+ * block straight to the card without passing through the FATFS sector window.
+ *
+ * @param sink  pointer to sink to fill
+ * @param path  file path, created or truncated
+ * @return esp_err_t status
+ */
+esp_err_t logger_file_sink(log_sink_t *sink, const char *path)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return ESP_FAIL;
+    }
+    sink->ctx = (void *)(intptr_t)fd;
+    sink->write = logger_file_write;
+    sink->sync = logger_file_sync;
+    sink->service = NULL;
+    return ESP_OK;
+}
+
+/**
+ * @brief Close a file sink opened by logger_file_sink()
+ *
+ * @param sink  pointer to sink
+ */
+void logger_file_close(const log_sink_t *sink)
+{
+    close((int)(intptr_t)sink->ctx);
+}
+
+/**
+ * @brief Copy of the logger counters
+ *
+ * @param stats pointer to stats to fill
+ */
+void logger_get_stats(logger_stats_t *stats)
+{
+    portENTER_CRITICAL(&logger_lock);
+    *stats = logger_stats;
+    stats->available = block_pool_available(&logger_pool);
+    stats->mode = (uint8_t)logger_mode;
+    portEXIT_CRITICAL(&logger_lock);
+}
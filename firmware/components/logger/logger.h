@@ -0,0 +1,91 @@
+/**
+ * @file logger.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Zero-copy record logger built on a pool of sector sized blocks
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _LOGGER_H_
+#define _LOGGER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "logfmt/log_block.h"
+#include "flush_policy.h"
+
+#define LOGGER_POOL_BLOCKS 16  /*!< Blocks in the pool, 8 KiB */
+#define LOGGER_WRITE_BLOCKS 8  /*!< Most blocks handed to a sink in one write */
+
+/**
+ * @struct log_sink_t logger.h
+ * @brief Destination of full blocks
+ *
+ * write() receives @p count blocks that are adjacent in memory. The blocks
+ * are only borrowed for the duration of the call. service() is optional
+ * background work run by the writer between writes, such as retrying a
+ * failed card; it returns the ms until it wants to run again, or
+ * FLUSH_WAIT_FOREVER.
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      void *ctx;
+ *      esp_err_t (*write)(void *ctx, const log_block_t *blocks, size_t count);
+ *      esp_err_t (*sync)(void *ctx);
+ *      uint32_t (*service)(void *ctx, uint32_t now_ms);
+ * }log_sink_t;
+ * ~~~
+ */
+typedef struct
+{
+    void *ctx;                                                             /*!< Sink state */
+    esp_err_t (*write)(void *ctx, const log_block_t *blocks, size_t count); /*!< Write blocks */
+    esp_err_t (*sync)(void *ctx);                                          /*!< Commit to media */
+    uint32_t (*service)(void *ctx, uint32_t now_ms);                       /*!< Background work, may be NULL */
+} log_sink_t;
+
+/**
+ * @struct logger_stats_t logger.h
+ * @brief Logger counters
+ */
+typedef struct
+{
+    uint32_t records;   /*!< Records committed */
+    uint32_t dropped;   /*!< Records lost to an empty pool */
+    uint32_t blocks;    /*!< Blocks written */
+    uint32_t writes;    /*!< Sink write calls */
+    uint32_t errors;    /*!< Failed sink calls */
+    uint32_t syncs;     /*!< Sink sync calls */
+    uint32_t partial;   /*!< Blocks written before they were full */
+    uint16_t available; /*!< Free blocks now */
+    uint16_t low;       /*!< Fewest free blocks seen */
+    uint8_t mode;       /*!< Flush mode now @see flush_mode_t */
+} logger_stats_t;
+
+esp_err_t logger_init(void);
+
+log_record_t *logger_reserve(void);
+
+void logger_commit(void);
+
+void logger_flush(void);
+
+void logger_set_battery(uint8_t percentage, uint16_t battery_mv);
+
+void logger_flag_event(void);
+
+uint32_t logger_step(const log_sink_t *sink);
+
+void logger_run(const log_sink_t *sink);
+
+esp_err_t logger_file_sink(log_sink_t *sink, const char *path);
+
+void logger_file_close(const log_sink_t *sink);
+
+void logger_get_stats(logger_stats_t *stats);
+
+#endif
@@ -0,0 +1,332 @@
+/**
+ * @file raw_log.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Log blocks streamed to a raw card region, no filesystem
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Region layout: one header sector, then log blocks back to back. Writing
+ * a block costs one sector, there is no allocation table or directory entry
+ * to update. The header is rewritten every RAW_LOG_HEADER_INTERVAL sectors
+ * and on sync; after a power loss raw_log_open() scans forward from the
+ * stored head over blocks that verify and continue the sequence. The region
+ * is only ever appended to and formatting erases it, so every valid block
+ * past the head belongs to the current log.
+ *
+ * The valid blocks are also a prefix of the region, so a header that was
+ * torn by a power loss during its rewrite, or otherwise lost, is rebuilt by
+ * a binary search for the end of that prefix. Only a region with neither a
+ * header nor a first block of ours is reported as empty; a read error is
+ * never taken as a reason to format.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "raw_log.h"
+#include "crc/crc32.h"
+
+#define RAW_LOG_SECTOR 512     /* Sector size */
+#define RAW_LOG_MBR_TABLE 446  /* Partition table offset in the MBR */
+#define RAW_LOG_MBR_ENTRIES 4  /* Primary partitions */
+
+/**
+ * @brief Header CRC, covers every field before crc
+ */
+static uint32_t raw_log_header_crc(const raw_log_header_t *header)
+{
+    return crc32_update(0, header, offsetof(raw_log_header_t, crc));
+}
+
+/**
+ * @brief Write the header sector with the current head
+ */
+static int raw_log_write_header(raw_log_t *raw)
+{
+    uint8_t sector[RAW_LOG_SECTOR] = {0};
+
+    raw->header.head = raw->head;
+    raw->header.crc = raw_log_header_crc(&raw->header);
+    memcpy(sector, &raw->header, sizeof(raw->header));
+    return raw->dev->write(raw->dev->ctx, raw->first, sector, 1);
+}
+
+/**
+ * @brief Read a data sector as a block
+ */
+static int raw_log_read_block(const raw_log_t *raw, uint32_t index, log_block_t *block)
+{
+    return raw->dev->read(raw->dev->ctx, raw->first + 1 + index, block, 1);
+}
+
+/**
+ * @brief Whether a sector reads as erased, all 0x00 or all 0xFF
+ */
+static bool raw_log_blank(const uint8_t *sector)
+{
+    for (uint32_t i = 1; i < RAW_LOG_SECTOR; i++)
+    {
+        if (sector[i] != sector[0])
+        {
+            return false;
+        }
+    }
+    return sector[0] == 0x00 || sector[0] == 0xFF;
+}
+
+/**
+ * @brief Number of valid blocks at the start of the data sectors
+ *
+ * @param raw   pointer to raw log, header.sectors set
+ * @param valid number of blocks that verify before the first one that does not
+ * @return int 0 success, -1 read failure
+ */
+static int raw_log_scan(const raw_log_t *raw, uint32_t *valid)
+{
+    uint8_t sector[RAW_LOG_SECTOR];
+    log_block_t *block = (log_block_t *)sector;
+    uint32_t low = 0, high = raw->header.sectors;
+
+    /* Blocks before low verify, the block at high does not or is past the end */
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        if (raw_log_read_block(raw, mid, block) != 0)
+        {
+            return -1;
+        }
+        if (log_block_verify(block))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    *valid = low;
+    return 0;
+}
+
+/**
+ * @brief Erase data sectors, zero fill when the device cannot erase
+ */
+static int raw_log_erase(const blockdev_t *dev, uint32_t sector, uint32_t count)
+{
+    static const uint8_t zero[RAW_LOG_SECTOR];
+
+    if (dev->erase != NULL)
+    {
+        return dev->erase(dev->ctx, sector, count);
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (dev->write(dev->ctx, sector + i, zero, 1) != 0)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Find the first MBR partition of type RAW_LOG_PARTITION_TYPE
+ *
+ * @param dev   pointer to device
+ * @param first first sector of the partition
+ * @param count partition size in sectors
+ * @return int 0 found, -1 otherwise
+ */
+int raw_log_find_partition(const blockdev_t *dev, uint32_t *first, uint32_t *count)
+{
+    uint8_t mbr[RAW_LOG_SECTOR];
+
+    if (dev->read(dev->ctx, 0, mbr, 1) != 0 || mbr[510] != 0x55 || mbr[511] != 0xAA)
+    {
+        return -1;
+    }
+    for (int i = 0; i < RAW_LOG_MBR_ENTRIES; i++)
+    {
+        const uint8_t *entry = &mbr[RAW_LOG_MBR_TABLE + i * 16];
+        uint32_t lba = (uint32_t)entry[8] | (uint32_t)entry[9] << 8 | (uint32_t)entry[10] << 16 |
+                       (uint32_t)entry[11] << 24;
+        uint32_t size = (uint32_t)entry[12] | (uint32_t)entry[13] << 8 | (uint32_t)entry[14] << 16 |
+                        (uint32_t)entry[15] << 24;
+        if (entry[4] == RAW_LOG_PARTITION_TYPE && size > 1 && lba + size <= dev->sectors)
+        {
+            *first = lba;
+            *count = size;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Create an empty log in a region, erasing it
+ *
+ * @param raw   pointer to raw log
+ * @param dev   pointer to device
+ * @param first first sector of the region
+ * @param count region size in sectors, header included
+ * @return int 0 success, -1 failure
+ */
+int raw_log_format(raw_log_t *raw, const blockdev_t *dev, uint32_t first, uint32_t count)
+{
+    if (count < 2 || raw_log_erase(dev, first + 1, count - 1) != 0)
+    {
+        return -1;
+    }
+    raw->dev = dev;
+    raw->first = first;
+    raw->header = (raw_log_header_t){
+        .magic = RAW_LOG_MAGIC,
+        .version = RAW_LOG_VERSION,
+        .sectors = count - 1,
+    };
+    raw->head = 0;
+    raw->seq = 0;
+    raw->last_us = 0;
+    return raw_log_write_header(raw);
+}
+
+/**
+ * @brief Open an existing log and recover the write head
+ *
+ * A header that does not verify or no longer matches the region is rebuilt
+ * from the blocks, its session count restarts when it cannot be trusted.
+ *
+ * @param raw   pointer to raw log
+ * @param dev   pointer to device
+ * @param first first sector of the region
+ * @param count region size in sectors, header included
+ * @return int 0 success, RAW_LOG_RECOVERED header rebuilt, RAW_LOG_EMPTY no log in the region,
+ *             -1 read failure
+ */
+int raw_log_open(raw_log_t *raw, const blockdev_t *dev, uint32_t first, uint32_t count)
+{
+    uint8_t sector[RAW_LOG_SECTOR];
+    log_block_t *block = (log_block_t *)sector;
+    int status = 0;
+
+    raw->dev = dev;
+    raw->first = first;
+    if (count < 2 || dev->read(dev->ctx, first, sector, 1) != 0)
+    {
+        return -1;
+    }
+    memcpy(&raw->header, sector, sizeof(raw->header));
+    bool ours = raw->header.magic == RAW_LOG_MAGIC && raw->header.version == RAW_LOG_VERSION;
+    bool intact = ours && raw->header.crc == raw_log_header_crc(&raw->header);
+    if (!intact || raw->header.sectors != count - 1 || raw->header.head > raw->header.sectors)
+    {
+        /* Blank or foreign: empty unless the first block says otherwise */
+        bool foreign = !ours || raw_log_blank(sector);
+        raw->header = (raw_log_header_t){
+            .magic = RAW_LOG_MAGIC,
+            .version = RAW_LOG_VERSION,
+            .sectors = count - 1,
+            .sessions = intact ? raw->header.sessions : 0,
+        };
+        uint32_t valid;
+        if (raw_log_scan(raw, &valid) != 0)
+        {
+            return -1;
+        }
+        raw->header.head = valid;
+        if (foreign && raw->header.head == 0)
+        {
+            return RAW_LOG_EMPTY;
+        }
+        status = RAW_LOG_RECOVERED;
+    }
+
+    /* Last block covered by the header */
+    raw->head = raw->header.head;
+    raw->seq = 0;
+    raw->last_us = 0;
+    bool known = false;
+    if (raw->head > 0 && raw_log_read_block(raw, raw->head - 1, block) == 0 && log_block_verify(block))
+    {
+        raw->seq = block->header.seq;
+        raw->last_us = block->header.last_us;
+        known = true;
+    }
+
+    /* Blocks written after the last header update */
+    uint32_t limit = raw->header.head + 2 * RAW_LOG_HEADER_INTERVAL;
+    while (raw->head < raw->header.sectors && raw->head < limit)
+    {
+        if (raw_log_read_block(raw, raw->head, block) != 0 || !log_block_verify(block))
+        {
+            break;
+        }
+        /* Continues the session or starts a new one */
+        if (known && block->header.seq != raw->seq + 1 && block->header.seq != 0)
+        {
+            break;
+        }
+        raw->seq = block->header.seq;
+        raw->last_us = block->header.last_us;
+        raw->head++;
+        known = true;
+    }
+    return status;
+}
+
+/**
+ * @brief Record the start of a logging session
+ *
+ * @param raw   pointer to raw log
+ * @return int 0 success, -1 failure
+ */
+int raw_log_start(raw_log_t *raw)
+{
+    raw->header.sessions++;
+    return raw_log_write_header(raw);
+}
+
+/**
+ * @brief Append blocks with one multi-sector write
+ *
+ * @param raw       pointer to raw log
+ * @param blocks    sealed blocks
+ * @param count     number of blocks
+ * @return int 0 success, -1 write failed or region full
+ */
+int raw_log_write(raw_log_t *raw, const log_block_t *blocks, uint32_t count)
+{
+    if (count > raw->header.sectors - raw->head)
+    {
+        return -1;
+    }
+    if (raw->dev->write(raw->dev->ctx, raw->first + 1 + raw->head, blocks, count) != 0)
+    {
+        return -1;
+    }
+    raw->head += count;
+    raw->seq = blocks[count - 1].header.seq;
+    raw->last_us = blocks[count - 1].header.last_us;
+
+    if (raw->head - raw->header.head >= RAW_LOG_HEADER_INTERVAL)
+    {
+        return raw_log_write_header(raw);
+    }
+    return 0;
+}
+
+/**
+ * @brief Store the write head in the header
+ *
+ * @param raw   pointer to raw log
+ * @return int 0 success, -1 failure
+ */
+int raw_log_sync(raw_log_t *raw)
+{
+    if (raw->head == raw->header.head)
+    {
+        return 0;
+    }
+    return raw_log_write_header(raw);
+}
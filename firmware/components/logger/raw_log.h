@@ -0,0 +1,115 @@
+/**
+ * @file raw_log.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Log blocks streamed to a raw card region, no filesystem
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _RAW_LOG_H_
+#define _RAW_LOG_H_
+
+#include <stdint.h>
+#include "logfmt/log_block.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RAW_LOG_MAGIC 0x57524453u     /*!< "SDRW" little endian */
+#define RAW_LOG_VERSION 1             /*!< Header format version */
+#define RAW_LOG_PARTITION_TYPE 0xDA   /*!< MBR type "non-FS data" */
+#define RAW_LOG_HEADER_INTERVAL 64    /*!< Sectors written between header updates */
+#define RAW_LOG_RECOVERED 1           /*!< raw_log_open(): header rebuilt from the blocks */
+#define RAW_LOG_EMPTY 2               /*!< raw_log_open(): blank or foreign region, format it */
+
+/**
+ * @struct blockdev_t raw_log.h
+ * @brief 512-byte sector device
+ *
+ * Callbacks return 0 on success, -1 on failure. erase() is optional, erased
+ * sectors may read back as 0x00 or 0xFF.
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      void *ctx;
+ *      uint32_t sectors;
+ *      int (*read)(void *ctx, uint32_t sector, void *dst, uint32_t count);
+ *      int (*write)(void *ctx, uint32_t sector, const void *src, uint32_t count);
+ *      int (*erase)(void *ctx, uint32_t sector, uint32_t count);
+ * }blockdev_t;
+ * ~~~
+ */
+typedef struct
+{
+    void *ctx;                                                                /*!< Device state */
+    uint32_t sectors;                                                         /*!< Device size in sectors */
+    int (*read)(void *ctx, uint32_t sector, void *dst, uint32_t count);        /*!< Read sectors */
+    int (*write)(void *ctx, uint32_t sector, const void *src, uint32_t count); /*!< Write sectors */
+    int (*erase)(void *ctx, uint32_t sector, uint32_t count);                 /*!< Erase sectors, NULL to write zeros */
+} blockdev_t;
+
+/**
+ * @struct raw_log_header_t raw_log.h
+ * @brief First sector of the region, blocks follow it
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;    /*!< RAW_LOG_MAGIC */
+    uint32_t version;  /*!< RAW_LOG_VERSION */
+    uint32_t sectors;  /*!< Data sectors after the header */
+    uint32_t head;     /*!< Next data sector to write, may lag by RAW_LOG_HEADER_INTERVAL */
+    uint32_t sessions; /*!< Number of logging sessions started */
+    uint32_t crc;      /*!< CRC-32 of the fields above */
+} raw_log_header_t;
+
+/**
+ * @struct raw_log_t raw_log.h
+ * @brief Open raw log region
+ *
+ * ### Example
+ * ~~~.c
+ * raw_log_t raw;
+ * int opened = raw_log_open(&raw, &dev, first, count);
+ * if (opened == RAW_LOG_EMPTY)
+ * {
+ *      raw_log_format(&raw, &dev, first, count);
+ * }
+ * else if (opened < 0)
+ * {
+ *      return; // read error, a retry may succeed
+ * }
+ * raw_log_start(&raw);
+ * raw_log_write(&raw, blocks, 8);
+ * ~~~
+ */
+typedef struct
+{
+    const blockdev_t *dev;   /*!< Underlying device */
+    uint32_t first;          /*!< Header sector */
+    raw_log_header_t header; /*!< Header as last written */
+    uint32_t head;           /*!< Next data sector to write */
+    uint32_t seq;            /*!< Sequence number of the last block, valid when head > 0 */
+    int64_t last_us;         /*!< Time of the last record, valid when head > 0 */
+} raw_log_t;
+
+int raw_log_find_partition(const blockdev_t *dev, uint32_t *first, uint32_t *count);
+
+int raw_log_format(raw_log_t *raw, const blockdev_t *dev, uint32_t first, uint32_t count);
+
+int raw_log_open(raw_log_t *raw, const blockdev_t *dev, uint32_t first, uint32_t count);
+
+int raw_log_start(raw_log_t *raw);
+
+int raw_log_write(raw_log_t *raw, const log_block_t *blocks, uint32_t count);
+
+int raw_log_sync(raw_log_t *raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
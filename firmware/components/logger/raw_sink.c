@@ -0,0 +1,121 @@
+/**
+ * @file raw_sink.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Logger sink writing to a raw SD card partition
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Blocks from the logger pool are DMA capable, so sdmmc_write_sectors()
+ * transfers them without a bounce buffer, one multi-block command per batch.
+ */
+
+#include <inttypes.h>
+#include "esp_idf_version.h"
+#include "esp_log.h"
+#include "raw_sink.h"
+
+static const char *RAW_SINK_TAG = "RAWLOG";
+
+static blockdev_t raw_sink_dev; /* Card as a block device */
+static raw_log_t raw_sink_raw;  /* Log region */
+
+static int raw_sink_read(void *ctx, uint32_t sector, void *dst, uint32_t count)
+{
+    return sdmmc_read_sectors((sdmmc_card_t *)ctx, dst, sector, count) == ESP_OK ? 0 : -1;
+}
+
+static int raw_sink_write_sectors(void *ctx, uint32_t sector, const void *src, uint32_t count)
+{
+    return sdmmc_write_sectors((sdmmc_card_t *)ctx, src, sector, count) == ESP_OK ? 0 : -1;
+}
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+static int raw_sink_erase(void *ctx, uint32_t sector, uint32_t count)
+{
+    return sdmmc_erase_sectors((sdmmc_card_t *)ctx, sector, count, SDMMC_ERASE_ARG) == ESP_OK ? 0 : -1;
+}
+#endif
+
+static esp_err_t raw_sink_write(void *ctx, const log_block_t *blocks, size_t count)
+{
+    return raw_log_write(ctx, blocks, count) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t raw_sink_sync(void *ctx)
+{
+    return raw_log_sync(ctx) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Open the raw log partition and start a session
+ *
+ * The card needs an MBR partition of type 0xDA, for example created with
+ * fdisk next to a FAT partition. Only a blank region, or one holding
+ * something else, is formatted: a damaged header is rebuilt from the blocks
+ * and a read error fails the init, the log stays for the next attempt.
+ *
+ * @param sink  pointer to sink to fill
+ * @param card  initialized card
+ * @return esp_err_t status
+ */
+esp_err_t raw_sink_init(log_sink_t *sink, sdmmc_card_t *card)
+{
+    uint32_t first, count;
+
+    raw_sink_dev = (blockdev_t){
+        .ctx = card,
+        .sectors = (uint32_t)card->csd.capacity,
+        .read = raw_sink_read,
+        .write = raw_sink_write_sectors,
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+        .erase = raw_sink_erase,
+#endif
+    };
+    if (raw_log_find_partition(&raw_sink_dev, &first, &count) != 0)
+    {
+        ESP_LOGE(RAW_SINK_TAG, "No partition of type 0x%02X", RAW_LOG_PARTITION_TYPE);
+        return ESP_ERR_NOT_FOUND;
+    }
+    int opened = raw_log_open(&raw_sink_raw, &raw_sink_dev, first, count);
+    if (opened < 0)
+    {
+        ESP_LOGE(RAW_SINK_TAG, "Cannot read the log at %" PRIu32, first);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    if (opened == RAW_LOG_RECOVERED)
+    {
+        ESP_LOGW(RAW_SINK_TAG, "Header rebuilt, %" PRIu32 " blocks found", raw_sink_raw.head);
+    }
+    if (opened == RAW_LOG_EMPTY)
+    {
+        ESP_LOGW(RAW_SINK_TAG, "Formatting %" PRIu32 " sectors at %" PRIu32, count, first);
+        if (raw_log_format(&raw_sink_raw, &raw_sink_dev, first, count) != 0)
+        {
+            return ESP_FAIL;
+        }
+    }
+    if (raw_log_start(&raw_sink_raw) != 0)
+    {
+        return ESP_FAIL;
+    }
+    ESP_LOGI(RAW_SINK_TAG, "Session %" PRIu32 ", head %" PRIu32 " of %" PRIu32 " sectors",
+             raw_sink_raw.header.sessions, raw_sink_raw.head, raw_sink_raw.header.sectors);
+
+    sink->ctx = &raw_sink_raw;
+    sink->write = raw_sink_write;
+    sink->sync = raw_sink_sync;
+    sink->service = NULL;
+    return ESP_OK;
+}
+
+/**
+ * @brief Raw log state, for status reports
+ *
+ * @return const raw_log_t* raw log
+ */
+const raw_log_t *raw_sink_log(void)
+{
+    return &raw_sink_raw;
+}
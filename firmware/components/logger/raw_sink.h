@@ -0,0 +1,23 @@
+/**
+ * @file raw_sink.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Logger sink writing to a raw SD card partition
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _RAW_SINK_H_
+#define _RAW_SINK_H_
+
+#include "esp_err.h"
+#include "sdmmc_cmd.h"
+#include "logger.h"
+#include "raw_log.h"
+
+esp_err_t raw_sink_init(log_sink_t *sink, sdmmc_card_t *card);
+
+const raw_log_t *raw_sink_log(void);
+
+#endif
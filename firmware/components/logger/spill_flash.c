@@ -0,0 +1,63 @@
+/**
+ * @file spill_flash.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Spill ring region on an internal flash partition
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Flash writes and erases suspend the cache on both cores, a sector erase
+ * for tens of ms, so the ring is only written while the card is down.
+ */
+
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "spill_flash.h"
+
+static const char *SPILL_FLASH_TAG = "SPILL";
+
+static int spill_flash_read(void *ctx, uint32_t offset, void *dst, uint32_t len)
+{
+    return esp_partition_read(ctx, offset, dst, len) == ESP_OK ? 0 : -1;
+}
+
+static int spill_flash_write(void *ctx, uint32_t offset, const void *src, uint32_t len)
+{
+    return esp_partition_write(ctx, offset, src, len) == ESP_OK ? 0 : -1;
+}
+
+static int spill_flash_erase(void *ctx, uint32_t offset, uint32_t len)
+{
+    return esp_partition_erase_range(ctx, offset, len) == ESP_OK ? 0 : -1;
+}
+
+/**
+ * @brief Describe a data partition as a spill ring region
+ *
+ * @param dev   pointer to region to fill
+ * @param label partition label, SPILL_FLASH_LABEL
+ * @return esp_err_t ESP_ERR_NOT_FOUND without the partition
+ */
+esp_err_t spill_flash_open(spill_dev_t *dev, const char *label)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, SPILL_FLASH_SUBTYPE, label);
+    if (part == NULL)
+    {
+        ESP_LOGW(SPILL_FLASH_TAG, "No partition %s, spilling disabled", label);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    *dev = (spill_dev_t){
+        .ctx = (void *)part,
+        .size = part->size - part->size % SPILL_FLASH_SECTOR,
+        .erase_size = SPILL_FLASH_SECTOR,
+        .read = spill_flash_read,
+        .write = spill_flash_write,
+        .erase = spill_flash_erase,
+    };
+    ESP_LOGI(SPILL_FLASH_TAG, "Partition %s at 0x%" PRIx32 ", %" PRIu32 " KB", label, (uint32_t)part->address,
+             dev->size / 1024);
+    return ESP_OK;
+}
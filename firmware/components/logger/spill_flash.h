@@ -0,0 +1,23 @@
+/**
+ * @file spill_flash.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Spill ring region on an internal flash partition
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SPILL_FLASH_H_
+#define _SPILL_FLASH_H_
+
+#include "esp_err.h"
+#include "spill_ring.h"
+
+#define SPILL_FLASH_LABEL "spill"   /*!< Partition label, see partitions.csv */
+#define SPILL_FLASH_SUBTYPE 0x40    /*!< Custom data subtype */
+#define SPILL_FLASH_SECTOR 4096     /*!< SPI flash erase sector */
+
+esp_err_t spill_flash_open(spill_dev_t *dev, const char *label);
+
+#endif
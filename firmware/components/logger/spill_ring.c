@@ -0,0 +1,287 @@
+/**
+ * @file spill_ring.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Append-only ring of log blocks on a flash partition
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Region layout: erase units back to back, each a spill_unit_t slot then
+ * log blocks. A unit is erased and stamped with the next sequence number
+ * when the head enters it. Blocks copied out are marked by clearing their
+ * bit in the unit's drained byte, which NOR flash allows without an erase.
+ * No state lives anywhere else: spill_ring_open() finds the newest unit by
+ * sequence number, the head as its first erased slot, and the tail by
+ * walking back over consecutive units until one is fully drained.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "spill_ring.h"
+#include "crc/crc32.h"
+
+#define SPILL_ERASED 0xFFFFFFFFu /* Magic of a slot never written */
+
+/**
+ * @brief Flash offset of a data slot
+ */
+static uint32_t spill_ring_offset(const spill_ring_t *ring, uint32_t position)
+{
+    return position / ring->slots * ring->dev->erase_size + (1 + position % ring->slots) * LOG_BLOCK_SIZE;
+}
+
+/**
+ * @brief Unit header CRC, covers magic and seq
+ */
+static uint32_t spill_unit_crc(const spill_unit_t *unit)
+{
+    return crc32_update(0, unit, offsetof(spill_unit_t, crc));
+}
+
+/**
+ * @brief Read and check a unit header
+ *
+ * @return int 0 valid, -1 erased, torn or unreadable
+ */
+static int spill_ring_unit(const spill_ring_t *ring, uint32_t unit, spill_unit_t *header)
+{
+    if (ring->dev->read(ring->dev->ctx, unit * ring->dev->erase_size, header, sizeof(*header)) != 0)
+    {
+        return -1;
+    }
+    return header->magic == SPILL_MAGIC && header->crc == spill_unit_crc(header) ? 0 : -1;
+}
+
+/**
+ * @brief Erase a unit and stamp it as the newest, dropping the oldest blocks if it holds them
+ */
+static int spill_ring_stamp(spill_ring_t *ring, uint32_t unit)
+{
+    const spill_dev_t *dev = ring->dev;
+
+    /* Full ring: the unit holds the oldest blocks */
+    if (ring->count > 0 && ring->tail / ring->slots == unit)
+    {
+        uint32_t lost = ring->slots - ring->tail % ring->slots;
+        lost = lost < ring->count ? lost : ring->count;
+        ring->count -= lost;
+        ring->stats.overwritten += lost;
+        ring->tail = (unit + 1) % ring->units * ring->slots;
+    }
+
+    if (dev->erase(dev->ctx, unit * dev->erase_size, dev->erase_size) != 0)
+    {
+        return -1;
+    }
+    ring->stats.erases++;
+
+    spill_unit_t header = {.magic = SPILL_MAGIC, .seq = ring->seq + 1, .drained = 0xFF};
+    header.crc = spill_unit_crc(&header);
+    if (dev->write(dev->ctx, unit * dev->erase_size, &header, sizeof(header)) != 0)
+    {
+        return -1;
+    }
+    ring->seq = header.seq;
+    return 0;
+}
+
+/**
+ * @brief Open the ring on a region and recover head and tail
+ *
+ * An empty or unformatted region opens as an empty ring, units are erased
+ * as they are first written.
+ *
+ * @param ring  pointer to ring
+ * @param dev   pointer to flash region
+ * @return int 0 success, -1 unsupported geometry
+ */
+int spill_ring_open(spill_ring_t *ring, const spill_dev_t *dev)
+{
+    spill_unit_t header;
+
+    if (dev->erase_size < 2 * LOG_BLOCK_SIZE || dev->erase_size > SPILL_UNIT_MAX ||
+        dev->erase_size % LOG_BLOCK_SIZE != 0 || dev->size < dev->erase_size)
+    {
+        return -1;
+    }
+    memset(ring, 0, sizeof(*ring));
+    ring->dev = dev;
+    ring->units = dev->size / dev->erase_size;
+    ring->slots = dev->erase_size / LOG_BLOCK_SIZE - 1;
+
+    /* Newest unit */
+    bool found = false;
+    uint32_t newest = 0;
+    for (uint32_t unit = 0; unit < ring->units; unit++)
+    {
+        if (spill_ring_unit(ring, unit, &header) == 0 && (!found || (int32_t)(header.seq - ring->seq) > 0))
+        {
+            newest = unit;
+            ring->seq = header.seq;
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        return 0;
+    }
+
+    /* Head: first slot of the newest unit never written */
+    uint32_t used = 0;
+    while (used < ring->slots)
+    {
+        uint32_t magic;
+        if (dev->read(dev->ctx, spill_ring_offset(ring, newest * ring->slots + used), &magic, sizeof(magic)) != 0 ||
+            magic == SPILL_ERASED)
+        {
+            break;
+        }
+        used++;
+    }
+    ring->head = used < ring->slots ? newest * ring->slots + used : (newest + 1) % ring->units * ring->slots;
+    ring->tail = ring->head;
+
+    /* Tail: back over consecutive units, stopping after a partly drained one */
+    uint32_t unit = newest;
+    uint32_t expect = ring->seq;
+    uint32_t written = used;
+    for (uint32_t visited = 0; visited < ring->units; visited++)
+    {
+        if (spill_ring_unit(ring, unit, &header) != 0 || header.seq != expect)
+        {
+            break;
+        }
+        /* Blocks are drained in order, so the cleared bits are the low ones */
+        uint32_t drained = header.drained == 0 ? 8 : (uint32_t)__builtin_ctz(header.drained);
+        if (drained < written)
+        {
+            ring->count += written - drained;
+            ring->tail = unit * ring->slots + drained;
+        }
+        /* A newest unit stamped but never written says nothing, keep going */
+        if (drained > 0 || (written > 0 && drained >= written))
+        {
+            break;
+        }
+        unit = (unit + ring->units - 1) % ring->units;
+        expect--;
+        written = ring->slots;
+    }
+    return 0;
+}
+
+/**
+ * @brief Append blocks, one program call per unit
+ *
+ * When the ring is full the oldest unit is erased and its blocks counted in
+ * stats.overwritten.
+ *
+ * @param ring      pointer to ring
+ * @param blocks    sealed blocks
+ * @param count     number of blocks
+ * @return int 0 success, -1 flash failure
+ */
+int spill_ring_append(spill_ring_t *ring, const log_block_t *blocks, uint32_t count)
+{
+    const spill_dev_t *dev = ring->dev;
+    uint32_t capacity = spill_ring_capacity(ring);
+
+    while (count > 0)
+    {
+        uint32_t slot = ring->head % ring->slots;
+        if (slot == 0 && spill_ring_stamp(ring, ring->head / ring->slots) != 0)
+        {
+            return -1;
+        }
+        if (ring->count == 0)
+        {
+            ring->tail = ring->head;
+        }
+
+        uint32_t n = ring->slots - slot;
+        n = n < count ? n : count;
+        if (dev->write(dev->ctx, spill_ring_offset(ring, ring->head), blocks, n * LOG_BLOCK_SIZE) != 0)
+        {
+            return -1;
+        }
+        ring->head = (ring->head + n) % capacity;
+        ring->count += n;
+        ring->stats.appended += n;
+        blocks += n;
+        count -= n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Copy the oldest blocks, up to the end of their unit
+ *
+ * Blocks stay in the ring until spill_ring_release(). A block torn by a
+ * power loss is returned as is, check it with log_block_verify().
+ *
+ * @param ring      pointer to ring
+ * @param blocks    destination
+ * @param max       most blocks to copy
+ * @return uint32_t blocks copied, 0 when empty or on a read failure
+ */
+uint32_t spill_ring_read(spill_ring_t *ring, log_block_t *blocks, uint32_t max)
+{
+    uint32_t n = ring->slots - ring->tail % ring->slots;
+    n = n < ring->count ? n : ring->count;
+    n = n < max ? n : max;
+    if (n == 0 || ring->dev->read(ring->dev->ctx, spill_ring_offset(ring, ring->tail), blocks,
+                                  n * LOG_BLOCK_SIZE) != 0)
+    {
+        return 0;
+    }
+    return n;
+}
+
+/**
+ * @brief Mark the oldest blocks as copied out
+ *
+ * @param ring      pointer to ring
+ * @param count     blocks, as returned by spill_ring_read()
+ * @return int 0 success, -1 flash failure
+ */
+int spill_ring_release(spill_ring_t *ring, uint32_t count)
+{
+    const spill_dev_t *dev = ring->dev;
+
+    count = count < ring->count ? count : ring->count;
+    while (count > 0)
+    {
+        uint32_t unit = ring->tail / ring->slots;
+        uint32_t slot = ring->tail % ring->slots;
+        uint32_t n = ring->slots - slot;
+        n = n < count ? n : count;
+
+        /* Every slot below slot + n is drained */
+        uint8_t drained = (uint8_t)(0xFFu << (slot + n));
+        if (dev->write(dev->ctx, unit * dev->erase_size + offsetof(spill_unit_t, drained), &drained, 1) != 0)
+        {
+            return -1;
+        }
+        ring->tail = (ring->tail + n) % spill_ring_capacity(ring);
+        ring->count -= n;
+        ring->stats.released += n;
+        count -= n;
+    }
+    if (ring->count == 0)
+    {
+        ring->tail = ring->head;
+    }
+    return 0;
+}
+
+/**
+ * @brief Blocks the ring holds when full
+ *
+ * @param ring  pointer to ring
+ * @return uint32_t blocks
+ */
+uint32_t spill_ring_capacity(const spill_ring_t *ring)
+{
+    return ring->units * ring->slots;
+}
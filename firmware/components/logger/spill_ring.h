@@ -0,0 +1,123 @@
+/**
+ * @file spill_ring.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Append-only ring of log blocks on a flash partition
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SPILL_RING_H_
+#define _SPILL_RING_H_
+
+#include <stdint.h>
+#include "logfmt/log_block.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPILL_MAGIC 0x4C495053u   /*!< "SPIL" little endian */
+#define SPILL_UNIT_MAX 4096       /*!< Largest erase unit supported */
+
+/**
+ * @struct spill_dev_t spill_ring.h
+ * @brief NOR flash region
+ *
+ * Callbacks return 0 on success, -1 on failure. Offsets are relative to the
+ * region. erase() takes whole erase units and leaves them 0xFF; write() can
+ * only clear bits, like esp_partition_write().
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      void *ctx;
+ *      uint32_t size;
+ *      uint32_t erase_size;
+ *      int (*read)(void *ctx, uint32_t offset, void *dst, uint32_t len);
+ *      int (*write)(void *ctx, uint32_t offset, const void *src, uint32_t len);
+ *      int (*erase)(void *ctx, uint32_t offset, uint32_t len);
+ * }spill_dev_t;
+ * ~~~
+ */
+typedef struct
+{
+    void *ctx;                                                                /*!< Device state */
+    uint32_t size;                                                            /*!< Region size in bytes */
+    uint32_t erase_size;                                                      /*!< Erase unit in bytes */
+    int (*read)(void *ctx, uint32_t offset, void *dst, uint32_t len);         /*!< Read bytes */
+    int (*write)(void *ctx, uint32_t offset, const void *src, uint32_t len);  /*!< Program bytes */
+    int (*erase)(void *ctx, uint32_t offset, uint32_t len);                   /*!< Erase units */
+} spill_dev_t;
+
+/**
+ * @struct spill_unit_t spill_ring.h
+ * @brief First slot of every erase unit, log blocks fill the others
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;  /*!< SPILL_MAGIC */
+    uint32_t seq;    /*!< One more than the unit written before */
+    uint32_t crc;    /*!< CRC-32 of magic and seq */
+    uint8_t drained; /*!< Bit i cleared once block i was copied out, programmed in place */
+} spill_unit_t;
+
+/**
+ * @struct spill_stats_t spill_ring.h
+ * @brief Ring counters since open
+ */
+typedef struct
+{
+    uint32_t appended;    /*!< Blocks written */
+    uint32_t released;    /*!< Blocks copied out */
+    uint32_t overwritten; /*!< Blocks lost to a full ring, oldest first */
+    uint32_t erases;      /*!< Units erased */
+} spill_stats_t;
+
+/**
+ * @struct spill_ring_t spill_ring.h
+ * @brief Open ring
+ *
+ * Positions count data slots, unit * slots + slot. Blocks are appended at
+ * head and copied out from tail; a full ring erases its oldest unit. Every
+ * unit is erased once per lap, so wear is even without a wear levelling
+ * layer. Not locked: one task appends and releases.
+ *
+ * ### Example
+ * ~~~.c
+ * spill_ring_t ring;
+ * spill_ring_open(&ring, &dev);
+ * spill_ring_append(&ring, blocks, 8);
+ * uint32_t n = spill_ring_read(&ring, buffer, 7);
+ * // copy buffer somewhere else, then
+ * spill_ring_release(&ring, n);
+ * ~~~
+ */
+typedef struct
+{
+    const spill_dev_t *dev; /*!< Underlying flash */
+    uint32_t units;         /*!< Erase units in the region */
+    uint32_t slots;         /*!< Data slots per unit */
+    uint32_t head;          /*!< Next slot to write */
+    uint32_t tail;          /*!< Oldest stored block, when count > 0 */
+    uint32_t count;         /*!< Blocks stored and not released */
+    uint32_t seq;           /*!< Sequence of the head unit */
+    spill_stats_t stats;    /*!< Counters */
+} spill_ring_t;
+
+int spill_ring_open(spill_ring_t *ring, const spill_dev_t *dev);
+
+int spill_ring_append(spill_ring_t *ring, const log_block_t *blocks, uint32_t count);
+
+uint32_t spill_ring_read(spill_ring_t *ring, log_block_t *blocks, uint32_t max);
+
+int spill_ring_release(spill_ring_t *ring, uint32_t count);
+
+uint32_t spill_ring_capacity(const spill_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * @file spill_sink.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Logger sink that falls back to a flash ring while the card is missing or failing
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Blocks go to the card while it works. The first failed write detaches
+ * it, and the blocks, that one included, go to the ring until a later
+ * attach succeeds. The ring is then copied to the drain sink one unit at a
+ * time between the writer's own work. A unit is released only after the
+ * drain sink synced it, so a power loss while draining duplicates blocks
+ * rather than losing them; a block whose card write failed half way may also
+ * be stored twice. Both show up as repeated block seq numbers.
+ */
+
+#include "spill_sink.h"
+
+/**
+ * @brief Drop a failed card, the retry delay starts at the next service call
+ */
+static void spill_sink_fail(spill_sink_t *spill)
+{
+    if (spill->attached && spill->detach != NULL)
+    {
+        spill->detach(spill->ctx);
+    }
+    spill->attached = false;
+    spill->failed = true;
+    spill->stats.failures++;
+}
+
+static esp_err_t spill_sink_write(void *ctx, const log_block_t *blocks, size_t count)
+{
+    spill_sink_t *spill = ctx;
+
+    if (spill->attached)
+    {
+        if (spill->card.write(spill->card.ctx, blocks, count) == ESP_OK)
+        {
+            return ESP_OK;
+        }
+        spill_sink_fail(spill);
+    }
+    if (spill->ring != NULL && spill_ring_append(spill->ring, blocks, (uint32_t)count) == 0)
+    {
+        spill->stats.spilled += count;
+        return ESP_OK;
+    }
+    spill->stats.lost += count;
+    return ESP_FAIL;
+}
+
+static esp_err_t spill_sink_sync(void *ctx)
+{
+    spill_sink_t *spill = ctx;
+
+    /* Flash programs are durable once they return */
+    if (!spill->attached)
+    {
+        return ESP_OK;
+    }
+    if (spill->card.sync(spill->card.ctx) != ESP_OK)
+    {
+        spill_sink_fail(spill);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Copy one unit of the ring to the drain sink
+ *
+ * @return uint32_t ms until the next batch, FLUSH_WAIT_FOREVER once empty
+ */
+static uint32_t spill_sink_drain(spill_sink_t *spill)
+{
+    uint32_t n = spill_ring_read(spill->ring, spill->buffer, spill->buffer_blocks);
+    if (n == 0)
+    {
+        return spill->ring->count > 0 ? spill->retry_ms : FLUSH_WAIT_FOREVER;
+    }
+
+    /* Runs of intact blocks, torn ones are skipped */
+    uint32_t start = 0;
+    uint32_t corrupt = 0;
+    for (uint32_t i = 0; i <= n; i++)
+    {
+        if (i < n && log_block_verify(&spill->buffer[i]))
+        {
+            continue;
+        }
+        if (i > start && spill->drain.write(spill->drain.ctx, &spill->buffer[start], i - start) != ESP_OK)
+        {
+            spill_sink_fail(spill);
+            return spill->retry_ms;
+        }
+        corrupt += i < n;
+        start = i + 1;
+    }
+    if (spill->drain.sync(spill->drain.ctx) != ESP_OK)
+    {
+        spill_sink_fail(spill);
+        return spill->retry_ms;
+    }
+
+    /* On the card: the ring may reuse the slots */
+    if (spill_ring_release(spill->ring, n) != 0)
+    {
+        return spill->retry_ms;
+    }
+    spill->stats.drained += n - corrupt;
+    spill->stats.corrupt += corrupt;
+    return spill->ring->count > 0 ? SPILL_DRAIN_PAUSE_MS : FLUSH_WAIT_FOREVER;
+}
+
+static uint32_t spill_sink_service(void *ctx, uint32_t now_ms)
+{
+    spill_sink_t *spill = ctx;
+
+    if (!spill->attached)
+    {
+        if (spill->failed)
+        {
+            /* Wait a full retry period after a failure */
+            spill->failed = false;
+            spill->tried = true;
+            spill->attempt_ms = now_ms;
+        }
+        uint32_t since = now_ms - spill->attempt_ms;
+        if (spill->tried && since < spill->retry_ms)
+        {
+            return spill->retry_ms - since;
+        }
+
+        spill->tried = true;
+        spill->attempt_ms = now_ms;
+        if (spill->attach(spill->ctx, &spill->card, &spill->drain) != ESP_OK)
+        {
+            spill->stats.failures++;
+            return spill->retry_ms;
+        }
+        spill->attached = true;
+        spill->stats.attaches++;
+    }
+
+    if (spill->ring == NULL || spill->ring->count == 0)
+    {
+        return FLUSH_WAIT_FOREVER;
+    }
+    return spill_sink_drain(spill);
+}
+
+/**
+ * @brief Reset the fallback and fill a logger sink that uses it
+ *
+ * The first attach is tried at the first service call.
+ *
+ * @param spill pointer to fallback, ring, buffer, retry_ms, attach, detach and ctx set
+ * @param sink  pointer to sink to fill
+ */
+void spill_sink_init(spill_sink_t *spill, log_sink_t *sink)
+{
+    spill->attached = false;
+    spill->tried = false;
+    spill->failed = false;
+    spill->attempt_ms = 0;
+    spill->stats = (spill_sink_stats_t){0};
+
+    sink->ctx = spill;
+    sink->write = spill_sink_write;
+    sink->sync = spill_sink_sync;
+    sink->service = spill_sink_service;
+}
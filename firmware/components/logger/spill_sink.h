@@ -0,0 +1,89 @@
+/**
+ * @file spill_sink.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Logger sink that falls back to a flash ring while the card is missing or failing
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SPILL_SINK_H_
+#define _SPILL_SINK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "logger.h"
+#include "spill_ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPILL_DRAIN_PAUSE_MS 10 /*!< Gap between drain batches, the writer keeps serving new blocks */
+
+/**
+ * @struct spill_sink_stats_t spill_sink.h
+ * @brief Fallback counters
+ */
+typedef struct
+{
+    uint32_t spilled;  /*!< Blocks written to the ring instead of the card */
+    uint32_t drained;  /*!< Blocks copied from the ring to the card */
+    uint32_t corrupt;  /*!< Torn blocks skipped while draining */
+    uint32_t lost;     /*!< Blocks neither the card nor the ring took */
+    uint32_t failures; /*!< Failed attach, write or sync on the card */
+    uint32_t attaches; /*!< Cards brought up */
+} spill_sink_stats_t;
+
+/**
+ * @struct spill_sink_t spill_sink.h
+ * @brief Card with a flash ring behind it
+ *
+ * attach() brings the card up and fills two sinks: card for new blocks and
+ * drain for the ring's contents, which are older; they may be the same
+ * sink. detach() releases a card that failed, and is retried every
+ * retry_ms. All calls come from the logger writer, see logger_run().
+ *
+ * ### Example
+ * ~~~.c
+ * static DMA_ATTR log_block_t buffer[7];
+ * spill_sink_t spill = {
+ *      .ring = &ring,
+ *      .buffer = buffer,
+ *      .buffer_blocks = 7,
+ *      .retry_ms = 5000,
+ *      .attach = cardAttach,
+ *      .detach = cardDetach,
+ * };
+ * log_sink_t sink;
+ * spill_sink_init(&spill, &sink);
+ * logger_run(&sink);
+ * ~~~
+ */
+typedef struct
+{
+    spill_ring_t *ring;                                                  /*!< Fallback, NULL for none */
+    log_block_t *buffer;                                                 /*!< Drain buffer, DMA capable */
+    uint32_t buffer_blocks;                                              /*!< Blocks in buffer */
+    uint32_t retry_ms;                                                   /*!< Time between attach attempts */
+    esp_err_t (*attach)(void *ctx, log_sink_t *card, log_sink_t *drain); /*!< Bring the card up */
+    void (*detach)(void *ctx);                                           /*!< Release a failed card */
+    void *ctx;                                                           /*!< Passed to attach() and detach() */
+    log_sink_t card;                                                     /*!< New blocks, when attached */
+    log_sink_t drain;                                                    /*!< Ring contents, when attached */
+    bool attached;                                                       /*!< Card is up */
+    bool tried;                                                          /*!< attempt_ms is valid */
+    bool failed;                                                         /*!< Card failed, retry delay not started */
+    uint32_t attempt_ms;                                                 /*!< Last attach attempt */
+    spill_sink_stats_t stats;                                            /*!< Counters */
+} spill_sink_t;
+
+void spill_sink_init(spill_sink_t *spill, log_sink_t *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
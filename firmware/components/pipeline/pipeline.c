@@ -0,0 +1,339 @@
+/**
+ * @file pipeline.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sample path from the sensor executor to the logger: filter, channels, wall clock, adaptive rate, records
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The firmware runs it from sensorTask and dataTask, tools/replay on the
+ * host stand-ins with a capture as the ticks, so a capture exercises the
+ * same filter, channels and logger as the device.
+ */
+
+#include "pipeline.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "sensor/sensor_drivers.h"
+#include "trace/trace.h"
+#if CONFIG_LOGGER_SD
+#include "logger/logger.h"
+#endif
+#if CONFIG_LOGGER_TELEMETRY
+#include "telemetry/telemetry.h"
+#endif
+
+/* Guards the channels and the wall clock, shared by producer, consumer and readers of the counters */
+static portMUX_TYPE pipeline_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief Reset the state and counters, set up the filter and the rate controller
+ *
+ * @param p     pointer to pipeline, sensor table, channels and hooks set
+ * @return int  0 on success, -1 for an invalid filter configuration
+ */
+int pipeline_init(pipeline_t *p)
+{
+    int result = 0;
+
+    p->space = xSemaphoreCreateBinaryStatic(&p->space_buffer);
+#if CONFIG_LOGGER_PRESSURE_OVERSAMPLE > 1
+    p->filter = (decimator_t){.config = PIPELINE_FILTER};
+    p->temperature = (decimator_t){.config = PIPELINE_FILTER};
+    result = decimator_init(&p->filter) | decimator_init(&p->temperature);
+    p->output_us = 0;
+#endif
+#if CONFIG_LOGGER_SAMPLE_RATE_ADAPTIVE
+    p->rate = (adaptive_rate_t){
+        .config = ADAPTIVE_RATE_DEFAULT(),
+        .period_ms = CONFIG_LOGGER_SAMPLE_PERIOD_MS,
+    };
+    adaptive_rate_init(&p->rate);
+#endif
+    p->clock = (epoch_clock_t){0};
+    p->battery_mv = 0;
+    stats_reset(&p->age);
+    p->samples = 0;
+    p->rates = 0;
+    p->unstored = 0;
+    return result;
+}
+
+/**
+ * @brief Filter a sample and queue it for pipeline_drain()
+ *
+ * @param arg       pointer to pipeline
+ * @param sample    sample from the executor
+ * @note   Producer only, the executor's emit hook
+ */
+void pipeline_push(void *arg, const sensor_sample_t *sample)
+{
+    pipeline_t *p = arg;
+
+#if CONFIG_LOGGER_PRESSURE_OVERSAMPLE > 1
+    /* Only every PIPELINE_OVERSAMPLE-th pressure reading goes on, with the filtered values */
+    sensor_sample_t filtered;
+    if (sample->sensor == p->pressure)
+    {
+        filtered = *sample;
+        bool ready = decimator_push(&p->filter, sample->value[BMP180_PRESSURE], &filtered.value[BMP180_PRESSURE]);
+        decimator_push(&p->temperature, sample->value[BMP180_TEMPERATURE], &filtered.value[BMP180_TEMPERATURE]);
+        if (!ready)
+        {
+            return;
+        }
+
+        /* Back to the time the output stands for, at the mean reading spacing of the last output */
+        int64_t reading_us = p->filter.outputs > 1 ? (sample->stamp - p->output_us) / PIPELINE_OVERSAMPLE
+                                                   : CONFIG_LOGGER_SAMPLE_PERIOD_MS * 1000 / PIPELINE_OVERSAMPLE;
+        p->output_us = sample->stamp;
+        filtered.stamp -= decimator_delay_us(&p->filter.config, reading_us);
+        sample = &filtered;
+    }
+#endif
+
+    channel_t *channel = &p->channels[sample->sensor];
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = p->timeouts[sample->sensor];
+    channel_result_t result;
+
+    while (1)
+    {
+        portENTER_CRITICAL(&pipeline_lock);
+        result = channel_push(channel, sample);
+        portEXIT_CRITICAL(&pipeline_lock);
+
+        /* CHANNEL_BLOCK: wait for the consumer to make room, then give up */
+        TickType_t waited = xTaskGetTickCount() - start;
+        if (result != CHANNEL_FULL)
+        {
+            break;
+        }
+        if (waited >= timeout || xSemaphoreTake(p->space, timeout - waited) != pdTRUE)
+        {
+            portENTER_CRITICAL(&pipeline_lock);
+            channel_timeout(channel);
+            portEXIT_CRITICAL(&pipeline_lock);
+            TRACE("%s: sample %u dropped after %u ms", (uintptr_t)p->sensors[sample->sensor].driver->name,
+                  sample->seq, (uint32_t)pdTICKS_TO_MS(timeout));
+            return;
+        }
+    }
+
+    if (result == CHANNEL_DROPPED || result == CHANNEL_REPLACED)
+    {
+        TRACE("%s: sample %u %s", (uintptr_t)p->sensors[sample->sensor].driver->name, sample->seq,
+              (uintptr_t)(result == CHANNEL_DROPPED ? "dropped" : "queued, oldest dropped"));
+    }
+    if (result != CHANNEL_DROPPED && p->ready != NULL)
+    {
+        p->ready(p->arg);
+    }
+}
+
+#if CONFIG_LOGGER_SAMPLE_RATE_ADAPTIVE
+/**
+ * @brief Log a change of the sample period and pass it on
+ *
+ * @param p         pointer to pipeline
+ * @param time_us   wall clock time of the reading that caused the change
+ * @param old       period before the change in ms
+ */
+static void pipeline_period(pipeline_t *p, int64_t time_us, uint32_t old)
+{
+    if (p->period != NULL)
+    {
+        p->period(p->arg, p->rate.period_ms);
+    }
+
+#if CONFIG_LOGGER_SD
+    /* Rate record, so the log says when the spacing of the samples changed and why */
+    log_record_t *record = logger_reserve();
+    if (record != NULL)
+    {
+        *record = (log_record_t){
+            .time_us = time_us,
+            .type = LOG_RECORD_RATE,
+            .flags = p->rate.reason,
+            .battery_mv = p->battery_mv,
+            .temperature = (int32_t)old,
+            .pressure = p->rate.period_ms,
+        };
+        logger_commit();
+        p->rates++;
+    }
+#endif
+    TRACE("sample period %u ms, reason 0x%x", p->rate.period_ms, p->rate.reason);
+}
+#endif
+
+/**
+ * @brief Log a pressure sample with the latest battery voltage
+ *
+ * @param p         pointer to pipeline
+ * @param pressure  pressure sensor sample
+ */
+static void pipeline_row(pipeline_t *p, const sensor_sample_t *pressure)
+{
+    /* Record slot, used directly when the logger has no free block */
+    static log_record_t spare;
+
+    /* Time from the tick to here */
+    stats_add(&p->age, esp_timer_get_time() - pressure->stamp);
+
+#if CONFIG_LOGGER_SD
+    /* Build the record in place inside the log block */
+    log_record_t *record = logger_reserve();
+    if (record == NULL)
+    {
+        TRACE("logger full, sample %u not stored", pressure->seq);
+        p->unstored++;
+        record = &spare;
+    }
+#else
+    /* Nothing stores records, the row only goes out */
+    log_record_t *record = &spare;
+#endif
+
+    /* Integer units, decoded by tools/telemetry.py; only the consumer writes the clock */
+    *record = (log_record_t){
+        .time_us = epoch_clock_now(&p->clock, pressure->stamp),
+        .type = LOG_RECORD_SAMPLE,
+        .battery_mv = p->battery_mv,
+        .temperature = pressure->value[BMP180_TEMPERATURE],
+        .pressure = (uint32_t)pressure->value[BMP180_PRESSURE],
+    };
+
+    /* Send record, then give the slot to the logger */
+#if CONFIG_LOGGER_TELEMETRY
+    telemetry_send(TELEMETRY_SAMPLE, record, sizeof(*record));
+#endif
+#if CONFIG_LOGGER_SD
+    bool stored = record != &spare;
+#else
+    bool stored = true;
+#endif
+    if (p->row != NULL)
+    {
+        p->row(p->arg, record, stored);
+    }
+#if CONFIG_LOGGER_SD
+    if (stored)
+    {
+        logger_commit();
+    }
+#endif
+    p->samples++;
+
+#if CONFIG_LOGGER_SAMPLE_RATE_ADAPTIVE
+    /* Period of the next ticks from how fast the pressure moves */
+    uint32_t old = p->rate.period_ms;
+    if (adaptive_rate_update(&p->rate, pressure->stamp, (int32_t)pressure->value[BMP180_PRESSURE]))
+    {
+        pipeline_period(p, epoch_clock_now(&p->clock, pressure->stamp), old);
+    }
+#endif
+}
+
+/**
+ * @brief Take every queued sample: sync the clock, track the battery, log pressure
+ *
+ * @param p     pointer to pipeline
+ * @note   Consumer only, call it after the ready hook
+ */
+void pipeline_drain(pipeline_t *p)
+{
+    sensor_sample_t sample;
+
+    for (uint8_t i = 0; i < p->count; i++)
+    {
+        while (1)
+        {
+            portENTER_CRITICAL(&pipeline_lock);
+            bool taken = channel_pop(&p->channels[i], &sample);
+            portEXIT_CRITICAL(&pipeline_lock);
+            if (!taken)
+            {
+                break;
+            }
+
+#if CONFIG_LOGGER_RTC
+            if (sample.sensor == p->rtc)
+            {
+                /* The sync boundary: RTC date and time of day to Unix time at the tick */
+                int64_t seconds = (int64_t)sample.value[DS3231_DAY] * EPOCH_SECONDS_PER_DAY + sample.value[DS3231_SECOND];
+                bool first = !p->clock.valid;
+                portENTER_CRITICAL(&pipeline_lock);
+                int64_t step = epoch_clock_sync(&p->clock, seconds * EPOCH_US_PER_SECOND, EPOCH_US_PER_SECOND, sample.stamp);
+                portEXIT_CRITICAL(&pipeline_lock);
+                if (!first && step != 0)
+                {
+                    TRACE("clock stepped %d us", (int32_t)step);
+                }
+                if (p->synced != NULL)
+                {
+                    p->synced(p->arg, first);
+                }
+                continue;
+            }
+#endif
+
+#if CONFIG_LOGGER_BATTERY
+            if (sample.sensor == p->battery)
+            {
+                p->battery_mv = (uint16_t)sample.value[BATTERY_VOLTAGE];
+#if CONFIG_LOGGER_TELEMETRY
+                /* Battery readings are forwarded as they come */
+                telemetry_battery_t status = {
+                    .raw = (uint16_t)sample.value[BATTERY_RAW],
+                    .voltage = p->battery_mv,
+                    .percentage = (uint8_t)sample.value[BATTERY_PERCENTAGE],
+                };
+                telemetry_send(TELEMETRY_BATTERY, &status, sizeof(status));
+#endif
+#if CONFIG_LOGGER_SD
+                /* The battery decides how much unwritten data the logger may hold */
+                logger_set_battery((uint8_t)sample.value[BATTERY_PERCENTAGE], p->battery_mv);
+#endif
+                continue;
+            }
+#endif
+
+            if (sample.sensor == p->pressure)
+            {
+                pipeline_row(p, &sample);
+            }
+        }
+    }
+
+    /* Room again for a blocked producer */
+    xSemaphoreGive(p->space);
+}
+
+/**
+ * @brief Copy of the wall clock
+ *
+ * @param p     pointer to pipeline
+ * @param clock pointer to clock to fill
+ */
+void pipeline_get_clock(const pipeline_t *p, epoch_clock_t *clock)
+{
+    portENTER_CRITICAL(&pipeline_lock);
+    *clock = p->clock;
+    portEXIT_CRITICAL(&pipeline_lock);
+}
+
+/**
+ * @brief Copy of a channel's counters
+ *
+ * @param p     pointer to pipeline
+ * @param index sensor index
+ * @param stats pointer to stats to fill
+ */
+void pipeline_get_channel(const pipeline_t *p, uint8_t index, channel_stats_t *stats)
+{
+    portENTER_CRITICAL(&pipeline_lock);
+    *stats = p->channels[index].stats;
+    portEXIT_CRITICAL(&pipeline_lock);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file pipeline.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sample path from the sensor executor to the logger: filter, channels, wall clock, adaptive rate, records
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "sdkconfig.h"
+#include "epoch/epoch.h"
+#include "logfmt/log_record.h"
+#include "sensor/adaptive_rate.h"
+#include "sensor/channel.h"
+#include "sensor/decimator.h"
+#include "sensor/sensor_exec.h"
+#include "stats/stats.h"
+
+#define PIPELINE_NONE 0xFF /*!< Sensor index of a sensor left out of the table */
+
+/*
+ * Pressure readings per logged sample: the tick runs this many times faster
+ * than the sample period and the filter decimates the readings, 1 to log
+ * every reading as it comes.
+ */
+#define PIPELINE_OVERSAMPLE CONFIG_LOGGER_PRESSURE_OVERSAMPLE
+
+/* Pressure filter, @see decimator_config_t; the FIR is flatter to 0.25 of the sample rate */
+#if CONFIG_LOGGER_PRESSURE_FILTER_FIR
+#define PIPELINE_FILTER DECIMATOR_FIR_CONFIG(PIPELINE_OVERSAMPLE, decimator_lowpass_8x32, CONFIG_LOGGER_PRESSURE_SMOOTH_SHIFT)
+#else
+#define PIPELINE_FILTER DECIMATOR_CIC_CONFIG(PIPELINE_OVERSAMPLE, CONFIG_LOGGER_PRESSURE_CIC_ORDER, CONFIG_LOGGER_PRESSURE_SMOOTH_SHIFT)
+#endif
+
+/**
+ * @struct pipeline_t pipeline.h
+ * @brief Everything between the sensor executor and the log block pool
+ *
+ * pipeline_push() is the executor's emit hook and runs in the sampling
+ * task: it filters pressure and temperature down to one sample per
+ * PIPELINE_OVERSAMPLE readings through the same filter, stamps it with the
+ * time it stands for, the latest reading's tick less the group delay, and
+ * queues every sample in its sensor's channel. pipeline_drain() runs in the
+ * consumer task: the RTC disciplines the wall clock, the battery feeds the
+ * flush mode, and every pressure sample becomes one record built in place
+ * with logger_reserve() and logger_commit(). Without CONFIG_LOGGER_SD the
+ * record only goes to telemetry and the hooks.
+ *
+ * ### Example
+ * ~~~.c
+ * pipeline_t pipeline = {
+ *      .sensors = table,
+ *      .channels = channels,
+ *      .timeouts = timeouts,
+ *      .count = 3,
+ *      .rtc = 0,
+ *      .pressure = 1,
+ *      .battery = 2,
+ *      .ready = wake_consumer,
+ * };
+ * pipeline_init(&pipeline);
+ * exec.emit = pipeline_push;
+ * exec.arg = &pipeline;
+ * // consumer task, once woken
+ * pipeline_drain(&pipeline);
+ * ~~~
+ */
+typedef struct
+{
+    const sensor_t *sensors;    /*!< Sensor table, names for the traces */
+    channel_t *channels;        /*!< One initialized channel per sensor */
+    const TickType_t *timeouts; /*!< CHANNEL_BLOCK wait per sensor in ticks */
+    uint8_t count;              /*!< Number of sensors */
+    uint8_t rtc;                /*!< DS3231 index, PIPELINE_NONE without one */
+    uint8_t pressure;           /*!< BMP180 index, one record per sample */
+    uint8_t battery;            /*!< Battery index, PIPELINE_NONE without one */
+    void (*ready)(void *arg);   /*!< A sample was queued, wake the consumer, may be NULL */
+    void (*row)(void *arg, const log_record_t *record, bool stored); /*!< Sample record before its commit, may be NULL */
+    void (*synced)(void *arg, bool first);                           /*!< After an RTC sync of the clock, may be NULL */
+    void (*period)(void *arg, uint32_t period_ms);                   /*!< Adaptive rate changed the sample period, may be NULL */
+    void *arg;                                                       /*!< Passed to the hooks */
+
+    SemaphoreHandle_t space;            /*!< Given by pipeline_drain() after taking samples */
+    StaticSemaphore_t space_buffer;     /*!< Storage of space */
+#if CONFIG_LOGGER_PRESSURE_OVERSAMPLE > 1
+    decimator_t filter;                 /*!< Pressure filter, pipeline_push() only */
+    decimator_t temperature;            /*!< Same filter for the temperature, so both share the delay */
+    int64_t output_us;                  /*!< Tick of the reading that completed the last output */
+#endif
+#if CONFIG_LOGGER_SAMPLE_RATE_ADAPTIVE
+    adaptive_rate_t rate;               /*!< Sample period, pipeline_drain() only */
+#endif
+    epoch_clock_t clock;                /*!< esp_timer to Unix time, written by pipeline_drain() */
+    uint16_t battery_mv;                /*!< Latest battery voltage, stored with every record */
+    stats_t age;                        /*!< Sample stamp to pipeline_drain() in us, the group delay included */
+    uint32_t samples;                   /*!< Sample records */
+    uint32_t rates;                     /*!< Rate records */
+    uint32_t unstored;                  /*!< Records the logger had no block for */
+} pipeline_t;
+
+int pipeline_init(pipeline_t *p);
+
+void pipeline_push(void *arg, const sensor_sample_t *sample);
+
+void pipeline_drain(pipeline_t *p);
+
+void pipeline_get_clock(const pipeline_t *p, epoch_clock_t *clock);
+
+void pipeline_get_channel(const pipeline_t *p, uint8_t index, channel_stats_t *stats);
+
+#endif
@@ -1,12 +1,13 @@
 #ifndef _SD_CARD_H_
 #define _SD_CARD_H_
 
-// Pin assignments can be set in menuconfig, see "SD SPI Example Configuration" menu.
-// You can also change the pin assignments here by changing the following 4 lines.
-#define PIN_NUM_MISO 19
-#define PIN_NUM_MOSI 23
-#define PIN_NUM_CLK 18
-#define PIN_NUM_CS 13
+#include "sdkconfig.h"
+
+// Pin assignments are set in menuconfig, see the "Sensor Data Logger" menu, "SD card logging".
+#define PIN_NUM_MISO CONFIG_LOGGER_SD_PIN_MISO
+#define PIN_NUM_MOSI CONFIG_LOGGER_SD_PIN_MOSI
+#define PIN_NUM_CLK CONFIG_LOGGER_SD_PIN_CLK
+#define PIN_NUM_CS CONFIG_LOGGER_SD_PIN_CS
 
 const char *SD_CARD_TAG = "SDCARD";
 
@@ -0,0 +1,139 @@
+/**
+ * @file adaptive_rate.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sampling period that follows how fast a pressure reading changes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Smoothing weights come from time constants rather than sample counts, so
+ * the filter behaves the same at every period: w = dt / (tau + dt). The
+ * forecast error RMS is the exception, its weight is capped so that one
+ * noisy reading at a long period cannot trip fast_dev on its own.
+ */
+
+#include "adaptive_rate.h"
+
+#define ADAPTIVE_RATE_DEV_WEIGHT 0.25f /* Largest forecast error weight, four readings or more */
+
+/**
+ * @brief Smoothing weight of a step of dt seconds
+ */
+static float adaptive_rate_weight(float dt, uint32_t tau_ms)
+{
+    return dt / (tau_ms / 1000.0f + dt);
+}
+
+/**
+ * @brief Reset the controller, clamping period_ms to the bounds
+ *
+ * @param rate  pointer to controller, config and period_ms set
+ */
+void adaptive_rate_init(adaptive_rate_t *rate)
+{
+    const adaptive_rate_config_t *config = &rate->config;
+
+    if (rate->period_ms < config->min_period_ms)
+    {
+        rate->period_ms = config->min_period_ms;
+    }
+    if (rate->period_ms > config->max_period_ms)
+    {
+        rate->period_ms = config->max_period_ms;
+    }
+    rate->primed = false;
+    rate->level = 0;
+    rate->trend = 0;
+    rate->variance = 0;
+    rate->reason = 0;
+    rate->changes = 0;
+}
+
+/**
+ * @brief Feed one reading and pick the period of the next ones
+ *
+ * @param rate      pointer to controller
+ * @param time_us   reading time, any monotonic microsecond clock
+ * @param pressure  reading in Pa
+ * @return true period_ms changed, reason says why
+ * @return false period unchanged
+ */
+bool adaptive_rate_update(adaptive_rate_t *rate, int64_t time_us, int32_t pressure)
+{
+    const adaptive_rate_config_t *config = &rate->config;
+    float reading = (float)pressure;
+
+    if (!rate->primed)
+    {
+        rate->primed = true;
+        rate->level = reading;
+        rate->last_us = time_us;
+        rate->calm_since_us = time_us;
+        return false;
+    }
+    if (time_us <= rate->last_us)
+    {
+        return false;
+    }
+    float dt = (float)(time_us - rate->last_us) / 1e6f;
+    rate->last_us = time_us;
+
+    /* Holt: forecast, then correct level and trend by the error */
+    float forecast = rate->level + rate->trend * dt;
+    float error = reading - forecast;
+    float previous = rate->level;
+    rate->level = forecast + adaptive_rate_weight(dt, config->level_tau_ms) * error;
+    rate->trend += adaptive_rate_weight(dt, config->trend_tau_ms) * ((rate->level - previous) / dt - rate->trend);
+    float weight = adaptive_rate_weight(dt, config->dev_tau_ms);
+    weight = weight < ADAPTIVE_RATE_DEV_WEIGHT ? weight : ADAPTIVE_RATE_DEV_WEIGHT;
+    rate->variance += weight * (error * error - rate->variance);
+
+    float slope = rate->trend < 0 ? -rate->trend : rate->trend;
+    uint8_t fast = 0;
+    if (slope >= config->fast_slope)
+    {
+        fast |= ADAPTIVE_RATE_SLOPE;
+    }
+    if (rate->variance >= config->fast_dev * config->fast_dev)
+    {
+        fast |= ADAPTIVE_RATE_DEVIATION;
+    }
+    if (error >= config->fast_step || error <= -config->fast_step)
+    {
+        fast |= ADAPTIVE_RATE_STEP;
+    }
+
+    /* Fast: shortest period at once */
+    if (fast != 0)
+    {
+        rate->calm_since_us = time_us;
+        if (rate->period_ms == config->min_period_ms)
+        {
+            return false;
+        }
+        rate->period_ms = config->min_period_ms;
+        rate->reason = fast;
+        rate->changes++;
+        return true;
+    }
+
+    /* Between the thresholds: hold */
+    if (slope >= config->calm_slope || rate->variance >= config->calm_dev * config->calm_dev)
+    {
+        rate->calm_since_us = time_us;
+        return false;
+    }
+
+    /* Calm long enough: one step slower */
+    if (time_us - rate->calm_since_us < (int64_t)config->calm_hold_ms * 1000 ||
+        rate->period_ms >= config->max_period_ms)
+    {
+        return false;
+    }
+    rate->period_ms = rate->period_ms * 2 < config->max_period_ms ? rate->period_ms * 2 : config->max_period_ms;
+    rate->calm_since_us = time_us;
+    rate->reason = ADAPTIVE_RATE_CALM;
+    rate->changes++;
+    return true;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file adaptive_rate.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sampling period that follows how fast a pressure reading changes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _ADAPTIVE_RATE_H_
+#define _ADAPTIVE_RATE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum adaptive_rate_reason_t adaptive_rate.h
+ * @brief Why the period changed, bits
+ */
+typedef enum
+{
+    ADAPTIVE_RATE_SLOPE = 1 << 0,     /*!< Trend at or above fast_slope */
+    ADAPTIVE_RATE_DEVIATION = 1 << 1, /*!< Forecast error RMS at or above fast_dev */
+    ADAPTIVE_RATE_CALM = 1 << 2,      /*!< Calm for calm_hold_ms */
+    ADAPTIVE_RATE_STEP = 1 << 3,      /*!< One forecast error at or above fast_step */
+} adaptive_rate_reason_t;
+
+/**
+ * @struct adaptive_rate_config_t adaptive_rate.h
+ * @brief Bounds and thresholds, pressure in Pa
+ *
+ * Any fast condition goes straight to min_period_ms. Each calm_hold_ms
+ * with both measures below their calm thresholds doubles the period, up to
+ * max_period_ms; the gap between the fast and calm thresholds is the
+ * hysteresis. fast_dev and calm_dev must sit above the sensor noise, which
+ * is part of the forecast error; at long periods the RMS averages over a few
+ * readings at least, so a sudden jump is caught by fast_step instead.
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      uint32_t min_period_ms;
+ *      uint32_t max_period_ms;
+ *      uint32_t level_tau_ms;
+ *      uint32_t trend_tau_ms;
+ *      uint32_t dev_tau_ms;
+ *      float fast_slope;
+ *      float calm_slope;
+ *      float fast_dev;
+ *      float calm_dev;
+ *      float fast_step;
+ *      uint32_t calm_hold_ms;
+ * }adaptive_rate_config_t;
+ * ~~~
+ */
+typedef struct
+{
+    uint32_t min_period_ms; /*!< Shortest period */
+    uint32_t max_period_ms; /*!< Longest period, min_period_ms times a power of two */
+    uint32_t level_tau_ms;  /*!< Level smoothing time constant */
+    uint32_t trend_tau_ms;  /*!< Trend smoothing time constant */
+    uint32_t dev_tau_ms;    /*!< Forecast error smoothing time constant */
+    float fast_slope;       /*!< Pa/s */
+    float calm_slope;       /*!< Pa/s */
+    float fast_dev;         /*!< Pa RMS */
+    float calm_dev;         /*!< Pa RMS */
+    float fast_step;        /*!< Pa, a single forecast error */
+    uint32_t calm_hold_ms;  /*!< Calm time before each doubling */
+} adaptive_rate_config_t;
+
+/**
+ * @brief BMP180 in standard mode, about 5 Pa RMS noise; 1.5 Pa/s is 12 cm/s of height
+ */
+#define ADAPTIVE_RATE_DEFAULT() \
+    {                           \
+        .min_period_ms = 250,   \
+        .max_period_ms = 8000,  \
+        .level_tau_ms = 2000,   \
+        .trend_tau_ms = 8000,   \
+        .dev_tau_ms = 4000,     \
+        .fast_slope = 1.5f,     \
+        .calm_slope = 0.4f,     \
+        .fast_dev = 16.0f,      \
+        .calm_dev = 10.0f,      \
+        .fast_step = 35.0f,     \
+        .calm_hold_ms = 20000,  \
+    }
+
+/**
+ * @struct adaptive_rate_t adaptive_rate.h
+ * @brief Controller state
+ *
+ * A Holt filter tracks level and trend of the readings; its one step
+ * forecast error, averaged as a variance, catches curvature, steps and
+ * gusts that a trend alone misses. Set config and the starting period_ms,
+ * then call adaptive_rate_init().
+ *
+ * ### Example
+ * ~~~.c
+ * adaptive_rate_t rate = {
+ *      .config = ADAPTIVE_RATE_DEFAULT(),
+ *      .period_ms = 1000,
+ * };
+ * adaptive_rate_init(&rate);
+ * if (adaptive_rate_update(&rate, stamp_us, pressure))
+ * {
+ *      // reprogram the sampling timer to rate.period_ms
+ * }
+ * ~~~
+ */
+typedef struct
+{
+    adaptive_rate_config_t config; /*!< Bounds and thresholds */
+    uint32_t period_ms;            /*!< Current period */
+    bool primed;                   /*!< A first reading was seen */
+    int64_t last_us;               /*!< Time of the last reading */
+    int64_t calm_since_us;         /*!< Start of the current calm stretch */
+    float level;                   /*!< Smoothed pressure, Pa */
+    float trend;                   /*!< Smoothed slope, Pa/s */
+    float variance;                /*!< Smoothed squared forecast error, Pa^2 */
+    uint8_t reason;                /*!< Reason of the last change @see adaptive_rate_reason_t */
+    uint32_t changes;              /*!< Period changes */
+} adaptive_rate_t;
+
+void adaptive_rate_init(adaptive_rate_t *rate);
+
+bool adaptive_rate_update(adaptive_rate_t *rate, int64_t time_us, int32_t pressure);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
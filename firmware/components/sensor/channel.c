@@ -0,0 +1,154 @@
+/**
+ * @file channel.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Bounded sample queue with an overflow policy and loss accounting
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every sample pushed is either delivered to the consumer, counted as
+ * dropped or counted as coalesced. After a stall the counters say how much
+ * was lost on which channel, and the policy decides which part.
+ */
+
+#include <string.h>
+#include "channel.h"
+
+/**
+ * @brief Initialize an empty channel
+ *
+ * @param channel   pointer to channel
+ * @param items     storage, @p length entries
+ * @param length    capacity
+ * @param policy    overflow policy
+ */
+void channel_init(channel_t *const channel, sensor_sample_t *items, uint16_t length, channel_policy_t policy)
+{
+    channel->items = items;
+    channel->length = length;
+    channel->head = 0;
+    channel->count = 0;
+    channel->policy = policy;
+    memset(&channel->stats, 0, sizeof(channel->stats));
+}
+
+/**
+ * @brief Fold a sample into an aggregate: running mean of the values, newest seq and stamp
+ *
+ * The merge count saturates at UINT16_MAX, past that the aggregate keeps that
+ * weight against each new sample instead of wrapping to a small one.
+ */
+static void channel_merge(sensor_sample_t *aggregate, const sensor_sample_t *sample)
+{
+    int64_t n = (int64_t)aggregate->merged + 1;
+    int64_t m = (int64_t)sample->merged + 1;
+
+    for (uint8_t i = 0; i < aggregate->count && i < SENSOR_MAX_CHANNELS; i++)
+    {
+        int64_t sum = (int64_t)aggregate->value[i] * n + (int64_t)sample->value[i] * m;
+        /* Round to nearest so repeated merges do not drift toward zero */
+        aggregate->value[i] = (int32_t)((sum >= 0 ? sum + (n + m) / 2 : sum - (n + m) / 2) / (n + m));
+    }
+    n += m - 1;
+    aggregate->merged = (uint16_t)(n < UINT16_MAX ? n : UINT16_MAX);
+    aggregate->seq = sample->seq;
+    aggregate->stamp = sample->stamp;
+}
+
+/**
+ * @brief Add a sample, applying the overflow policy when full
+ *
+ * @param channel   pointer to channel
+ * @param sample    sample to add
+ * @return channel_result_t outcome
+ */
+channel_result_t channel_push(channel_t *const channel, const sensor_sample_t *sample)
+{
+    channel_result_t result = CHANNEL_QUEUED;
+
+    if (channel->count == channel->length)
+    {
+        switch (channel->policy)
+        {
+        case CHANNEL_BLOCK:
+            channel->stats.waits++;
+            return CHANNEL_FULL;
+        case CHANNEL_DROP_OLDEST:
+            channel->head = (uint16_t)((channel->head + 1) % channel->length);
+            channel->count--;
+            channel->stats.dropped++;
+            result = CHANNEL_REPLACED;
+            break;
+        case CHANNEL_COALESCE:
+            channel_merge(&channel->items[(channel->head + channel->count - 1) % channel->length], sample);
+            channel->stats.coalesced++;
+            return CHANNEL_MERGED;
+        case CHANNEL_DROP_NEWEST:
+        default:
+            channel->stats.dropped++;
+            return CHANNEL_DROPPED;
+        }
+    }
+
+    channel->items[(channel->head + channel->count) % channel->length] = *sample;
+    channel->count++;
+    channel->stats.enqueued++;
+    if (channel->count > channel->stats.high_water)
+    {
+        channel->stats.high_water = channel->count;
+    }
+    return result;
+}
+
+/**
+ * @brief Give up on a sample after CHANNEL_FULL and its timeout
+ *
+ * @param channel   pointer to channel
+ */
+void channel_timeout(channel_t *const channel)
+{
+    channel->stats.dropped++;
+}
+
+/**
+ * @brief Take the oldest sample
+ *
+ * @param channel   pointer to channel
+ * @param sample    destination
+ * @return true a sample was taken
+ */
+bool channel_pop(channel_t *const channel, sensor_sample_t *sample)
+{
+    if (channel->count == 0)
+    {
+        return false;
+    }
+    *sample = channel->items[channel->head];
+    channel->head = (uint16_t)((channel->head + 1) % channel->length);
+    channel->count--;
+    return true;
+}
+
+/**
+ * @brief Policy name for reports
+ *
+ * @param policy    policy
+ * @return const char* name
+ */
+const char *channel_policy_name(channel_policy_t policy)
+{
+    switch (policy)
+    {
+    case CHANNEL_BLOCK:
+        return "block";
+    case CHANNEL_DROP_OLDEST:
+        return "drop-oldest";
+    case CHANNEL_DROP_NEWEST:
+        return "drop-newest";
+    case CHANNEL_COALESCE:
+        return "coalesce";
+    default:
+        return "?";
+    }
+}
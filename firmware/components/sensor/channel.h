@@ -0,0 +1,100 @@
+/**
+ * @file channel.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Bounded sample queue with an overflow policy and loss accounting
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CHANNEL_H_
+#define _CHANNEL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sensor_exec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum channel_policy_t channel.h
+ * @brief What a push does when the channel is full
+ */
+typedef enum
+{
+    CHANNEL_BLOCK = 0,       /*!< Caller waits up to a timeout, then drops the new sample */
+    CHANNEL_DROP_OLDEST = 1, /*!< Oldest queued sample is discarded */
+    CHANNEL_DROP_NEWEST = 2, /*!< New sample is discarded */
+    CHANNEL_COALESCE = 3,    /*!< New sample is averaged into the newest queued one */
+} channel_policy_t;
+
+/**
+ * @enum channel_result_t channel.h
+ * @brief Outcome of a push
+ */
+typedef enum
+{
+    CHANNEL_QUEUED = 0,   /*!< Stored */
+    CHANNEL_FULL = 1,     /*!< CHANNEL_BLOCK only: wait for space and retry, or call channel_timeout() */
+    CHANNEL_REPLACED = 2, /*!< Stored, the oldest sample was dropped */
+    CHANNEL_DROPPED = 3,  /*!< Not stored */
+    CHANNEL_MERGED = 4,   /*!< Folded into the newest queued sample */
+} channel_result_t;
+
+/**
+ * @struct channel_stats_t channel.h
+ * @brief Channel counters
+ */
+typedef struct
+{
+    uint32_t enqueued;   /*!< Samples stored in a slot of their own */
+    uint32_t dropped;    /*!< Samples lost */
+    uint32_t coalesced;  /*!< Samples folded into an aggregate */
+    uint32_t waits;      /*!< Pushes that found a CHANNEL_BLOCK channel full */
+    uint16_t high_water; /*!< Deepest queue seen */
+} channel_stats_t;
+
+/**
+ * @struct channel_t channel.h
+ * @brief Ring of samples
+ *
+ * Not locked: one producer and one consumer sharing a channel guard every
+ * call with the same lock.
+ *
+ * ### Example
+ * ~~~.c
+ * static sensor_sample_t items[10];
+ * channel_t channel;
+ * channel_init(&channel, items, 10, CHANNEL_DROP_OLDEST);
+ * channel_push(&channel, &sample);
+ * channel_pop(&channel, &sample);
+ * ~~~
+ */
+typedef struct
+{
+    sensor_sample_t *items;  /*!< Storage, length entries */
+    uint16_t length;         /*!< Capacity */
+    uint16_t head;           /*!< Oldest sample */
+    uint16_t count;          /*!< Queued samples */
+    channel_policy_t policy; /*!< Overflow policy */
+    channel_stats_t stats;   /*!< Counters */
+} channel_t;
+
+void channel_init(channel_t *const channel, sensor_sample_t *items, uint16_t length, channel_policy_t policy);
+
+channel_result_t channel_push(channel_t *const channel, const sensor_sample_t *sample);
+
+void channel_timeout(channel_t *const channel);
+
+bool channel_pop(channel_t *const channel, sensor_sample_t *sample);
+
+const char *channel_policy_name(channel_policy_t policy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * @file decimator.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Integer decimating filter for oversampled readings: CIC or polyphase FIR, then an optional IIR
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The CIC integrators run in unsigned 64-bit arithmetic and are meant to
+ * wrap: the combs take differences, and a difference of wrapped values is
+ * right as long as the true result fits, which the gain limit ensures for
+ * any 32-bit input. The FIR keeps one partial sum per output in progress
+ * and adds each reading to all of them as it arrives, instead of running
+ * all taps at the last reading of an output, so every reading costs the
+ * same.
+ */
+
+#include <string.h>
+#include "decimator.h"
+
+const int16_t decimator_lowpass_8x32[32] = {
+    0,    -6,   -21,  -52,  -94,  -134, -143, -77,  114,  472,  1011, 1702, 2473, 3214, 3800, 4125,
+    4125, 3800, 3214, 2473, 1702, 1011, 472,  114,  -77,  -143, -134, -94,  -52,  -21,  -6,   0,
+};
+
+/**
+ * @brief value / divisor rounded to nearest, halves away from zero
+ */
+static int64_t decimator_divide(int64_t value, int64_t divisor)
+{
+    return value >= 0 ? (value + divisor / 2) / divisor : -((-value + divisor / 2) / divisor);
+}
+
+/**
+ * @brief Check the configuration and clear the state
+ *
+ * @param dec   pointer to filter, config set
+ * @return int 0 on success, -1 on an invalid configuration
+ */
+int decimator_init(decimator_t *dec)
+{
+    const decimator_config_t *config = &dec->config;
+
+    if (config->factor == 0 || config->smooth_shift > DECIMATOR_SMOOTH_MAX)
+    {
+        return -1;
+    }
+
+    uint32_t gain = 1;
+    uint32_t phases = 0;
+    switch (config->type)
+    {
+    case DECIMATOR_CIC:
+        if (config->order == 0 || config->order > DECIMATOR_MAX_ORDER)
+        {
+            return -1;
+        }
+        for (uint8_t i = 0; i < config->order; i++)
+        {
+            gain *= config->factor;
+            if (gain > DECIMATOR_CIC_GAIN_MAX)
+            {
+                return -1;
+            }
+        }
+        break;
+    case DECIMATOR_FIR:
+        phases = ((uint32_t)config->tap_count + config->factor - 1) / config->factor;
+        if (config->taps == NULL || phases == 0 || phases > DECIMATOR_MAX_PHASES)
+        {
+            return -1;
+        }
+        break;
+    default:
+        return -1;
+    }
+
+    decimator_config_t saved = *config;
+    memset(dec, 0, sizeof(*dec));
+    dec->config = saved;
+    dec->gain = gain;
+    dec->phases = (uint8_t)phases;
+    return 0;
+}
+
+/**
+ * @brief Feed one reading
+ *
+ * @param dec   pointer to filter
+ * @param value reading
+ * @param out   filtered value, written when an output is ready
+ * @return true out written, every factor readings
+ * @return false more readings needed
+ */
+bool decimator_push(decimator_t *dec, int32_t value, int32_t *out)
+{
+    const decimator_config_t *config = &dec->config;
+    int64_t result;
+
+    if (!dec->primed)
+    {
+        dec->primed = true;
+        dec->bias = value;
+    }
+    int64_t x = (int64_t)value - dec->bias;
+    dec->inputs++;
+
+    if (config->type == DECIMATOR_CIC)
+    {
+        uint64_t v = (uint64_t)x;
+        for (uint8_t i = 0; i < config->order; i++)
+        {
+            dec->integrator[i] += v;
+            v = dec->integrator[i];
+        }
+        if (++dec->phase < config->factor)
+        {
+            return false;
+        }
+
+        /* Combs at the output rate, then the gain out with the fraction bits kept */
+        for (uint8_t i = 0; i < config->order; i++)
+        {
+            uint64_t delayed = dec->comb[i];
+            dec->comb[i] = v;
+            v -= delayed;
+        }
+        result = decimator_divide((int64_t)v * (1 << DECIMATOR_FRAC_BITS), dec->gain);
+    }
+    else
+    {
+        /* Reading at phase p meets tap factor - 1 - p of the output in progress,
+           and every factor taps further along in each later one */
+        uint32_t tap = (uint32_t)config->factor - 1 - dec->phase;
+        uint8_t slot = dec->head;
+        for (uint8_t i = 0; i < dec->phases && tap < config->tap_count; i++)
+        {
+            dec->acc[slot] += (int64_t)config->taps[tap] * x;
+            tap += config->factor;
+            slot = slot + 1 < dec->phases ? slot + 1 : 0;
+        }
+        if (++dec->phase < config->factor)
+        {
+            return false;
+        }
+
+        /* The output in progress is complete, its slot starts the newest one */
+        result = decimator_divide(dec->acc[dec->head], 1 << (15 - DECIMATOR_FRAC_BITS));
+        dec->acc[dec->head] = 0;
+        dec->head = dec->head + 1 < dec->phases ? dec->head + 1 : 0;
+    }
+    dec->phase = 0;
+
+    if (config->smooth_shift > 0)
+    {
+        /* smooth holds the output scaled by 2^smooth_shift, so small steps are not rounded away */
+        int64_t scale = (int64_t)1 << config->smooth_shift;
+        dec->smooth += result - decimator_divide(dec->smooth, scale);
+        result = decimator_divide(dec->smooth, scale);
+    }
+    dec->outputs++;
+    *out = (int32_t)(dec->bias + decimator_divide(result, 1 << DECIMATOR_FRAC_BITS));
+    return true;
+}
+
+/**
+ * @brief Group delay of a filter chain, how long its output lags the latest reading
+ *
+ * In half readings: order * (factor - 1) for a CIC, tap_count - 1 for a
+ * symmetric FIR, plus 2^smooth_shift - 1 outputs for the smoother. Stamp an
+ * output with the latest reading's time less this delay to give it the
+ * time it stands for.
+ *
+ * @param config        filter chain
+ * @param reading_us    time between readings
+ * @return int64_t delay in us
+ */
+int64_t decimator_delay_us(const decimator_config_t *config, int64_t reading_us)
+{
+    int64_t halves = config->type == DECIMATOR_CIC ? (int64_t)config->order * (config->factor - 1)
+                                                   : (int64_t)config->tap_count - 1;
+    halves += 2 * (((int64_t)1 << config->smooth_shift) - 1) * config->factor;
+    return halves * reading_us / 2;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file sample_join.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Join samples of several sensors into rows of the same tick
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Samples are matched by key rather than by arrival order, so a lost or
+ * reordered sample costs one row instead of shifting every later pairing.
+ */
+
+#include <string.h>
+#include "sample_join.h"
+
+/**
+ * @brief True if a sample belongs to a row with this key
+ */
+static bool sample_join_match(const sample_join_t *join, const sensor_sample_t *sample, uint32_t seq,
+                              int64_t stamp)
+{
+    if (join->key == SAMPLE_JOIN_SEQ)
+    {
+        return sample->seq == seq;
+    }
+    int64_t delta = sample->stamp - stamp;
+    return delta <= join->tolerance_us && -delta <= join->tolerance_us;
+}
+
+/**
+ * @brief Free a slot and remember its key
+ *
+ * @param join      pointer to join
+ * @param slot      row slot
+ * @param complete  row was emitted, otherwise count its losses
+ */
+static void sample_join_close(sample_join_t *join, int slot, bool complete)
+{
+    sample_row_t *row = &join->row[slot];
+
+    if (!complete)
+    {
+        for (int i = 0; i < SENSOR_MAX_SENSORS; i++)
+        {
+            uint32_t bit = 1u << i;
+            if (row->present & bit)
+            {
+                join->stats.orphaned++;
+            }
+            else if (join->required & bit)
+            {
+                join->stats.missing[i]++;
+            }
+        }
+    }
+
+    join->closed_seq[join->closed_next] = row->seq;
+    join->closed_stamp[join->closed_next] = row->stamp;
+    join->closed_next = (uint8_t)((join->closed_next + 1) % SAMPLE_JOIN_CLOSED);
+    if (join->closed_count < SAMPLE_JOIN_CLOSED)
+    {
+        join->closed_count++;
+    }
+    join->open[slot] = false;
+}
+
+/**
+ * @brief Clear every row and counter
+ *
+ * @param join  pointer to join, configuration fields already set
+ */
+void sample_join_init(sample_join_t *const join)
+{
+    memset(join->open, 0, sizeof(join->open));
+    memset(&join->stats, 0, sizeof(join->stats));
+    join->closed_count = 0;
+    join->closed_next = 0;
+    join->newest = INT64_MIN;
+}
+
+/**
+ * @brief Add a sample, emits its row when it completes
+ *
+ * @param join      pointer to join
+ * @param sample    sample from any sensor
+ */
+void sample_join_push(sample_join_t *const join, const sensor_sample_t *sample)
+{
+    if (sample->sensor >= SENSOR_MAX_SENSORS || !(join->required & (1u << sample->sensor)))
+    {
+        join->stats.ignored++;
+        return;
+    }
+    uint32_t bit = 1u << sample->sensor;
+    if (sample->stamp > join->newest)
+    {
+        join->newest = sample->stamp;
+    }
+
+    /* Open row with the same key */
+    int slot = -1;
+    for (int i = 0; i < SAMPLE_JOIN_ROWS; i++)
+    {
+        if (join->open[i] && sample_join_match(join, sample, join->row[i].seq, join->row[i].stamp))
+        {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot < 0)
+    {
+        /* Its row is already gone */
+        for (int i = 0; i < join->closed_count; i++)
+        {
+            if (sample_join_match(join, sample, join->closed_seq[i], join->closed_stamp[i]))
+            {
+                join->stats.late++;
+                return;
+            }
+        }
+
+        /* New row, in a free slot or in place of the oldest */
+        int oldest = 0;
+        for (int i = 0; i < SAMPLE_JOIN_ROWS; i++)
+        {
+            if (!join->open[i])
+            {
+                slot = i;
+                break;
+            }
+            if (join->row[i].stamp < join->row[oldest].stamp)
+            {
+                oldest = i;
+            }
+        }
+        if (slot < 0)
+        {
+            sample_join_close(join, oldest, false);
+            slot = oldest;
+        }
+        join->row[slot].seq = sample->seq;
+        join->row[slot].stamp = sample->stamp;
+        join->row[slot].present = 0;
+        join->open[slot] = true;
+    }
+
+    sample_row_t *row = &join->row[slot];
+    if (row->present & bit)
+    {
+        join->stats.duplicates++;
+        return;
+    }
+    row->sample[sample->sensor] = *sample;
+    row->present |= bit;
+
+    if ((row->present & join->required) == join->required)
+    {
+        join->stats.rows++;
+        join->emit(join->arg, row);
+        sample_join_close(join, slot, true);
+    }
+
+    /* Rows the newest sample has left behind */
+    sample_join_expire(join, join->newest);
+}
+
+/**
+ * @brief Close incomplete rows older than max_age_us
+ *
+ * Call it when no sample arrived for a while, so a stalled sensor does not
+ * hold rows open.
+ *
+ * @param join      pointer to join
+ * @param now_us    current time on the sample clock
+ */
+void sample_join_expire(sample_join_t *const join, int64_t now_us)
+{
+    for (int i = 0; i < SAMPLE_JOIN_ROWS; i++)
+    {
+        if (join->open[i] && now_us - join->row[i].stamp > join->max_age_us)
+        {
+            sample_join_close(join, i, false);
+        }
+    }
+}
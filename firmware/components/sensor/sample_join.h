@@ -0,0 +1,110 @@
+/**
+ * @file sample_join.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Join samples of several sensors into rows of the same tick
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SAMPLE_JOIN_H_
+#define _SAMPLE_JOIN_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sensor_exec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SAMPLE_JOIN_ROWS 8    /*!< Rows waiting for samples */
+#define SAMPLE_JOIN_CLOSED 16 /*!< Recently closed rows remembered to spot late samples */
+
+/**
+ * @enum sample_join_key_t sample_join.h
+ * @brief What makes two samples part of the same row
+ */
+typedef enum
+{
+    SAMPLE_JOIN_SEQ = 0,  /*!< Same tick sequence number */
+    SAMPLE_JOIN_TIME = 1, /*!< Stamps within tolerance_us */
+} sample_join_key_t;
+
+/**
+ * @struct sample_row_t sample_join.h
+ * @brief Samples of one tick, sample[i] is valid when bit i of present is set
+ */
+typedef struct
+{
+    uint32_t seq;                                /*!< Sequence number of the first sample */
+    int64_t stamp;                               /*!< Stamp of the first sample */
+    uint32_t present;                            /*!< Sensors received */
+    sensor_sample_t sample[SENSOR_MAX_SENSORS];  /*!< Samples by sensor index */
+} sample_row_t;
+
+/**
+ * @struct sample_join_stats_t sample_join.h
+ * @brief Join counters
+ */
+typedef struct
+{
+    uint32_t rows;                        /*!< Complete rows emitted */
+    uint32_t late;                        /*!< Samples for a row already closed */
+    uint32_t orphaned;                    /*!< Samples discarded with an incomplete row */
+    uint32_t duplicates;                  /*!< Second sample of a sensor in one row */
+    uint32_t ignored;                     /*!< Samples of sensors that are not joined */
+    uint32_t missing[SENSOR_MAX_SENSORS]; /*!< Incomplete rows lacking this sensor */
+} sample_join_stats_t;
+
+/**
+ * @struct sample_join_t sample_join.h
+ * @brief Join state
+ *
+ * A row is emitted as soon as every required sensor has a sample. Rows
+ * that stay incomplete for longer than max_age_us, or are pushed out by
+ * newer rows, are closed: their samples count as orphaned and each absent
+ * sensor as missing.
+ *
+ * ### Example
+ * ~~~.c
+ * sample_join_t join = {
+ *      .required = (1 << SENSOR_RTC) | (1 << SENSOR_PRESSURE),
+ *      .key = SAMPLE_JOIN_SEQ,
+ *      .max_age_us = 3000000,
+ *      .emit = on_row,
+ * };
+ * sample_join_init(&join);
+ * sample_join_push(&join, &sample);
+ * ~~~
+ */
+typedef struct
+{
+    uint32_t required;                                   /*!< Sensors a row needs, bit per index */
+    sample_join_key_t key;                               /*!< Matching rule */
+    int64_t tolerance_us;                                /*!< Largest stamp difference for SAMPLE_JOIN_TIME */
+    int64_t max_age_us;                                  /*!< Incomplete rows older than this are closed */
+    void (*emit)(void *arg, const sample_row_t *row);    /*!< Complete row output */
+    void *arg;                                           /*!< Passed to emit */
+    sample_row_t row[SAMPLE_JOIN_ROWS];                  /*!< Open rows */
+    bool open[SAMPLE_JOIN_ROWS];                         /*!< Slot in use */
+    uint32_t closed_seq[SAMPLE_JOIN_CLOSED];             /*!< Keys of recently closed rows */
+    int64_t closed_stamp[SAMPLE_JOIN_CLOSED];            /*!< Stamps of recently closed rows */
+    uint8_t closed_count;                                /*!< Valid closed entries */
+    uint8_t closed_next;                                 /*!< Next closed entry to overwrite */
+    int64_t newest;                                      /*!< Newest stamp pushed */
+    sample_join_stats_t stats;                           /*!< Counters */
+} sample_join_t;
+
+void sample_join_init(sample_join_t *const join);
+
+void sample_join_push(sample_join_t *const join, const sensor_sample_t *sample);
+
+void sample_join_expire(sample_join_t *const join, int64_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file sensor_drivers.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Drivers of the on-board sensors for the sensor executor
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+#include <time.h>
+#include "sdkconfig.h"
+#include "epoch/epoch.h"
+#include "sensor_drivers.h"
+
+/* BMP180 */
+
+static const sensor_channel_t bmp180_channels[] = {
+    {"temperature", "C", 100},
+    {"pressure", "Pa", 1},
+};
+
+static int bmp180_sensor_init(void *ctx)
+{
+    i2c_sensor_t *sensor = ctx;
+
+    memset(&sensor->dev.bmp180, 0, sizeof(sensor->dev.bmp180));
+    if (bmp180_init_desc(&sensor->dev.bmp180, sensor->port, sensor->sda, sensor->scl) != ESP_OK)
+    {
+        return -1;
+    }
+    return bmp180_init(&sensor->dev.bmp180) == ESP_OK ? 0 : -1;
+}
+
+static int bmp180_sensor_read(void *ctx, void *raw)
+{
+    i2c_sensor_t *sensor = ctx;
+    bmp180_raw_t *reading = raw;
+
+    /* Converts and waits inside the driver */
+    return bmp180_measure(&sensor->dev.bmp180, &reading->temperature, &reading->pressure,
+                          BMP180_MODE_STANDARD) == ESP_OK ? 0 : -1;
+}
+
+static void bmp180_sensor_decode(void *ctx, const void *raw, int32_t *values)
+{
+    const bmp180_raw_t *reading = raw;
+
+    (void)ctx;
+    values[BMP180_TEMPERATURE] = (int32_t)(reading->temperature * 100.0f);
+    values[BMP180_PRESSURE] = (int32_t)reading->pressure;
+}
+
+const sensor_driver_t bmp180_sensor = {
+    .name = "BMP180",
+    .channels = bmp180_channels,
+    .channel_count = 2,
+    .raw_size = sizeof(bmp180_raw_t),
+    .conversion_us = 0,
+    .init = bmp180_sensor_init,
+    .start = NULL,
+    .read = bmp180_sensor_read,
+    .decode = bmp180_sensor_decode,
+};
+
+#if CONFIG_LOGGER_RTC
+/* DS3231 */
+
+static const sensor_channel_t ds3231_channels[] = {
+    {"day", "d", 1},
+    {"second", "s", 1},
+    {"temperature", "C", 100},
+};
+
+/**
+ * @brief Firmware build time, a better guess than any fixed date for a clock that lost power
+ *
+ * @param time  calendar time out, UTC like the rest of the RTC, from BUILD_TIME_UTC
+ * @note   BUILD_TIME_UTC is Unix seconds from the build, SOURCE_DATE_EPOCH when set;
+ *         __DATE__ and __TIME__ would be the build machine's local time
+ */
+static void ds3231_build_time(struct tm *time)
+{
+    civil_time_t civil;
+
+    epoch_to_civil((int64_t)BUILD_TIME_UTC * EPOCH_US_PER_SECOND, &civil);
+    *time = (struct tm){
+        .tm_year = civil.year - 1900,
+        .tm_mon = civil.month - 1,
+        .tm_mday = civil.day,
+        .tm_hour = civil.hour,
+        .tm_min = civil.minute,
+        .tm_sec = civil.second,
+    };
+}
+
+static int ds3231_sensor_init(void *ctx)
+{
+    i2c_sensor_t *sensor = ctx;
+
+    memset(&sensor->dev.ds3231, 0, sizeof(sensor->dev.ds3231));
+    if (ds3231_init_desc(&sensor->dev.ds3231, sensor->port, sensor->sda, sensor->scl) != ESP_OK)
+    {
+        return -1;
+    }
+
+    /* Keep a running clock, set it only after it lost power */
+    bool stopped;
+    if (ds3231_get_oscillator_stop_flag(&sensor->dev.ds3231, &stopped) != ESP_OK)
+    {
+        return -1;
+    }
+    if (!stopped)
+    {
+        return 0;
+    }
+
+    struct tm time;
+    ds3231_build_time(&time);
+    if (ds3231_set_time(&sensor->dev.ds3231, &time) != ESP_OK)
+    {
+        return -1;
+    }
+    return ds3231_clear_oscillator_stop_flag(&sensor->dev.ds3231) == ESP_OK ? 0 : -1;
+}
+
+static int ds3231_sensor_read(void *ctx, void *raw)
+{
+    i2c_sensor_t *sensor = ctx;
+    ds3231_raw_t *reading = raw;
+
+    struct tm time;
+
+    if (ds3231_get_temp_float(&sensor->dev.ds3231, &reading->temperature) != ESP_OK ||
+        ds3231_get_time(&sensor->dev.ds3231, &time) != ESP_OK)
+    {
+        return -1;
+    }
+
+    /* The only struct tm in the data path, its fields go into the fixed raw layout */
+    reading->year = (int16_t)(time.tm_year + 1900);
+    reading->month = (uint8_t)(time.tm_mon + 1);
+    reading->day = (uint8_t)time.tm_mday;
+    reading->hour = (uint8_t)time.tm_hour;
+    reading->minute = (uint8_t)time.tm_min;
+    reading->second = (uint8_t)time.tm_sec;
+    reading->reserved = 0;
+    return 0;
+}
+
+static void ds3231_sensor_decode(void *ctx, const void *raw, int32_t *values)
+{
+    const ds3231_raw_t *reading = raw;
+
+    (void)ctx;
+    /* Calendar to day number, no mktime() */
+    values[DS3231_DAY] = days_from_civil(reading->year, reading->month, reading->day);
+    values[DS3231_SECOND] = reading->hour * 3600 + reading->minute * 60 + reading->second;
+    values[DS3231_TEMPERATURE] = (int32_t)(reading->temperature * 100.0f);
+}
+
+const sensor_driver_t ds3231_sensor = {
+    .name = "DS3231",
+    .channels = ds3231_channels,
+    .channel_count = 3,
+    .raw_size = sizeof(ds3231_raw_t),
+    .conversion_us = 0,
+    .init = ds3231_sensor_init,
+    .start = NULL,
+    .read = ds3231_sensor_read,
+    .decode = ds3231_sensor_decode,
+};
+#endif
+
+#if CONFIG_LOGGER_BATTERY
+/* Battery */
+
+static const sensor_channel_t battery_channels[] = {
+    {"raw", "", 1},
+    {"voltage", "V", 1000},
+    {"percentage", "%", 1},
+};
+
+static int battery_sensor_init(void *ctx)
+{
+    battery_t *battery = ctx;
+
+    /* Set battery to default configuration */
+    battery_default(battery);
+    if (battery_init(battery) != ESP_OK)
+    {
+        return -1;
+    }
+
+    /* Power cycle the divider: off now, on again in start() after settle_us */
+    battery_disable(battery);
+    return 0;
+}
+
+static int battery_sensor_start(void *ctx)
+{
+    battery_enable(ctx);
+    return 0;
+}
+
+static int battery_sensor_read(void *ctx, void *raw)
+{
+    *(int32_t *)raw = battery_read(ctx);
+    return 0;
+}
+
+static void battery_sensor_decode(void *ctx, const void *raw, int32_t *values)
+{
+    battery_t *battery = ctx;
+
+    /* The conversions work on the cached value; set it from raw, so replayed readings convert too */
+    battery->value = *(const int32_t *)raw;
+    values[BATTERY_RAW] = battery->value;
+    values[BATTERY_VOLTAGE] = battery_voltage(ctx);
+    values[BATTERY_PERCENTAGE] = battery_percentage(ctx);
+}
+
+const sensor_driver_t battery_sensor = {
+    .name = "Battery",
+    .channels = battery_channels,
+    .channel_count = 3,
+    .raw_size = sizeof(int32_t),
+    .conversion_us = 0,
+    .settle_us = 250000,
+    .init = battery_sensor_init,
+    .start = battery_sensor_start,
+    .read = battery_sensor_read,
+    .decode = battery_sensor_decode,
+};
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file sensor_drivers.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Drivers of the on-board sensors for the sensor executor
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SENSOR_DRIVERS_H_
+#define _SENSOR_DRIVERS_H_
+
+#include "driver/gpio.h"
+#include "bmp180.h"
+#include "ds3231.h"
+#include "battery/battery.h"
+#include "sensor_exec.h"
+
+/**
+ * @struct i2c_sensor_t sensor_drivers.h
+ * @brief Device on the I2C bus
+ *
+ * ### Example
+ * ~~~.c
+ * static i2c_sensor_t pressure = {.port = 0, .sda = 21, .scl = 22};
+ * static const sensor_t table[] = {{&bmp180_sensor, &pressure, 1}};
+ * ~~~
+ */
+typedef struct
+{
+    i2c_port_t port; /*!< I2C port */
+    gpio_num_t sda;  /*!< SDA pin */
+    gpio_num_t scl;  /*!< SCL pin */
+    union
+    {
+        bmp180_dev_t bmp180; /*!< BMP180 descriptor */
+        i2c_dev_t ds3231;    /*!< DS3231 descriptor */
+    } dev;
+} i2c_sensor_t;
+
+/*
+ * Raw readings, as captured by the executor's capture hook and replayed on
+ * the host: fixed layouts, the same on the device and the host.
+ */
+
+/* BMP180: temperature (0.01 C), pressure (Pa) */
+enum
+{
+    BMP180_TEMPERATURE = 0,
+    BMP180_PRESSURE = 1,
+};
+typedef struct
+{
+    float temperature; /* C */
+    uint32_t pressure; /* Pa */
+} bmp180_raw_t;
+extern const sensor_driver_t bmp180_sensor;
+
+/* DS3231: date (days since 1970), time of day (s), temperature (0.01 C) */
+enum
+{
+    DS3231_DAY = 0,
+    DS3231_SECOND = 1,
+    DS3231_TEMPERATURE = 2,
+};
+typedef struct
+{
+    int16_t year;      /* calendar time, struct tm differs between C libraries */
+    uint8_t month;     /* 1 to 12 */
+    uint8_t day;       /* 1 to 31 */
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t reserved;
+    float temperature; /* C */
+} ds3231_raw_t;
+extern const sensor_driver_t ds3231_sensor;
+
+/* Battery, ctx is a battery_t: raw adc, voltage (mV), percentage; the raw reading is an int32_t */
+enum
+{
+    BATTERY_RAW = 0,
+    BATTERY_VOLTAGE = 1,
+    BATTERY_PERCENTAGE = 2,
+};
+extern const sensor_driver_t battery_sensor;
+
+#endif
@@ -0,0 +1,199 @@
+/**
+ * @file sensor_exec.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sensor driver interface and the executor that runs every sensor
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every tick, the executor starts all due conversions first and waits once
+ * for the slowest, so conversions overlap instead of adding up. Then it
+ * reads and decodes each sensor and emits one sample per sensor. Adding a
+ * sensor is a table entry, with no task, stack or dataTask code of its own.
+ *
+ * The capture hook sees every access with its raw bytes before decode, and
+ * sensor_exec_replay() enters a captured reading at the same point, so a
+ * replay runs the drivers' decode and everything after it unchanged.
+ */
+
+#include <string.h>
+#include "sensor_exec.h"
+
+/**
+ * @brief Initialize every sensor of the table
+ *
+ * Sensors whose init() fails are disabled, the others keep running. No
+ * waiting here: settling sensors are skipped by ticks until ready.
+ *
+ * @param exec  pointer to executor
+ * @return int number of enabled sensors, -1 if the table is too large
+ */
+int sensor_exec_init(sensor_exec_t *const exec)
+{
+    int enabled = 0;
+
+    if (exec->count > SENSOR_MAX_SENSORS)
+    {
+        return -1;
+    }
+    for (uint8_t i = 0; i < exec->count; i++)
+    {
+        const sensor_t *sensor = &exec->sensors[i];
+        sensor_status_t *status = &exec->status[i];
+
+        memset(status, 0, sizeof(*status));
+        stats_reset(&status->latency);
+        status->enabled = sensor->driver->channel_count <= SENSOR_MAX_CHANNELS &&
+                          sensor->driver->raw_size <= SENSOR_RAW_MAX &&
+                          (sensor->driver->init == NULL || sensor->driver->init(sensor->ctx) == 0);
+        status->ready_us = exec->now_us(exec->arg) + sensor->driver->settle_us;
+        enabled += status->enabled;
+    }
+    return enabled;
+}
+
+/**
+ * @brief Pass one access to the capture hook, if any
+ */
+static void sensor_exec_capture(sensor_exec_t *const exec, uint8_t index, sensor_capture_result_t result,
+                                uint32_t seq, int64_t tick_us, int64_t latency_us, const void *raw)
+{
+    if (exec->capture == NULL)
+    {
+        return;
+    }
+    sensor_capture_t capture = {
+        .sensor = index,
+        .result = (uint8_t)result,
+        .size = result == SENSOR_CAPTURE_OK ? exec->sensors[index].driver->raw_size : 0,
+        .seq = seq,
+        .tick_us = tick_us,
+        .latency_us = latency_us > 0 ? (uint32_t)latency_us : 0,
+    };
+    exec->capture(exec->arg, &capture, raw);
+}
+
+/**
+ * @brief Decode a raw reading and emit it as a sample
+ */
+static void sensor_exec_collect(sensor_exec_t *const exec, uint8_t index, uint32_t seq, int64_t tick_us,
+                                int64_t latency_us, const void *raw)
+{
+    const sensor_t *sensor = &exec->sensors[index];
+    sensor_status_t *status = &exec->status[index];
+
+    stats_add(&status->latency, latency_us);
+
+    sensor_sample_t sample = {
+        .sensor = index,
+        .count = sensor->driver->channel_count,
+        .seq = seq,
+        .stamp = tick_us,
+    };
+    sensor->driver->decode(sensor->ctx, raw, sample.value);
+    status->samples++;
+    exec->emit(exec->arg, &sample);
+}
+
+/**
+ * @brief Run one acquisition tick
+ *
+ * @param exec      pointer to executor
+ * @param seq       tick sequence number, stamped on every sample
+ * @param tick_us   tick time, stamped on every sample
+ */
+void sensor_exec_tick(sensor_exec_t *const exec, uint32_t seq, int64_t tick_us)
+{
+    bool due[SENSOR_MAX_SENSORS];
+    uint32_t wait = 0;
+
+    /* Start every due conversion */
+    for (uint8_t i = 0; i < exec->count; i++)
+    {
+        const sensor_t *sensor = &exec->sensors[i];
+        sensor_status_t *status = &exec->status[i];
+
+        due[i] = status->enabled && tick_us >= status->ready_us &&
+                 (sensor->interval <= 1 || seq % sensor->interval == 0);
+        if (!due[i] || sensor->driver->start == NULL)
+        {
+            continue;
+        }
+        if (sensor->driver->start(sensor->ctx) != 0)
+        {
+            status->errors++;
+            due[i] = false;
+            sensor_exec_capture(exec, i, SENSOR_CAPTURE_START_FAILED, seq, tick_us, 0, NULL);
+            continue;
+        }
+        if (sensor->driver->conversion_us > wait)
+        {
+            wait = sensor->driver->conversion_us;
+        }
+    }
+
+    /* Wait once for the slowest conversion */
+    if (wait > 0)
+    {
+        exec->wait_us(exec->arg, wait);
+    }
+
+    /* Collect */
+    for (uint8_t i = 0; i < exec->count; i++)
+    {
+        const sensor_t *sensor = &exec->sensors[i];
+        sensor_status_t *status = &exec->status[i];
+        uint64_t raw[SENSOR_RAW_MAX / sizeof(uint64_t)]; /* aligned for any raw type */
+
+        if (!due[i])
+        {
+            continue;
+        }
+        int result = sensor->driver->read(sensor->ctx, raw);
+        int64_t latency = exec->now_us(exec->arg) - tick_us;
+        if (result != 0)
+        {
+            status->errors++;
+            sensor_exec_capture(exec, i, SENSOR_CAPTURE_READ_FAILED, seq, tick_us, latency, NULL);
+            continue;
+        }
+        sensor_exec_capture(exec, i, SENSOR_CAPTURE_OK, seq, tick_us, latency, raw);
+        sensor_exec_collect(exec, i, seq, tick_us, latency, raw);
+    }
+}
+
+/**
+ * @brief Enter a captured access in place of the device
+ *
+ * Counts a failed access as an error, decodes and emits a reading like a
+ * tick would. Neither init() nor the devices are needed, the status counters
+ * only have to start zeroed. Ticks come from the capture, so the caller
+ * keeps any pacing: replays are as fast as the caller feeds them.
+ *
+ * @param exec      pointer to executor
+ * @param capture   captured access, @see sensor_capture_t
+ * @param raw       capture->size raw bytes, any alignment
+ * @return int 0 on success, -1 if the capture does not fit the sensor table
+ */
+int sensor_exec_replay(sensor_exec_t *const exec, const sensor_capture_t *capture, const void *raw)
+{
+    uint64_t aligned[SENSOR_RAW_MAX / sizeof(uint64_t)];
+
+    if (capture->sensor >= exec->count)
+    {
+        return -1;
+    }
+    if (capture->result != SENSOR_CAPTURE_OK)
+    {
+        exec->status[capture->sensor].errors++;
+        return 0;
+    }
+    if (capture->size != exec->sensors[capture->sensor].driver->raw_size)
+    {
+        return -1;
+    }
+    memcpy(aligned, raw, capture->size);
+    sensor_exec_collect(exec, capture->sensor, capture->seq, capture->tick_us, capture->latency_us, aligned);
+    return 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file sensor_exec.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sensor driver interface and the executor that runs every sensor
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SENSOR_EXEC_H_
+#define _SENSOR_EXEC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "stats/stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SENSOR_MAX_CHANNELS 4 /*!< Values per sample */
+#define SENSOR_MAX_SENSORS 8  /*!< Sensors per executor */
+#define SENSOR_RAW_MAX 40     /*!< Largest raw reading in bytes, 8-byte multiple, fits a capture frame */
+
+/**
+ * @struct sensor_channel_t sensor_exec.h
+ * @brief One value produced by a sensor
+ *
+ * Values are integers, physical value = value / scale.
+ */
+typedef struct
+{
+    const char *name; /*!< Channel name */
+    const char *unit; /*!< Physical unit */
+    int32_t scale;    /*!< Counts per unit */
+} sensor_channel_t;
+
+/**
+ * @struct sensor_driver_t sensor_exec.h
+ * @brief Driver callbacks, shared by every instance of a sensor type
+ *
+ * Callbacks return 0 on success, -1 on failure. start() is optional, it
+ * triggers a conversion that read() collects conversion_us later; drivers
+ * that convert inside read() leave it NULL. init() must not wait for the
+ * device to settle: settle_us holds the sensor out of ticks for that long
+ * after init() while the other sensors already run.
+ *
+ * ### Example
+ * ~~~.c
+ * static const sensor_channel_t sht3x_channels[] = {
+ *      {"temperature", "C", 100},
+ *      {"humidity", "%", 100},
+ * };
+ * const sensor_driver_t sht3x_driver = {
+ *      .name = "SHT3x",
+ *      .channels = sht3x_channels,
+ *      .channel_count = 2,
+ *      .raw_size = sizeof(float) * 2,
+ *      .conversion_us = 15000,
+ *      .init = sht3x_sensor_init,
+ *      .start = sht3x_sensor_start,
+ *      .read = sht3x_sensor_read,
+ *      .decode = sht3x_sensor_decode,
+ * };
+ * ~~~
+ */
+typedef struct
+{
+    const char *name;                                          /*!< Sensor name */
+    const sensor_channel_t *channels;                          /*!< Channel descriptors */
+    uint8_t channel_count;                                     /*!< Number of channels */
+    uint8_t raw_size;                                          /*!< Raw reading size, at most SENSOR_RAW_MAX */
+    uint32_t conversion_us;                                    /*!< Time from start() to read() */
+    uint32_t settle_us;                                        /*!< Time from init() to the first start() */
+    int (*init)(void *ctx);                                    /*!< Configure the device */
+    int (*start)(void *ctx);                                   /*!< Trigger a conversion, may be NULL */
+    int (*read)(void *ctx, void *raw);                         /*!< Fetch a raw reading */
+    void (*decode)(void *ctx, const void *raw, int32_t *values); /*!< Raw reading to channel values */
+} sensor_driver_t;
+
+/**
+ * @struct sensor_t sensor_exec.h
+ * @brief One registered sensor
+ */
+typedef struct
+{
+    const sensor_driver_t *driver; /*!< Driver */
+    void *ctx;                     /*!< Device instance passed to the callbacks */
+    uint16_t interval;             /*!< Read every interval ticks, 0 or 1 for every tick */
+} sensor_t;
+
+/**
+ * @struct sensor_sample_t sensor_exec.h
+ * @brief Decoded reading of one sensor at one tick
+ */
+typedef struct
+{
+    uint8_t sensor;                      /*!< Index in the sensor table */
+    uint8_t count;                       /*!< Number of values */
+    uint16_t merged;                     /*!< Later samples averaged into this one, saturates at UINT16_MAX, @see CHANNEL_COALESCE */
+    uint32_t seq;                        /*!< Tick sequence number */
+    int64_t stamp;                       /*!< Tick time in us */
+    int32_t value[SENSOR_MAX_CHANNELS];  /*!< Channel values */
+} sensor_sample_t;
+
+/**
+ * @struct sensor_status_t sensor_exec.h
+ * @brief Per sensor counters
+ */
+typedef struct
+{
+    bool enabled;    /*!< init() succeeded */
+    int64_t ready_us; /*!< First tick time the sensor is read, init() plus settle_us */
+    uint32_t samples; /*!< Samples emitted */
+    uint32_t errors;  /*!< Failed start() or read() */
+    stats_t latency;  /*!< Tick to read complete in us */
+} sensor_status_t;
+
+/**
+ * @enum sensor_capture_result_t sensor_exec.h
+ * @brief Outcome of a captured sensor access
+ */
+typedef enum
+{
+    SENSOR_CAPTURE_OK = 0,           /*!< Raw reading follows */
+    SENSOR_CAPTURE_START_FAILED = 1, /*!< start() failed, no reading */
+    SENSOR_CAPTURE_READ_FAILED = 2,  /*!< read() failed, no reading */
+} sensor_capture_result_t;
+
+/**
+ * @struct sensor_capture_t sensor_exec.h
+ * @brief One access to a due sensor, followed by size raw bytes
+ *
+ * Passed to the capture hook for every start() and read() of a tick, the
+ * failed ones included, and fed back by sensor_exec_replay(). Packed and
+ * little endian: a capture file is these records back to back, see
+ * tools/replay. Raw readings must have the same layout on every target to
+ * replay, no struct tm or pointers.
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      uint8_t sensor;
+ *      uint8_t result;
+ *      uint8_t size;
+ *      uint8_t reserved;
+ *      uint32_t seq;
+ *      int64_t tick_us;
+ *      uint32_t latency_us;
+ * }sensor_capture_t;
+ * ~~~
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t sensor;      /*!< Index in the sensor table */
+    uint8_t result;      /*!< sensor_capture_result_t */
+    uint8_t size;        /*!< Raw bytes that follow, raw_size on success, else 0 */
+    uint8_t reserved;    /*!< 0 */
+    uint32_t seq;        /*!< Tick sequence number */
+    int64_t tick_us;     /*!< Tick time */
+    uint32_t latency_us; /*!< Tick to read complete, 0 after a failed start() */
+} sensor_capture_t;
+
+#ifdef __cplusplus
+static_assert(sizeof(sensor_capture_t) == 20, "sensor_capture_t is a file format");
+#else
+_Static_assert(sizeof(sensor_capture_t) == 20, "sensor_capture_t is a file format");
+#endif
+
+/**
+ * @struct sensor_exec_t sensor_exec.h
+ * @brief Executor, runs all sensors from one task
+ *
+ * ### Example
+ * ~~~.c
+ * sensor_exec_t exec = {
+ *      .sensors = table,
+ *      .count = 2,
+ *      .emit = on_sample,
+ *      .wait_us = delay_us,
+ *      .now_us = clock_us,
+ * };
+ * sensor_exec_init(&exec);
+ * sensor_exec_tick(&exec, seq, tick_us);
+ * ~~~
+ */
+typedef struct
+{
+    const sensor_t *sensors;                                   /*!< Sensor table */
+    uint8_t count;                                             /*!< Number of sensors */
+    void (*emit)(void *arg, const sensor_sample_t *sample);    /*!< Sample output */
+    void (*wait_us)(void *arg, uint32_t us);                   /*!< Sleep for conversions */
+    int64_t (*now_us)(void *arg);                              /*!< Monotonic clock */
+    void (*capture)(void *arg, const sensor_capture_t *capture, const void *raw); /*!< Raw reading tap, may be NULL */
+    void *arg;                                                 /*!< Passed to emit, wait_us, now_us and capture */
+    sensor_status_t status[SENSOR_MAX_SENSORS];                /*!< Per sensor counters */
+} sensor_exec_t;
+
+int sensor_exec_init(sensor_exec_t *const exec);
+
+void sensor_exec_tick(sensor_exec_t *const exec, uint32_t seq, int64_t tick_us);
+
+int sensor_exec_replay(sensor_exec_t *const exec, const sensor_capture_t *capture, const void *raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
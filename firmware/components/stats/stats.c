@@ -0,0 +1,73 @@
+/**
+ * @file stats.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Running min/max/mean/deviation of integer measurements
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+#include "stats.h"
+
+/**
+ * @brief Clear all samples
+ *
+ * @param stats pointer to stats object
+ */
+void stats_reset(stats_t *const stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+/**
+ * @brief Add one sample
+ *
+ * @param stats pointer to stats object
+ * @param value sample, e.g. a latency in microseconds
+ */
+void stats_add(stats_t *const stats, int64_t value)
+{
+    if (stats->count == 0 || value < stats->min)
+    {
+        stats->min = value;
+    }
+    if (stats->count == 0 || value > stats->max)
+    {
+        stats->max = value;
+    }
+    stats->count++;
+    stats->sum += value;
+    stats->sum_sq += (double)value * (double)value;
+}
+
+/**
+ * @brief Mean of all samples
+ *
+ * @param stats pointer to stats object
+ * @return int64_t mean, 0 without samples
+ */
+int64_t stats_mean(const stats_t *const stats)
+{
+    return stats->count ? stats->sum / (int64_t)stats->count : 0;
+}
+
+/**
+ * @brief Population standard deviation of all samples
+ *
+ * @param stats pointer to stats object
+ * @return int64_t standard deviation, 0 without samples
+ */
+int64_t stats_stddev(const stats_t *const stats)
+{
+    if (stats->count == 0)
+    {
+        return 0;
+    }
+    double mean = (double)stats->sum / stats->count;
+    double var = stats->sum_sq / stats->count - mean * mean;
+    return var > 0.0 ? (int64_t)sqrt(var) : 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file stats.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Running min/max/mean/deviation of integer measurements
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STATS_H_
+#define _STATS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct stats_t stats.h
+ * @brief Running statistics, O(1) per sample
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      uint32_t count;
+ *      int64_t min;
+ *      int64_t max;
+ *      int64_t sum;
+ *      double sum_sq;
+ * }stats_t;
+ * ~~~
+ */
+typedef struct
+{
+    uint32_t count; /*!< Number of samples */
+    int64_t min;    /*!< Smallest sample */
+    int64_t max;    /*!< Largest sample */
+    int64_t sum;    /*!< Sum of samples */
+    double sum_sq;  /*!< Sum of squared samples */
+} stats_t;
+
+void stats_reset(stats_t *const stats);
+
+void stats_add(stats_t *const stats, int64_t value);
+
+int64_t stats_mean(const stats_t *const stats);
+
+int64_t stats_stddev(const stats_t *const stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
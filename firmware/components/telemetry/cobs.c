@@ -0,0 +1,89 @@
+/**
+ * @file cobs.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Consistent Overhead Byte Stuffing
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "cobs.h"
+
+/**
+ * @brief Encode a buffer, the output contains no 0x00 byte
+ *
+ * @param src   source buffer
+ * @param len   number of source bytes
+ * @param dst   destination, at least COBS_MAX_ENCODED(len) bytes
+ * @return size_t encoded length
+ */
+size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t code_pos = 0; /* position of the current code byte */
+    size_t out = 1;      /* next output position */
+    uint8_t code = 1;    /* distance to the next zero */
+
+    for (size_t i = 0; i < len; i++)
+    {
+        if (src[i] == 0)
+        {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+        else
+        {
+            dst[out++] = src[i];
+            code++;
+            /* Block full: 254 data bytes without a zero */
+            if (code == 0xFF)
+            {
+                dst[code_pos] = code;
+                code_pos = out++;
+                code = 1;
+            }
+        }
+    }
+    dst[code_pos] = code;
+    return out;
+}
+
+/**
+ * @brief Decode a buffer (delimiter already stripped)
+ *
+ * @param src   encoded buffer
+ * @param len   number of encoded bytes
+ * @param dst   destination, at least @p len bytes. May alias @p src.
+ * @return int  decoded length, -1 if the input is malformed
+ */
+int cobs_decode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < len)
+    {
+        uint8_t code = src[in++];
+        if (code == 0 || in + code - 1 > len)
+        {
+            return -1;
+        }
+        for (uint8_t i = 1; i < code; i++)
+        {
+            uint8_t b = src[in++];
+            if (b == 0)
+            {
+                return -1;
+            }
+            dst[out++] = b;
+        }
+        /* A zero follows every block except a full one and the last one */
+        if (code != 0xFF && in < len)
+        {
+            dst[out++] = 0;
+        }
+    }
+    return (int)out;
+}
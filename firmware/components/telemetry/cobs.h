@@ -0,0 +1,34 @@
+/**
+ * @file cobs.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Consistent Overhead Byte Stuffing
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _COBS_H_
+#define _COBS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Worst case encoded size of @p len bytes (without the 0x00 delimiter)
+ */
+#define COBS_MAX_ENCODED(len) ((len) + ((len) / 254) + 1)
+
+size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+
+int cobs_decode(const uint8_t *src, size_t len, uint8_t *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file frame.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Telemetry frame encoding: COBS framed record with CRC-32
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+#include "frame.h"
+#include "crc/crc32.h"
+
+/**
+ * @brief Encode one frame
+ *
+ * @param type      record type
+ * @param seq       frame sequence number
+ * @param payload   payload bytes
+ * @param len       payload length, at most FRAME_MAX_PAYLOAD
+ * @param out       destination, at least FRAME_MAX_ENCODED bytes
+ * @return size_t   encoded length, 0 if @p len is too large
+ */
+size_t frame_encode(uint8_t type, uint8_t seq, const void *payload, size_t len, uint8_t *out)
+{
+    uint8_t raw[FRAME_MAX_PAYLOAD + FRAME_OVERHEAD];
+
+    if (len > FRAME_MAX_PAYLOAD)
+    {
+        return 0;
+    }
+
+    /* Build raw frame */
+    raw[0] = type;
+    raw[1] = seq;
+    memcpy(&raw[2], payload, len);
+    return frame_seal(raw, len, out);
+}
+
+/**
+ * @brief Encode a frame already laid out in place, for payloads of any size
+ *
+ * Saves a copy of large payloads: the caller builds type, seq and payload
+ * in @p raw and leaves 4 spare bytes after it for the CRC.
+ *
+ * @param raw       type, seq, @p len payload bytes, then 4 spare bytes
+ * @param len       payload length
+ * @param out       destination, at least FRAME_ENCODED_SIZE(len) bytes
+ * @return size_t   encoded length
+ */
+size_t frame_seal(uint8_t *raw, size_t len, uint8_t *out)
+{
+    uint32_t crc = crc32_update(0, raw, len + 2);
+    raw[len + 2] = (uint8_t)crc;
+    raw[len + 3] = (uint8_t)(crc >> 8);
+    raw[len + 4] = (uint8_t)(crc >> 16);
+    raw[len + 5] = (uint8_t)(crc >> 24);
+
+    /* Stuff between two delimiters */
+    out[0] = 0;
+    size_t n = cobs_encode(raw, len + FRAME_OVERHEAD, &out[1]);
+    out[n + 1] = 0;
+    return n + 2;
+}
+
+/**
+ * @brief Decode one frame in place (delimiters already stripped)
+ *
+ * @param buf       encoded bytes, overwritten with the decoded frame
+ * @param len       encoded length
+ * @param type      decoded record type
+ * @param seq       decoded sequence number
+ * @param payload   set to the payload inside @p buf
+ * @return int      payload length, -1 on COBS or CRC error
+ */
+int frame_decode(uint8_t *buf, size_t len, uint8_t *type, uint8_t *seq, const uint8_t **payload)
+{
+    int n = cobs_decode(buf, len, buf);
+    if (n < FRAME_OVERHEAD)
+    {
+        return -1;
+    }
+
+    uint32_t crc = (uint32_t)buf[n - 4] | ((uint32_t)buf[n - 3] << 8) |
+                   ((uint32_t)buf[n - 2] << 16) | ((uint32_t)buf[n - 1] << 24);
+    if (crc32_update(0, buf, (size_t)n - 4) != crc)
+    {
+        return -1;
+    }
+
+    *type = buf[0];
+    *seq = buf[1];
+    *payload = &buf[2];
+    return n - FRAME_OVERHEAD;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file frame.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Telemetry frame encoding: COBS framed record with CRC-32
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Wire format:
+ * ~~~
+ * 0x00 | COBS( type | seq | payload[0..n) | crc32 (LE) ) | 0x00
+ * ~~~
+ * The CRC covers type, seq and payload. The leading delimiter resynchronizes
+ * the host decoder when console text shares the same port.
+ */
+#ifndef _FRAME_H_
+#define _FRAME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cobs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FRAME_MAX_PAYLOAD 64 /*!< Largest payload in bytes */
+#define FRAME_OVERHEAD 6     /*!< type + seq + crc32 */
+
+/**
+ * @brief Encoded size of a frame with @p len payload bytes, both delimiters included
+ */
+#define FRAME_ENCODED_SIZE(len) (COBS_MAX_ENCODED((len) + FRAME_OVERHEAD) + 2)
+
+/**
+ * @brief Largest encoded frame including both delimiters
+ */
+#define FRAME_MAX_ENCODED FRAME_ENCODED_SIZE(FRAME_MAX_PAYLOAD)
+
+size_t frame_encode(uint8_t type, uint8_t seq, const void *payload, size_t len, uint8_t *out);
+
+size_t frame_seal(uint8_t *raw, size_t len, uint8_t *out);
+
+int frame_decode(uint8_t *buf, size_t len, uint8_t *type, uint8_t *seq, const uint8_t **payload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
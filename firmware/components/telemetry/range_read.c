@@ -0,0 +1,351 @@
+/**
+ * @file range_read.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Log range reads over the telemetry link, served from the card
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Blocks are sent exactly as stored, each in a frame of its own with its
+ * block number, so the host can check the frame CRC, spot a missing chunk
+ * by its number and ask again from there. Nothing is buffered beyond the
+ * frame being sent: one block is read from the store per frame, and the
+ * store is only touched from the caller of range_read_feed() and
+ * range_read_poll(), never from the logger writer.
+ */
+
+#include <string.h>
+#include "range_read.h"
+#include "frame.h"
+
+/* Operation in progress */
+enum
+{
+    RANGE_IDLE,    /* Nothing to send */
+    RANGE_LISTING, /* Sending a RANGE_SEGMENT per segment */
+    RANGE_OPENING, /* Sending the opening RANGE_SPAN */
+    RANGE_SENDING, /* Sending RANGE_CHUNK frames */
+    RANGE_CLOSING, /* Sending the closing RANGE_SPAN */
+};
+
+/**
+ * @brief Block read into the chunk slot of tx, reused as scratch while searching
+ */
+static log_block_t *range_read_block(range_read_t *range)
+{
+    return (log_block_t *)&range->tx[2 + offsetof(range_chunk_t, data)];
+}
+
+/**
+ * @brief Read a block, false if the read failed or the block is torn
+ */
+static bool range_read_intact(range_read_t *range, uint32_t block)
+{
+    log_block_t *scratch = range_read_block(range);
+    return range->store.read(range->store.ctx, range->segment, block, scratch) == 0 && log_block_verify(scratch);
+}
+
+/**
+ * @brief First block whose records reach a time
+ *
+ * Blocks of a segment are in time order. A torn block is searched past to
+ * the next intact one; a run of torn blocks moves the result before them,
+ * so they are sent rather than skipped.
+ *
+ * @return uint32_t block, range->end when every block is older
+ */
+static uint32_t range_read_seek(range_read_t *range, int64_t from_us)
+{
+    uint32_t low = 0;
+    uint32_t high = range->end;
+
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        uint32_t probe = mid;
+        while (probe < high && !range_read_intact(range, probe))
+        {
+            probe++;
+        }
+        if (probe < high && range_read_block(range)->header.last_us < from_us)
+        {
+            low = probe + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Stop the operation in progress with a closing span
+ */
+static void range_read_close(range_read_t *range, range_status_t status)
+{
+    range->state = RANGE_CLOSING;
+    range->status = (uint8_t)status;
+    range->pending = false;
+}
+
+/**
+ * @brief Start a read
+ */
+static void range_read_start(range_read_t *range, const range_request_t *request)
+{
+    char name[RANGE_NAME_MAX];
+
+    range->segment = request->segment;
+    range->first = 0;
+    range->next = 0;
+    if (range->store.segment(range->store.ctx, request->segment, name, sizeof(name), &range->end) != 0)
+    {
+        range_read_close(range, RANGE_NO_SEGMENT);
+        return;
+    }
+
+    if (request->resume > 0)
+    {
+        range->first = request->resume < range->end ? request->resume : range->end;
+    }
+    else if (request->from_us != INT64_MIN)
+    {
+        range->first = range_read_seek(range, request->from_us);
+    }
+    range->next = range->first;
+    range->to_us = request->to_us;
+    range->state = RANGE_OPENING;
+    range->pending = false;
+}
+
+/**
+ * @brief Act on one decoded request
+ */
+static void range_read_request(range_read_t *range, uint8_t type, const uint8_t *payload, int len)
+{
+    range_request_t request;
+
+    switch (type)
+    {
+    case RANGE_LIST:
+        range->segment = 0;
+        range->state = RANGE_LISTING;
+        range->pending = false;
+        break;
+    case RANGE_READ:
+        if (len != sizeof(request))
+        {
+            range->stats.bad_frames++;
+            return;
+        }
+        memcpy(&request, payload, sizeof(request));
+        range_read_start(range, &request);
+        break;
+    case RANGE_ABORT:
+        /* Answered even when idle, the host waits for the span to resynchronize */
+        range_read_close(range, RANGE_ABORTED);
+        break;
+    default:
+        range->stats.bad_frames++;
+        return;
+    }
+    range->stats.requests++;
+}
+
+/**
+ * @brief Build the next frame in tx
+ *
+ * @return bool false when there is nothing more to send
+ */
+static bool range_read_build(range_read_t *range)
+{
+    uint8_t *payload = &range->tx[2];
+
+    if (range->state == RANGE_LISTING)
+    {
+        range_segment_t segment = {.index = range->segment};
+        uint32_t blocks;
+        if (range->store.segment(range->store.ctx, range->segment, segment.name, sizeof(segment.name), &blocks) != 0)
+        {
+            /* Past the last one: the closing span gives the count */
+            range->first = 0;
+            range->next = 0;
+            range_read_close(range, RANGE_DONE);
+        }
+        else
+        {
+            segment.blocks = blocks;
+
+            /* Times of the first and last intact blocks, the last ones may be unwritten or torn */
+            for (uint32_t i = 0; i < blocks && i < RANGE_PROBE_MAX; i++)
+            {
+                if (range_read_intact(range, i))
+                {
+                    segment.first_us = range_read_block(range)->header.first_us;
+                    break;
+                }
+            }
+            for (uint32_t i = 0; i < blocks && i < RANGE_PROBE_MAX; i++)
+            {
+                if (range_read_intact(range, blocks - 1 - i))
+                {
+                    segment.last_us = range_read_block(range)->header.last_us;
+                    break;
+                }
+            }
+            range->tx[0] = RANGE_SEGMENT;
+            range->tx_len = sizeof(segment);
+            memcpy(payload, &segment, sizeof(segment));
+            return true;
+        }
+    }
+
+    if (range->state == RANGE_SENDING)
+    {
+        if (range->next >= range->end)
+        {
+            range_read_close(range, RANGE_DONE);
+        }
+        else if (range->store.read(range->store.ctx, range->segment, range->next, range_read_block(range)) != 0)
+        {
+            range_read_close(range, RANGE_READ_ERROR);
+        }
+        else if (log_block_verify(range_read_block(range)) && range_read_block(range)->header.first_us > range->to_us)
+        {
+            range_read_close(range, RANGE_DONE);
+        }
+        else
+        {
+            range->tx[0] = RANGE_CHUNK;
+            range->tx_len = sizeof(range_chunk_t);
+            memcpy(payload, &range->next, sizeof(range->next));
+            return true;
+        }
+    }
+
+    if (range->state == RANGE_OPENING || range->state == RANGE_CLOSING)
+    {
+        range_span_t span = {
+            .segment = range->segment,
+            .status = range->state == RANGE_OPENING ? RANGE_STARTED : range->status,
+            .first = range->first,
+            .next = range->state == RANGE_OPENING ? range->end : range->next,
+        };
+        range->tx[0] = RANGE_SPAN;
+        range->tx_len = sizeof(span);
+        memcpy(payload, &span, sizeof(span));
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Reset the service, store and send set
+ *
+ * @param range pointer to service
+ */
+void range_read_init(range_read_t *range)
+{
+    range->state = RANGE_IDLE;
+    range->pending = false;
+    range->rx_len = 0;
+    range->rx_skip = false;
+    range->stats = (range_stats_t){0};
+}
+
+/**
+ * @brief Take bytes received from the host, requests act at once
+ *
+ * A read request searches its start here, a few block reads.
+ *
+ * @param range pointer to service
+ * @param data  received bytes, any split
+ * @param len   number of bytes
+ */
+void range_read_feed(range_read_t *range, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (data[i] != 0)
+        {
+            if (range->rx_len < sizeof(range->rx))
+            {
+                range->rx[range->rx_len++] = data[i];
+            }
+            else
+            {
+                range->rx_skip = true;
+            }
+            continue;
+        }
+
+        /* Delimiter: decode what came before it */
+        if (range->rx_len > 0)
+        {
+            uint8_t type;
+            uint8_t seq;
+            const uint8_t *payload;
+            int n = range->rx_skip ? -1 : frame_decode(range->rx, range->rx_len, &type, &seq, &payload);
+            if (n < 0)
+            {
+                range->stats.bad_frames++;
+            }
+            else
+            {
+                range_read_request(range, type, payload, n);
+            }
+        }
+        range->rx_len = 0;
+        range->rx_skip = false;
+    }
+}
+
+/**
+ * @brief Send the next frame of the operation in progress
+ *
+ * @param range pointer to service
+ * @return true     more to send, poll again without waiting
+ * @return false    idle
+ */
+bool range_read_poll(range_read_t *range)
+{
+    if (!range->pending)
+    {
+        if (!range_read_build(range))
+        {
+            range->state = RANGE_IDLE;
+            return false;
+        }
+        range->pending = true;
+    }
+
+    if (!range->send(range->send_ctx, range->tx, range->tx_len))
+    {
+        range->stats.retries++;
+        return true;
+    }
+    range->pending = false;
+
+    /* Sent: move on */
+    switch (range->state)
+    {
+    case RANGE_LISTING:
+        range->segment++;
+        break;
+    case RANGE_OPENING:
+        range->state = RANGE_SENDING;
+        break;
+    case RANGE_SENDING:
+        range->next++;
+        range->stats.chunks++;
+        break;
+    case RANGE_CLOSING:
+        range->state = RANGE_IDLE;
+        break;
+    default:
+        break;
+    }
+    return range->state != RANGE_IDLE;
+}
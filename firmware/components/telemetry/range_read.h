@@ -0,0 +1,206 @@
+/**
+ * @file range_read.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Log range reads over the telemetry link, served from the card
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Requests come from the host as frames of the telemetry format, see
+ * frame.h, replies go out on the telemetry stream:
+ * ~~~
+ * host                        device
+ * RANGE_LIST          ->      RANGE_SEGMENT per segment, RANGE_SPAN
+ * RANGE_READ          ->      RANGE_SPAN, RANGE_CHUNK per block, RANGE_SPAN
+ * RANGE_ABORT         ->      RANGE_SPAN, status RANGE_ABORTED
+ * ~~~
+ * A new request replaces the one in progress. Decoded by tools/range.py.
+ */
+#ifndef _RANGE_READ_H_
+#define _RANGE_READ_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "logfmt/log_block.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RANGE_NAME_MAX 24 /*!< Segment name bytes, zero padded */
+#define RANGE_RX_MAX 64   /*!< Longest encoded request */
+#define RANGE_PROBE_MAX 8 /*!< Blocks tried at each end of a segment for its times */
+
+/**
+ * @enum range_type_t range_read.h
+ * @brief Frame types, replies share the numbering of telemetry_type_t
+ */
+typedef enum
+{
+    RANGE_SEGMENT = 6,  /*!< Device: range_segment_t */
+    RANGE_SPAN = 7,     /*!< Device: range_span_t, before and after the chunks of a read, after a list */
+    RANGE_CHUNK = 8,    /*!< Device: range_chunk_t */
+    RANGE_LIST = 0x81,  /*!< Host: no payload */
+    RANGE_READ = 0x82,  /*!< Host: range_request_t */
+    RANGE_ABORT = 0x83, /*!< Host: no payload */
+} range_type_t;
+
+/**
+ * @enum range_status_t range_read.h
+ * @brief Outcome in a closing RANGE_SPAN
+ */
+typedef enum
+{
+    RANGE_STARTED = 0,    /*!< Opening span, chunks follow */
+    RANGE_DONE = 1,       /*!< Every block up to the range end was sent */
+    RANGE_ABORTED = 2,    /*!< Stopped by RANGE_ABORT */
+    RANGE_NO_SEGMENT = 3, /*!< No such segment */
+    RANGE_READ_ERROR = 4, /*!< Card read failed, next is the block that failed */
+} range_status_t;
+
+/**
+ * @struct range_segment_t range_read.h
+ * @brief One log file, little endian
+ *
+ * Times come from the first and last intact blocks, 0 when none was found.
+ */
+typedef struct __attribute__((packed))
+{
+    uint16_t index;            /*!< Segment number */
+    uint32_t blocks;           /*!< Blocks in the segment */
+    int64_t first_us;          /*!< Time of its first record */
+    int64_t last_us;           /*!< Time of its last record */
+    char name[RANGE_NAME_MAX]; /*!< Path on the card, zero padded */
+} range_segment_t;
+
+/**
+ * @struct range_request_t range_read.h
+ * @brief RANGE_READ payload, little endian
+ *
+ * The read starts at the first block whose records reach from_us, found by
+ * a binary search over block headers, and ends after the last block that
+ * starts by to_us. A resumed read gives the block to continue from instead
+ * and skips the search.
+ */
+typedef struct __attribute__((packed))
+{
+    uint16_t segment; /*!< Segment number */
+    uint32_t resume;  /*!< Block to continue from, 0 to search from_us */
+    int64_t from_us;  /*!< Range start, INT64_MIN for the whole segment */
+    int64_t to_us;    /*!< Range end, INT64_MAX for the whole segment */
+} range_request_t;
+
+/**
+ * @struct range_span_t range_read.h
+ * @brief RANGE_SPAN payload, little endian
+ */
+typedef struct __attribute__((packed))
+{
+    uint16_t segment; /*!< Segment number, segments listed after RANGE_LIST */
+    uint8_t status;   /*!< range_status_t */
+    uint32_t first;   /*!< First block of the read */
+    uint32_t next;    /*!< Opening: blocks in the segment; closing: one past the last block sent */
+} range_span_t;
+
+/**
+ * @struct range_chunk_t range_read.h
+ * @brief RANGE_CHUNK payload: one block exactly as stored
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t block;   /*!< Block number in the segment */
+    log_block_t data; /*!< Block, check it with log_block_verify() */
+} range_chunk_t;
+
+/**
+ * @struct range_store_t range_read.h
+ * @brief Segments to serve
+ *
+ * Callbacks return 0 on success, -1 on failure.
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      void *ctx;
+ *      int (*segment)(void *ctx, uint16_t index, char *name, size_t size, uint32_t *blocks);
+ *      int (*read)(void *ctx, uint16_t index, uint32_t block, log_block_t *dst);
+ * }range_store_t;
+ * ~~~
+ */
+typedef struct
+{
+    void *ctx;                                                                            /*!< Store state */
+    int (*segment)(void *ctx, uint16_t index, char *name, size_t size, uint32_t *blocks); /*!< Name and size */
+    int (*read)(void *ctx, uint16_t index, uint32_t block, log_block_t *dst);             /*!< One block */
+} range_store_t;
+
+/**
+ * @struct range_stats_t range_read.h
+ * @brief Service counters
+ */
+typedef struct
+{
+    uint32_t requests;   /*!< Requests decoded */
+    uint32_t bad_frames; /*!< Received frames dropped: CRC, length or type */
+    uint32_t chunks;     /*!< Blocks sent */
+    uint32_t retries;    /*!< Times send() refused a frame */
+} range_stats_t;
+
+/**
+ * @struct range_read_t range_read.h
+ * @brief Range read service
+ *
+ * send() gets a raw frame: type, a seq slot to fill, len payload bytes and
+ * 4 spare bytes, @see frame_seal(). It may refuse a frame when the link is
+ * busy, the frame is offered again at the next poll. One frame goes out per
+ * range_read_poll(), so requests are read between chunks.
+ *
+ * ### Example
+ * ~~~.c
+ * range_read_t range = {
+ *      .store = {.ctx = &dir, .segment = dirSegment, .read = dirRead},
+ *      .send = rangeSend,
+ * };
+ * range_read_init(&range);
+ * while (1)
+ * {
+ *      int n = telemetry_receive(rx, sizeof(rx), busy ? 0 : pdMS_TO_TICKS(100));
+ *      range_read_feed(&range, rx, n > 0 ? n : 0);
+ *      busy = range_read_poll(&range);
+ * }
+ * ~~~
+ */
+typedef struct
+{
+    range_store_t store;                                /*!< Segments */
+    bool (*send)(void *ctx, uint8_t *raw, size_t len);  /*!< Queue a raw frame */
+    void *send_ctx;                                     /*!< Passed to send() */
+    uint8_t state;                                      /*!< Operation in progress */
+    uint8_t status;                                     /*!< range_status_t of the closing span */
+    bool pending;                                       /*!< tx holds a frame send() refused */
+    size_t tx_len;                                      /*!< Payload bytes in tx */
+    uint16_t segment;                                   /*!< Segment being read or listed */
+    uint32_t first;                                     /*!< First block of the read */
+    uint32_t next;                                      /*!< Next block to send */
+    uint32_t end;                                       /*!< Blocks in the segment at the request */
+    int64_t to_us;                                      /*!< Range end */
+    size_t rx_len;                                      /*!< Bytes in rx */
+    bool rx_skip;                                       /*!< rx overflowed, drop up to the next delimiter */
+    uint8_t rx[RANGE_RX_MAX];                           /*!< Request being received */
+    uint8_t tx[2 + sizeof(range_chunk_t) + 4];          /*!< Frame being sent */
+    range_stats_t stats;                                /*!< Counters */
+} range_read_t;
+
+void range_read_init(range_read_t *range);
+
+void range_read_feed(range_read_t *range, const uint8_t *data, size_t len);
+
+bool range_read_poll(range_read_t *range);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,235 @@
+/**
+ * @file telemetry.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Binary telemetry stream over UART
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Producers encode a frame on their own stack and copy it into a byte ring
+ * buffer without waiting. telemetry_task() is the only writer to the UART
+ * driver, so a slow or disconnected host never stalls acquisition; when the
+ * ring is full the frame is dropped and counted instead.
+ *
+ * Bulk transfers, such as log range reads, are the exception: their sender
+ * waits for room, but only until the ring keeps a reserve free for the
+ * live records, so they fill the link without pushing those out.
+ */
+
+#include <string.h>
+#include "esp_vfs_dev.h"
+#include "freertos/task.h"
+#include "telemetry.h"
+#include "frame.h"
+
+#define TELEMETRY_CHUNK 256 /*!< Largest write handed to the UART driver */
+
+static RingbufHandle_t telemetry_ring = NULL; /* Producer ring buffer */
+static uart_port_t telemetry_port;           /* UART port */
+static uint8_t telemetry_seq;                /* Frame sequence number */
+static uint32_t telemetry_drops;             /* Frames lost to a full ring */
+
+/**
+ * @brief Initialize UART driver and producer ring buffer
+ *
+ * @param config    pointer to telemetry configuration
+ * @return esp_err_t status
+ * @note   Create telemetry_task() afterwards to drain the ring buffer
+ */
+esp_err_t telemetry_init(const telemetry_config_t *config)
+{
+    uart_config_t uart_config = {
+        .baud_rate = config->baudrate,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+    };
+
+    /* Configure port */
+    esp_err_t error = uart_param_config(config->port, &uart_config);
+    if (error != ESP_OK)
+    {
+        return error;
+    }
+
+    /* Install driver with an interrupt fed TX buffer */
+    error = uart_driver_install(config->port, 256, config->uart_buffer, 0, NULL, 0);
+    if (error != ESP_OK)
+    {
+        return error;
+    }
+
+    /* Route console writes through the driver so they never split a frame */
+    if (config->port == CONFIG_ESP_CONSOLE_UART_NUM)
+    {
+        esp_vfs_dev_uart_use_driver(config->port);
+    }
+
+    /* Ring buffer from caller storage when provided */
+    if (config->ring_storage != NULL && config->ring_buffer != NULL)
+    {
+        telemetry_ring = xRingbufferCreateStatic(config->ring_size, RINGBUF_TYPE_BYTEBUF,
+                                                 config->ring_storage, config->ring_buffer);
+    }
+    else
+    {
+        telemetry_ring = xRingbufferCreate(config->ring_size, RINGBUF_TYPE_BYTEBUF);
+    }
+    if (telemetry_ring == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    telemetry_port = config->port;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Queue a record for transmission, never blocks
+ *
+ * @param type      record type @see telemetry_type_t
+ * @param payload   payload bytes
+ * @param len       payload length, at most FRAME_MAX_PAYLOAD
+ * @return true     frame queued
+ * @return false    ring buffer full or not initialized, frame dropped
+ */
+bool telemetry_send(telemetry_type_t type, const void *payload, size_t len)
+{
+    uint8_t frame[FRAME_MAX_ENCODED];
+
+    if (telemetry_ring == NULL)
+    {
+        return false;
+    }
+
+    uint8_t seq = __atomic_fetch_add(&telemetry_seq, 1, __ATOMIC_RELAXED);
+    size_t n = frame_encode((uint8_t)type, seq, payload, len, frame);
+
+    /* Whole frame or nothing */
+    if (n == 0 || xRingbufferSend(telemetry_ring, frame, n, 0) != pdTRUE)
+    {
+        __atomic_fetch_add(&telemetry_drops, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Queue a text record, truncated to FRAME_MAX_PAYLOAD bytes
+ *
+ * @param text  null terminated string
+ * @return bool @see telemetry_send()
+ */
+bool telemetry_text(const char *text)
+{
+    size_t len = strlen(text);
+    if (len > FRAME_MAX_PAYLOAD)
+    {
+        len = FRAME_MAX_PAYLOAD;
+    }
+    return telemetry_send(TELEMETRY_TEXT, text, len);
+}
+
+/**
+ * @brief Queue a large frame built in place, waiting for room
+ *
+ * Returns once the ring has room for the frame with @p reserve bytes left
+ * over, so live records sent meanwhile still fit. Bulk frames are not
+ * counted as dropped, the sender retries them.
+ *
+ * @param raw       type, a seq slot, @p len payload bytes, then 4 spare bytes @see frame_seal()
+ * @param len       payload length, at most TELEMETRY_BULK_MAX
+ * @param reserve   ring bytes to leave free for telemetry_send()
+ * @param wait      ticks to wait for room
+ * @return true     frame queued
+ * @return false    no room in time, too large or not initialized
+ */
+bool telemetry_send_bulk(uint8_t *raw, size_t len, size_t reserve, TickType_t wait)
+{
+    uint8_t frame[FRAME_ENCODED_SIZE(TELEMETRY_BULK_MAX)];
+
+    if (telemetry_ring == NULL || len > TELEMETRY_BULK_MAX)
+    {
+        return false;
+    }
+
+    /* Room for the worst case encoding, polled: the ring has no free space event */
+    TickType_t start = xTaskGetTickCount();
+    size_t need = FRAME_ENCODED_SIZE(len) + reserve;
+    while (xRingbufferGetCurFreeSize(telemetry_ring) < need)
+    {
+        if (xTaskGetTickCount() - start >= wait)
+        {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+
+    /* Sequence number only once the frame will go out, the host counts gaps as lost */
+    raw[1] = __atomic_fetch_add(&telemetry_seq, 1, __ATOMIC_RELAXED);
+    size_t n = frame_seal(raw, len, frame);
+    return xRingbufferSend(telemetry_ring, frame, n, 0) == pdTRUE;
+}
+
+/**
+ * @brief Read bytes the host sent, for request handlers such as range_read_feed()
+ *
+ * @param data  destination
+ * @param size  most bytes to read
+ * @param wait  ticks to wait for the first byte
+ * @return int  bytes read, -1 on error
+ */
+int telemetry_receive(uint8_t *data, size_t size, TickType_t wait)
+{
+    /* uart_read_bytes() waits for all of size, so wait for one byte and take what followed it */
+    int n = uart_read_bytes(telemetry_port, data, 1, wait);
+    if (n <= 0 || size <= 1)
+    {
+        return n;
+    }
+    size_t buffered = 0;
+    uart_get_buffered_data_len(telemetry_port, &buffered);
+    if (buffered > size - 1)
+    {
+        buffered = size - 1;
+    }
+    if (buffered > 0)
+    {
+        int more = uart_read_bytes(telemetry_port, &data[1], buffered, 0);
+        n += more > 0 ? more : 0;
+    }
+    return n;
+}
+
+/**
+ * @brief Number of frames dropped since boot
+ *
+ * @return uint32_t dropped frames
+ */
+uint32_t telemetry_dropped(void)
+{
+    return __atomic_load_n(&telemetry_drops, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Drain the ring buffer into the UART driver
+ *
+ * @param pvParameters unused
+ * @warning Call telemetry_init() before creating this task
+ */
+void telemetry_task(void *pvParameters)
+{
+    while (1)
+    {
+        size_t size = 0;
+        /* Take as many queued bytes as possible in one go */
+        uint8_t *data = xRingbufferReceiveUpTo(telemetry_ring, &size, portMAX_DELAY, TELEMETRY_CHUNK);
+        if (data != NULL)
+        {
+            uart_write_bytes(telemetry_port, (const char *)data, size);
+            vRingbufferReturnItem(telemetry_ring, data);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * @file telemetry.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Binary telemetry stream over UART
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "driver/uart.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/ringbuf.h"
+
+/**
+ * @enum telemetry_type_t telemetry.h
+ * @brief Record types on the telemetry stream, decoded by tools/telemetry.py
+ */
+typedef enum
+{
+    TELEMETRY_SAMPLE = 1,  /*!< log_record_t */
+    TELEMETRY_BATTERY = 2, /*!< telemetry_battery_t */
+    TELEMETRY_TEXT = 3,    /*!< UTF-8 text, not terminated */
+    TELEMETRY_TRACE = 4,   /*!< Trace records, @see trace_ring.h, decoded by tools/trace.py */
+    TELEMETRY_BOOT = 5,    /*!< boot_record_t, one per boot stage, decoded by tools/boot.py */
+    TELEMETRY_SEGMENT = 6, /*!< range_segment_t, log range reads, @see range_read.h, tools/range.py */
+    TELEMETRY_SPAN = 7,    /*!< range_span_t */
+    TELEMETRY_CHUNK = 8,   /*!< range_chunk_t */
+    TELEMETRY_CAPTURE = 9, /*!< sensor_capture_t and raw bytes, @see sensor_exec.h, tools/replay */
+} telemetry_type_t;
+
+/**
+ * @struct telemetry_battery_t telemetry.h
+ * @brief Battery status payload
+ */
+typedef struct __attribute__((packed))
+{
+    uint16_t raw;       /*!< Raw adc value */
+    uint16_t voltage;   /*!< Battery voltage in mV */
+    uint8_t percentage; /*!< Battery percentage */
+} telemetry_battery_t;
+
+/**
+ * @struct telemetry_config_t telemetry.h
+ * @brief Telemetry configuration
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      uart_port_t port;
+ *      int baudrate;
+ *      size_t ring_size;
+ *      size_t uart_buffer;
+ *      uint8_t *ring_storage;
+ *      StaticRingbuffer_t *ring_buffer;
+ * }telemetry_config_t;
+ * ~~~
+ */
+typedef struct
+{
+    uart_port_t port;                /*!< UART port */
+    int baudrate;                    /*!< Baudrate, bit/sec */
+    size_t ring_size;                /*!< Producer ring buffer size in bytes */
+    size_t uart_buffer;              /*!< UART driver TX buffer size in bytes */
+    uint8_t *ring_storage;           /*!< Static ring storage of ring_size bytes, NULL to allocate */
+    StaticRingbuffer_t *ring_buffer; /*!< Static ring control block, NULL to allocate */
+} telemetry_config_t;
+
+#define TELEMETRY_BAUDRATE_DEFAULT 921600 /*!< Default baudrate */
+#define TELEMETRY_BULK_MAX 544            /*!< Largest telemetry_send_bulk() payload, a log block and a small header */
+
+/**
+ * @brief Default configuration: console UART at 921600 baud
+ */
+#define TELEMETRY_CONFIG_DEFAULT()                \
+    {                                             \
+        .port = UART_NUM_0,                       \
+        .baudrate = TELEMETRY_BAUDRATE_DEFAULT,   \
+        .ring_size = 4096,                        \
+        .uart_buffer = 2048,                      \
+        .ring_storage = NULL,                     \
+        .ring_buffer = NULL,                      \
+    }
+
+esp_err_t telemetry_init(const telemetry_config_t *config);
+
+bool telemetry_send(telemetry_type_t type, const void *payload, size_t len);
+
+bool telemetry_text(const char *text);
+
+bool telemetry_send_bulk(uint8_t *raw, size_t len, size_t reserve, TickType_t wait);
+
+int telemetry_receive(uint8_t *data, size_t size, TickType_t wait);
+
+uint32_t telemetry_dropped(void);
+
+void telemetry_task(void *pvParameters);
+
+#endif
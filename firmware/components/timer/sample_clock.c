@@ -0,0 +1,186 @@
+/**
+ * @file sample_clock.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sampling tick schedule on a fixed grid, with a missed tick policy
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every alarm is set to the next grid point, an absolute counter value, so
+ * the period error does not add up and the trigger instant is known before
+ * it happens. A tick is stamped with its grid point: its sensor reads are
+ * timed from the trigger edge, not from whenever a task got to run.
+ *
+ * Ticks are missed in two places. The interrupt can come a period or more
+ * late, while interrupts are held off for a flash write, and the sampling
+ * task can fall a period or more behind. The policy decides both the same
+ * way: serve every tick late (CATCH_UP), the newest only (SKIP), or the
+ * newest only and restart the grid from the late interrupt (RESYNC).
+ */
+
+#include <stddef.h>
+#include "sample_clock.h"
+
+/**
+ * @brief Queue a tick for the sampling task
+ *
+ * @param clock         pointer to clock
+ * @param seq           grid index
+ * @param grid          counter value of the trigger
+ * @param counter       counter value at interrupt entry
+ * @param offset_us     esp_timer time minus counter value
+ */
+static void sample_clock_push(sample_clock_t *const clock, uint32_t seq, uint64_t grid, uint64_t counter,
+                              int64_t offset_us)
+{
+    uint32_t head = clock->head;
+
+    if (head - __atomic_load_n(&clock->tail, __ATOMIC_ACQUIRE) >= SAMPLE_CLOCK_DEPTH)
+    {
+        clock->dropped++;
+        return;
+    }
+    sample_clock_tick_t *tick = &clock->ring[head & (SAMPLE_CLOCK_DEPTH - 1)];
+    tick->seq = seq;
+    /* A grid point within the margin ahead is served now, it is not late */
+    tick->latency_us = counter > grid ? (uint32_t)(counter - grid) : 0;
+    tick->time_us = (int64_t)grid + offset_us;
+    __atomic_store_n(&clock->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Set up a stopped clock
+ *
+ * @param clock     pointer to clock
+ * @param period_us grid spacing
+ * @param policy    missed tick policy
+ */
+void sample_clock_init(sample_clock_t *const clock, uint32_t period_us, sample_clock_policy_t policy)
+{
+    *clock = (sample_clock_t){.period_us = period_us, .policy = policy};
+}
+
+/**
+ * @brief Start the grid with a tick as soon as possible
+ *
+ * @param clock     pointer to clock
+ * @param counter   current counter value
+ * @return uint64_t counter value of the first alarm
+ */
+uint64_t sample_clock_start(sample_clock_t *const clock, uint64_t counter)
+{
+    clock->due = counter + SAMPLE_CLOCK_MARGIN_US;
+    return clock->due;
+}
+
+/**
+ * @brief Change the grid spacing, the next tick comes one new period from now
+ *
+ * A faster rate takes effect at once rather than after the slow tick in
+ * progress. The grid index carries on.
+ *
+ * @param clock     pointer to clock
+ * @param period_us new spacing
+ * @param counter   current counter value
+ * @return uint64_t counter value of the next alarm
+ * @note   Call with the timer interrupt held off
+ */
+uint64_t sample_clock_set_period(sample_clock_t *const clock, uint32_t period_us, uint64_t counter)
+{
+    clock->period_us = period_us;
+    clock->due = counter + period_us;
+    return clock->due;
+}
+
+/**
+ * @brief Handle an alarm: queue the ticks the policy serves, pick the next alarm
+ *
+ * The alarm is the one set to due, the trigger edge. An alarm that went off
+ * just before a period change moved due is ignored.
+ *
+ * @param clock     pointer to clock
+ * @param counter   counter value at interrupt entry
+ * @param now_us    esp_timer time at interrupt entry
+ * @return uint64_t counter value of the next alarm, at least SAMPLE_CLOCK_MARGIN_US ahead
+ * @note   Interrupt context: no floating point, no blocking
+ */
+uint64_t sample_clock_fire(sample_clock_t *const clock, uint64_t counter, int64_t now_us)
+{
+    const uint64_t period = clock->period_us;
+    const uint64_t alarm = clock->due;
+    const int64_t offset = now_us - (int64_t)counter;
+
+    if (counter + SAMPLE_CLOCK_MARGIN_US < alarm)
+    {
+        return alarm;
+    }
+    clock->fired++;
+
+    /* Grid points after the alarm that are already due, or too close to set */
+    uint64_t passed = counter > alarm ? (counter - alarm) / period : 0;
+    uint64_t next = alarm + (passed + 1) * period;
+    if (next < counter + SAMPLE_CLOCK_MARGIN_US)
+    {
+        passed++;
+        next += period;
+    }
+    uint64_t latest = alarm + passed * period;
+
+    switch (clock->policy)
+    {
+    case SAMPLE_CLOCK_CATCH_UP:
+        for (uint64_t k = 0; k <= passed; k++)
+        {
+            sample_clock_push(clock, clock->seq + (uint32_t)k, alarm + k * period, counter, offset);
+        }
+        break;
+    case SAMPLE_CLOCK_RESYNC:
+        if (passed > 0 && counter > latest)
+        {
+            /* The grid moves to this interrupt, the tick is served on time */
+            latest = counter;
+            next = counter + period;
+        }
+        /* fall through */
+    case SAMPLE_CLOCK_SKIP:
+    default:
+        __atomic_fetch_add(&clock->missed, (uint32_t)passed, __ATOMIC_RELAXED);
+        sample_clock_push(clock, clock->seq + (uint32_t)passed, latest, counter, offset);
+        break;
+    }
+
+    clock->seq += (uint32_t)passed + 1;
+    clock->due = next;
+    return next;
+}
+
+/**
+ * @brief Next tick for the sampling task
+ *
+ * With CATCH_UP the oldest waiting tick. With SKIP and RESYNC the newest,
+ * older ones count as missed.
+ *
+ * @param clock pointer to clock
+ * @param tick  destination
+ * @return true tick taken, false none waiting
+ * @note   Single consumer
+ */
+bool sample_clock_take(sample_clock_t *const clock, sample_clock_tick_t *tick)
+{
+    uint32_t tail = clock->tail;
+    uint32_t head = __atomic_load_n(&clock->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail)
+    {
+        return false;
+    }
+    if (clock->policy != SAMPLE_CLOCK_CATCH_UP && head - tail > 1)
+    {
+        __atomic_fetch_add(&clock->missed, head - tail - 1, __ATOMIC_RELAXED);
+        tail = head - 1;
+    }
+    *tick = clock->ring[tail & (SAMPLE_CLOCK_DEPTH - 1)];
+    __atomic_store_n(&clock->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
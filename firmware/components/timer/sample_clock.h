@@ -0,0 +1,104 @@
+/**
+ * @file sample_clock.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sampling tick schedule on a fixed grid, with a missed tick policy
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The clock sets every alarm, so it knows the counter value of each trigger
+ * edge. The hardware timer interrupt calls sample_clock_fire() with the
+ * counter value at its entry, which makes the interrupt latency measured
+ * rather than assumed. Ticks go to the sampling task through a
+ * single-producer, single-consumer ring.
+ */
+#ifndef _SAMPLE_CLOCK_H_
+#define _SAMPLE_CLOCK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SAMPLE_CLOCK_DEPTH 8       /*!< Ticks waiting for the sampling task, power of two */
+#define SAMPLE_CLOCK_MARGIN_US 20  /*!< Closest next alarm to the current counter value */
+
+/**
+ * @enum sample_clock_policy_t sample_clock.h
+ * @brief What happens to grid ticks that could not be served on time
+ */
+typedef enum
+{
+    SAMPLE_CLOCK_SKIP = 0,     /*!< Serve the newest tick only, later ticks stay on the grid */
+    SAMPLE_CLOCK_CATCH_UP = 1, /*!< Serve every tick late, stamped with its grid time */
+    SAMPLE_CLOCK_RESYNC = 2,   /*!< Serve the newest tick only, the grid restarts from it */
+} sample_clock_policy_t;
+
+/**
+ * @struct sample_clock_tick_t sample_clock.h
+ * @brief One tick handed to the sampling task
+ *
+ * ### Example
+ * ~~~.c
+ * typedef struct{
+ *      uint32_t seq;
+ *      uint32_t latency_us;
+ *      int64_t time_us;
+ * }sample_clock_tick_t;
+ * ~~~
+ */
+typedef struct
+{
+    uint32_t seq;        /*!< Grid index, steps over missed ticks */
+    uint32_t latency_us; /*!< Trigger to interrupt entry, from the timer counter */
+    int64_t time_us;     /*!< Trigger instant in esp_timer time */
+} sample_clock_tick_t;
+
+/**
+ * @struct sample_clock_t sample_clock.h
+ * @brief Tick schedule and the ring of ticks not yet taken
+ *
+ * Schedule fields are changed by the interrupt, and by the task only with
+ * the interrupt held off. The counters are read without a lock.
+ *
+ * ### Example
+ * ~~~.c
+ * sample_clock_t clock;
+ * sample_clock_init(&clock, 125000, SAMPLE_CLOCK_SKIP);
+ * uint64_t alarm = sample_clock_start(&clock, counter_now);
+ * // interrupt: alarm = sample_clock_fire(&clock, counter, esp_timer_get_time());
+ * // task:      while (sample_clock_take(&clock, &tick)) sample(tick.time_us);
+ * ~~~
+ */
+typedef struct
+{
+    uint32_t period_us;                        /*!< Grid spacing */
+    sample_clock_policy_t policy;              /*!< Missed tick policy */
+    uint64_t due;                              /*!< Counter value of the next grid tick */
+    uint32_t seq;                              /*!< Grid index of due */
+    sample_clock_tick_t ring[SAMPLE_CLOCK_DEPTH]; /*!< Ticks for the task */
+    uint32_t head;                             /*!< Next slot to write, interrupt only */
+    uint32_t tail;                             /*!< Next slot to read, task only */
+    uint32_t fired;                            /*!< Alarms handled */
+    uint32_t missed;                           /*!< Grid ticks passed over by the policy */
+    uint32_t dropped;                          /*!< Ticks lost to a full ring */
+} sample_clock_t;
+
+void sample_clock_init(sample_clock_t *const clock, uint32_t period_us, sample_clock_policy_t policy);
+
+uint64_t sample_clock_start(sample_clock_t *const clock, uint64_t counter);
+
+uint64_t sample_clock_set_period(sample_clock_t *const clock, uint32_t period_us, uint64_t counter);
+
+uint64_t sample_clock_fire(sample_clock_t *const clock, uint64_t counter, int64_t now_us);
+
+bool sample_clock_take(sample_clock_t *const clock, sample_clock_tick_t *tick);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file sample_timer.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sampling clock on a hardware timer, ticks dispatched from its interrupt
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The alarm is a compare on the timer counter, so the counter value it was
+ * set to is the exact trigger instant and the counter read at interrupt
+ * entry gives the dispatch latency. esp_timer, read in the same interrupt,
+ * converts both to the time base of the rest of the firmware.
+ *
+ * The interrupt is not placed in IRAM: during flash writes, the spill ring
+ * for one, it waits until the cache is back, and the missed tick policy of
+ * the clock decides what happens to the grid points passed meanwhile.
+ *
+ * ESP-IDF 5 runs it on a GPTimer, earlier versions on timer 0 of group 0.
+ */
+
+#include "esp_idf_version.h"
+#include "esp_timer.h"
+#include "sample_timer.h"
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include "driver/gptimer.h"
+#else
+#include "driver/timer.h"
+#define SAMPLE_TIMER_GROUP TIMER_GROUP_0
+#define SAMPLE_TIMER_INDEX TIMER_0
+#define SAMPLE_TIMER_DIVIDER 80 /* 80 MHz APB clock to 1 MHz */
+#endif
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+/**
+ * @brief Alarm interrupt: queue the due ticks and arm the next alarm
+ *
+ * @param gptimer   timer
+ * @param edata     counter value at interrupt entry
+ * @param arg       sample_timer_t
+ * @return true     a higher priority task was woken
+ */
+static bool sample_timer_alarm(gptimer_handle_t gptimer, const gptimer_alarm_event_data_t *edata, void *arg)
+{
+    sample_timer_t *timer = arg;
+    BaseType_t woken = pdFALSE;
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL_ISR(&timer->lock);
+    uint32_t head = timer->clock.head;
+    gptimer_alarm_config_t alarm = {
+        .alarm_count = sample_clock_fire(&timer->clock, edata->count_value, now),
+    };
+    gptimer_set_alarm_action(gptimer, &alarm);
+    bool queued = timer->clock.head != head;
+    portEXIT_CRITICAL_ISR(&timer->lock);
+
+    if (queued)
+    {
+        vTaskNotifyGiveFromISR(timer->task, &woken);
+    }
+    return woken == pdTRUE;
+}
+#else
+/**
+ * @brief Alarm interrupt: queue the due ticks and arm the next alarm
+ *
+ * @param arg   sample_timer_t
+ * @return true a higher priority task was woken
+ */
+static bool sample_timer_alarm(void *arg)
+{
+    sample_timer_t *timer = arg;
+    BaseType_t woken = pdFALSE;
+    int64_t now = esp_timer_get_time();
+    uint64_t counter = timer_group_get_counter_value_in_isr(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX);
+
+    portENTER_CRITICAL_ISR(&timer->lock);
+    uint32_t head = timer->clock.head;
+    uint64_t next = sample_clock_fire(&timer->clock, counter, now);
+    timer_group_set_alarm_value_in_isr(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX, next);
+    timer_group_enable_alarm_in_isr(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX);
+    bool queued = timer->clock.head != head;
+    portEXIT_CRITICAL_ISR(&timer->lock);
+
+    if (queued)
+    {
+        vTaskNotifyGiveFromISR(timer->task, &woken);
+    }
+    return woken == pdTRUE;
+}
+#endif
+
+/**
+ * @brief Arm the alarm at a counter value
+ *
+ * @param timer pointer to timer
+ * @param alarm counter value
+ * @return esp_err_t status
+ */
+static esp_err_t sample_timer_arm(sample_timer_t *timer, uint64_t alarm)
+{
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    gptimer_alarm_config_t config = {.alarm_count = alarm};
+    return gptimer_set_alarm_action(timer->handle, &config);
+#else
+    esp_err_t err = timer_set_alarm_value(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX, alarm);
+    return err == ESP_OK ? timer_set_alarm(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX, TIMER_ALARM_EN) : err;
+#endif
+}
+
+/**
+ * @brief Current counter value
+ *
+ * @param timer pointer to timer
+ * @return uint64_t counter, 1 MHz
+ */
+static uint64_t sample_timer_counter(sample_timer_t *timer)
+{
+    uint64_t counter = 0;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    gptimer_get_raw_count(timer->handle, &counter);
+#else
+    timer_get_counter_value(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX, &counter);
+#endif
+    return counter;
+}
+
+/**
+ * @brief Create the timer and its interrupt, stopped
+ *
+ * The interrupt is allocated on the calling core, call it from the core
+ * that samples.
+ *
+ * @param timer     pointer to timer
+ * @param period_us tick period
+ * @param policy    missed tick policy
+ * @param task      task notified on ticks
+ * @return esp_err_t status
+ */
+esp_err_t sample_timer_init(sample_timer_t *timer, uint32_t period_us, sample_clock_policy_t policy, TaskHandle_t task)
+{
+    sample_clock_init(&timer->clock, period_us, policy);
+    timer->task = task;
+    portMUX_INITIALIZE(&timer->lock);
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    gptimer_handle_t gptimer = NULL;
+    gptimer_config_t config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,
+    };
+    esp_err_t err = gptimer_new_timer(&config, &gptimer);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    timer->handle = gptimer;
+    gptimer_event_callbacks_t callbacks = {.on_alarm = sample_timer_alarm};
+    err = gptimer_register_event_callbacks(gptimer, &callbacks, timer);
+    return err == ESP_OK ? gptimer_enable(gptimer) : err;
+#else
+    timer->handle = NULL;
+    timer_config_t config = {
+        .divider = SAMPLE_TIMER_DIVIDER,
+        .counter_dir = TIMER_COUNT_UP,
+        .counter_en = TIMER_PAUSE,
+        .alarm_en = TIMER_ALARM_DIS,
+        .auto_reload = TIMER_AUTORELOAD_DIS,
+    };
+    esp_err_t err = timer_init(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX, &config);
+    if (err == ESP_OK)
+    {
+        err = timer_set_counter_value(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX, 0);
+    }
+    if (err == ESP_OK)
+    {
+        err = timer_isr_callback_add(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX, sample_timer_alarm, timer, 0);
+    }
+    return err;
+#endif
+}
+
+/**
+ * @brief Start counting, the first tick comes at once
+ *
+ * @param timer pointer to timer
+ * @return esp_err_t status
+ */
+esp_err_t sample_timer_start(sample_timer_t *timer)
+{
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    esp_err_t err = gptimer_start(timer->handle);
+#else
+    esp_err_t err = timer_start(SAMPLE_TIMER_GROUP, SAMPLE_TIMER_INDEX);
+#endif
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    portENTER_CRITICAL(&timer->lock);
+    err = sample_timer_arm(timer, sample_clock_start(&timer->clock, sample_timer_counter(timer)));
+    portEXIT_CRITICAL(&timer->lock);
+    return err;
+}
+
+/**
+ * @brief Change the tick period, the next tick comes one new period from now
+ *
+ * @param timer     pointer to timer
+ * @param period_us new tick period
+ * @return esp_err_t status
+ */
+esp_err_t sample_timer_set_period(sample_timer_t *timer, uint32_t period_us)
+{
+    portENTER_CRITICAL(&timer->lock);
+    uint64_t alarm = sample_clock_set_period(&timer->clock, period_us, sample_timer_counter(timer));
+    esp_err_t err = sample_timer_arm(timer, alarm);
+    portEXIT_CRITICAL(&timer->lock);
+    return err;
+}
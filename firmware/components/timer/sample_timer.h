@@ -0,0 +1,57 @@
+/**
+ * @file sample_timer.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sampling clock on a hardware timer, ticks dispatched from its interrupt
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _SAMPLE_TIMER_H_
+#define _SAMPLE_TIMER_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sample_clock.h"
+
+/**
+ * @struct sample_timer_t sample_timer.h
+ * @brief Hardware timer running a sample_clock_t
+ *
+ * The timer counts at 1 MHz. Its interrupt queues the ticks in clock and
+ * gives task a notification, take them with sample_clock_take().
+ *
+ * ### Example
+ * ~~~.c
+ * static sample_timer_t timer;
+ * sample_timer_init(&timer, 125000, SAMPLE_CLOCK_SKIP, xTaskGetCurrentTaskHandle());
+ * sample_timer_start(&timer);
+ * while (1)
+ * {
+ *     ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+ *     sample_clock_tick_t tick;
+ *     while (sample_clock_take(&timer.clock, &tick))
+ *     {
+ *         ...
+ *     }
+ * }
+ * ~~~
+ */
+typedef struct
+{
+    sample_clock_t clock; /*!< Schedule and ticks */
+    TaskHandle_t task;    /*!< Notified when ticks are queued */
+    portMUX_TYPE lock;    /*!< Guards the schedule against the interrupt */
+    void *handle;         /*!< gptimer_handle_t on ESP-IDF 5, unused before */
+} sample_timer_t;
+
+esp_err_t sample_timer_init(sample_timer_t *timer, uint32_t period_us, sample_clock_policy_t policy, TaskHandle_t task);
+
+esp_err_t sample_timer_start(sample_timer_t *timer);
+
+esp_err_t sample_timer_set_period(sample_timer_t *timer, uint32_t period_us);
+
+#endif
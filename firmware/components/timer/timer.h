@@ -10,6 +10,4 @@
 #define FIVE_MINUTE 300000000
 #define TEN_MINUTE 600000000
 
-extern void timer_callback(void *arg);
-
 #endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+/**
+ * @file trace.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Deferred binary trace: record on the hot path, format on the host
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * One ring per core keeps producers on different cores from contending on
+ * the same head. A task that migrates between reading its core ID and
+ * writing only lands in the other ring, which is just as safe.
+ */
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "telemetry/telemetry.h"
+#include "telemetry/frame.h"
+#include "trace.h"
+
+static trace_slot_t trace_slots[portNUM_PROCESSORS][TRACE_RING_SLOTS]; /* Ring storage */
+static trace_ring_t trace_rings[portNUM_PROCESSORS];                   /* One ring per core */
+
+/**
+ * @brief Initialize the rings, call before the first TRACE()
+ */
+void trace_init(void)
+{
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        trace_ring_init(&trace_rings[core], trace_slots[core], TRACE_RING_SLOTS);
+    }
+}
+
+/**
+ * @brief Record a trace event on the calling core, use TRACE()
+ *
+ * Safe from tasks and interrupts, never blocks. Only the stamp, the format
+ * address and the arguments are stored.
+ *
+ * @param fmt       format string literal
+ * @param args      raw arguments
+ * @param nargs     number of arguments
+ * @return true recorded
+ * @return false ring full, record dropped
+ */
+bool trace_write(const char *fmt, const uint32_t *args, size_t nargs)
+{
+    return trace_ring_write(&trace_rings[xPortGetCoreID()], (uint32_t)esp_timer_get_time(), fmt, args, nargs);
+}
+
+/**
+ * @brief Records dropped on every core since boot
+ *
+ * @return uint32_t dropped records
+ */
+uint32_t trace_dropped(void)
+{
+    uint32_t dropped = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        dropped += trace_ring_dropped(&trace_rings[core]);
+    }
+    return dropped;
+}
+
+/**
+ * @brief Low priority task that sends trace records as TELEMETRY_TRACE frames
+ *
+ * Records are packed into frames of up to FRAME_MAX_PAYLOAD bytes. A frame
+ * the telemetry ring has no room for counts in telemetry_dropped().
+ *
+ * @param pvParameters unused
+ */
+void trace_task(void *pvParameters)
+{
+    uint8_t frame[FRAME_MAX_PAYLOAD];
+    trace_slot_t slot;
+
+    while (1)
+    {
+        vTaskDelay(pdMS_TO_TICKS(TRACE_DRAIN_MS));
+
+        for (int core = 0; core < portNUM_PROCESSORS; core++)
+        {
+            size_t len = 0;
+            while (trace_ring_read(&trace_rings[core], &slot))
+            {
+                if (len + TRACE_RECORD_MAX > sizeof(frame))
+                {
+                    telemetry_send(TELEMETRY_TRACE, frame, len);
+                    len = 0;
+                }
+                len += trace_encode(&slot, (uint8_t)core, frame + len);
+            }
+            if (len > 0)
+            {
+                telemetry_send(TELEMETRY_TRACE, frame, len);
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ * @file trace.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Deferred binary trace: record on the hot path, format on the host
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * TRACE() stores the format string address, a timestamp and raw arguments in
+ * the ring of the calling core. trace_task() sends the records over the
+ * telemetry stream and tools/trace.py turns them back into text with the
+ * strings from the firmware ELF.
+ */
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "trace_ring.h"
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#define TRACE_RING_SLOTS 64 /*!< Records per core, power of two */
+#define TRACE_DRAIN_MS 100  /*!< trace_task() period */
+
+/**
+ * @brief Record a trace event, at most TRACE_MAX_ARGS integer arguments
+ *
+ * The format must be a string literal. Arguments are truncated to 32 bits,
+ * @see TRACE_ARGS(). No floating point.
+ *
+ * ### Example
+ * ~~~.c
+ * TRACE("tick late by %d us", jitter);
+ * TRACE("%s: sample %u dropped", (uintptr_t)driver->name, seq);
+ * ~~~
+ */
+#if defined(ESP_PLATFORM) && !CONFIG_LOGGER_TRACE
+#define TRACE(fmt, ...) ((void)0) /* trace configured out, arguments are not evaluated */
+#else
+#define TRACE(fmt, ...) trace_write(fmt, TRACE_ARGS(__VA_ARGS__))
+#endif
+
+void trace_init(void);
+
+bool trace_write(const char *fmt, const uint32_t *args, size_t nargs);
+
+uint32_t trace_dropped(void);
+
+void trace_task(void *pvParameters);
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * @file trace_ring.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Lock-free ring of deferred trace records
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+#include "trace_ring.h"
+
+/**
+ * @brief Initialize an empty ring
+ *
+ * @param ring      pointer to ring
+ * @param slots     storage, @p size entries
+ * @param size      capacity, power of two
+ * @return int 0 on success, -1 if size is not a power of two
+ */
+int trace_ring_init(trace_ring_t *const ring, trace_slot_t *slots, uint32_t size)
+{
+    if (size == 0 || (size & (size - 1)) != 0)
+    {
+        return -1;
+    }
+    memset(slots, 0, size * sizeof(*slots));
+    ring->slots = slots;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+    return 0;
+}
+
+/**
+ * @brief Append a record, safe from any number of tasks and interrupts
+ *
+ * @param ring      pointer to ring
+ * @param stamp     time in us
+ * @param fmt       format string, must live as long as the firmware image
+ * @param args      raw arguments
+ * @param nargs     number of arguments, at most TRACE_MAX_ARGS are kept
+ * @return true record written
+ * @return false ring full, record counted as dropped
+ */
+bool trace_ring_write(trace_ring_t *const ring, uint32_t stamp, const char *fmt, const uint32_t *args,
+                      size_t nargs)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+
+    /* Reserve a slot */
+    do
+    {
+        if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= ring->size)
+        {
+            __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+    } while (!__atomic_compare_exchange_n(&ring->head, &head, head + 1, true, __ATOMIC_ACQUIRE,
+                                          __ATOMIC_RELAXED));
+
+    /* Fill it, then publish */
+    trace_slot_t *slot = &ring->slots[head & (ring->size - 1)];
+    if (nargs > TRACE_MAX_ARGS)
+    {
+        nargs = TRACE_MAX_ARGS;
+    }
+    slot->stamp = stamp;
+    slot->fmt = fmt;
+    slot->nargs = (uint32_t)nargs;
+    for (size_t i = 0; i < nargs; i++)
+    {
+        slot->arg[i] = args[i];
+    }
+    __atomic_store_n(&slot->seq, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Take the oldest record, single consumer only
+ *
+ * @param ring      pointer to ring
+ * @param slot      destination
+ * @return true a record was taken
+ * @return false ring empty, or the oldest record is still being written
+ */
+bool trace_ring_read(trace_ring_t *const ring, trace_slot_t *slot)
+{
+    uint32_t tail = ring->tail;
+    const trace_slot_t *next = &ring->slots[tail & (ring->size - 1)];
+
+    if (__atomic_load_n(&next->seq, __ATOMIC_ACQUIRE) != tail + 1)
+    {
+        return false;
+    }
+    *slot = *next;
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Records dropped since init
+ *
+ * @param ring      pointer to ring
+ * @return uint32_t dropped records
+ */
+uint32_t trace_ring_dropped(const trace_ring_t *ring)
+{
+    return __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Store a little endian u32
+ */
+static uint8_t *trace_put32(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+    return out + 4;
+}
+
+/**
+ * @brief Encode a record in wire format, @see trace_ring.h
+ *
+ * @param slot      record
+ * @param core      core that wrote it
+ * @param out       destination, at least TRACE_RECORD_MAX bytes
+ * @return size_t encoded length
+ */
+size_t trace_encode(const trace_slot_t *slot, uint8_t core, uint8_t *out)
+{
+    uint8_t *p = out;
+
+    p = trace_put32(p, (uint32_t)(uintptr_t)slot->fmt);
+    p = trace_put32(p, slot->stamp);
+    *p++ = core;
+    *p++ = (uint8_t)slot->nargs;
+    for (uint32_t i = 0; i < slot->nargs; i++)
+    {
+        p = trace_put32(p, slot->arg[i]);
+    }
+    return (size_t)(p - out);
+}
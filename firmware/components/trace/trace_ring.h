@@ -0,0 +1,103 @@
+/**
+ * @file trace_ring.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Lock-free ring of deferred trace records
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A trace record is the address of its format string, a timestamp and up to
+ * TRACE_MAX_ARGS raw 32-bit arguments. Nothing is formatted on the device:
+ * the host looks the format string up in the firmware ELF, @see tools/trace.py.
+ *
+ * Wire format of one record, little endian:
+ * ~~~
+ * fmt (u32) | stamp (u32, us) | core (u8) | nargs (u8) | arg[nargs] (u32)
+ * ~~~
+ */
+#ifndef _TRACE_RING_H_
+#define _TRACE_RING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRACE_MAX_ARGS 4 /*!< Arguments kept per record, extra ones are ignored */
+#define TRACE_RECORD_HEADER 10 /*!< Encoded bytes before the arguments */
+#define TRACE_RECORD_MAX (TRACE_RECORD_HEADER + 4 * TRACE_MAX_ARGS) /*!< Largest encoded record */
+
+/**
+ * @struct trace_slot_t trace_ring.h
+ * @brief One record in the ring
+ */
+typedef struct
+{
+    uint32_t seq;                  /*!< Ring index + 1 once the record is complete */
+    uint32_t stamp;                /*!< Time in us, low 32 bits */
+    const char *fmt;               /*!< Format string, its address is the record ID */
+    uint32_t nargs;                /*!< Arguments used */
+    uint32_t arg[TRACE_MAX_ARGS];  /*!< Raw arguments */
+} trace_slot_t;
+
+/**
+ * @struct trace_ring_t trace_ring.h
+ * @brief Multi-producer, single-consumer ring of trace slots
+ *
+ * Producers reserve a slot with a compare-and-swap on head and publish it
+ * through the slot's seq, so a task preempted between the two only holds
+ * back the consumer, never corrupts a record. A full ring drops the new
+ * record and counts it.
+ *
+ * ### Example
+ * ~~~.c
+ * static trace_slot_t slots[64];
+ * trace_ring_t ring;
+ * trace_ring_init(&ring, slots, 64);
+ * TRACE_RING_WRITE(&ring, now, "sensor %u failed: %d", id, err);
+ * ~~~
+ */
+typedef struct
+{
+    trace_slot_t *slots; /*!< Storage, size entries */
+    uint32_t size;       /*!< Capacity, power of two */
+    uint32_t head;       /*!< Next slot to reserve */
+    uint32_t tail;       /*!< Next slot to read */
+    uint32_t dropped;    /*!< Records lost to a full ring */
+} trace_ring_t;
+
+/**
+ * @brief Variadic arguments as the (args, nargs) pair of trace_ring_write()
+ *
+ * Every argument is converted to uint32_t. Pointers must be cast to
+ * uintptr_t; a %s argument is resolved on the host and has to point into the
+ * firmware image (string literals, const tables).
+ */
+#define TRACE_ARGS(...) \
+    (const uint32_t[]){0, ##__VA_ARGS__} + 1, sizeof((const uint32_t[]){0, ##__VA_ARGS__}) / sizeof(uint32_t) - 1
+
+/**
+ * @brief Write a record with the variadic arguments, @see TRACE_ARGS()
+ */
+#define TRACE_RING_WRITE(ring, stamp, fmt, ...) trace_ring_write((ring), (stamp), (fmt), TRACE_ARGS(__VA_ARGS__))
+
+int trace_ring_init(trace_ring_t *const ring, trace_slot_t *slots, uint32_t size);
+
+bool trace_ring_write(trace_ring_t *const ring, uint32_t stamp, const char *fmt, const uint32_t *args,
+                      size_t nargs);
+
+bool trace_ring_read(trace_ring_t *const ring, trace_slot_t *slot);
+
+uint32_t trace_ring_dropped(const trace_ring_t *ring);
+
+size_t trace_encode(const trace_slot_t *slot, uint8_t core, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
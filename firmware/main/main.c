@@ -1,26 +1,37 @@
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
 
 /* Drivers */
 #include "button/button.h"
-#include "lcd/esp_lcd.h"
 #include "led/led.h"
+#if CONFIG_LOGGER_LCD
+#include "lcd/esp_lcd.h"
+#endif
+#if CONFIG_LOGGER_BATTERY
 #include "battery/battery.h"
+#endif
 
 /* I2C drivers */
 #include "bmp180.h"
+#if CONFIG_LOGGER_RTC
 #include "ds3231.h"
+#endif
 #include <inttypes.h>
 
 /* SD Card */
+#if CONFIG_LOGGER_SD
 #include <sys/unistd.h>
 #include <sys/stat.h>
 #include "esp_vfs_fat.h"
 #include "sdmmc_cmd.h"
+#endif
 
 /* Battery reading */
 #include "driver/adc.h"
@@ -29,33 +40,353 @@
 #include "esp_idf_version.h"
 /* Timer */
 #include "esp_timer.h"
+/* Memory report */
+#include "esp_heap_caps.h"
+#include "esp_system.h"
+#include "esp_attr.h"
+#include "freertos/ringbuf.h"
 
 /* Custom headers */
 #include "sensor/sensor.h"
+#include "sensor/sensor_drivers.h"
+#include "sensor/channel.h"
+#include "pipeline/pipeline.h"
+#include "timer/sample_timer.h"
+#include "logfmt/log_record.h"
+#include "fmt/fmt.h"
+#include "epoch/epoch.h"
+#include "stats/stats.h"
+#include "trace/trace.h"
+#include "boot/boot_trace.h"
+#if CONFIG_LOGGER_SD
 #include "sdcard/sd_card.h"
-#include "timer/timer.h"
+#include "logger/logger.h"
+#include "logger/raw_sink.h"
+#include "logger/spill_flash.h"
+#include "logger/spill_sink.h"
+#endif
+#if CONFIG_LOGGER_TELEMETRY
+#include "telemetry/telemetry.h"
+#include "telemetry/frame.h"
+#endif
+#if CONFIG_LOGGER_RANGE_READ
+#include "telemetry/range_read.h"
+#include "logger/log_dir.h"
+#endif
 
 #define ONBOARD_LED 2
 
-QueueHandle_t pressureSensorQueue;
-QueueHandle_t realTimeClockQueue;
+/* Task placement: acquisition and timing on one core, storage, display and console on the other */
+#if CONFIG_FREERTOS_UNICORE
+#define CORE_ACQUISITION 0
+#define CORE_SERVICE 0
+#else
+#define CORE_ACQUISITION 1 /* APP_CPU */
+#define CORE_SERVICE 0     /* PRO_CPU */
+#endif
+
+/*
+ * Features, tuning and pins are set in menuconfig, "Sensor Data Logger",
+ * see Kconfig.projbuild; profiles/ holds complete sets of them. A feature
+ * configured out is not compiled: its sources leave the component, its
+ * rows leave the tables below and its code here is preprocessed away.
+ */
+#if CONFIG_LOGGER_LCD
+#define APP_WITH_LCD(row) row
+#else
+#define APP_WITH_LCD(row)
+#endif
+#if CONFIG_LOGGER_RTC
+#define APP_WITH_RTC(row) row
+#else
+#define APP_WITH_RTC(row)
+#endif
+#if CONFIG_LOGGER_BATTERY
+#define APP_WITH_BATTERY(row) row
+#else
+#define APP_WITH_BATTERY(row)
+#endif
+#if CONFIG_LOGGER_SD
+#define APP_WITH_SD(row) row
+#else
+#define APP_WITH_SD(row)
+#endif
+#if CONFIG_LOGGER_TELEMETRY
+#define APP_WITH_TELEMETRY(row) row
+#else
+#define APP_WITH_TELEMETRY(row)
+#endif
+#if CONFIG_LOGGER_TRACE
+#define APP_WITH_TRACE(row) row
+#else
+#define APP_WITH_TRACE(row)
+#endif
+#if CONFIG_LOGGER_RANGE_READ
+#define APP_WITH_RANGE_READ(row) row
+#else
+#define APP_WITH_RANGE_READ(row)
+#endif
+#if CONFIG_LOGGER_STATUS
+#define APP_WITH_STATUS(row) row
+#else
+#define APP_WITH_STATUS(row)
+#endif
+
+/*
+ * Pressure readings per logged sample, @see PIPELINE_OVERSAMPLE. The BMP180
+ * standard mode read takes about 13 ms, which bounds the shortest sample
+ * period at this many ticks of 15 ms.
+ */
+#define PRESSURE_OVERSAMPLE PIPELINE_OVERSAMPLE
+
+/* Ticks read later than this after their trigger edge are traced, in us */
+#define TICK_LATE_US 1000
+
+/* Policy for sampling ticks that could not be served on time */
+#if CONFIG_LOGGER_SAMPLE_MISSED_CATCH_UP
+#define SAMPLE_MISSED SAMPLE_CLOCK_CATCH_UP
+#elif CONFIG_LOGGER_SAMPLE_MISSED_RESYNC
+#define SAMPLE_MISSED SAMPLE_CLOCK_RESYNC
+#else
+#define SAMPLE_MISSED SAMPLE_CLOCK_SKIP
+#endif
+
+/* Longest wait for the first RTC read before the log file is named, in ms */
+#define CLOCK_WAIT_MS 3000
+
+/*
+ * Time-to-first-sample target: first record in the log block pool, in ms since esp_timer started.
+ * Provisional: only checked against a synthetic boot capture, not yet measured on a board.
+ * Set it from `tools/boot.py report --port` boots of real hardware, with some margin.
+ */
+#define BOOT_FIRST_SAMPLE_BUDGET_MS 1000
+
+/* Longest wait for every boot stage before the boot report, in ms */
+#define BOOT_REPORT_WAIT_MS 10000
+
+/* Width of the boot report timeline in characters */
+#define BOOT_BAR_WIDTH 40
+
+/* Telemetry ring bytes a range read leaves free for live records */
+#define RANGE_TELEMETRY_RESERVE 1024
+
+/* Longest wait for telemetry ring room per range read frame, in ms */
+#define RANGE_SEND_WAIT_MS 50
+
+/* Wait for a request while no range read is in progress, in ms */
+#define RANGE_IDLE_MS 100
+
+static const char *STATUS_TAG = "STATUS";
+#if CONFIG_LOGGER_STATUS
+static const char *BOOT_TAG = "BOOT";
+#endif
 
 /* Notification Handle */
 static TaskHandle_t sensorHandle = NULL;
-static TaskHandle_t rtcHandle = NULL;
-static TaskHandle_t batteryHandle = NULL;
+static TaskHandle_t dataHandle = NULL;
+
+/* Timing statistics, each written by a single task and read by statusTask */
+static stats_t tickLatency;        /* trigger edge to timer interrupt in us */
+static stats_t tickJitter;         /* trigger edge to sensor reads in us */
+
+/*
+ * Sampling timer, created by timerTask, PRESSURE_OVERSAMPLE ticks per
+ * logged sample. Its interrupt stamps every tick with the trigger edge and
+ * notifies sensorTask, dataTask changes the period.
+ */
+static sample_timer_t sampleTimer;
+static uint32_t samplePeriodUs = CONFIG_LOGGER_SAMPLE_PERIOD_MS * 1000 / PRESSURE_OVERSAMPLE; /* tick period */
+
+/* Sensor devices */
+static i2c_sensor_t pressureDevice = {.port = 0, .sda = CONFIG_LOGGER_I2C_SDA, .scl = CONFIG_LOGGER_I2C_SCL};
+#if CONFIG_LOGGER_RTC
+static i2c_sensor_t rtcDevice = {.port = 0, .sda = CONFIG_LOGGER_I2C_SDA, .scl = CONFIG_LOGGER_I2C_SCL};
+#endif
+#if CONFIG_LOGGER_BATTERY
+static battery_t batteryDevice;
+#endif
+
+/*
+ * Sensors run by sensorTask, X(id, driver, device, interval in ticks, overflow policy, block timeout ms).
+ *
+ * Each sensor feeds dataTask through a samplePipeline channel of
+ * QUEUE_SIZE samples. The policy decides what a full channel gives up: the time base keeps the
+ * newest readings, pressure averages what it cannot queue, the battery only
+ * needs its latest value. Pressure is read every tick and filtered down to
+ * one sample per PRESSURE_OVERSAMPLE ticks, the battery is read at that
+ * rate. The RTC only disciplines the wall clock, so it is read once every
+ * CONFIG_LOGGER_RTC_SYNC_SAMPLES samples. CHANNEL_BLOCK stalls sensorTask and with it every
+ * other sensor, so it suits slow sensors only.
+ */
+#define APP_SENSOR_TABLE(X)                                                                                                         \
+   APP_WITH_RTC(X(SENSOR_RTC,          ds3231_sensor,  &rtcDevice,      CONFIG_LOGGER_RTC_SYNC_SAMPLES * PRESSURE_OVERSAMPLE, CHANNEL_DROP_OLDEST, 0)) \
+   X(SENSOR_PRESSURE,                  bmp180_sensor,  &pressureDevice, 1,                                                    CHANNEL_COALESCE,    0)  \
+   APP_WITH_BATTERY(X(SENSOR_BATTERY,  battery_sensor, &batteryDevice,  PRESSURE_OVERSAMPLE,                                  CHANNEL_DROP_OLDEST, 0))
+
+#define APP_SENSOR_ID(id, driver, device, interval, policy, timeout) id,
+#define APP_SENSOR_ENTRY(id, driver, device, interval, policy, timeout) {&driver, device, interval},
+#define APP_SENSOR_STORAGE(id, driver, device, interval, policy, timeout) \
+   static sensor_sample_t id##Items[QUEUE_SIZE];
+#define APP_SENSOR_CHANNEL(id, driver, device, interval, policy, timeout) \
+   channel_init(&sensorChannels[id], id##Items, QUEUE_SIZE, policy);
+#define APP_SENSOR_TIMEOUT(id, driver, device, interval, policy, timeout) pdMS_TO_TICKS(timeout),
+
+enum
+{
+   APP_SENSOR_TABLE(APP_SENSOR_ID)
+   APP_SENSOR_COUNT
+};
+
+APP_SENSOR_TABLE(APP_SENSOR_STORAGE)
+
+static const sensor_t appSensors[] = {APP_SENSOR_TABLE(APP_SENSOR_ENTRY)};
+static const TickType_t appSensorTimeouts[] = {APP_SENSOR_TABLE(APP_SENSOR_TIMEOUT)};
+
+/* Sensor to dataTask channels, owned by samplePipeline */
+static channel_t sensorChannels[APP_SENSOR_COUNT];
+
+/*
+ * Filter, channels, wall clock, adaptive rate and records: pushed by
+ * sensorTask, drained by dataTask, counters read by statusTask.
+ */
+static pipeline_t samplePipeline;
+
+static sensor_exec_t sensorExec; /* Written by sensorTask, counters read by statusTask */
+
+#if CONFIG_LOGGER_SD
+/* Blocks copied from the flash spill ring to the card per batch, one erase unit */
+#define SPILL_DRAIN_BLOCKS (SPILL_FLASH_SECTOR / LOG_BLOCK_SIZE - 1)
+
+/* Card between sdcardAttach() and sdcardDetach(), sdcardTask only */
+static bool sdBusReady; /* SPI bus initialized, kept across attaches */
+#if CONFIG_LOGGER_STORAGE_RAW
+static sdmmc_card_t sdRawCard;
+static sdspi_dev_handle_t sdDevice;
+#else
+static sdmmc_card_t *sdCard;
+static log_sink_t sdLog;   /* Log file, new blocks */
+static log_sink_t sdSpill; /* Spill file, blocks drained from flash */
+static bool sdSpillOpen;
+#endif
+
+/* Internal flash fallback while the card is down, used by sdcardTask, counters read by statusTask */
+static spill_sink_t spillSink;
+#if CONFIG_LOGGER_SPILL
+static spill_dev_t spillDev;
+static spill_ring_t spillRing;
+static DMA_ATTR log_block_t spillBuffer[SPILL_DRAIN_BLOCKS];
+#endif
+#endif
+
+#if CONFIG_LOGGER_RANGE_READ
+/* Log files served to the host by rangeTask; sdcardDetach() closes them under cardLock before the unmount */
+static StaticSemaphore_t cardLockBuffer;
+static SemaphoreHandle_t cardLock;
+static bool cardMounted; /* Filesystem up, under cardLock */
+static log_dir_t rangeDir;
+static range_read_t rangeService; /* Counters read by statusTask */
+#endif
+
+/*
+ * Bring-up stages, X(id, name). Each stage runs in the task that needs it
+ * and sets its bit in bootEvents when done; a task that depends on another
+ * stage waits for that bit only, so independent stages overlap. Acquisition
+ * starts as soon as the sensors are initialized: records collect in the log
+ * block pool until storage is ready, and the display catches up on its own.
+ *
+ *   core          app_main: trace rings, channels, telemetry, log block pool
+ *   sensors       sensorTask: every sensor init(), ticks start when done
+ *   clock         dataTask: first RTC sync of the wall clock
+ *   display       lcdTask: LCD controller init
+ *   storage       sdcardTask: spill ring, SPI bus, card mount, log file open;
+ *                 fails without a card, logging then goes to the spill ring
+ *   first_sample  dataRow(): first record in the log block pool, without
+ *                 SD card logging the first record sent out
+ *
+ * Stages of features configured out are left out.
+ */
+#define APP_BOOT_TABLE(X)                              \
+   X(BOOT_CORE,                      "core")          \
+   X(BOOT_SENSORS,                   "sensors")       \
+   APP_WITH_RTC(X(BOOT_CLOCK,        "clock"))        \
+   APP_WITH_LCD(X(BOOT_DISPLAY,      "display"))      \
+   APP_WITH_SD(X(BOOT_STORAGE,       "storage"))      \
+   X(BOOT_FIRST_SAMPLE,              "first_sample")
+
+#define APP_BOOT_ID(id, name) id,
+#define APP_BOOT_NAME(id, name) name,
+
+enum
+{
+   APP_BOOT_TABLE(APP_BOOT_ID)
+   APP_BOOT_COUNT
+};
+
+static const char *const appBootNames[] = {APP_BOOT_TABLE(APP_BOOT_NAME)};
+
+#define BOOT_BIT(stage) ((EventBits_t)1 << (stage))
+#define BOOT_ALL (BOOT_BIT(APP_BOOT_COUNT) - 1)
+
+/* Stage times, each written by the task running the stage, read by statusTask once every bit is set */
+static boot_trace_t bootTrace;
+static StaticEventGroup_t bootEventsBuffer;
+static EventGroupHandle_t bootEvents;
+
+static void bootBegin(uint8_t stage)
+{
+   boot_stage_begin(&bootTrace, stage, (uint8_t)xPortGetCoreID(), esp_timer_get_time());
+}
+
+static void bootEnd(uint8_t stage, int result)
+{
+   boot_stage_end(&bootTrace, stage, result, esp_timer_get_time());
+   xEventGroupSetBits(bootEvents, BOOT_BIT(stage));
+}
+
+static void bootMark(uint8_t stage)
+{
+   boot_stage_mark(&bootTrace, stage, (uint8_t)xPortGetCoreID(), esp_timer_get_time());
+   xEventGroupSetBits(bootEvents, BOOT_BIT(stage));
+}
+
+#if CONFIG_LOGGER_LCD
+/* Latest logged record, written by dataTask and shown by lcdTask */
+static log_record_t displayRecord;
+static portMUX_TYPE displayLock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief Show "label value unit" on one 16 character LCD row
+ *
+ * @param lcd       pointer to LCD object
+ * @param row       LCD row
+ * @param label     text before the value
+ * @param value     fixed-point value
+ * @param decimals  digits after the point
+ * @param unit      text after the value
+ */
+static void lcdRow(lcd_t *const lcd, int row, const char *label, int64_t value, uint8_t decimals, const char *unit)
+{
+   char line[32 + FMT_INT_MAX];
+   size_t labelLen = strlen(label);
+   size_t unitLen = strlen(unit);
+
+   /* Right-align the value so the row is always fully rewritten */
+   int width = 16 - (int)(labelLen + unitLen);
+   memcpy(line, label, labelLen);
+   size_t n = labelLen + fmt_fixed(line + labelLen, value, decimals, width > 0 ? width : 0, ' ');
+   memcpy(line + n, unit, unitLen + 1);
+   lcdSetText(lcd, line, 0, row);
+}
 
 void lcdTask(void *pvParameters)
 {
    /* Create LCD object */
    lcd_t lcd;
 
-   /* Set LCD to custom pinout */
-   gpio_num_t data[4] = {19, 18, 17, 16}; /* Data pins */
-   gpio_num_t en = 27;                    /* Enable pin */
-   gpio_num_t regSel = 26;                /* Register Select pin */
+   bootBegin(BOOT_DISPLAY);
 
-   lcdCtor(&lcd, data, en, regSel);
+   /* Pinout from menuconfig */
+   lcdDefault(&lcd);
 
    /* Initialize LCD */
    lcdInit(&lcd);
@@ -64,192 +395,240 @@ void lcdTask(void *pvParameters)
 
    /* Set text */
    lcdSetText(&lcd, "Custom ESP LCD", 0, 0);
+   bootEnd(BOOT_DISPLAY, 0);
 
-   /* Variable */
-   int count = 0; /* count */
+   /* Banner until there is a sample to show */
+   xEventGroupWaitBits(bootEvents, BOOT_BIT(BOOT_FIRST_SAMPLE), pdFALSE, pdTRUE, pdMS_TO_TICKS(1000));
 
    while (1)
    {
-      /* Set custom text */
-      lcdSetText(&lcd, "Count: ", 0, 1);
-      lcdSetInt(&lcd, count, 8, 1);
-      count++;                               /* Increment count */
+      /* Copy under the lock, format outside it */
+      portENTER_CRITICAL(&displayLock);
+      log_record_t record = displayRecord;
+      portEXIT_CRITICAL(&displayLock);
+
+      /* Latest sample, integer units to text without printf: "hh:mm:ss  21.50C" */
+      char clock[EPOCH_TEXT_MAX];
+      epoch_format(clock, record.time_us, 0);
+      lcdRow(&lcd, 0, clock + 11, record.temperature, 2, "C");
+      lcdRow(&lcd, 1, "Press", record.pressure, 0, " Pa");
       vTaskDelay(1000 / portTICK_PERIOD_MS); /* 1 second delay */
    }
 }
+#endif
+
+static void sensorWait(void *arg, uint32_t us)
+{
+   vTaskDelay(pdMS_TO_TICKS(us / 1000) + 1);
+}
+
+static int64_t sensorClock(void *arg)
+{
+   return esp_timer_get_time();
+}
 
-void bmp180Task(void *pvParameters)
+#if CONFIG_LOGGER_SENSOR_CAPTURE
+/* A capture with the largest raw reading goes out whole in one frame */
+_Static_assert(sizeof(sensor_capture_t) + SENSOR_RAW_MAX <= FRAME_MAX_PAYLOAD, "capture does not fit a frame");
+
+/**
+ * @brief Send one sensor access with its raw reading, for tools/replay
+ *
+ * @param arg       unused
+ * @param capture   access, timing and result
+ * @param raw       capture->size raw bytes
+ */
+static void sensorCapture(void *arg, const sensor_capture_t *capture, const void *raw)
 {
-   /* Create bmp180 device */
-   bmp180_dev_t dev;
-   /* Clear memory */
-   memset(&dev, 0, sizeof(bmp180_dev_t));
+   uint8_t payload[sizeof(sensor_capture_t) + SENSOR_RAW_MAX];
 
-   /* I2C pins */
-   gpio_num_t i2c_sda = 21;
-   gpio_num_t i2c_scl = 22;
+   /* Dropped with the rest of the telemetry when the ring is full, replay skips the gap */
+   memcpy(payload, capture, sizeof(*capture));
+   if (capture->size > 0)
+   {
+      memcpy(payload + sizeof(*capture), raw, capture->size);
+   }
+   telemetry_send(TELEMETRY_CAPTURE, payload, sizeof(*capture) + capture->size);
+}
+#endif
 
-   ESP_ERROR_CHECK(bmp180_init_desc(&dev, 0, i2c_sda, i2c_scl));
-   ESP_ERROR_CHECK(bmp180_init(&dev));
+void sensorTask(void *pvParameters)
+{
+   sensorExec = (sensor_exec_t){
+       .sensors = appSensors,
+       .count = APP_SENSOR_COUNT,
+       .emit = pipeline_push,
+       .wait_us = sensorWait,
+       .now_us = sensorClock,
+#if CONFIG_LOGGER_SENSOR_CAPTURE
+       .capture = sensorCapture,
+#endif
+       .arg = &samplePipeline,
+   };
 
-   data_t bmp180Sensor;
-   bmp180Sensor.event = BMP180_SENSOR;
+   /* Sensors that fail to initialize are skipped, the others keep running */
+   bootBegin(BOOT_SENSORS);
+   int enabled = sensor_exec_init(&sensorExec);
+   for (size_t i = 0; i < APP_SENSOR_COUNT; i++)
+   {
+      if (!sensorExec.status[i].enabled)
+      {
+         ESP_LOGE(STATUS_TAG, "%s: init failed", appSensors[i].driver->name);
+      }
+   }
+   bootEnd(BOOT_SENSORS, enabled > 0 ? 0 : -1);
 
+   /* Consecutive count of the ticks read, sensor intervals count these */
+   uint32_t seq = 0;
+   bool on = false;
    while (1)
    {
-      /* Wait for nofitication */
-      uint32_t count = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-      /* Display re */
-      printf("BMP180 count: %lu\n", (unsigned long)count);
-
-      float temp;
-      uint32_t pressure;
+      /* The timer interrupt queues the ticks, then notifies */
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 
-      esp_err_t res = bmp180_measure(&dev, &temp, &pressure, BMP180_MODE_STANDARD);
-      if (res != ESP_OK)
-         printf("Could not measure: %d\n", res);
-      else
+      sample_clock_tick_t tick;
+      while (sample_clock_take(&sampleTimer.clock, &tick))
       {
-         /* float is used in printf(). you need non-default configuration in
-          * sdkconfig for ESP8266, which is enabled by default for this
-          * example. see sdkconfig.defaults.esp8266
-          */
-         // printf("Temperature: %.2f degrees Celsius; Pressure: %" PRIu32 " Pa\n", temp, pressure);
+         int64_t jitter = esp_timer_get_time() - tick.time_us;
+         stats_add(&tickLatency, tick.latency_us);
+         stats_add(&tickJitter, jitter);
+         if (jitter > TICK_LATE_US)
+         {
+            TRACE("tick %u read %d us late", tick.seq, (int32_t)jitter);
+         }
 
-         bmp180Sensor.data0 = (void *)&temp;
-         bmp180Sensor.data1 = (void *)&pressure;
+         on = !on;
+         gpio_set_level(ONBOARD_LED, on);
 
-         /* Send queue data */
-         xQueueSendToBack(pressureSensorQueue, &bmp180Sensor, 0);
+         /* Readings are stamped with the trigger edge, not the time they were read */
+         sensor_exec_tick(&sensorExec, seq++, tick.time_us);
       }
-
-      vTaskDelay(pdMS_TO_TICKS(500));
    }
 }
 
-void rtcTask(void *pvParameters)
+#if CONFIG_LOGGER_SD
+/**
+ * @brief Log file path of a start time, MOUNT_POINT/YYYYMMDD/hhmmss.BIN
+ *
+ * 8.3 names, so FAT needs no long file name support. Creates the day's
+ * directory.
+ *
+ * @param path  destination, 32 bytes
+ * @param us    start time, microseconds since 1970
+ */
+static void logFilePath(char *path, int64_t us)
 {
+   civil_time_t civil;
+   epoch_to_civil(us, &civil);
+
+   char *p = path;
+   memcpy(p, MOUNT_POINT "/", sizeof(MOUNT_POINT));
+   p += sizeof(MOUNT_POINT);
+   p += fmt_uint(p, (uint32_t)civil.year * 10000 + civil.month * 100 + civil.day, 8, '0');
+   mkdir(path, 0775);
+   *p++ = '/';
+   p += fmt_uint(p, (uint32_t)civil.hour * 10000 + civil.minute * 100 + civil.second, 6, '0');
+   memcpy(p, ".BIN", 5);
+}
 
-   /* Allocate memory */
-   i2c_dev_t dev;
-   memset(&dev, 0, sizeof(i2c_dev_t));
-
-   /* Select i2c pins */
-   gpio_num_t i2c_sda = 21;
-   gpio_num_t i2c_scl = 22;
-
-   /* Initialize device */
-   ESP_ERROR_CHECK(ds3231_init_desc(&dev, 0, i2c_sda, i2c_scl));
-
-   struct tm time = {
-       .tm_year = 122, // since 1900 (2016 - 1900)
-       .tm_mon = 10,   // 0-based
-       .tm_mday = 26,
-       .tm_hour = 19,
-       .tm_min = 7,
-       .tm_sec = 0};
-   ESP_ERROR_CHECK(ds3231_set_time(&dev, &time));
-
-   data_t ds3231Sensor;
-   ds3231Sensor.event = DS3231_SENSOR;
+/**
+ * @brief Bring the card up and open the log, the spill sink's attach()
+ *
+ * The SPI bus is initialized on the first call and kept. Blocks drained
+ * from flash go to a file of their own, MOUNT_POINT/SPILLnnn.BIN, so every
+ * file stays in block order; with CONFIG_LOGGER_STORAGE_RAW they go to the log
+ * partition like any other block.
+ *
+ * @param ctx   unused
+ * @param card  sink for new blocks
+ * @param drain sink for blocks spilled to flash
+ * @return esp_err_t status
+ */
+static esp_err_t sdcardAttach(void *ctx, log_sink_t *card, log_sink_t *drain)
+{
+   esp_err_t ret;
+   sdmmc_host_t host = SDSPI_HOST_DEFAULT();
 
-   while (1)
+   if (!sdBusReady)
    {
-
-      /* Wait for nofitication */
-      uint32_t count = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-      /* Display re */
-      printf("D3231 count: %lu\n", (unsigned long)count);
-
-      float temp;
-
-      // vTaskDelay(1000 / portTICK_PERIOD_MS);
-
-      if (ds3231_get_temp_float(&dev, &temp) != ESP_OK)
-      {
-         printf("Could not get temperature\n");
-         continue;
-      }
-
-      if (ds3231_get_time(&dev, &time) != ESP_OK)
+      ESP_LOGI(SD_CARD_TAG, "Using SPI peripheral");
+      spi_bus_config_t bus_cfg = {
+          .mosi_io_num = PIN_NUM_MOSI,
+          .miso_io_num = PIN_NUM_MISO,
+          .sclk_io_num = PIN_NUM_CLK,
+          .quadwp_io_num = -1,
+          .quadhd_io_num = -1,
+          .max_transfer_sz = LOGGER_WRITE_BLOCKS * LOG_BLOCK_SIZE, /* one logger batch per transfer */
+      };
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+      ret = spi_bus_initialize(host.slot, &bus_cfg, SDSPI_DEFAULT_DMA);
+#else
+      ret = spi_bus_initialize(host.slot, &bus_cfg, SDSPI_DEFAULT_HOST);
+#endif
+      if (ret != ESP_OK)
       {
-         printf("Could not get time\n");
-         continue;
+         ESP_LOGE(SD_CARD_TAG, "Failed to initialize bus.");
+         return ret;
       }
+      sdBusReady = true;
+   }
 
-      /* float is used in printf(). you need non-default configuration in
-       * sdkconfig for ESP8266, which is enabled by default for this
-       * example. see sdkconfig.defaults.esp8266
-       */
-      // printf("%04d-%02d-%02d %02d:%02d:%02d, %.2f deg Cel\n", time.tm_year + 1900 /*Add 1900 for better readability*/, time.tm_mon + 1,
-      //        time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec, temp);
-
-      ds3231Sensor.data0 = (void *)&time;
+   // This initializes the slot without card detect (CD) and write protect (WP) signals.
+   // Modify slot_config.gpio_cd and slot_config.gpio_wp if your board has these signals.
+   sdspi_device_config_t slot_config = SDSPI_DEVICE_CONFIG_DEFAULT();
+   slot_config.gpio_cs = PIN_NUM_CS;
+   slot_config.host_id = host.slot;
 
-      xQueueSendToBack(realTimeClockQueue, &ds3231Sensor, 0);
+#if CONFIG_LOGGER_STORAGE_RAW
+   /* Card only, no filesystem */
+   ret = host.init();
+   if (ret == ESP_OK)
+   {
+      ret = sdspi_host_init_device(&slot_config, &sdDevice);
    }
-}
-
-void sdcardTask(void *pvParameters)
-{
-   esp_err_t ret;
+   if (ret != ESP_OK)
+   {
+      ESP_LOGE(SD_CARD_TAG, "Failed to initialize the card (%s).", esp_err_to_name(ret));
+      return ret;
+   }
+   host.slot = sdDevice;
+   ret = sdmmc_card_init(&host, &sdRawCard);
+   if (ret != ESP_OK)
+   {
+      ESP_LOGE(SD_CARD_TAG, "Failed to initialize the card (%s).", esp_err_to_name(ret));
+      sdspi_host_remove_device(sdDevice);
+      return ret;
+   }
+   sdmmc_card_print_info(stdout, &sdRawCard);
 
+   if (raw_sink_init(card, &sdRawCard) != ESP_OK)
+   {
+      sdspi_host_remove_device(sdDevice);
+      return ESP_FAIL;
+   }
+   *drain = *card;
+#else
    // Options for mounting the filesystem.
    // If format_if_mount_failed is set to true, SD card will be partitioned and
    // formatted in case when mounting fails.
    esp_vfs_fat_sdmmc_mount_config_t mount_config = {
-#ifdef CONFIG_EXAMPLE_FORMAT_IF_MOUNT_FAILED
+#ifdef CONFIG_LOGGER_SD_FORMAT_IF_MOUNT_FAILED
        .format_if_mount_failed = true,
 #else
        .format_if_mount_failed = false,
-#endif // EXAMPLE_FORMAT_IF_MOUNT_FAILED
+#endif // CONFIG_LOGGER_SD_FORMAT_IF_MOUNT_FAILED
        .max_files = 5,
        .allocation_unit_size = 16 * 1024};
-   sdmmc_card_t *card;
-   const char mount_point[] = MOUNT_POINT;
-   ESP_LOGI(SD_CARD_TAG, "Initializing SD card");
-
-   // Use settings defined above to initialize SD card and mount FAT filesystem.
-   // Note: esp_vfs_fat_sdmmc/sdspi_mount is all-in-one convenience functions.
-   // Please check its source code and implement error recovery when developing
-   // production applications.
-   ESP_LOGI(SD_CARD_TAG, "Using SPI peripheral");
-
-   sdmmc_host_t host = SDSPI_HOST_DEFAULT();
-   spi_bus_config_t bus_cfg = {
-       .mosi_io_num = PIN_NUM_MOSI,
-       .miso_io_num = PIN_NUM_MISO,
-       .sclk_io_num = PIN_NUM_CLK,
-       .quadwp_io_num = -1,
-       .quadhd_io_num = -1,
-       .max_transfer_sz = 4000,
-   };
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
-   ret = spi_bus_initialize(host.slot, &bus_cfg, SDSPI_DEFAULT_DMA);
-#else
-   ret = spi_bus_initialize(host.slot, &bus_cfg, SDSPI_DEFAULT_HOST);
-#endif
-   if (ret != ESP_OK)
-   {
-      ESP_LOGE(SD_CARD_TAG, "Failed to initialize bus.");
-      return;
-   }
-
-   // This initializes the slot without card detect (CD) and write protect (WP) signals.
-   // Modify slot_config.gpio_cd and slot_config.gpio_wp if your board has these signals.
-   sdspi_device_config_t slot_config = SDSPI_DEVICE_CONFIG_DEFAULT();
-   slot_config.gpio_cs = PIN_NUM_CS;
-   slot_config.host_id = host.slot;
 
    ESP_LOGI(SD_CARD_TAG, "Mounting filesystem");
-   ret = esp_vfs_fat_sdspi_mount(mount_point, &host, &slot_config, &mount_config, &card);
+   ret = esp_vfs_fat_sdspi_mount(MOUNT_POINT, &host, &slot_config, &mount_config, &sdCard);
 
    if (ret != ESP_OK)
    {
       if (ret == ESP_FAIL)
       {
          ESP_LOGE(SD_CARD_TAG, "Failed to mount filesystem. "
-                               "If you want the card to be formatted, set the CONFIG_EXAMPLE_FORMAT_IF_MOUNT_FAILED menuconfig option.");
+                               "If you want the card to be formatted, set the CONFIG_LOGGER_SD_FORMAT_IF_MOUNT_FAILED menuconfig option.");
       }
       else
       {
@@ -257,100 +636,222 @@ void sdcardTask(void *pvParameters)
                                "Make sure SD card lines have pull-up resistors in place.",
                   esp_err_to_name(ret));
       }
-      return;
+      return ret;
    }
    ESP_LOGI(SD_CARD_TAG, "Filesystem mounted");
 
    // Card has been initialized, print its properties
-   sdmmc_card_print_info(stdout, card);
-
-   // Use POSIX and C standard library functions to work with files.
+   sdmmc_card_print_info(stdout, sdCard);
 
-   // First create a file.
-   const char *file_hello = MOUNT_POINT "/test.txt";
+   /* Name the file after the wall clock once the RTC has been read, usually long done by now */
+   char path[32];
+   struct stat st;
+#if CONFIG_LOGGER_RTC
+   xEventGroupWaitBits(bootEvents, BOOT_BIT(BOOT_CLOCK), pdFALSE, pdTRUE, pdMS_TO_TICKS(CLOCK_WAIT_MS));
+#endif
+   epoch_clock_t clock;
+   pipeline_get_clock(&samplePipeline, &clock);
 
-   ESP_LOGI(SD_CARD_TAG, "Opening file %s", file_hello);
-   FILE *f = fopen(file_hello, "w");
-   if (f == NULL)
+   if (clock.valid)
    {
-      ESP_LOGE(SD_CARD_TAG, "Failed to open file for writing");
-      return;
+      int64_t now = epoch_clock_now(&clock, esp_timer_get_time());
+      do
+      {
+         logFilePath(path, now);
+         now += EPOCH_US_PER_SECOND;
+      } while (stat(path, &st) == 0);
+   }
+   else
+   {
+      /* No RTC: next free numbered file */
+      int index = 0;
+      do
+      {
+         snprintf(path, sizeof(path), MOUNT_POINT "/LOG%05d.BIN", index++);
+      } while (stat(path, &st) == 0);
    }
-   fprintf(f, "Hello %s!\n", card->cid.name);
-   printf("Hello  %s!\n", card->cid.name);
-   fclose(f);
-   ESP_LOGI(SD_CARD_TAG, "File written");
-
-   const char *file_foo = MOUNT_POINT "/foo.txt";
 
-   // Check if destination file exists before renaming
-   struct stat st;
-   if (stat(file_foo, &st) == 0)
+   if (logger_file_sink(&sdLog, path) != ESP_OK)
    {
-      // Delete it if it exists
-      unlink(file_foo);
+      ESP_LOGE(SD_CARD_TAG, "Failed to open %s", path);
+      esp_vfs_fat_sdcard_unmount(MOUNT_POINT, sdCard);
+      return ESP_FAIL;
    }
+   ESP_LOGI(SD_CARD_TAG, "Logging to %s", path);
+   *card = sdLog;
+   *drain = sdLog;
 
-   // Rename original file
-   ESP_LOGI(SD_CARD_TAG, "Renaming file %s to %s", file_hello, file_foo);
-   if (rename(file_hello, file_foo) != 0)
+   /* Blocks left in flash, from this boot or an earlier one */
+   if (spillSink.ring != NULL && spillSink.ring->count > 0)
    {
-      ESP_LOGE(SD_CARD_TAG, "Rename failed");
-      return;
+      int index = 0;
+      do
+      {
+         snprintf(path, sizeof(path), MOUNT_POINT "/SPILL%03d.BIN", index++);
+      } while (stat(path, &st) == 0);
+
+      if (logger_file_sink(&sdSpill, path) != ESP_OK)
+      {
+         ESP_LOGE(SD_CARD_TAG, "Failed to open %s", path);
+         logger_file_close(&sdLog);
+         esp_vfs_fat_sdcard_unmount(MOUNT_POINT, sdCard);
+         return ESP_FAIL;
+      }
+      sdSpillOpen = true;
+      *drain = sdSpill;
+      ESP_LOGI(SD_CARD_TAG, "Draining %" PRIu32 " blocks from flash to %s", spillSink.ring->count, path);
    }
 
-   // Open renamed file for reading
-   ESP_LOGI(SD_CARD_TAG, "Reading file %s", file_foo);
-   f = fopen(file_foo, "r");
-   if (f == NULL)
+#if CONFIG_LOGGER_RANGE_READ
+   /* Files may be read by the host from now on */
+   xSemaphoreTake(cardLock, portMAX_DELAY);
+   cardMounted = true;
+   xSemaphoreGive(cardLock);
+#endif
+#endif
+   return ESP_OK;
+}
+
+/**
+ * @brief Release a card that failed, the spill sink's detach()
+ *
+ * @param ctx   unused
+ */
+static void sdcardDetach(void *ctx)
+{
+#if CONFIG_LOGGER_STORAGE_RAW
+   sdspi_host_remove_device(sdDevice);
+#else
+#if CONFIG_LOGGER_RANGE_READ
+   /* Wait out a range read block in progress, then keep it off the card */
+   xSemaphoreTake(cardLock, portMAX_DELAY);
+   log_dir_close(&rangeDir);
+   cardMounted = false;
+   xSemaphoreGive(cardLock);
+#endif
+
+   logger_file_close(&sdLog);
+   if (sdSpillOpen)
    {
-      ESP_LOGE(SD_CARD_TAG, "Failed to open file for reading");
-      return;
+      logger_file_close(&sdSpill);
+      sdSpillOpen = false;
    }
+   esp_vfs_fat_sdcard_unmount(MOUNT_POINT, sdCard);
+#endif
+   ESP_LOGW(SD_CARD_TAG, "Card failed, logging to flash until it is back");
+}
+
+void sdcardTask(void *pvParameters)
+{
+   log_sink_t sink;
 
-   // Read a line from file
-   char line[64];
-   fgets(line, sizeof(line), f);
-   fclose(f);
+   bootBegin(BOOT_STORAGE);
 
-   // Strip newline
-   char *pos = strchr(line, '\n');
-   if (pos)
+   spillSink = (spill_sink_t){
+       .retry_ms = CONFIG_LOGGER_SD_RETRY_MS,
+       .attach = sdcardAttach,
+       .detach = sdcardDetach,
+   };
+
+#if CONFIG_LOGGER_SPILL
+   /* Flash ring behind the card, may still hold blocks from an earlier boot */
+   if (spill_flash_open(&spillDev, SPILL_FLASH_LABEL) == ESP_OK && spill_ring_open(&spillRing, &spillDev) == 0)
    {
-      *pos = '\0';
+      spillSink.ring = &spillRing;
+      spillSink.buffer = spillBuffer;
+      spillSink.buffer_blocks = SPILL_DRAIN_BLOCKS;
+      ESP_LOGI(SD_CARD_TAG, "Spill ring %" PRIu32 " of %" PRIu32 " blocks used", spillRing.count,
+               spill_ring_capacity(&spillRing));
    }
-   ESP_LOGI(SD_CARD_TAG, "Read from file: '%s'", line);
-   printf("Data: %s\n", line);
+#endif
+   spill_sink_init(&spillSink, &sink);
 
-   // All done, unmount partition and disable SPI peripheral
-   esp_vfs_fat_sdcard_unmount(mount_point, card);
-   ESP_LOGI(SD_CARD_TAG, "Card unmounted");
+   /* First attach now, so the boot report tells whether the card came up */
+   ESP_LOGI(SD_CARD_TAG, "Initializing SD card");
+   sink.service(sink.ctx, (uint32_t)(esp_timer_get_time() / 1000));
+   bootEnd(BOOT_STORAGE, spillSink.attached ? 0 : -1);
 
-   // deinitialize the bus after all devices are removed
-   spi_bus_free(host.slot);
+   /* Write full blocks until power off, starting with what was sampled meanwhile, to flash while the card is down */
+   logger_run(&sink);
+}
+#endif
 
-   while (1)
+#if CONFIG_LOGGER_RANGE_READ
+/**
+ * @brief Log file of the card, range_store_t segment()
+ *
+ * With CONFIG_LOGGER_STORAGE_RAW there are no files, read the partition with
+ * tools/rawlog instead.
+ */
+static int rangeSegment(void *ctx, uint16_t index, char *name, size_t size, uint32_t *blocks)
+{
+   int ret = -1;
+   xSemaphoreTake(cardLock, portMAX_DELAY);
+   if (cardMounted)
    {
-      vTaskDelay(100);
+      ret = log_dir_segment(ctx, index, name, size, blocks);
    }
+   xSemaphoreGive(cardLock);
+   return ret;
 }
 
-void timer_callback(void *arg)
+/**
+ * @brief One block of a log file, range_store_t read()
+ */
+static int rangeRead(void *ctx, uint16_t index, uint32_t block, log_block_t *dst)
 {
-   /* Send message */
-   printf("Timer was trigger!!!\n");
-   /* store previous state of gpio */
-   static bool on;
-   /* toggle state */
-   on = !on;
-   /* Set gpio level */
-   gpio_set_level(ONBOARD_LED, on);
+   int ret = -1;
+   xSemaphoreTake(cardLock, portMAX_DELAY);
+   if (cardMounted)
+   {
+      ret = log_dir_read(ctx, index, block, dst);
+   }
+   xSemaphoreGive(cardLock);
+   return ret;
+}
 
-   /* Give task handle */
-   xTaskNotifyGive(sensorHandle);
-   xTaskNotifyGive(rtcHandle);
+/**
+ * @brief Queue a range read frame behind the live telemetry
+ */
+static bool rangeSend(void *ctx, uint8_t *raw, size_t len)
+{
+   return telemetry_send_bulk(raw, len, RANGE_TELEMETRY_RESERVE, pdMS_TO_TICKS(RANGE_SEND_WAIT_MS));
 }
 
+/**
+ * @brief Serve log range reads to the host over the telemetry UART, @see tools/range.py
+ *
+ * Reads the card beside the logger writer, through the filesystem and one
+ * block at a time, and sends only as fast as the telemetry ring drains, so
+ * neither acquisition nor logging waits on the host.
+ *
+ * @param pvParameters unused
+ */
+void rangeTask(void *pvParameters)
+{
+   uint8_t rx[RANGE_RX_MAX];
+   bool busy = false;
+
+   log_dir_init(&rangeDir, MOUNT_POINT);
+   rangeService = (range_read_t){
+       .store = {.ctx = &rangeDir, .segment = rangeSegment, .read = rangeRead},
+       .send = rangeSend,
+   };
+   range_read_init(&rangeService);
+
+   while (1)
+   {
+      /* Requests first, so an abort stops a read at the next block */
+      int n = telemetry_receive(rx, sizeof(rx), busy ? 0 : pdMS_TO_TICKS(RANGE_IDLE_MS));
+      if (n > 0)
+      {
+         range_read_feed(&rangeService, rx, (size_t)n);
+      }
+      busy = range_read_poll(&rangeService);
+   }
+}
+#endif
+
 void timerTask(void *pvParameters)
 {
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
@@ -361,24 +862,19 @@ void timerTask(void *pvParameters)
    gpio_set_direction(ONBOARD_LED, GPIO_MODE_OUTPUT);
    gpio_set_level(ONBOARD_LED, 0);
 
-   /* Set timer arguments */
-   esp_timer_create_args_t timer_args = {
-       .callback = timer_callback,
-       .arg = NULL,
-       .dispatch_method = ESP_TIMER_TASK,
-       .name = "Sensor Timer Trigger",
-       .skip_unhandled_events = false,
-   };
-   /* Create timer handle */
-   esp_timer_handle_t timer_handle;
-   /* Create an instance of timer */
-   esp_timer_create(&timer_args, &timer_handle);
-
-   /* Set period */
-   uint64_t period = ONE_SECOND;
+   /* Created here, so its interrupt runs on the acquisition core */
+   esp_err_t err = sample_timer_init(&sampleTimer, samplePeriodUs, SAMPLE_MISSED, sensorHandle);
+   if (err != ESP_OK)
+   {
+      ESP_LOGE(STATUS_TAG, "sample timer: %s", esp_err_to_name(err));
+   }
 
-   /* Start periodic timer */
-   esp_timer_start_periodic(timer_handle, period);
+   /* First tick as soon as the sensors are ready, not one period later */
+   xEventGroupWaitBits(bootEvents, BOOT_BIT(BOOT_SENSORS), pdFALSE, pdTRUE, portMAX_DELAY);
+   if (err == ESP_OK)
+   {
+      sample_timer_start(&sampleTimer);
+   }
 
    while (1)
    {
@@ -386,104 +882,404 @@ void timerTask(void *pvParameters)
    }
 }
 
-void dataTask(void *pvParameters)
+static void dataReady(void *arg)
+{
+   xTaskNotifyGive(dataHandle);
+}
+
+#if CONFIG_LOGGER_SAMPLE_RATE_ADAPTIVE
+/**
+ * @brief Restart the sampling timer with the period samplePipeline chose
+ *
+ * The next tick comes one new period from now, so a faster rate takes
+ * effect at once rather than after the slow tick in progress.
+ *
+ * @param arg       unused
+ * @param period_ms new sample period
+ */
+static void samplePeriodChange(void *arg, uint32_t period_ms)
+{
+   samplePeriodUs = period_ms * 1000 / PRESSURE_OVERSAMPLE;
+   sample_timer_set_period(&sampleTimer, samplePeriodUs);
+}
+#endif
+
+#if CONFIG_LOGGER_RTC
+static void dataSynced(void *arg, bool first)
 {
+   if (first)
+   {
+      bootEnd(BOOT_CLOCK, 0);
+   }
+}
+#endif
+
+/**
+ * @brief Show a sample record and mark the first one stored
+ *
+ * @param arg       unused
+ * @param record    record before its commit
+ * @param stored    the record goes to the logger
+ */
+static void dataRow(void *arg, const log_record_t *record, bool stored)
+{
+#if CONFIG_LOGGER_LCD
+   portENTER_CRITICAL(&displayLock);
+   displayRecord = *record;
+   portEXIT_CRITICAL(&displayLock);
+#endif
+
+   /* Time to first sample: the first record that will reach storage */
+   static bool logged;
+   if (stored && !logged)
+   {
+      logged = true;
+      bootMark(BOOT_FIRST_SAMPLE);
+   }
+}
 
-   data_t sensor[2];
-   /*RTC sensor data */
-   struct tm time;
-   /* Pressure sensor data */
-   float temp = 0.0;
-   uint32_t pressure = 0;
+void dataTask(void *pvParameters)
+{
+#if CONFIG_LOGGER_RTC
+   /* Ends with the first RTC sample */
+   bootBegin(BOOT_CLOCK);
+#endif
 
    while (1)
    {
-      /* Wait for both queues */
-      if (xQueueReceive(realTimeClockQueue, &sensor[0], (TickType_t)100) == pdPASS &&
-          xQueueReceive(pressureSensorQueue, &sensor[1], (TickType_t)100) == pdPASS)
-      {
-         /* Verify that sensor 0 is the DS3231 */
-         if (sensor[0].event == DS3231_SENSOR)
-         {
-            /* Store data into time */
-            time = *(struct tm *)sensor[0].data0;
-         }
-         /* Verify that sensor 1 is the BMP180 */
-         if (sensor[1].event == BMP180_SENSOR)
-         {
-            /* Store data into temp & pressure */
-            temp = *(float *)sensor[1].data0;
-            pressure = *(uint32_t *)sensor[1].data1;
-         }
+      /* Sleep until sensorTask queued a sample */
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      pipeline_drain(&samplePipeline);
+   }
+}
 
-         /* Display time */
-         printf("RTC: %04d-%02d-%02d %02d:%02d:%02d\n", time.tm_year + 1900 /*Add 1900 for better readability*/, time.tm_mon + 1,
-                time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec);
-         /* Display temp & pressure */
-         printf("BMP180: Temperature: %.2f degrees Celsius; Pressure: %" PRIu32 " Pa\n", temp, pressure);
-      }
-      else
+/**
+ * @struct app_task_t main.c
+ * @brief One entry of the task topology
+ */
+typedef struct
+{
+   TaskFunction_t function;     /*!< Task function */
+   const char *name;            /*!< Task name */
+   uint32_t stack;              /*!< Stack size in bytes */
+   UBaseType_t priority;        /*!< Priority, rate-monotonic within a core */
+   BaseType_t core;             /*!< Core the task is pinned to */
+   UBaseType_t legacyPriority;  /*!< Priority before pinning, @see CONFIG_LOGGER_TASK_TOPOLOGY_LEGACY */
+   TaskHandle_t *handle;        /*!< Optional handle */
+   StackType_t *stackBuffer;    /*!< Statically allocated stack */
+   StaticTask_t *tcb;           /*!< Statically allocated task control block */
+} app_task_t;
+
+void statusTask(void *pvParameters);
+
+/*
+ * Task topology, X(function, name, stack bytes, priority, core, legacy priority, handle).
+ *
+ * On the acquisition core, shorter deadlines get higher priorities: the tick
+ * source first, then the sensor executor it notifies, then the consumer of
+ * the sensor queues. Every sensor runs inside sensorTask, @see APP_SENSOR_TABLE.
+ * Everything that may block on I/O
+ * lives on the service core. timerTask only sets up the sampling timer, whose
+ * interrupt lands on the core it was created on. Tasks are created in table
+ * order, so the timer comes after the task handles it notifies.
+ *
+ * Stack sizes follow the "recommend" column of the status report, which is
+ * measured usage plus STACK_MARGIN_PERCENT and STACK_MARGIN_BYTES. Tasks of
+ * features configured out are left out.
+ */
+#define APP_TASK_TABLE(X)                                                                                          \
+   X(sensorTask,                         "Sensor Task",     3072, 11, CORE_ACQUISITION, 4,  &sensorHandle)         \
+   X(dataTask,                           "Queue Data Task", 2560, 10, CORE_ACQUISITION, 10, &dataHandle)           \
+   X(timerTask,                          "ESP Timer Task",  1536, 12, CORE_ACQUISITION, 10, NULL)                  \
+   APP_WITH_SD(X(sdcardTask,             "SDCARD Task",     4096, 6,  CORE_SERVICE,     12, NULL))                 \
+   APP_WITH_TELEMETRY(X(telemetry_task,  "Telemetry Task",  2048, 5,  CORE_SERVICE,     5,  NULL))                 \
+   APP_WITH_STATUS(X(statusTask,         "Status Task",     3072, 4,  CORE_SERVICE,     4,  NULL))                 \
+   APP_WITH_LCD(X(lcdTask,               "LCD task",        1536, 3,  CORE_SERVICE,     3,  NULL))                 \
+   APP_WITH_TRACE(X(trace_task,          "Trace Task",      2048, 2,  CORE_SERVICE,     2,  NULL))                 \
+   APP_WITH_RANGE_READ(X(rangeTask,      "Range Task",      4096, 1,  CORE_SERVICE,     1,  NULL))
+
+/* Stack recommendation: measured peak plus a margin, rounded to 256 bytes */
+#define STACK_MARGIN_PERCENT 25
+#define STACK_MARGIN_BYTES 256
+
+/* Static storage for every table entry */
+#define APP_TASK_STORAGE(fn, name, stack, prio, core, legacy, handle) \
+   static StackType_t fn##Stack[stack];                               \
+   static StaticTask_t fn##Tcb;
+#define APP_TASK_ENTRY(fn, name, stack, prio, core, legacy, handle) \
+   {&fn, name, stack, prio, core, legacy, handle, fn##Stack, &fn##Tcb},
+
+APP_TASK_TABLE(APP_TASK_STORAGE)
+
+static const app_task_t appTasks[] = {APP_TASK_TABLE(APP_TASK_ENTRY)};
+
+#define APP_TASK_COUNT (sizeof(appTasks) / sizeof(appTasks[0]))
+
+static TaskHandle_t appTaskHandles[APP_TASK_COUNT];
+
+#if CONFIG_LOGGER_TELEMETRY
+static uint8_t telemetryRingStorage[CONFIG_LOGGER_TELEMETRY_RING_SIZE];
+static StaticRingbuffer_t telemetryRing;
+#endif
+
+#if CONFIG_LOGGER_STATUS
+/**
+ * @brief Log a timing statistic in microseconds
+ *
+ * @param name  statistic name
+ * @param stats pointer to stats object
+ */
+static void statusPrint(const char *name, const stats_t *stats)
+{
+   ESP_LOGI(STATUS_TAG, "%-14s n=%5" PRIu32 " min=%6" PRId64 " max=%6" PRId64 " mean=%6" PRId64 " sd=%6" PRId64 " us",
+            name, stats->count, stats->min, stats->max, stats_mean(stats), stats_stddev(stats));
+}
+
+/**
+ * @brief Right-sized stack for a task from its measured peak usage
+ *
+ * @param used  peak stack usage in bytes
+ * @return uint32_t recommended stack size in bytes
+ */
+static uint32_t stackRecommendation(uint32_t used)
+{
+   uint32_t size = used + used * STACK_MARGIN_PERCENT / 100 + STACK_MARGIN_BYTES;
+   return (size + 255) & ~255u;
+}
+
+/**
+ * @brief Log stack high-water marks and heap state
+ */
+static void statusMemory(void)
+{
+   int32_t reclaim = 0;
+
+   for (size_t i = 0; i < APP_TASK_COUNT; i++)
+   {
+      const app_task_t *task = &appTasks[i];
+      if (appTaskHandles[i] == NULL)
       {
-         vTaskDelay(100); /* avoid WDT */
+         continue;
       }
+      /* ESP-IDF stacks are counted in bytes */
+      uint32_t unused = uxTaskGetStackHighWaterMark(appTaskHandles[i]);
+      uint32_t used = task->stack - unused;
+      uint32_t recommend = stackRecommendation(used);
+      reclaim += (int32_t)task->stack - (int32_t)recommend;
+      ESP_LOGI(STATUS_TAG, "%-20s stack=%5" PRIu32 " used=%5" PRIu32 " free=%5" PRIu32 " recommend=%5" PRIu32,
+               task->name, task->stack, used, unused, recommend);
    }
+   ESP_LOGI(STATUS_TAG, "stack reclaimable=%" PRId32 " bytes", reclaim);
+   ESP_LOGI(STATUS_TAG, "heap free=%u min free=%u largest block=%u",
+            heap_caps_get_free_size(MALLOC_CAP_8BIT),
+            heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT),
+            heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
 }
 
-void batteryTask(void *pvParameters)
+/**
+ * @brief Log the boot stages once all ended, or after BOOT_REPORT_WAIT_MS, and send them as TELEMETRY_BOOT
+ */
+static void bootReport(void)
 {
-   /* Create an instance of battery object */
-   battery_t battery;
-
-   /* Set battery to default configuration */
-   battery_default(&battery);
+   xEventGroupWaitBits(bootEvents, BOOT_ALL, pdFALSE, pdTRUE, pdMS_TO_TICKS(BOOT_REPORT_WAIT_MS));
 
-   /* Intialize battery */
-   battery_init(&battery);
-
-   /* Disable battery */
-   battery_disable(&battery);
+   int64_t span = boot_trace_span(&bootTrace);
+   char bar[BOOT_BAR_WIDTH + 1];
+   for (uint8_t i = 0; i < APP_BOOT_COUNT; i++)
+   {
+      const boot_stage_t *stage = &bootTrace.stage[i];
+      boot_trace_bar(&bootTrace, i, span, bar, BOOT_BAR_WIDTH);
+      ESP_LOGI(BOOT_TAG, "%-12s start=%8" PRId64 " end=%8" PRId64 " us core=%u %-7s |%s|", stage->name,
+               stage->start_us, stage->end_us, stage->core,
+               stage->end_us < 0 ? "pending" : (stage->result == 0 ? "ok" : "failed"), bar);
+
+#if CONFIG_LOGGER_TELEMETRY
+      boot_record_t record;
+      boot_trace_encode(&bootTrace, i, &record);
+      telemetry_send(TELEMETRY_BOOT, &record, sizeof(record));
+#endif
+   }
 
-   /* 250 ms delay */
-   vTaskDelay(250 / portTICK_PERIOD_MS);
+   int64_t first = bootTrace.stage[BOOT_FIRST_SAMPLE].end_us;
+   if (first < 0 || first > BOOT_FIRST_SAMPLE_BUDGET_MS * 1000LL)
+   {
+      ESP_LOGW(BOOT_TAG, "first sample at %" PRId64 " us, over the %d ms budget", first, BOOT_FIRST_SAMPLE_BUDGET_MS);
+   }
+   else
+   {
+      ESP_LOGI(BOOT_TAG, "first sample at %" PRId64 " us, budget %d ms", first, BOOT_FIRST_SAMPLE_BUDGET_MS);
+   }
+}
 
-   /* Enable battery */
-   battery_enable(&battery);
+void statusTask(void *pvParameters)
+{
+   bootReport();
 
    while (1)
    {
-      /* Get voltage reading */
-      int value = battery_read(&battery);
-      printf("Value: %d\tBattery: %d\n", value, battery.value);
+      vTaskDelay(pdMS_TO_TICKS(CONFIG_LOGGER_STATUS_PERIOD_MS));
+
+      /* Timing of the sampling path */
+      statusPrint("tick latency", &tickLatency);
+      statusPrint("tick jitter", &tickJitter);
+      ESP_LOGI(STATUS_TAG, "ticks fired=%" PRIu32 " missed=%" PRIu32 " dropped=%" PRIu32, sampleTimer.clock.fired,
+               sampleTimer.clock.missed, sampleTimer.clock.dropped);
+#if CONFIG_LOGGER_SAMPLE_RATE_ADAPTIVE
+      ESP_LOGI(STATUS_TAG, "sample period %" PRIu32 " ms changes=%" PRIu32, samplePipeline.rate.period_ms,
+               samplePipeline.rate.changes);
+#endif
+#if PRESSURE_OVERSAMPLE > 1
+      ESP_LOGI(STATUS_TAG, "pressure filter readings=%" PRIu32 " samples=%" PRIu32, samplePipeline.filter.inputs,
+               samplePipeline.filter.outputs);
+#endif
+      for (size_t i = 0; i < APP_SENSOR_COUNT; i++)
+      {
+         const sensor_status_t *sensor = &sensorExec.status[i];
+         statusPrint(appSensors[i].driver->name, &sensor->latency);
+         ESP_LOGI(STATUS_TAG, "%-14s samples=%" PRIu32 " errors=%" PRIu32 "%s", appSensors[i].driver->name,
+                  sensor->samples, sensor->errors, sensor->enabled ? "" : " disabled");
+      }
+      statusPrint("sample age", &samplePipeline.age);
+      for (size_t i = 0; i < APP_SENSOR_COUNT; i++)
+      {
+         /* Copy under the lock, log outside it */
+         channel_stats_t channel;
+         pipeline_get_channel(&samplePipeline, i, &channel);
+         ESP_LOGI(STATUS_TAG, "%-14s %-11s enqueued=%" PRIu32 " dropped=%" PRIu32 " coalesced=%" PRIu32
+                              " waits=%" PRIu32 " high=%u/%d",
+                  appSensors[i].driver->name, channel_policy_name(sensorChannels[i].policy), channel.enqueued,
+                  channel.dropped, channel.coalesced, channel.waits, channel.high_water, QUEUE_SIZE);
+      }
 
-      uint16_t percentage = battery_percentage(&battery);
-      printf("Percentage: %d\n", percentage);
+      /* Wall clock */
+      epoch_clock_t clock;
+      pipeline_get_clock(&samplePipeline, &clock);
+      char now[EPOCH_TEXT_MAX];
+      epoch_format(now, epoch_clock_now(&clock, esp_timer_get_time()), 3);
+      ESP_LOGI(STATUS_TAG, "clock %s%s syncs=%" PRIu32 " steps=%" PRIu32 " max step=%" PRId64 " us", now,
+               clock.valid ? "" : " (no RTC)", clock.syncs, clock.steps, clock.max_step_us);
+#if CONFIG_LOGGER_TELEMETRY
+      ESP_LOGI(STATUS_TAG, "telemetry dropped=%" PRIu32, telemetry_dropped());
+#endif
+#if CONFIG_LOGGER_TRACE
+      ESP_LOGI(STATUS_TAG, "trace dropped=%" PRIu32, trace_dropped());
+#endif
+
+#if CONFIG_LOGGER_SD
+      /* Log storage */
+      logger_stats_t logger;
+      logger_get_stats(&logger);
+      ESP_LOGI(STATUS_TAG, "logger records=%" PRIu32 " dropped=%" PRIu32 " blocks=%" PRIu32 " writes=%" PRIu32
+                           " syncs=%" PRIu32 " partial=%" PRIu32 " errors=%" PRIu32 " free=%u low=%u flush=%s",
+               logger.records, logger.dropped, logger.blocks, logger.writes, logger.syncs, logger.partial,
+               logger.errors, logger.available, logger.low, flush_mode_name((flush_mode_t)logger.mode));
+      spill_sink_stats_t spill = spillSink.stats;
+      const spill_ring_t *ring = spillSink.ring;
+      ESP_LOGI(STATUS_TAG, "card %s attaches=%" PRIu32 " failures=%" PRIu32 " spill pending=%" PRIu32
+                           " spilled=%" PRIu32 " drained=%" PRIu32 " corrupt=%" PRIu32 " overwritten=%" PRIu32
+                           " lost=%" PRIu32,
+               spillSink.attached ? "up" : "down", spill.attaches, spill.failures, ring != NULL ? ring->count : 0,
+               spill.spilled, spill.drained, spill.corrupt, ring != NULL ? ring->stats.overwritten : 0, spill.lost);
+#endif
+#if CONFIG_LOGGER_RANGE_READ
+      range_stats_t range = rangeService.stats;
+      ESP_LOGI(STATUS_TAG, "range requests=%" PRIu32 " chunks=%" PRIu32 " retries=%" PRIu32 " bad=%" PRIu32,
+               range.requests, range.chunks, range.retries, range.bad_frames);
+#endif
 
-      vTaskDelay(1000 / portTICK_PERIOD_MS);
+      /* Memory */
+      statusMemory();
    }
 }
+#endif
 
 void app_main(void)
 {
-   /* Initialize Queue*/
-   pressureSensorQueue = xQueueCreate(QUEUE_SIZE, sizeof(data_t));
-   realTimeClockQueue = xQueueCreate(QUEUE_SIZE, sizeof(data_t));
+   /* Boot trace first, every task reports its stage to it */
+   bootEvents = xEventGroupCreateStatic(&bootEventsBuffer);
+   boot_trace_init(&bootTrace, appBootNames, APP_BOOT_COUNT);
+   bootBegin(BOOT_CORE);
+
+#if CONFIG_LOGGER_TRACE
+   /* Trace rings, before anything that may TRACE() */
+   trace_init();
+#endif
+
+   /* Sensor channels from the sensor table, the sample path between sensorTask and dataTask */
+   APP_SENSOR_TABLE(APP_SENSOR_CHANNEL)
+   samplePipeline = (pipeline_t){
+       .sensors = appSensors,
+       .channels = sensorChannels,
+       .timeouts = appSensorTimeouts,
+       .count = APP_SENSOR_COUNT,
+#if CONFIG_LOGGER_RTC
+       .rtc = SENSOR_RTC,
+       .synced = dataSynced,
+#else
+       .rtc = PIPELINE_NONE,
+#endif
+       .pressure = SENSOR_PRESSURE,
+#if CONFIG_LOGGER_BATTERY
+       .battery = SENSOR_BATTERY,
+#else
+       .battery = PIPELINE_NONE,
+#endif
+       .ready = dataReady,
+       .row = dataRow,
+#if CONFIG_LOGGER_SAMPLE_RATE_ADAPTIVE
+       .period = samplePeriodChange,
+#endif
+   };
+   if (pipeline_init(&samplePipeline) != 0)
+   {
+      ESP_LOGE(STATUS_TAG, "PIPELINE_FILTER: invalid configuration");
+   }
+
+#if CONFIG_LOGGER_RANGE_READ
+   /* Card lock, shared by the logger writer and range reads */
+   cardLock = xSemaphoreCreateMutexStatic(&cardLockBuffer);
+#endif
+
+#if CONFIG_LOGGER_TELEMETRY
+   /* Initialize telemetry stream */
+   telemetry_config_t telemetry = TELEMETRY_CONFIG_DEFAULT();
+   telemetry.baudrate = CONFIG_LOGGER_TELEMETRY_BAUDRATE;
+   telemetry.ring_size = CONFIG_LOGGER_TELEMETRY_RING_SIZE;
+   telemetry.ring_storage = telemetryRingStorage;
+   telemetry.ring_buffer = &telemetryRing;
+   ESP_ERROR_CHECK(telemetry_init(&telemetry));
+#endif
+
+#if CONFIG_LOGGER_SD
+   /* Log block pool, filled by dataTask and drained by sdcardTask */
+   ESP_ERROR_CHECK(logger_init());
 
-   /* Create mutex for i2c devices */
+   /* Last run browned out: write and sync eagerly for the first minute */
+   if (esp_reset_reason() == ESP_RST_BROWNOUT)
+   {
+      logger_flag_event();
+   }
+#endif
+
+   /* Create mutex for i2c devices, before sensorTask opens them */
    ESP_ERROR_CHECK(i2cdev_init());
-   /* Create SD Card task */
-   xTaskCreate(&sdcardTask, "SDCARD Task", 4096, NULL, 12, NULL);
-   /* Create LCD task */
-   xTaskCreate(&lcdTask, "LCD task", 2048, NULL, 3, NULL);
-   /* Create bmp180 task */
-   xTaskCreate(&bmp180Task, "BMP180 Task", 1920, NULL, 4, &sensorHandle);
-   /* Create RTC task */
-   xTaskCreate(&rtcTask, "RTC Task", 2048, NULL, 4, &rtcHandle);
-   /* Create timer task @ 1 second trigger  */
-   xTaskCreate(&timerTask, "ESP Timer Task", 2048, NULL, 10, NULL);
-
-   /* Create temp task to display queue data*/
-   xTaskCreate(&dataTask, "Queue Data Task", 2048, NULL, 10, NULL);
-
-   /* Create battery reading task */
-   xTaskCreate(&batteryTask, "Battery reading task", 1024, NULL, 10, &batteryHandle);
-}
\ No newline at end of file
+   bootEnd(BOOT_CORE, 0);
+
+   /* Create every task from the topology table, the stages run in them */
+   for (size_t i = 0; i < APP_TASK_COUNT; i++)
+   {
+      const app_task_t *task = &appTasks[i];
+#if CONFIG_LOGGER_TASK_TOPOLOGY_LEGACY
+      appTaskHandles[i] = xTaskCreateStaticPinnedToCore(task->function, task->name, task->stack, NULL,
+                                                        task->legacyPriority, task->stackBuffer, task->tcb,
+                                                        tskNO_AFFINITY);
+#else
+      appTaskHandles[i] = xTaskCreateStaticPinnedToCore(task->function, task->name, task->stack, NULL,
+                                                        task->priority, task->stackBuffer, task->tcb, task->core);
+#endif
+      if (task->handle != NULL)
+      {
+         *task->handle = appTaskHandles[i];
+      }
+   }
+}
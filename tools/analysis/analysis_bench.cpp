@@ -0,0 +1,179 @@
+/**
+ * @file analysis_bench.cpp
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Compare every analysis kernel against its scalar version
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ### Example
+ * ~~~
+ * analysis_bench            # 8M samples
+ * analysis_bench 33554432   # 32M samples
+ * ~~~
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include "kernels.h"
+
+using analysis::Isa;
+
+namespace
+{
+
+constexpr int REPS = 7;
+
+/**
+ * @brief Best of REPS runs in seconds
+ */
+double time_best(const std::function<void()> &fn)
+{
+    fn(); /* warmup */
+    double best = 1e30;
+    for (int i = 0; i < REPS; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+bool report(const char *kernel, Isa isa, double seconds, double scalar, size_t n, bool match)
+{
+    std::printf("%-16s %-8s %10.3f ms %10.1f Msamples/s %7.2fx  %s\n", kernel, analysis::isa_name(isa),
+                seconds * 1e3, (double)n / seconds * 1e-6, scalar / seconds, match ? "ok" : "MISMATCH");
+    return match;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    size_t n = (size_t)8 << 20;
+    if (argc > 1)
+    {
+        char *end = nullptr;
+        n = (size_t)std::strtoull(argv[1], &end, 10);
+        /* Resampling needs two samples to span */
+        if (argc > 2 || *end != '\0' || n < 2)
+        {
+            std::fprintf(stderr, "usage: %s [samples, at least 2]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    /* Synthetic logger data: jittered 1 Hz timestamps, pressure around 1 atm */
+    std::vector<int64_t> time_us(n);
+    std::vector<int32_t> pressure_pa(n);
+    uint32_t noise = 12345;
+    int64_t t = 1666811220000000LL;
+    for (size_t i = 0; i < n; i++)
+    {
+        noise = noise * 1664525u + 1013904223u;
+        t += 1000000 + (int64_t)(noise >> 22) - 512;
+        time_us[i] = t;
+        pressure_pa[i] = 101325 + (int32_t)(300.0 * std::sin((double)i * 1e-4)) + (int32_t)(noise % 41) - 20;
+    }
+
+    std::vector<Isa> isas = {Isa::Scalar, Isa::Sse, Isa::Avx2};
+    isas.erase(std::remove_if(isas.begin(), isas.end(), [](Isa i) { return !analysis::isa_supported(i); }),
+               isas.end());
+
+    std::printf("%zu samples, best isa: %s\n\n", n, analysis::isa_name(Isa::Best));
+
+    /* to_float */
+    std::vector<float> ref(n), out(n);
+    double scalar = 0.0;
+    bool ok = true;
+    for (Isa isa : isas)
+    {
+        std::vector<float> &dst = isa == Isa::Scalar ? ref : out;
+        double s = time_best([&] { analysis::to_float(pressure_pa.data(), n, 1.0f, dst.data(), isa); });
+        scalar = isa == Isa::Scalar ? s : scalar;
+        ok &= report("to_float", isa, s, scalar, n, isa == Isa::Scalar || ref == out);
+    }
+    std::vector<float> y = ref;
+
+    /* to_seconds */
+    for (Isa isa : isas)
+    {
+        std::vector<float> &dst = isa == Isa::Scalar ? ref : out;
+        double s = time_best([&] { analysis::to_seconds(time_us.data(), n, time_us[0], dst.data(), isa); });
+        scalar = isa == Isa::Scalar ? s : scalar;
+        ok &= report("to_seconds", isa, s, scalar, n, isa == Isa::Scalar || ref == out);
+    }
+    std::vector<float> x = ref;
+
+    /* window_reduce, 60 samples = one minute */
+    const size_t window = 60;
+    const size_t windows = (n + window - 1) / window;
+    std::vector<float> mn_ref(windows), mx_ref(windows), mn(windows), mx(windows);
+    std::vector<double> mean_ref(windows), mean(windows);
+    for (Isa isa : isas)
+    {
+        bool base = isa == Isa::Scalar;
+        double s = time_best([&] {
+            analysis::window_reduce(y.data(), n, window, base ? mn_ref.data() : mn.data(),
+                                    base ? mx_ref.data() : mx.data(), base ? mean_ref.data() : mean.data(), isa);
+        });
+        scalar = base ? s : scalar;
+        bool match = base;
+        if (!base)
+        {
+            match = mn == mn_ref && mx == mx_ref;
+            for (size_t w = 0; match && w < windows; w++)
+            {
+                match = std::fabs(mean[w] - mean_ref[w]) <= 1e-9 * std::fabs(mean_ref[w]);
+            }
+        }
+        ok &= report("window_reduce", isa, s, scalar, n, match);
+    }
+
+    /* resample_linear onto a 1 s grid */
+    const int64_t step = 1000000;
+    const size_t count = (size_t)((time_us[n - 1] - time_us[0]) / step);
+    std::vector<float> rs_ref(count), rs(count);
+    for (Isa isa : isas)
+    {
+        bool base = isa == Isa::Scalar;
+        double s = time_best([&] {
+            analysis::resample_linear(time_us.data(), y.data(), n, time_us[0], step, count,
+                                      base ? rs_ref.data() : rs.data(), isa);
+        });
+        scalar = base ? s : scalar;
+        bool match = base;
+        if (!base)
+        {
+            match = true;
+            for (size_t k = 0; match && k < count; k++)
+            {
+                match = rs[k] == rs_ref[k]; /* same operations in the same order, no FMA */
+            }
+        }
+        ok &= report("resample_linear", isa, s, scalar, count, match);
+    }
+
+    /* lttb down to 2000 plot points */
+    const size_t points = 2000;
+    std::vector<uint32_t> ix_ref(points), ix(points);
+    for (Isa isa : isas)
+    {
+        bool base = isa == Isa::Scalar;
+        double s = time_best([&] {
+            analysis::lttb(x.data(), y.data(), n, points, base ? ix_ref.data() : ix.data(), isa);
+        });
+        scalar = base ? s : scalar;
+        ok &= report("lttb", isa, s, scalar, n, base || ix == ix_ref);
+    }
+    std::printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
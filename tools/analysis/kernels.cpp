@@ -0,0 +1,729 @@
+/**
+ * @file kernels.cpp
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Vectorized aggregation and resampling kernels for logged channels
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * SIMD variants are compiled with per-function target attributes, so the
+ * library builds with the default compiler flags and still runs on any
+ * x86-64 (or non-x86) host; dispatch happens at runtime.
+ */
+
+#include "kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KERNELS_X86 1
+#define TARGET_SSE __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define KERNELS_X86 0
+#endif
+
+namespace analysis
+{
+
+namespace
+{
+
+constexpr size_t TILE = 64; /* resample outputs handled per tile */
+
+/**
+ * @brief Resolve Isa::Best and fall back when the CPU lacks the request
+ */
+Isa resolve(Isa isa)
+{
+    if (isa == Isa::Best || !isa_supported(isa))
+    {
+        return best_isa();
+    }
+    return isa;
+}
+
+/* ------------------------------------------------------------------ */
+/* Scalar                                                             */
+/* ------------------------------------------------------------------ */
+
+void to_float_scalar(const int32_t *src, size_t n, float scale, float *dst)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        dst[i] = (float)src[i] * scale;
+    }
+}
+
+void to_seconds_scalar(const int64_t *t, size_t n, int64_t origin, float *dst)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        dst[i] = (float)((double)(t[i] - origin) * 1e-6);
+    }
+}
+
+void window_scalar(const float *x, size_t s, size_t e, float *mn, float *mx, double *mean)
+{
+    float lo = x[s];
+    float hi = x[s];
+    double sum = 0.0;
+    for (size_t i = s; i < e; i++)
+    {
+        lo = std::min(lo, x[i]);
+        hi = std::max(hi, x[i]);
+        sum += x[i];
+    }
+    *mn = lo;
+    *mx = hi;
+    *mean = sum / (double)(e - s);
+}
+
+/**
+ * @brief Interpolation plan for one tile: y[idx] + num / den * (y[idx + 1] - y[idx])
+ *
+ * The search over the timestamps is inherently sequential and shared by all
+ * variants; only the gather, divide and lerp are vectorized.
+ */
+size_t resample_plan(const int64_t *t, size_t n, int64_t start, int64_t step, size_t first, size_t count,
+                     size_t cursor, int32_t *idx, float *num, float *den)
+{
+    for (size_t k = 0; k < count; k++)
+    {
+        int64_t tk = start + (int64_t)(first + k) * step;
+        while (cursor + 2 < n && t[cursor + 1] <= tk)
+        {
+            cursor++;
+        }
+        idx[k] = (int32_t)cursor;
+        if (tk <= t[0])
+        {
+            num[k] = 0.0f;
+            den[k] = 1.0f;
+        }
+        else if (tk >= t[n - 1])
+        {
+            num[k] = 1.0f;
+            den[k] = 1.0f;
+        }
+        else
+        {
+            num[k] = (float)(tk - t[cursor]);
+            den[k] = (float)(t[cursor + 1] - t[cursor]);
+        }
+    }
+    return cursor;
+}
+
+void lerp_scalar(const float *y, const int32_t *idx, const float *num, const float *den, size_t count, float *out)
+{
+    for (size_t k = 0; k < count; k++)
+    {
+        float y0 = y[idx[k]];
+        float y1 = y[idx[k] + 1];
+        out[k] = y0 + (num[k] / den[k]) * (y1 - y0);
+    }
+}
+
+/**
+ * @brief Index of the largest |p * y + q * x + r| in [s, e), first one wins ties
+ */
+size_t argmax_scalar(const float *x, const float *y, size_t s, size_t e, float p, float q, float r)
+{
+    size_t best = s;
+    float best_area = -1.0f;
+    for (size_t j = s; j < e; j++)
+    {
+        float area = std::fabs((p * y[j] + q * x[j]) + r);
+        if (area > best_area)
+        {
+            best_area = area;
+            best = j;
+        }
+    }
+    return best;
+}
+
+#if KERNELS_X86
+
+/* ------------------------------------------------------------------ */
+/* SSE                                                                */
+/* ------------------------------------------------------------------ */
+
+TARGET_SSE void to_float_sse(const int32_t *src, size_t n, float scale, float *dst)
+{
+    const __m128 vs = _mm_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), vs));
+    }
+    to_float_scalar(src + i, n - i, scale, dst + i);
+}
+
+/**
+ * @brief Exact int64 -> double for 0 <= v < 2^52 using the exponent trick
+ */
+TARGET_SSE inline __m128d u52_to_pd_sse(__m128i v)
+{
+    const __m128i magic_i = _mm_set1_epi64x(0x4330000000000000LL);
+    const __m128d magic_d = _mm_set1_pd(4503599627370496.0);
+    return _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(v, magic_i)), magic_d);
+}
+
+TARGET_SSE void to_seconds_sse(const int64_t *t, size_t n, int64_t origin, float *dst)
+{
+    const __m128i vo = _mm_set1_epi64x(origin);
+    const __m128d us = _mm_set1_pd(1e-6);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i a = _mm_sub_epi64(_mm_loadu_si128((const __m128i *)(t + i)), vo);
+        __m128i b = _mm_sub_epi64(_mm_loadu_si128((const __m128i *)(t + i + 2)), vo);
+        /* Negative offsets are outside the exact range, finish in scalar */
+        if (_mm_movemask_pd(_mm_castsi128_pd(_mm_or_si128(a, b))) != 0)
+        {
+            break;
+        }
+        __m128 lo = _mm_cvtpd_ps(_mm_mul_pd(u52_to_pd_sse(a), us));
+        __m128 hi = _mm_cvtpd_ps(_mm_mul_pd(u52_to_pd_sse(b), us));
+        _mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+    }
+    to_seconds_scalar(t + i, n - i, origin, dst + i);
+}
+
+TARGET_SSE void window_sse(const float *x, size_t s, size_t e, float *mn, float *mx, double *mean)
+{
+    __m128 lo = _mm_set1_ps(x[s]);
+    __m128 hi = lo;
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    size_t i = s;
+    for (; i + 4 <= e; i += 4)
+    {
+        __m128 v = _mm_loadu_ps(x + i);
+        lo = _mm_min_ps(lo, v);
+        hi = _mm_max_ps(hi, v);
+        sum0 = _mm_add_pd(sum0, _mm_cvtps_pd(v));
+        sum1 = _mm_add_pd(sum1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    float l[4], h[4];
+    double sd[2];
+    _mm_storeu_ps(l, lo);
+    _mm_storeu_ps(h, hi);
+    _mm_storeu_pd(sd, _mm_add_pd(sum0, sum1));
+    float rl = std::min(std::min(l[0], l[1]), std::min(l[2], l[3]));
+    float rh = std::max(std::max(h[0], h[1]), std::max(h[2], h[3]));
+    double sum = sd[0] + sd[1];
+    for (; i < e; i++)
+    {
+        rl = std::min(rl, x[i]);
+        rh = std::max(rh, x[i]);
+        sum += x[i];
+    }
+    *mn = rl;
+    *mx = rh;
+    *mean = sum / (double)(e - s);
+}
+
+TARGET_SSE void lerp_sse(const float *y, const int32_t *idx, const float *num, const float *den, size_t count,
+                         float *out)
+{
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4)
+    {
+        /* No gather in SSE: assemble the lanes by hand */
+        __m128 y0 = _mm_setr_ps(y[idx[k]], y[idx[k + 1]], y[idx[k + 2]], y[idx[k + 3]]);
+        __m128 y1 = _mm_setr_ps(y[idx[k] + 1], y[idx[k + 1] + 1], y[idx[k + 2] + 1], y[idx[k + 3] + 1]);
+        __m128 f = _mm_div_ps(_mm_loadu_ps(num + k), _mm_loadu_ps(den + k));
+        _mm_storeu_ps(out + k, _mm_add_ps(y0, _mm_mul_ps(f, _mm_sub_ps(y1, y0))));
+    }
+    lerp_scalar(y, idx + k, num + k, den + k, count - k, out + k);
+}
+
+TARGET_SSE size_t argmax_sse(const float *x, const float *y, size_t s, size_t e, float p, float q, float r)
+{
+    if (e - s < 8)
+    {
+        return argmax_scalar(x, y, s, e, p, q, r);
+    }
+    const __m128 vp = _mm_set1_ps(p);
+    const __m128 vq = _mm_set1_ps(q);
+    const __m128 vr = _mm_set1_ps(r);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 best = _mm_set1_ps(-1.0f);
+    __m128i best_idx = _mm_setzero_si128();
+    __m128i cur = _mm_setr_epi32((int)s, (int)s + 1, (int)s + 2, (int)s + 3);
+    const __m128i four = _mm_set1_epi32(4);
+    size_t j = s;
+    for (; j + 4 <= e; j += 4)
+    {
+        __m128 area = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vp, _mm_loadu_ps(y + j)), _mm_mul_ps(vq, _mm_loadu_ps(x + j))), vr);
+        area = _mm_and_ps(area, abs_mask);
+        __m128 gt = _mm_cmpgt_ps(area, best);
+        best = _mm_blendv_ps(best, area, gt);
+        best_idx = _mm_blendv_epi8(best_idx, cur, _mm_castps_si128(gt));
+        cur = _mm_add_epi32(cur, four);
+    }
+    float a[4];
+    int32_t ix[4];
+    _mm_storeu_ps(a, best);
+    _mm_storeu_si128((__m128i *)ix, best_idx);
+    /* Largest area, smallest index among equals: same pick as the scalar loop */
+    size_t pick = (size_t)ix[0];
+    float pick_area = a[0];
+    for (int l = 1; l < 4; l++)
+    {
+        if (a[l] > pick_area || (a[l] == pick_area && (size_t)ix[l] < pick))
+        {
+            pick_area = a[l];
+            pick = (size_t)ix[l];
+        }
+    }
+    for (; j < e; j++)
+    {
+        float area = std::fabs((p * y[j] + q * x[j]) + r);
+        if (area > pick_area)
+        {
+            pick_area = area;
+            pick = j;
+        }
+    }
+    return pick;
+}
+
+/* ------------------------------------------------------------------ */
+/* AVX2                                                               */
+/* ------------------------------------------------------------------ */
+
+TARGET_AVX2 void to_float_avx2(const int32_t *src, size_t n, float scale, float *dst)
+{
+    const __m256 vs = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), vs));
+    }
+    to_float_scalar(src + i, n - i, scale, dst + i);
+}
+
+TARGET_AVX2 inline __m256d u52_to_pd_avx2(__m256i v)
+{
+    const __m256i magic_i = _mm256_set1_epi64x(0x4330000000000000LL);
+    const __m256d magic_d = _mm256_set1_pd(4503599627370496.0);
+    return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(v, magic_i)), magic_d);
+}
+
+TARGET_AVX2 void to_seconds_avx2(const int64_t *t, size_t n, int64_t origin, float *dst)
+{
+    const __m256i vo = _mm256_set1_epi64x(origin);
+    const __m256d us = _mm256_set1_pd(1e-6);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i a = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i *)(t + i)), vo);
+        __m256i b = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i *)(t + i + 4)), vo);
+        if (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_or_si256(a, b))) != 0)
+        {
+            break;
+        }
+        __m128 lo = _mm256_cvtpd_ps(_mm256_mul_pd(u52_to_pd_avx2(a), us));
+        __m128 hi = _mm256_cvtpd_ps(_mm256_mul_pd(u52_to_pd_avx2(b), us));
+        _mm256_storeu_ps(dst + i, _mm256_set_m128(hi, lo));
+    }
+    to_seconds_scalar(t + i, n - i, origin, dst + i);
+}
+
+TARGET_AVX2 void window_avx2(const float *x, size_t s, size_t e, float *mn, float *mx, double *mean)
+{
+    __m256 lo = _mm256_set1_ps(x[s]);
+    __m256 hi = lo;
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    size_t i = s;
+    for (; i + 8 <= e; i += 8)
+    {
+        __m256 v = _mm256_loadu_ps(x + i);
+        lo = _mm256_min_ps(lo, v);
+        hi = _mm256_max_ps(hi, v);
+        sum0 = _mm256_add_pd(sum0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        sum1 = _mm256_add_pd(sum1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    float l[8], h[8];
+    double sd[4];
+    _mm256_storeu_ps(l, lo);
+    _mm256_storeu_ps(h, hi);
+    _mm256_storeu_pd(sd, _mm256_add_pd(sum0, sum1));
+    float rl = *std::min_element(l, l + 8);
+    float rh = *std::max_element(h, h + 8);
+    double sum = (sd[0] + sd[1]) + (sd[2] + sd[3]);
+    for (; i < e; i++)
+    {
+        rl = std::min(rl, x[i]);
+        rh = std::max(rh, x[i]);
+        sum += x[i];
+    }
+    *mn = rl;
+    *mx = rh;
+    *mean = sum / (double)(e - s);
+}
+
+TARGET_AVX2 void lerp_avx2(const float *y, const int32_t *idx, const float *num, const float *den, size_t count,
+                           float *out)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8)
+    {
+        __m256i i0 = _mm256_loadu_si256((const __m256i *)(idx + k));
+        __m256 y0 = _mm256_i32gather_ps(y, i0, 4);
+        __m256 y1 = _mm256_i32gather_ps(y, _mm256_add_epi32(i0, one), 4);
+        __m256 f = _mm256_div_ps(_mm256_loadu_ps(num + k), _mm256_loadu_ps(den + k));
+        _mm256_storeu_ps(out + k, _mm256_add_ps(y0, _mm256_mul_ps(f, _mm256_sub_ps(y1, y0))));
+    }
+    lerp_scalar(y, idx + k, num + k, den + k, count - k, out + k);
+}
+
+TARGET_AVX2 size_t argmax_avx2(const float *x, const float *y, size_t s, size_t e, float p, float q, float r)
+{
+    if (e - s < 16)
+    {
+        return argmax_scalar(x, y, s, e, p, q, r);
+    }
+    const __m256 vp = _mm256_set1_ps(p);
+    const __m256 vq = _mm256_set1_ps(q);
+    const __m256 vr = _mm256_set1_ps(r);
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 best = _mm256_set1_ps(-1.0f);
+    __m256i best_idx = _mm256_setzero_si256();
+    __m256i cur = _mm256_add_epi32(_mm256_set1_epi32((int)s), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256i eight = _mm256_set1_epi32(8);
+    size_t j = s;
+    for (; j + 8 <= e; j += 8)
+    {
+        /* Same operation order as the scalar loop, no FMA, identical areas */
+        __m256 area = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(vp, _mm256_loadu_ps(y + j)), _mm256_mul_ps(vq, _mm256_loadu_ps(x + j))), vr);
+        area = _mm256_and_ps(area, abs_mask);
+        __m256 gt = _mm256_cmp_ps(area, best, _CMP_GT_OQ);
+        best = _mm256_blendv_ps(best, area, gt);
+        best_idx = _mm256_blendv_epi8(best_idx, cur, _mm256_castps_si256(gt));
+        cur = _mm256_add_epi32(cur, eight);
+    }
+    float a[8];
+    int32_t ix[8];
+    _mm256_storeu_ps(a, best);
+    _mm256_storeu_si256((__m256i *)ix, best_idx);
+    size_t pick = (size_t)ix[0];
+    float pick_area = a[0];
+    for (int l = 1; l < 8; l++)
+    {
+        if (a[l] > pick_area || (a[l] == pick_area && (size_t)ix[l] < pick))
+        {
+            pick_area = a[l];
+            pick = (size_t)ix[l];
+        }
+    }
+    for (; j < e; j++)
+    {
+        float area = std::fabs((p * y[j] + q * x[j]) + r);
+        if (area > pick_area)
+        {
+            pick_area = area;
+            pick = j;
+        }
+    }
+    return pick;
+}
+
+#endif /* KERNELS_X86 */
+
+} // namespace
+
+/**
+ * @brief Widest instruction set supported by this CPU
+ *
+ * @return Isa Avx2, Sse or Scalar
+ */
+Isa best_isa()
+{
+#if KERNELS_X86
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return Isa::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return Isa::Sse;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+/**
+ * @brief Check if a variant can run on this CPU
+ *
+ * @param isa   instruction set
+ * @return true supported
+ */
+bool isa_supported(Isa isa)
+{
+    switch (isa)
+    {
+    case Isa::Best:
+    case Isa::Scalar:
+        return true;
+#if KERNELS_X86
+    case Isa::Sse:
+        return __builtin_cpu_supports("sse4.1");
+    case Isa::Avx2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Printable instruction set name
+ */
+const char *isa_name(Isa isa)
+{
+    switch (resolve(isa))
+    {
+    case Isa::Sse:
+        return "sse4.1";
+    case Isa::Avx2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+/**
+ * @brief Convert a fixed-point integer column to float
+ *
+ * @param src   integer column (pressure in Pa, temperature in 0.01 C, ...)
+ * @param n     number of values
+ * @param scale multiplier, e.g. 0.01f for temperature
+ * @param dst   float column
+ * @param isa   instruction set
+ */
+void to_float(const int32_t *src, size_t n, float scale, float *dst, Isa isa)
+{
+    switch (resolve(isa))
+    {
+#if KERNELS_X86
+    case Isa::Avx2:
+        to_float_avx2(src, n, scale, dst);
+        return;
+    case Isa::Sse:
+        to_float_sse(src, n, scale, dst);
+        return;
+#endif
+    default:
+        to_float_scalar(src, n, scale, dst);
+    }
+}
+
+/**
+ * @brief Convert epoch microseconds to float seconds since @p origin_us
+ *
+ * @param time_us   time column
+ * @param n         number of values
+ * @param origin_us time that maps to 0.0
+ * @param dst       float seconds
+ * @param isa       instruction set
+ */
+void to_seconds(const int64_t *time_us, size_t n, int64_t origin_us, float *dst, Isa isa)
+{
+    switch (resolve(isa))
+    {
+#if KERNELS_X86
+    case Isa::Avx2:
+        to_seconds_avx2(time_us, n, origin_us, dst);
+        return;
+    case Isa::Sse:
+        to_seconds_sse(time_us, n, origin_us, dst);
+        return;
+#endif
+    default:
+        to_seconds_scalar(time_us, n, origin_us, dst);
+    }
+}
+
+/**
+ * @brief Min, max and mean over consecutive windows
+ *
+ * Writes ceil(n / window) results; the last window may be shorter.
+ *
+ * @param x         input column
+ * @param n         number of values
+ * @param window    values per window
+ * @param min       window minimum
+ * @param max       window maximum
+ * @param mean      window mean, accumulated in double
+ * @param isa       instruction set
+ */
+void window_reduce(const float *x, size_t n, size_t window, float *min, float *max, double *mean, Isa isa)
+{
+    if (window == 0)
+    {
+        return;
+    }
+    isa = resolve(isa);
+    for (size_t w = 0, s = 0; s < n; w++, s += window)
+    {
+        size_t e = std::min(n, s + window);
+        switch (isa)
+        {
+#if KERNELS_X86
+        case Isa::Avx2:
+            window_avx2(x, s, e, &min[w], &max[w], &mean[w]);
+            break;
+        case Isa::Sse:
+            window_sse(x, s, e, &min[w], &max[w], &mean[w]);
+            break;
+#endif
+        default:
+            window_scalar(x, s, e, &min[w], &max[w], &mean[w]);
+        }
+    }
+}
+
+/**
+ * @brief Resample irregular samples onto a uniform grid by linear interpolation
+ *
+ * Grid points before the first or after the last sample hold the edge value.
+ *
+ * @param time_us   sorted sample times
+ * @param y         sample values
+ * @param n         number of samples
+ * @param start_us  first grid time
+ * @param step_us   grid spacing
+ * @param count     number of grid points
+ * @param out       resampled values
+ * @param isa       instruction set
+ */
+void resample_linear(const int64_t *time_us, const float *y, size_t n, int64_t start_us, int64_t step_us,
+                     size_t count, float *out, Isa isa)
+{
+    if (n == 0)
+    {
+        return;
+    }
+    if (n == 1)
+    {
+        std::fill(out, out + count, y[0]);
+        return;
+    }
+    isa = resolve(isa);
+
+    int32_t idx[TILE];
+    float num[TILE];
+    float den[TILE];
+    size_t cursor = 0;
+    for (size_t first = 0; first < count; first += TILE)
+    {
+        size_t m = std::min(TILE, count - first);
+        cursor = resample_plan(time_us, n, start_us, step_us, first, m, cursor, idx, num, den);
+        switch (isa)
+        {
+#if KERNELS_X86
+        case Isa::Avx2:
+            lerp_avx2(y, idx, num, den, m, out + first);
+            break;
+        case Isa::Sse:
+            lerp_sse(y, idx, num, den, m, out + first);
+            break;
+#endif
+        default:
+            lerp_scalar(y, idx, num, den, m, out + first);
+        }
+    }
+}
+
+/**
+ * @brief Largest-Triangle-Three-Buckets downsampling for plotting
+ *
+ * @param x         sample x (e.g. seconds from to_seconds())
+ * @param y         sample values
+ * @param n         number of samples
+ * @param threshold number of points to keep
+ * @param index     indices of the kept samples, min(n, threshold) entries
+ * @param isa       instruction set
+ * @return size_t   number of indices written
+ */
+size_t lttb(const float *x, const float *y, size_t n, size_t threshold, uint32_t *index, Isa isa)
+{
+    if (threshold >= n || threshold < 3)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            index[i] = (uint32_t)i;
+        }
+        return n;
+    }
+    isa = resolve(isa);
+
+    const double every = (double)(n - 2) / (double)(threshold - 2);
+    size_t a = 0;
+    size_t out = 0;
+    index[out++] = 0;
+
+    for (size_t b = 0; b < threshold - 2; b++)
+    {
+        /* Average of the next bucket (the last point for the final bucket) */
+        size_t avg_s = (size_t)std::floor((double)(b + 1) * every) + 1;
+        size_t avg_e = std::min(n, (size_t)std::floor((double)(b + 2) * every) + 1);
+        if (avg_s >= avg_e)
+        {
+            avg_s = n - 1;
+            avg_e = n;
+        }
+        double sx = 0.0;
+        double sy = 0.0;
+        for (size_t j = avg_s; j < avg_e; j++)
+        {
+            sx += x[j];
+            sy += y[j];
+        }
+        float cx = (float)(sx / (double)(avg_e - avg_s));
+        float cy = (float)(sy / (double)(avg_e - avg_s));
+
+        /* Triangle area with a and c is linear in the candidate: |p * y + q * x + r| */
+        size_t s = (size_t)std::floor((double)b * every) + 1;
+        size_t e = std::min(n - 1, (size_t)std::floor((double)(b + 1) * every) + 1);
+        float ax = x[a];
+        float ay = y[a];
+        float p = ax - cx;
+        float q = cy - ay;
+        float r = -(p * ay) - ax * q;
+
+        switch (isa)
+        {
+#if KERNELS_X86
+        case Isa::Avx2:
+            a = argmax_avx2(x, y, s, e, p, q, r);
+            break;
+        case Isa::Sse:
+            a = argmax_sse(x, y, s, e, p, q, r);
+            break;
+#endif
+        default:
+            a = argmax_scalar(x, y, s, e, p, q, r);
+        }
+        index[out++] = (uint32_t)a;
+    }
+
+    index[out++] = (uint32_t)(n - 1);
+    return out;
+}
+
+} // namespace analysis
@@ -0,0 +1,57 @@
+/**
+ * @file kernels.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Vectorized aggregation and resampling kernels for logged channels
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every kernel has a scalar, an SSE and an AVX2 implementation with the same
+ * result: the float kernels do the same operations in the same order, with
+ * no FMA and built with -ffp-contract=off. Isa::Best picks the widest one the
+ * running CPU supports.
+ */
+#ifndef _KERNELS_H_
+#define _KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace analysis
+{
+
+/**
+ * @enum Isa kernels.h
+ * @brief Instruction set used by a kernel
+ */
+enum class Isa
+{
+    Best,   /*!< Widest supported at runtime */
+    Scalar, /*!< Portable C++ */
+    Sse,    /*!< SSE4.1, 4 floats per op */
+    Avx2,   /*!< AVX2 + FMA, 8 floats per op */
+};
+
+Isa best_isa();
+
+bool isa_supported(Isa isa);
+
+const char *isa_name(Isa isa);
+
+void to_float(const int32_t *src, size_t n, float scale, float *dst, Isa isa = Isa::Best);
+
+void to_seconds(const int64_t *time_us, size_t n, int64_t origin_us, float *dst, Isa isa = Isa::Best);
+
+void window_reduce(const float *x, size_t n, size_t window, float *min, float *max, double *mean,
+                   Isa isa = Isa::Best);
+
+void resample_linear(const int64_t *time_us, const float *y, size_t n, int64_t start_us, int64_t step_us,
+                     size_t count, float *out, Isa isa = Isa::Best);
+
+size_t lttb(const float *x, const float *y, size_t n, size_t threshold, uint32_t *index,
+            Isa isa = Isa::Best);
+
+} // namespace analysis
+
+#endif
@@ -0,0 +1,284 @@
+/**
+ * @file bench.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Microbenchmark runner: warmup, repetitions, summary, JSON and baseline compare
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * JSON results are written one case per line so bench_compare() can read a
+ * baseline back without a JSON parser:
+ * ~~~
+ * {"suite": "perf", "results": [
+ *   {"name": "battery_percentage", "ops": 4194304, "reps": 15, "min_ns": 2.01, "median_ns": 2.05, ...},
+ *   ...
+ * ]}
+ * ~~~
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+
+volatile uint64_t bench_sink; /* Keeps results of benchmarked code alive */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Time one case
+ *
+ * @param config    runner settings
+ * @param bench     case
+ * @param result    summary
+ * @return true the case ran, false it was filtered out
+ */
+bool bench_run(const bench_config_t *config, const bench_case_t *bench, bench_result_t *result)
+{
+    double rep_ns[BENCH_MAX_REPS];
+    uint32_t reps = config->reps < 1 ? 1 : config->reps > BENCH_MAX_REPS ? BENCH_MAX_REPS : config->reps;
+
+    if (config->filter != NULL && strstr(bench->name, config->filter) == NULL)
+    {
+        return false;
+    }
+
+    /* Calibrate: double the operations until one repetition is long enough */
+    uint64_t ops = 1;
+    uint64_t min_ns = (uint64_t)config->min_rep_ms * 1000000u;
+    for (;;)
+    {
+        uint64_t start = now_ns();
+        bench->run(bench->ctx, ops);
+        if (now_ns() - start >= min_ns || ops >= (UINT64_C(1) << 40))
+        {
+            break;
+        }
+        ops *= 2;
+    }
+
+    /* Warmup */
+    for (uint64_t start = now_ns(); now_ns() - start < (uint64_t)config->warmup_ms * 1000000u;)
+    {
+        bench->run(bench->ctx, ops);
+    }
+
+    /* Timed repetitions, counters over all of them */
+    uint64_t before[BENCH_MAX_COUNTERS] = {0};
+    for (int c = 0; c < BENCH_MAX_COUNTERS; c++)
+    {
+        before[c] = bench->counter[c].value != NULL ? *bench->counter[c].value : 0;
+    }
+    double sum = 0.0, sum_sq = 0.0;
+    for (uint32_t r = 0; r < reps; r++)
+    {
+        uint64_t start = now_ns();
+        bench->run(bench->ctx, ops);
+        rep_ns[r] = (double)(now_ns() - start) / (double)ops;
+        sum += rep_ns[r];
+        sum_sq += rep_ns[r] * rep_ns[r];
+    }
+
+    memset(result, 0, sizeof(*result));
+    for (int c = 0; c < BENCH_MAX_COUNTERS; c++)
+    {
+        if (bench->counter[c].value != NULL)
+        {
+            result->counter_name[c] = bench->counter[c].name;
+            result->counter[c] = (double)(*bench->counter[c].value - before[c]) / ((double)ops * reps);
+        }
+    }
+    qsort(rep_ns, reps, sizeof(rep_ns[0]), compare_double);
+    result->name = bench->name;
+    result->ops = ops;
+    result->reps = reps;
+    result->min = rep_ns[0];
+    result->max = rep_ns[reps - 1];
+    result->median = reps % 2 ? rep_ns[reps / 2] : (rep_ns[reps / 2 - 1] + rep_ns[reps / 2]) / 2.0;
+    result->mean = sum / reps;
+    double var = sum_sq / reps - result->mean * result->mean;
+    result->stddev = var > 0.0 ? sqrt(var) : 0.0;
+    return true;
+}
+
+/**
+ * @brief Column titles for bench_print()
+ */
+void bench_print_header(FILE *out)
+{
+    fprintf(out, "%-28s %12s %10s %10s %10s %7s  %s\n", "case", "ops/rep", "min ns", "median ns", "max ns",
+            "sd %", "per op");
+}
+
+/**
+ * @brief One result as a table row
+ */
+void bench_print(FILE *out, const bench_result_t *result)
+{
+    fprintf(out, "%-28s %12llu %10.2f %10.2f %10.2f %7.2f ", result->name, (unsigned long long)result->ops,
+            result->min, result->median, result->max,
+            result->mean > 0.0 ? 100.0 * result->stddev / result->mean : 0.0);
+    for (int c = 0; c < BENCH_MAX_COUNTERS; c++)
+    {
+        if (result->counter_name[c] != NULL)
+        {
+            fprintf(out, " %s=%.2f", result->counter_name[c], result->counter[c]);
+        }
+    }
+    fputc('\n', out);
+}
+
+/**
+ * @brief Save results as JSON, one case per line
+ *
+ * @param path      output file
+ * @param suite     suite name
+ * @param results   results
+ * @param count     number of results
+ * @return int 0 on success, -1 on I/O error
+ */
+int bench_write_json(const char *path, const char *suite, const bench_result_t *results, size_t count)
+{
+    FILE *out = fopen(path, "w");
+    if (out == NULL)
+    {
+        return -1;
+    }
+    fprintf(out, "{\"suite\": \"%s\", \"results\": [\n", suite);
+    for (size_t i = 0; i < count; i++)
+    {
+        const bench_result_t *r = &results[i];
+        fprintf(out,
+                "  {\"name\": \"%s\", \"ops\": %llu, \"reps\": %u, \"min_ns\": %.3f, \"median_ns\": %.3f, "
+                "\"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"max_ns\": %.3f",
+                r->name, (unsigned long long)r->ops, (unsigned)r->reps, r->min, r->median, r->mean, r->stddev,
+                r->max);
+        for (int c = 0; c < BENCH_MAX_COUNTERS; c++)
+        {
+            if (r->counter_name[c] != NULL)
+            {
+                fprintf(out, ", \"%s_per_op\": %.3f", r->counter_name[c], r->counter[c]);
+            }
+        }
+        fprintf(out, "}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(out, "]}\n");
+    return fclose(out) == 0 ? 0 : -1;
+}
+
+/**
+ * @brief Number after "key": on a result line
+ */
+static bool json_number(const char *line, const char *key, double *value)
+{
+    char pattern[72];
+    snprintf(pattern, sizeof(pattern), "\"%.64s\": ", key);
+    const char *at = strstr(line, pattern);
+    if (at == NULL)
+    {
+        return false;
+    }
+    *value = strtod(at + strlen(pattern), NULL);
+    return true;
+}
+
+/**
+ * @brief Compare medians and counters against a baseline written by bench_write_json()
+ *
+ * A case regresses when its median is more than @p threshold percent slower
+ * or any counter grew. Cases missing on either side are listed, not failed.
+ *
+ * @param path      baseline file
+ * @param results   current results
+ * @param count     number of results
+ * @param threshold allowed slowdown in percent
+ * @return int number of regressions, -1 if the baseline cannot be read
+ */
+int bench_compare(const char *path, const bench_result_t *results, size_t count, double threshold)
+{
+    FILE *in = fopen(path, "r");
+    char line[512];
+    int regressions = 0;
+    bool *seen = calloc(count ? count : 1, sizeof(bool));
+
+    if (in == NULL || seen == NULL)
+    {
+        if (in != NULL)
+        {
+            fclose(in);
+        }
+        free(seen);
+        return -1;
+    }
+
+    printf("\n%-28s %10s %10s %8s\n", "vs baseline", "base ns", "now ns", "change");
+    while (fgets(line, sizeof(line), in) != NULL)
+    {
+        const char *name = strstr(line, "\"name\": \"");
+        double base;
+        if (name == NULL || !json_number(line, "median_ns", &base))
+        {
+            continue;
+        }
+        name += strlen("\"name\": \"");
+        size_t len = strcspn(name, "\"");
+
+        size_t i = 0;
+        while (i < count && (strlen(results[i].name) != len || strncmp(results[i].name, name, len) != 0))
+        {
+            i++;
+        }
+        if (i == count)
+        {
+            printf("%-28.*s %10.2f %10s %8s\n", (int)len, name, base, "-", "missing");
+            continue;
+        }
+        seen[i] = true;
+
+        const bench_result_t *r = &results[i];
+        double change = base > 0.0 ? 100.0 * (r->median - base) / base : 0.0;
+        bool slower = change > threshold;
+        bool counters = false;
+        for (int c = 0; c < BENCH_MAX_COUNTERS; c++)
+        {
+            char key[64];
+            double old;
+            if (r->counter_name[c] == NULL)
+            {
+                continue;
+            }
+            snprintf(key, sizeof(key), "%s_per_op", r->counter_name[c]);
+            if (json_number(line, key, &old) && r->counter[c] > old + 1e-3)
+            {
+                printf("%-28s %s %.2f -> %.2f per op\n", r->name, r->counter_name[c], old, r->counter[c]);
+                counters = true;
+            }
+        }
+        regressions += slower || counters;
+        printf("%-28s %10.2f %10.2f %+7.1f%% %s\n", r->name, base, r->median, change,
+               slower || counters ? "REGRESSION" : "");
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!seen[i])
+        {
+            printf("%-28s %10s %10.2f %8s\n", results[i].name, "-", results[i].median, "new");
+        }
+    }
+    fclose(in);
+    free(seen);
+    return regressions;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file bench.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Microbenchmark runner: warmup, repetitions, summary, JSON and baseline compare
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Each case is calibrated to run for at least min_rep_ms per repetition,
+ * warmed up, then timed over reps repetitions. Results are reported in ns
+ * per operation; counters (GPIO writes, bytes, ...) in units per operation.
+ * Only clock_gettime() is needed, so the runner also links into an ESP-IDF
+ * test app.
+ */
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define BENCH_MAX_COUNTERS 2 /*!< Counters per case */
+#define BENCH_MAX_REPS 101   /*!< Largest repetition count */
+
+/**
+ * @struct bench_counter_t bench.h
+ * @brief Event counter read before and after each case, reported per operation
+ */
+typedef struct
+{
+    const char *name;         /*!< JSON key, reported as name_per_op */
+    const uint64_t *value;    /*!< Counter, NULL if unused */
+} bench_counter_t;
+
+/**
+ * @struct bench_case_t bench.h
+ * @brief One benchmark
+ *
+ * ### Example
+ * ~~~.c
+ * static void run_crc(void *ctx, uint64_t n)
+ * {
+ *     for (uint64_t i = 0; i < n; i++)
+ *         bench_sink += crc32(0, ctx, 512);
+ * }
+ * static const bench_case_t cases[] = {{"crc32 512 B", run_crc, block}};
+ * ~~~
+ */
+typedef struct
+{
+    const char *name;                         /*!< Result name */
+    void (*run)(void *ctx, uint64_t n);       /*!< Runs n operations */
+    void *ctx;                                /*!< Passed to run */
+    bench_counter_t counter[BENCH_MAX_COUNTERS]; /*!< Optional counters */
+} bench_case_t;
+
+/**
+ * @struct bench_config_t bench.h
+ * @brief Runner settings
+ */
+typedef struct
+{
+    uint32_t reps;       /*!< Timed repetitions */
+    uint32_t warmup_ms;  /*!< Untimed run before the repetitions */
+    uint32_t min_rep_ms; /*!< Shortest repetition, sets the operations per repetition */
+    const char *filter;  /*!< Only cases whose name contains this, NULL for all */
+} bench_config_t;
+
+/**
+ * @brief Default settings: 15 repetitions of at least 20 ms after 50 ms of warmup
+ */
+#define BENCH_CONFIG_DEFAULT() {.reps = 15, .warmup_ms = 50, .min_rep_ms = 20, .filter = NULL}
+
+/**
+ * @struct bench_result_t bench.h
+ * @brief Summary of one case, times in ns per operation
+ */
+typedef struct
+{
+    const char *name;                       /*!< Case name */
+    uint64_t ops;                           /*!< Operations per repetition */
+    uint32_t reps;                          /*!< Repetitions */
+    double min;                             /*!< Fastest repetition */
+    double median;                          /*!< Median repetition */
+    double mean;                            /*!< Mean */
+    double stddev;                          /*!< Standard deviation */
+    double max;                             /*!< Slowest repetition */
+    double counter[BENCH_MAX_COUNTERS];     /*!< Counter increments per operation */
+    const char *counter_name[BENCH_MAX_COUNTERS]; /*!< Counter names, NULL if unused */
+} bench_result_t;
+
+extern volatile uint64_t bench_sink;
+
+bool bench_run(const bench_config_t *config, const bench_case_t *bench, bench_result_t *result);
+
+void bench_print_header(FILE *out);
+
+void bench_print(FILE *out, const bench_result_t *result);
+
+int bench_write_json(const char *path, const char *suite, const bench_result_t *results, size_t count);
+
+int bench_compare(const char *path, const bench_result_t *results, size_t count, double threshold);
+
+#endif
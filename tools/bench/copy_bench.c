@@ -0,0 +1,194 @@
+/**
+ * @file copy_bench.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Bytes copied and time per sample on the way to the SD card
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Replays the storage path of one sample with every memcpy counted.
+ *
+ * stdio path: the record is built on the stack, formatted into a line,
+ * buffered by a FILE, gathered into the FATFS sector window and staged in a
+ * DMA bounce buffer because the window is not DMA capable.
+ *
+ * pool path: the record is built inside a block from the pool, the full block
+ * pointer is queued and the block itself is the DMA source.
+ *
+ * ### Example
+ * ~~~
+ * copy_bench            # 1M samples
+ * copy_bench 10000000   # 10M samples
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "logfmt/log_block.h"
+#include "logger/block_pool.h"
+
+#define POOL_BLOCKS 16   /* LOGGER_POOL_BLOCKS */
+#define STDIO_BUFFER 128 /* newlib FILE buffer on the ESP32 */
+
+static uint64_t copied; /* Bytes moved by counted_copy() */
+
+/**
+ * @brief memcpy that counts bytes
+ */
+static void counted_copy(void *dst, const void *src, size_t n)
+{
+    memcpy(dst, src, n);
+    copied += n;
+}
+
+/**
+ * @brief Stand-in for the SD card, reads what the DMA would read
+ */
+static uint32_t sink_checksum;
+static void card_dma(const void *data, size_t n)
+{
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < n; i += 64)
+    {
+        sink_checksum += bytes[i];
+    }
+}
+
+static void sample(uint32_t i, log_record_t *record)
+{
+    record->time_us = 1666811220000000LL + (int64_t)i * 1000000;
+    record->type = LOG_RECORD_SAMPLE;
+    record->flags = 0;
+    record->battery_mv = 3900;
+    record->temperature = 2150 + (int32_t)(i % 100);
+    record->pressure = 101325 + i % 300;
+}
+
+/**
+ * @brief stdio + FATFS path, CSV line per sample
+ */
+static void run_stdio(uint32_t n)
+{
+    static uint8_t window[LOG_BLOCK_SIZE]; /* FATFS sector window */
+    static uint8_t bounce[LOG_BLOCK_SIZE]; /* SPI DMA bounce buffer */
+    char buffer[STDIO_BUFFER];
+    size_t buffered = 0, fill = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        log_record_t local, queued;
+        sample(i, &local);
+        counted_copy(&queued, &local, sizeof(local)); /* queue in, queue out */
+        counted_copy(&local, &queued, sizeof(local));
+
+        char line[64];
+        int len = snprintf(line, sizeof(line), "%" PRId64 ",%d.%02d,%" PRIu32 ",%u\n", local.time_us,
+                           (int)(local.temperature / 100), (int)(local.temperature % 100), local.pressure,
+                           (unsigned)local.battery_mv);
+        copied += (uint64_t)len; /* formatted bytes */
+
+        for (int done = 0; done < len;)
+        {
+            size_t chunk = (size_t)(len - done) < STDIO_BUFFER - buffered ? (size_t)(len - done)
+                                                                        : STDIO_BUFFER - buffered;
+            counted_copy(buffer + buffered, line + done, chunk); /* fwrite */
+            buffered += chunk;
+            done += (int)chunk;
+            if (buffered == STDIO_BUFFER)
+            {
+                /* FILE flush into the sector window */
+                for (size_t k = 0; k < buffered;)
+                {
+                    size_t part = buffered - k < LOG_BLOCK_SIZE - fill ? buffered - k : LOG_BLOCK_SIZE - fill;
+                    counted_copy(window + fill, buffer + k, part);
+                    fill += part;
+                    k += part;
+                    if (fill == LOG_BLOCK_SIZE)
+                    {
+                        counted_copy(bounce, window, LOG_BLOCK_SIZE);
+                        card_dma(bounce, LOG_BLOCK_SIZE);
+                        fill = 0;
+                    }
+                }
+                buffered = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Block pool path, records built in place
+ */
+static void run_pool(uint32_t n)
+{
+    static log_block_t blocks[POOL_BLOCKS];
+    static uint16_t ring[POOL_BLOCKS];
+    block_pool_t pool;
+    block_pool_init(&pool, blocks, ring, POOL_BLOCKS);
+
+    log_block_t *current = NULL;
+    uint32_t seq = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (current == NULL)
+        {
+            current = block_pool_alloc(&pool);
+            log_block_init(current, seq++);
+        }
+        sample(i, log_block_reserve(current));
+        log_block_commit(current);
+        if (log_block_full(current))
+        {
+            /* Pointer handoff, the writer DMAs straight from the block */
+            log_block_seal(current);
+            card_dma(current, LOG_BLOCK_SIZE);
+            block_pool_free(&pool, current);
+            current = NULL;
+        }
+    }
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void report(const char *name, void (*run)(uint32_t), uint32_t n)
+{
+    run(n / 10); /* warmup */
+    copied = 0;
+    double start = now_s();
+    run(n);
+    double elapsed = now_s() - start;
+    printf("%-6s %8.1f bytes copied/sample %8.1f ns/sample\n", name, (double)copied / n, elapsed * 1e9 / n);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t n = 1000000;
+    if (argc > 1)
+    {
+        char *end = NULL;
+        unsigned long long arg = strtoull(argv[1], &end, 10);
+        /* Per sample figures need at least one sample */
+        if (argc > 2 || *end != '\0' || arg == 0 || arg > UINT32_MAX)
+        {
+            fprintf(stderr, "usage: %s [samples, at least 1]\n", argv[0]);
+            return 2;
+        }
+        n = (uint32_t)arg;
+    }
+
+    printf("%" PRIu32 " samples, %zu byte records, %zu per block\n\n", n, sizeof(log_record_t),
+           (size_t)LOG_BLOCK_RECORDS);
+    report("stdio", run_stdio, n);
+    report("pool", run_pool, n);
+    printf("\nsink checksum %08" PRIx32 "\n", sink_checksum); /* keeps the sink live */
+    return 0;
+}
@@ -0,0 +1,512 @@
+/**
+ * @file decimator_bench.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Check the decimating filter against references and its frequency response, then time it
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every chain is checked three ways: against a direct convolution of the
+ * same integer filter, bit for bit, over readings spanning the whole int32
+ * range so the CIC integrators wrap many times; by its gain to sine waves
+ * across the passband and the alias bands, against the gain computed from
+ * the design; and by the noise left from BMP180-like 5 Pa RMS readings.
+ * Outputs stamped with decimator_delay_us() must line up with the input: a
+ * ramp is met exactly and, without the smoother, a step is half way at its
+ * own time. The timing gives ns and TSC cycles per reading.
+ *
+ * ### Example
+ * ~~~
+ * decimator_bench
+ * decimator_bench --json decimator.json
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "sensor/decimator.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES() __rdtsc()
+#else
+#define CYCLES() 0
+#endif
+
+#define BIAS 100000        /* Pa, sea level */
+#define AMPLITUDE 2000.0   /* Pa, test sine */
+#define REFERENCE_READINGS 1000000
+#define NOISE_READINGS 400000
+#define NOISE_RMS 5.0      /* Pa, BMP180 standard mode */
+#define GAIN_TOLERANCE 0.002
+#define READING_US 125000  /* Tick of the default configuration */
+#define RAMP_SLOPE 16      /* Pa per reading */
+#define DELAY_TOLERANCE 0.1 /* readings */
+#define STEP_SPAN 512      /* half readings of step response kept */
+
+/**
+ * @struct chain_t
+ * @brief One filter chain under test
+ */
+typedef struct
+{
+    const char *name;
+    decimator_config_t config;
+} chain_t;
+
+static const chain_t chains[] = {
+    {"cic 8x1", DECIMATOR_CIC_CONFIG(8, 1, 0)},
+    {"cic 8x3", DECIMATOR_CIC_CONFIG(8, 3, 0)},
+    {"cic 16x4", DECIMATOR_CIC_CONFIG(16, 4, 0)},
+    {"cic 8x3 smooth 2", DECIMATOR_CIC_CONFIG(8, 3, 2)},
+    {"fir 8x32", DECIMATOR_FIR_CONFIG(8, decimator_lowpass_8x32, 0)},
+    {"fir 8x32 smooth 3", DECIMATOR_FIR_CONFIG(8, decimator_lowpass_8x32, 3)},
+};
+
+#define CHAIN_COUNT (sizeof(chains) / sizeof(chains[0]))
+
+/* Test frequencies in multiples of the output rate, none an alias of DC or Nyquist */
+static const double frequencies[] = {0.02, 0.05, 0.1, 0.2, 0.3, 0.45, 0.7, 0.9, 1.15, 1.3, 1.7, 2.2, 3.4};
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next_random(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+/**
+ * @brief Normal deviate, Box-Muller
+ */
+static double next_normal(void)
+{
+    double u = ((next_random() >> 11) + 0.5) / 9007199254740992.0;
+    double v = ((next_random() >> 11) + 0.5) / 9007199254740992.0;
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static int64_t divide_round(int64_t value, int64_t divisor)
+{
+    return value >= 0 ? (value + divisor / 2) / divisor : -((-value + divisor / 2) / divisor);
+}
+
+/**
+ * @brief Impulse response of the decimating stage in integers, returns its length
+ *
+ * CIC: a boxcar of factor ones convolved order times, gain factor^order.
+ * FIR: the taps, gain 32768.
+ */
+static size_t impulse(const decimator_config_t *config, int64_t *h, size_t max, int64_t *gain)
+{
+    if (config->type == DECIMATOR_FIR)
+    {
+        for (size_t i = 0; i < config->tap_count; i++)
+        {
+            h[i] = config->taps[i];
+        }
+        *gain = 32768;
+        return config->tap_count;
+    }
+
+    size_t len = 1;
+    h[0] = 1;
+    *gain = 1;
+    for (uint8_t k = 0; k < config->order; k++)
+    {
+        int64_t next[1024] = {0};
+        for (size_t i = 0; i < len; i++)
+        {
+            for (size_t j = 0; j < config->factor && i + j < max; j++)
+            {
+                next[i + j] += h[i];
+            }
+        }
+        len += config->factor - 1;
+        memcpy(h, next, len * sizeof(h[0]));
+        *gain *= config->factor;
+    }
+    return len;
+}
+
+/**
+ * @brief Designed gain at f cycles per reading
+ */
+static double design_gain(const decimator_config_t *config, double f)
+{
+    double gain;
+    if (config->type == DECIMATOR_CIC)
+    {
+        double s = sin(M_PI * f);
+        double boxcar = fabs(s) < 1e-12 ? 1.0 : sin(M_PI * f * config->factor) / (config->factor * s);
+        gain = pow(fabs(boxcar), config->order);
+    }
+    else
+    {
+        double re = 0, im = 0;
+        for (uint16_t k = 0; k < config->tap_count; k++)
+        {
+            re += config->taps[k] / 32768.0 * cos(2.0 * M_PI * f * k);
+            im -= config->taps[k] / 32768.0 * sin(2.0 * M_PI * f * k);
+        }
+        gain = hypot(re, im);
+    }
+    if (config->smooth_shift > 0)
+    {
+        /* One pole at the output rate: w / (1 - (1 - w) z^-1) */
+        double w = 1.0 / (1 << config->smooth_shift);
+        double theta = 2.0 * M_PI * f * config->factor;
+        gain *= w / hypot(1.0 - (1.0 - w) * cos(theta), (1.0 - w) * sin(theta));
+    }
+    return gain;
+}
+
+/**
+ * @brief Outputs bit for bit against a direct convolution, smoother off
+ */
+static bool check_reference(const chain_t *chain)
+{
+    decimator_config_t config = chain->config;
+    config.smooth_shift = 0;
+    decimator_t dec = {.config = config};
+    if (decimator_init(&dec) != 0)
+    {
+        printf("  %s: init failed\n", chain->name);
+        return false;
+    }
+
+    static int64_t h[1024];
+    int64_t gain;
+    size_t len = impulse(&config, h, 1024, &gain);
+
+    /* Readings over the full int32 range, with runs of extremes */
+    static int32_t x[REFERENCE_READINGS];
+    for (size_t n = 0; n < REFERENCE_READINGS; n++)
+    {
+        uint64_t r = next_random();
+        x[n] = (n / 4096) % 3 == 0 ? (int32_t)r : (r & 1) ? INT32_MAX : INT32_MIN;
+    }
+    x[0] = 0;
+
+    uint64_t outputs = 0;
+    uint64_t mismatches = 0;
+    for (size_t n = 0; n < REFERENCE_READINGS; n++)
+    {
+        int32_t out;
+        if (!decimator_push(&dec, x[n], &out))
+        {
+            continue;
+        }
+        int64_t sum = 0;
+        for (size_t k = 0; k < len && k <= n; k++)
+        {
+            sum += h[k] * ((int64_t)x[n - k] - x[0]);
+        }
+        int64_t q = config.type == DECIMATOR_CIC ? divide_round(sum * (1 << DECIMATOR_FRAC_BITS), gain)
+                                                 : divide_round(sum, 1 << (15 - DECIMATOR_FRAC_BITS));
+        int32_t want = (int32_t)(x[0] + divide_round(q, 1 << DECIMATOR_FRAC_BITS));
+        outputs++;
+        if (out != want && mismatches++ < 5)
+        {
+            printf("  %s: reading %zu got %" PRId32 " want %" PRId32 "\n", chain->name, n, out, want);
+        }
+    }
+    bool ok = mismatches == 0 && outputs == REFERENCE_READINGS / config.factor;
+    printf("  %-18s %8" PRIu64 " outputs %6" PRIu64 " mismatches\n", chain->name, outputs, mismatches);
+    return ok;
+}
+
+/**
+ * @brief Gain to a sine of f output rates, least squares fit after the transient
+ */
+static double measure_gain(const decimator_config_t *config, double f_out)
+{
+    decimator_t dec = {.config = *config};
+    decimator_init(&dec);
+
+    double f = f_out / config->factor; /* cycles per reading */
+    const size_t settle = 200;
+    const size_t outputs = 2000;
+    double ss = 0, cc = 0, sc = 0, ys = 0, yc = 0;
+    size_t m = 0;
+    for (size_t n = 0; m < settle + outputs; n++)
+    {
+        double phase = 2.0 * M_PI * f * (double)n;
+        int32_t out;
+        if (!decimator_push(&dec, (int32_t)lround(BIAS + AMPLITUDE * sin(phase)), &out) || m++ < settle)
+        {
+            continue;
+        }
+        double s = sin(phase);
+        double c = cos(phase);
+        double y = out - BIAS;
+        ss += s * s;
+        cc += c * c;
+        sc += s * c;
+        ys += y * s;
+        yc += y * c;
+    }
+    double det = ss * cc - sc * sc;
+    double a = (ys * cc - yc * sc) / det;
+    double b = (yc * ss - ys * sc) / det;
+    return hypot(a, b) / AMPLITUDE;
+}
+
+/**
+ * @brief Gain table against the design, the error allows the output rounding
+ */
+static bool check_response(const chain_t *chain)
+{
+    bool ok = true;
+    printf("  %-18s", chain->name);
+    for (size_t i = 0; i < sizeof(frequencies) / sizeof(frequencies[0]); i++)
+    {
+        double want = design_gain(&chain->config, frequencies[i] / chain->config.factor);
+        double got = measure_gain(&chain->config, frequencies[i]);
+        bool match = fabs(got - want) <= GAIN_TOLERANCE;
+        ok = ok && match;
+        printf(" %6.1f%s", 20.0 * log10(got > 1e-6 ? got : 1e-6), match ? " " : "!");
+    }
+    printf("\n");
+    return ok;
+}
+
+/**
+ * @brief RMS left from white noise, against the design's noise gain plus rounding
+ */
+static bool check_noise(const chain_t *chain)
+{
+    decimator_t dec = {.config = chain->config};
+    decimator_init(&dec);
+
+    double sum = 0, squares = 0;
+    size_t count = 0;
+    for (size_t n = 0; n < NOISE_READINGS; n++)
+    {
+        int32_t out;
+        if (decimator_push(&dec, (int32_t)lround(BIAS + NOISE_RMS * next_normal()), &out) && n > 4096)
+        {
+            sum += out - BIAS;
+            squares += (double)(out - BIAS) * (out - BIAS);
+            count++;
+        }
+    }
+    double mean = sum / count;
+    double rms = sqrt(squares / count - mean * mean);
+
+    /* Noise gain: sum of the squared response from the readings to one output. Outputs
+       of a stage longer than factor are correlated, so the smoother is folded in as
+       w (1 - w)^j times the stage response delayed by j outputs */
+    static int64_t h[1024];
+    int64_t gain;
+    size_t len = impulse(&chain->config, h, 1024, &gain);
+    double w = chain->config.smooth_shift > 0 ? 1.0 / (1 << chain->config.smooth_shift) : 1.0;
+    size_t terms = chain->config.smooth_shift > 0 ? (size_t)32 << chain->config.smooth_shift : 1;
+    size_t span = len + (terms - 1) * chain->config.factor;
+    double *g = calloc(span, sizeof(double));
+    for (size_t j = 0; j < terms; j++)
+    {
+        double weight = w * pow(1.0 - w, (double)j);
+        for (size_t k = 0; k < len; k++)
+        {
+            g[j * chain->config.factor + k] += weight * (double)h[k] / gain;
+        }
+    }
+    double power = 0;
+    for (size_t k = 0; k < span; k++)
+    {
+        power += g[k] * g[k];
+    }
+    free(g);
+    /* Input readings are whole Pa: their rounding is noise too, and so is the output's */
+    double want = sqrt((NOISE_RMS * NOISE_RMS + 1.0 / 12.0) * power + 1.0 / 12.0);
+    bool ok = fabs(rms - want) <= 0.1 * want;
+    printf("  %-18s %6.2f Pa RMS, design %6.2f, %5.1fx below the readings%s\n", chain->name, rms, want,
+           NOISE_RMS / rms, ok ? "" : "  MISMATCH");
+    return ok;
+}
+
+/**
+ * @brief Outputs stamped with the group delay against a ramp and a step at those stamps
+ */
+static bool check_delay(const chain_t *chain)
+{
+    const decimator_config_t *config = &chain->config;
+    int64_t delay_us = decimator_delay_us(config, READING_US);
+    decimator_t dec = {.config = *config};
+    decimator_init(&dec);
+
+    /* Ramp: after the transient the output is the ramp at its stamp */
+    double ramp = 0;
+    for (int64_t n = 0; n < 16384; n++)
+    {
+        int32_t out;
+        if (decimator_push(&dec, (int32_t)(BIAS + RAMP_SLOPE * n), &out) && n > 8192)
+        {
+            double stamp = (double)(n * READING_US - delay_us) / READING_US;
+            double error = (out - BIAS) / (double)RAMP_SLOPE - stamp;
+            ramp = fabs(error) > fabs(ramp) ? error : ramp;
+        }
+    }
+    bool ok = fabs(ramp) <= DELAY_TOLERANCE;
+
+    /* Step from BIAS to BIAS + AMPLITUDE at reading s, the first at the new level. Over every phase
+       of s within an output, the outputs sample the step response at every reading: it must be
+       half way at s - 0.5 readings, where the readings it lies between meet. In half readings */
+    double step = 0;
+    if (config->smooth_shift == 0)
+    {
+        static double response[STEP_SPAN];
+        static bool seen[STEP_SPAN];
+        memset(seen, 0, sizeof(seen));
+        int64_t halves = decimator_delay_us(config, 2);
+        for (int64_t s = STEP_SPAN; s < STEP_SPAN + config->factor; s++)
+        {
+            dec = (decimator_t){.config = *config};
+            decimator_init(&dec);
+            for (int64_t n = 0; n < s + STEP_SPAN / 2; n++)
+            {
+                int32_t out;
+                int64_t at = 2 * n - halves - (2 * s - 1) + STEP_SPAN / 2;
+                if (decimator_push(&dec, n < s ? BIAS : BIAS + (int32_t)AMPLITUDE, &out) && at >= 0 &&
+                    at < STEP_SPAN)
+                {
+                    response[at] = (out - BIAS) / AMPLITUDE;
+                    seen[at] = true;
+                }
+            }
+        }
+        int64_t last = -1;
+        for (int64_t at = 0; at < STEP_SPAN; at++)
+        {
+            if (!seen[at])
+            {
+                continue;
+            }
+            if (last >= 0 && response[last] < 0.5 && response[at] >= 0.5)
+            {
+                double half = last + (at - last) * (0.5 - response[last]) / (response[at] - response[last]);
+                step = (half - STEP_SPAN / 2) / 2;
+                break;
+            }
+            last = at;
+        }
+        ok = ok && fabs(step) <= DELAY_TOLERANCE;
+    }
+
+    printf("  %-18s delay %5.1f readings, ramp off by %+.3f", chain->name, (double)delay_us / READING_US, ramp);
+    if (config->smooth_shift == 0)
+    {
+        printf(", step off by %+.3f", step);
+    }
+    printf(" readings%s\n", ok ? "" : "  MISMATCH");
+    return ok;
+}
+
+/* Timing */
+
+static uint64_t cycles;
+static int32_t readings[4096];
+
+static void run_push(void *ctx, uint64_t n)
+{
+    decimator_t *dec = ctx;
+    uint64_t sum = 0;
+    uint64_t c0 = CYCLES();
+    for (uint64_t i = 0; i < n; i++)
+    {
+        int32_t out;
+        if (decimator_push(dec, readings[i & 4095], &out))
+        {
+            sum += (uint32_t)out;
+        }
+    }
+    cycles += CYCLES() - c0;
+    bench_sink += sum;
+}
+
+int main(int argc, char **argv)
+{
+    bench_config_t config = BENCH_CONFIG_DEFAULT();
+    const char *json = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bool ok = true;
+    printf("Bit exact against direct convolution, full int32 range\n");
+    for (size_t i = 0; i < CHAIN_COUNT; i++)
+    {
+        ok = check_reference(&chains[i]) && ok;
+    }
+
+    printf("\nGain in dB at multiples of the output rate, ! off the design by more than %.3f\n%-20s",
+           GAIN_TOLERANCE, "");
+    for (size_t i = 0; i < sizeof(frequencies) / sizeof(frequencies[0]); i++)
+    {
+        printf(" %6.2f ", frequencies[i]);
+    }
+    printf("\n");
+    for (size_t i = 0; i < CHAIN_COUNT; i++)
+    {
+        ok = check_response(&chains[i]) && ok;
+    }
+
+    printf("\nNoise from %.0f Pa RMS readings\n", NOISE_RMS);
+    for (size_t i = 0; i < CHAIN_COUNT; i++)
+    {
+        ok = check_noise(&chains[i]) && ok;
+    }
+
+    printf("\nStamps moved back by the group delay, at most %.1f readings off\n", DELAY_TOLERANCE);
+    for (size_t i = 0; i < CHAIN_COUNT; i++)
+    {
+        ok = check_delay(&chains[i]) && ok;
+    }
+    printf("\n");
+
+    for (size_t i = 0; i < 4096; i++)
+    {
+        readings[i] = BIAS + (int32_t)(next_random() % 41) - 20;
+    }
+    static decimator_t filters[CHAIN_COUNT];
+    bench_case_t cases[CHAIN_COUNT];
+    bench_result_t results[CHAIN_COUNT];
+    for (size_t i = 0; i < CHAIN_COUNT; i++)
+    {
+        filters[i] = (decimator_t){.config = chains[i].config};
+        decimator_init(&filters[i]);
+        cases[i] = (bench_case_t){chains[i].name, run_push, &filters[i], {{"cycles", &cycles}}};
+    }
+
+    bench_print_header(stdout);
+    for (size_t i = 0; i < CHAIN_COUNT; i++)
+    {
+        bench_run(&config, &cases[i], &results[i]);
+        bench_print(stdout, &results[i]);
+    }
+    if (json != NULL && bench_write_json(json, "decimator", results, CHAIN_COUNT) != 0)
+    {
+        perror(json);
+        return 2;
+    }
+
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
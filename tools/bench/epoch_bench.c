@@ -0,0 +1,455 @@
+/**
+ * @file epoch_bench.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Check the epoch calendar conversion and wall clock, then time them against libc
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * calendar: every day from -9999-01-01 to 9999-12-31 against a day by day
+ * walk of the Gregorian rules, both directions, plus leap days and century
+ * boundaries by name.
+ *
+ * libc: random microsecond times in years 0..9999 against gmtime_r() and
+ * timegm(), and epoch_format() against strftime().
+ *
+ * clock: an RTC that counts whole seconds and drifts against esp_timer,
+ * read once a minute for a simulated week. Every timestamp must stay within
+ * one second plus the drift of a sync interval from true time.
+ *
+ * ### Example
+ * ~~~
+ * epoch_bench
+ * epoch_bench --json epoch.json
+ * ~~~
+ */
+
+#define _DEFAULT_SOURCE /* timegm() */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "epoch/epoch.h"
+
+static uint64_t checked;
+static uint64_t failures;
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next_random(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+static bool expect(bool ok, const char *what, int64_t value)
+{
+    checked++;
+    if (!ok && failures++ < 10)
+    {
+        printf("  %s: mismatch at %" PRId64 "\n", what, value);
+    }
+    return ok;
+}
+
+static void report(const char *what, uint64_t before_checked, uint64_t before_failures)
+{
+    printf("%-34s %12" PRIu64 " checked %8" PRIu64 " failed\n", what, checked - before_checked,
+           failures - before_failures);
+}
+
+/* Reference calendar, one day at a time */
+
+static bool is_leap(int32_t year)
+{
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+static uint32_t month_days(int32_t year, uint32_t month)
+{
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return days[month - 1] + (month == 2 && is_leap(year));
+}
+
+static bool check_day(int32_t days, int32_t year, uint32_t month, uint32_t day)
+{
+    int32_t y;
+    uint32_t m, d;
+    civil_from_days(days, &y, &m, &d);
+    return expect(y == year && m == month && d == day && days_from_civil(year, month, day) == days, "calendar walk",
+                  days);
+}
+
+static void verify_calendar(void)
+{
+    uint64_t c = checked, f = failures;
+
+    /* Forward from 1970-01-01 */
+    int32_t year = 1970;
+    uint32_t month = 1, day = 1;
+    for (int32_t days = 0; year <= 9999; days++)
+    {
+        check_day(days, year, month, day);
+        if (++day > month_days(year, month))
+        {
+            day = 1;
+            if (++month > 12)
+            {
+                month = 1;
+                year++;
+            }
+        }
+    }
+
+    /* Backward from 1969-12-31 */
+    year = 1969, month = 12, day = 31;
+    for (int32_t days = -1; year >= -9999; days--)
+    {
+        check_day(days, year, month, day);
+        if (--day == 0)
+        {
+            if (--month == 0)
+            {
+                month = 12;
+                year--;
+            }
+            day = month_days(year, month);
+        }
+    }
+    report("every day, -9999..9999", c, f);
+}
+
+/* Named cases */
+
+typedef struct
+{
+    const char *name;
+    civil_time_t civil;
+    int64_t us; /* expected Unix time */
+} named_case_t;
+
+static void verify_named(void)
+{
+    static const named_case_t cases[] = {
+        {"epoch", {1970, 1, 1, 0, 0, 0, 0}, 0},
+        {"last us before epoch", {1969, 12, 31, 23, 59, 59, 999999}, -1},
+        {"2000-02-29, leap century", {2000, 2, 29, 12, 0, 0, 0}, 951825600000000LL},
+        {"2000-03-01", {2000, 3, 1, 0, 0, 0, 0}, 951868800000000LL},
+        {"1900-02-28, no leap century", {1900, 2, 28, 0, 0, 0, 0}, -2203977600000000LL},
+        {"1900-03-01", {1900, 3, 1, 0, 0, 0, 0}, -2203891200000000LL},
+        {"2100-02-28, no leap century", {2100, 2, 28, 0, 0, 0, 0}, 4107456000000000LL},
+        {"2100-03-01", {2100, 3, 1, 0, 0, 0, 0}, 4107542400000000LL},
+        {"2400-02-29, leap century", {2400, 2, 29, 0, 0, 0, 0}, 13574563200000000LL},
+        {"1999-12-31 23:59:59.999999", {1999, 12, 31, 23, 59, 59, 999999}, 946684799999999LL},
+        {"2000-01-01", {2000, 1, 1, 0, 0, 0, 0}, 946684800000000LL},
+        {"2038-01-19 03:14:08, past int32", {2038, 1, 19, 3, 14, 8, 0}, 2147483648000000LL},
+        {"2022-11-26 19:07:00", {2022, 11, 26, 19, 7, 0, 0}, 1669489620000000LL},
+        {"1600-01-01", {1600, 1, 1, 0, 0, 0, 0}, -11676096000000000LL},
+        {"0000-03-01", {0, 3, 1, 0, 0, 0, 0}, -62162035200000000LL},
+        {"9999-12-31 23:59:59", {9999, 12, 31, 23, 59, 59, 0}, 253402300799000000LL},
+    };
+    uint64_t c = checked, f = failures;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const named_case_t *t = &cases[i];
+        civil_time_t back;
+        epoch_to_civil(t->us, &back);
+        bool ok = epoch_from_civil(&t->civil) == t->us && back.year == t->civil.year &&
+                  back.month == t->civil.month && back.day == t->civil.day && back.hour == t->civil.hour &&
+                  back.minute == t->civil.minute && back.second == t->civil.second && back.usec == t->civil.usec;
+        expect(ok, t->name, t->us);
+        printf("  %-34s %s\n", t->name, ok ? "ok" : "FAIL");
+    }
+
+    /* Feb 29 of a common year rolls over to Mar 1 */
+    for (int32_t y = 1600; y <= 2400; y += 100)
+    {
+        int32_t year;
+        uint32_t month, day;
+        civil_from_days(days_from_civil(y, 2, 29), &year, &month, &day);
+        expect(year == y && month == (is_leap(y) ? 2u : 3u) && day == (is_leap(y) ? 29u : 1u), "Feb 29", y);
+    }
+    report("named cases, century leap days", c, f);
+}
+
+/* Against libc */
+
+static int64_t random_us(void)
+{
+    /* 0000-01-01 to 9999-12-31 */
+    const int64_t first = -62167219200000000LL, last = 253402300799999999LL;
+    return first + (int64_t)(next_random() % (uint64_t)(last - first + 1));
+}
+
+static void verify_libc(void)
+{
+    uint64_t c = checked, f = failures;
+
+    for (int i = 0; i < 2000000; i++)
+    {
+        int64_t us = i < 1000000 ? random_us() : (int64_t)(next_random() % 4102444800000000ull); /* 1970..2100 */
+        time_t seconds = (time_t)(us >= 0 ? us / 1000000 : -((-us + 999999) / 1000000));
+        struct tm tm;
+        civil_time_t civil;
+
+        gmtime_r(&seconds, &tm);
+        epoch_to_civil(us, &civil);
+        bool fields = civil.year == tm.tm_year + 1900 && civil.month == tm.tm_mon + 1 && civil.day == tm.tm_mday &&
+                      civil.hour == tm.tm_hour && civil.minute == tm.tm_min && civil.second == tm.tm_sec &&
+                      (int64_t)seconds * 1000000 + civil.usec == us;
+        expect(fields, "epoch_to_civil vs gmtime_r", us);
+        expect(epoch_from_civil(&civil) == us, "epoch_from_civil round trip", us);
+        expect((int64_t)timegm(&tm) == (int64_t)seconds, "timegm", us);
+
+        /* Text, years 0..9999 print with four digits in both */
+        char got[EPOCH_TEXT_MAX], want[64];
+        uint8_t decimals = (uint8_t)(i % 7);
+        epoch_format(got, us, decimals);
+        size_t n = strftime(want, sizeof(want), "%Y-%m-%d %H:%M:%S", &tm);
+        if (tm.tm_year + 1900 < 1000)
+        {
+            n = (size_t)snprintf(want, sizeof(want), "%04d-%02d-%02d %02d:%02d:%02d", tm.tm_year + 1900,
+                                 tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+        }
+        if (decimals > 0)
+        {
+            static const uint32_t scale[7] = {1000000, 100000, 10000, 1000, 100, 10, 1};
+            snprintf(want + n, sizeof(want) - n, ".%0*u", decimals, civil.usec / scale[decimals]);
+        }
+        expect(strcmp(got, want) == 0, "epoch_format vs strftime", us);
+    }
+    report("random us vs gmtime_r/timegm", c, f);
+}
+
+/* Wall clock against a drifting one-second RTC */
+
+static void verify_clock(void)
+{
+    static const double drift_ppm[] = {0.0, 20.0, -20.0, 100.0, -100.0};
+    const int64_t start_us = 1669489620123456LL; /* true time at boot */
+    const int64_t interval_us = 60 * EPOCH_US_PER_SECOND;
+    const int64_t week_us = 7LL * EPOCH_SECONDS_PER_DAY * EPOCH_US_PER_SECOND;
+    uint64_t c = checked, f = failures;
+
+    for (size_t k = 0; k < sizeof(drift_ppm) / sizeof(drift_ppm[0]); k++)
+    {
+        epoch_clock_t clock = {0};
+        int64_t worst = 0;
+        /* The RTC keeps true time, esp_timer runs fast or slow by drift_ppm */
+        const double rate = 1.0 + drift_ppm[k] * 1e-6;
+        const double ppm = drift_ppm[k] < 0 ? -drift_ppm[k] : drift_ppm[k];
+        const int64_t bound = EPOCH_US_PER_SECOND + (int64_t)((double)interval_us * ppm * 1e-6) + 1;
+
+        for (int64_t t = 0; t <= week_us; t += interval_us / 4)
+        {
+            int64_t mono = (int64_t)((double)t * rate);
+            int64_t truth = start_us + t;
+            if (t % interval_us == 0)
+            {
+                int64_t rtc = truth / EPOCH_US_PER_SECOND * EPOCH_US_PER_SECOND;
+                epoch_clock_sync(&clock, rtc, EPOCH_US_PER_SECOND, mono);
+            }
+            int64_t error = epoch_clock_now(&clock, mono) - truth;
+            error = error < 0 ? -error : error;
+            worst = error > worst ? error : worst;
+            expect(error < bound, "clock error", t);
+        }
+        printf("  drift %+6.1f ppm: worst error %7" PRId64 " us, bound %7" PRId64 " us, %5" PRIu32
+               " of %5" PRIu32 " syncs stepped, max step %6" PRId64 " us\n",
+               drift_ppm[k], worst, bound, clock.steps, clock.syncs, clock.max_step_us);
+    }
+    report("wall clock, one week per drift", c, f);
+}
+
+/* Benchmarks */
+
+static const int64_t bench_base_us = 1669489620000000LL;
+
+static void run_days_from_civil(void *ctx, uint64_t n)
+{
+    int64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += days_from_civil(1970 + (int32_t)(i % 130), 1 + (uint32_t)(i % 12), 1 + (uint32_t)(i % 28));
+    }
+    bench_sink += (uint64_t)sum;
+}
+
+static void run_civil_from_days(void *ctx, uint64_t n)
+{
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        int32_t year;
+        uint32_t month, day;
+        civil_from_days((int32_t)(i * 7919 % 47482), &year, &month, &day);
+        sum += (uint64_t)year + month + day;
+    }
+    bench_sink += sum;
+}
+
+static void run_epoch_to_civil(void *ctx, uint64_t n)
+{
+    uint64_t sum = 0;
+    civil_time_t civil;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        epoch_to_civil(bench_base_us + (int64_t)i * 1000003, &civil);
+        sum += (uint64_t)civil.year + civil.day + civil.second + civil.usec;
+    }
+    bench_sink += sum;
+}
+
+static void run_gmtime(void *ctx, uint64_t n)
+{
+    uint64_t sum = 0;
+    struct tm tm;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        time_t seconds = (time_t)((bench_base_us + (int64_t)i * 1000003) / 1000000);
+        gmtime_r(&seconds, &tm);
+        sum += (uint64_t)tm.tm_year + (uint64_t)tm.tm_mday + (uint64_t)tm.tm_sec;
+    }
+    bench_sink += sum;
+}
+
+static void run_epoch_from_civil(void *ctx, uint64_t n)
+{
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        civil_time_t civil = {2022, (uint8_t)(1 + i % 12), (uint8_t)(1 + i % 28), (uint8_t)(i % 24),
+                              (uint8_t)(i % 60), (uint8_t)(i % 59), 0};
+        sum += (uint64_t)epoch_from_civil(&civil);
+    }
+    bench_sink += sum;
+}
+
+static void run_timegm(void *ctx, uint64_t n)
+{
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        struct tm tm = {.tm_year = 122, .tm_mon = (int)(i % 12), .tm_mday = (int)(1 + i % 28),
+                        .tm_hour = (int)(i % 24), .tm_min = (int)(i % 60), .tm_sec = (int)(i % 59)};
+        sum += (uint64_t)timegm(&tm);
+    }
+    bench_sink += sum;
+}
+
+static void run_mktime(void *ctx, uint64_t n)
+{
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        struct tm tm = {.tm_year = 122, .tm_mon = (int)(i % 12), .tm_mday = (int)(1 + i % 28),
+                        .tm_hour = (int)(i % 24), .tm_min = (int)(i % 60), .tm_sec = (int)(i % 59)};
+        sum += (uint64_t)mktime(&tm);
+    }
+    bench_sink += sum;
+}
+
+static void run_epoch_format(void *ctx, uint64_t n)
+{
+    char out[EPOCH_TEXT_MAX];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += epoch_format(out, bench_base_us + (int64_t)i * 1000003, 3);
+    }
+    bench_sink += sum;
+}
+
+static void run_strftime(void *ctx, uint64_t n)
+{
+    char out[64];
+    uint64_t sum = 0;
+    struct tm tm;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        int64_t us = bench_base_us + (int64_t)i * 1000003;
+        time_t seconds = (time_t)(us / 1000000);
+        gmtime_r(&seconds, &tm);
+        size_t len = strftime(out, sizeof(out), "%Y-%m-%d %H:%M:%S", &tm);
+        sum += len + (uint64_t)snprintf(out + len, sizeof(out) - len, ".%03d", (int)(us % 1000000 / 1000));
+    }
+    bench_sink += sum;
+}
+
+int main(int argc, char **argv)
+{
+    bench_config_t config = BENCH_CONFIG_DEFAULT();
+    const char *json = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    /* mktime() below converts local time, as it did on the device */
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    verify_calendar();
+    verify_named();
+    verify_libc();
+    verify_clock();
+    bool ok = failures == 0;
+    printf("\n");
+
+    const bench_case_t cases[] = {
+        {"days_from_civil", run_days_from_civil, NULL, {{0}}},
+        {"civil_from_days", run_civil_from_days, NULL, {{0}}},
+        {"epoch_to_civil", run_epoch_to_civil, NULL, {{0}}},
+        {"gmtime_r", run_gmtime, NULL, {{0}}},
+        {"epoch_from_civil", run_epoch_from_civil, NULL, {{0}}},
+        {"timegm", run_timegm, NULL, {{0}}},
+        {"mktime", run_mktime, NULL, {{0}}},
+        {"epoch_format .3", run_epoch_format, NULL, {{0}}},
+        {"gmtime_r + strftime .3", run_strftime, NULL, {{0}}},
+    };
+    const size_t count = sizeof(cases) / sizeof(cases[0]);
+    bench_result_t results[sizeof(cases) / sizeof(cases[0])];
+
+    bench_print_header(stdout);
+    for (size_t i = 0; i < count; i++)
+    {
+        bench_run(&config, &cases[i], &results[i]);
+        bench_print(stdout, &results[i]);
+    }
+    printf("%-28s %6.1fx faster than gmtime_r\n", "epoch_to_civil", results[3].median / results[2].median);
+    printf("%-28s %6.1fx faster than timegm, %.1fx than mktime\n", "epoch_from_civil",
+           results[5].median / results[4].median, results[6].median / results[4].median);
+    printf("%-28s %6.1fx faster than strftime\n", "epoch_format", results[8].median / results[7].median);
+    if (json != NULL && bench_write_json(json, "epoch", results, count) != 0)
+    {
+        perror(json);
+        return 2;
+    }
+
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,414 @@
+/**
+ * @file fmt_bench.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Check the fmt library against snprintf, then time both
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Checks every 32-bit value in [-2^24, 2^24], every power of ten boundary up
+ * to 64 bits, random 64-bit values, all widths from -24 to 24 with both pads,
+ * every decimal count and every timestamp field combination on a grid.
+ * --exhaustive extends the integer check to all 2^32 values of int32 and
+ * uint32, which takes a few minutes.
+ *
+ * ### Example
+ * ~~~
+ * fmt_bench
+ * fmt_bench --exhaustive
+ * fmt_bench --json fmt.json
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "fmt/fmt.h"
+
+static uint64_t checked;
+static uint64_t failures;
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next_random(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+static void expect(const char *what, const char *got, size_t len, const char *want)
+{
+    checked++;
+    if (strcmp(got, want) != 0 || len != strlen(want))
+    {
+        if (failures++ < 10)
+        {
+            printf("  %s: got \"%s\" (%zu) want \"%s\"\n", what, got, len, want);
+        }
+    }
+}
+
+/**
+ * @brief printf reference for a field width, both pads and left-aligned
+ */
+static void check_int(int64_t value, int width, char pad)
+{
+    char got[64], want[64];
+    size_t len = fmt_int(got, value, width, pad);
+    if (width < 0)
+        snprintf(want, sizeof(want), "%-*" PRId64, -width, value);
+    else if (pad == '0')
+        snprintf(want, sizeof(want), "%0*" PRId64, width, value);
+    else
+        snprintf(want, sizeof(want), "%*" PRId64, width, value);
+    expect("fmt_int", got, len, want);
+}
+
+static void check_uint(uint64_t value, int width, char pad)
+{
+    char got[64], want[64];
+    size_t len = fmt_uint(got, value, width, pad);
+    if (width < 0)
+        snprintf(want, sizeof(want), "%-*" PRIu64, -width, value);
+    else if (pad == '0')
+        snprintf(want, sizeof(want), "%0*" PRIu64, width, value);
+    else
+        snprintf(want, sizeof(want), "%*" PRIu64, width, value);
+    expect("fmt_uint", got, len, want);
+}
+
+/**
+ * @brief Reference: integer part and zero padded fraction from integer printf
+ */
+static void check_fixed(int64_t value, uint8_t decimals, int width, char pad)
+{
+    char got[64], body[64], want[64];
+    uint64_t magnitude = value < 0 ? 0u - (uint64_t)value : (uint64_t)value;
+    uint64_t scale = 1;
+    for (uint8_t i = 0; i < decimals; i++)
+    {
+        scale *= 10;
+    }
+
+    if (decimals == 0)
+        snprintf(body, sizeof(body), "%s%" PRIu64, value < 0 ? "-" : "", magnitude);
+    else
+        snprintf(body, sizeof(body), "%s%" PRIu64 ".%0*" PRIu64, value < 0 ? "-" : "", magnitude / scale,
+                 (int)decimals, magnitude % scale);
+
+    int fill = (width < 0 ? -width : width) - (int)strlen(body);
+    if (width > 0 && pad == '0' && fill > 0)
+    {
+        /* printf only zero pads numbers: zeros after the sign */
+        int sign = value < 0;
+        snprintf(want, sizeof(want), "%.*s%0*d%s", sign, body, fill, 0, body + sign);
+    }
+    else if (width < 0)
+        snprintf(want, sizeof(want), "%-*s", -width, body);
+    else
+        snprintf(want, sizeof(want), "%*s", width, body);
+
+    size_t len = fmt_fixed(got, value, decimals, width, pad);
+    expect("fmt_fixed", got, len, want);
+}
+
+static void check_datetime(int y, int mo, int d, int h, int mi, int s)
+{
+    char got[32], want[32];
+    size_t len = fmt_datetime(got, y, mo, d, h, mi, s);
+    snprintf(want, sizeof(want), "%04d-%02d-%02d %02d:%02d:%02d", y, mo, d, h, mi, s);
+    expect("fmt_datetime", got, len, want);
+}
+
+static void report(const char *what, uint64_t before_checked, uint64_t before_failures)
+{
+    printf("%-34s %12" PRIu64 " checked %8" PRIu64 " failed\n", what, checked - before_checked,
+           failures - before_failures);
+}
+
+static bool verify(bool exhaustive)
+{
+    uint64_t c, f;
+
+    /* Dense range, every 32-bit value in exhaustive mode */
+    c = checked, f = failures;
+    if (exhaustive)
+    {
+        uint32_t v = 0;
+        do
+        {
+            check_int((int32_t)v, 0, ' ');
+            check_uint(v, 0, ' ');
+        } while (++v != 0);
+    }
+    else
+    {
+        for (int64_t v = -(1 << 24); v <= (1 << 24); v++)
+        {
+            check_int(v, 0, ' ');
+            check_uint((uint64_t)v, 0, ' ');
+        }
+    }
+    report(exhaustive ? "int32/uint32, all 2^32" : "int/uint, [-2^24, 2^24]", c, f);
+
+    /* Power of ten boundaries and the 64-bit extremes */
+    c = checked, f = failures;
+    for (uint64_t p = 1; p != 0 && p <= UINT64_MAX / 10 * 10; p = p <= UINT64_MAX / 10 ? p * 10 : 0)
+    {
+        for (int64_t d = -2; d <= 2; d++)
+        {
+            uint64_t v = p + (uint64_t)d;
+            check_uint(v, 0, ' ');
+            check_int((int64_t)v, 0, ' ');
+            check_int(-(int64_t)v, 0, ' ');
+        }
+    }
+    check_uint(UINT64_MAX, 0, ' ');
+    check_int(INT64_MAX, 0, ' ');
+    check_int(INT64_MIN, 0, ' ');
+    check_int(INT64_MIN + 1, 0, ' ');
+    report("powers of ten, 64-bit limits", c, f);
+
+    /* Random 64-bit values of every length */
+    c = checked, f = failures;
+    for (int i = 0; i < 4000000; i++)
+    {
+        uint64_t v = next_random() >> (next_random() % 64);
+        check_uint(v, 0, ' ');
+        check_int((int64_t)v, 0, ' ');
+        check_int(-(int64_t)(v >> 1), 0, ' ');
+    }
+    report("random 64-bit", c, f);
+
+    /* Widths and padding */
+    c = checked, f = failures;
+    for (int i = 0; i < 20000; i++)
+    {
+        int64_t v = (int64_t)(next_random() >> (next_random() % 64));
+        v = i & 1 ? -v : v;
+        if (i < 3)
+        {
+            v = i == 0 ? 0 : i == 1 ? INT64_MIN : INT64_MAX;
+        }
+        for (int w = -24; w <= 24; w++)
+        {
+            check_int(v, w, ' ');
+            check_int(v, w, '0');
+            check_uint((uint64_t)v, w, ' ');
+            check_uint((uint64_t)v, w, '0');
+        }
+    }
+    report("widths -24..24, space and zero pad", c, f);
+
+    /* Fixed point */
+    c = checked, f = failures;
+    for (int i = 0; i < 20000; i++)
+    {
+        int64_t v = (int64_t)(next_random() >> (next_random() % 64));
+        v = i & 1 ? -v : v;
+        if (i < 4)
+        {
+            v = i == 0 ? 0 : i == 1 ? INT64_MIN : i == 2 ? INT64_MAX : -5;
+        }
+        for (uint8_t d = 0; d <= 18; d++)
+        {
+            check_fixed(v, d, 0, ' ');
+            check_fixed(v, d, (int)(next_random() % 49) - 24, next_random() & 1 ? '0' : ' ');
+        }
+    }
+    for (int64_t v = -100000; v <= 100000; v++)
+    {
+        check_fixed(v, 2, 0, ' ');
+        check_fixed(v, 2, 7, ' ');
+    }
+    report("fixed point, 0..18 decimals", c, f);
+
+    /* Timestamps: every date field on a time grid, every time on a date grid */
+    c = checked, f = failures;
+    for (int y = 1900; y <= 2200; y++)
+        for (int mo = 1; mo <= 12; mo++)
+            for (int d = 1; d <= 31; d++)
+                check_datetime(y, mo, d, d % 24, (y + d) % 60, mo * 5 % 61);
+    for (int h = 0; h < 24; h++)
+        for (int mi = 0; mi < 60; mi++)
+            for (int s = 0; s <= 60; s++)
+                check_datetime(2022 + s % 9, 1 + mi % 12, 1 + h, h, mi, s);
+    for (int y = 0; y <= 9999; y++)
+        check_datetime(y, 11, 26, 19, 7, 0);
+    report("datetime", c, f);
+
+    return failures == 0;
+}
+
+/* Benchmarks, the snprintf cases are what the firmware used before */
+
+static void run_fmt_int(void *ctx, uint64_t n)
+{
+    char out[FMT_INT_MAX];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += fmt_int(out, (int32_t)(i * 2654435761u), 0, ' ');
+    }
+    bench_sink += sum;
+}
+
+static void run_snprintf_int(void *ctx, uint64_t n)
+{
+    char out[FMT_INT_MAX];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += (uint64_t)snprintf(out, sizeof(out), "%d", (int32_t)(i * 2654435761u));
+    }
+    bench_sink += sum;
+}
+
+static void run_fmt_fixed(void *ctx, uint64_t n)
+{
+    char out[FMT_INT_MAX];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += fmt_fixed(out, 2150 + (int64_t)(i % 1000), 2, 0, ' ');
+    }
+    bench_sink += sum;
+}
+
+static void run_snprintf_float(void *ctx, uint64_t n)
+{
+    char out[32];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += (uint64_t)snprintf(out, sizeof(out), "%.2f", (2150 + (double)(i % 1000)) / 100.0);
+    }
+    bench_sink += sum;
+}
+
+static void run_fmt_datetime(void *ctx, uint64_t n)
+{
+    char out[FMT_DATETIME_LEN + 1];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += fmt_datetime(out, 2022, 11, 26, 19, (int)(i % 60), (int)(i % 61));
+    }
+    bench_sink += sum;
+}
+
+static void run_snprintf_datetime(void *ctx, uint64_t n)
+{
+    char out[32];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += (uint64_t)snprintf(out, sizeof(out), "%04d-%02d-%02d %02d:%02d:%02d", 2022, 11, 26, 19,
+                                  (int)(i % 60), (int)(i % 61));
+    }
+    bench_sink += sum;
+}
+
+/* One CSV row: time_us,temperature,pressure,battery */
+
+static void run_fmt_csv(void *ctx, uint64_t n)
+{
+    char line[4 * FMT_INT_MAX];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        char *p = line;
+        p += fmt_int(p, 1666811220000000LL + (int64_t)i * 1000000, 0, ' ');
+        *p++ = ',';
+        p += fmt_fixed(p, 2150 + (int64_t)(i % 1000), 2, 0, ' ');
+        *p++ = ',';
+        p += fmt_uint(p, 101325 + i % 300, 0, ' ');
+        *p++ = ',';
+        p += fmt_uint(p, 3900, 0, ' ');
+        *p++ = '\n';
+        sum += (uint64_t)(p - line);
+    }
+    bench_sink += sum;
+}
+
+static void run_snprintf_csv(void *ctx, uint64_t n)
+{
+    char line[96];
+    uint64_t sum = 0;
+    (void)ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += (uint64_t)snprintf(line, sizeof(line), "%" PRId64 ",%.2f,%" PRIu64 ",%u\n",
+                                  (int64_t)(1666811220000000LL + (int64_t)i * 1000000), (2150 + (double)(i % 1000)) / 100.0,
+                                  101325 + i % 300, 3900u);
+    }
+    bench_sink += sum;
+}
+
+int main(int argc, char **argv)
+{
+    bench_config_t config = BENCH_CONFIG_DEFAULT();
+    bool exhaustive = false;
+    const char *json = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--exhaustive") == 0)
+            exhaustive = true;
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--exhaustive] [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bool ok = verify(exhaustive);
+    printf("\n");
+
+    const bench_case_t cases[] = {
+        {"fmt_int int32", run_fmt_int, NULL, {{0}}},
+        {"snprintf %d", run_snprintf_int, NULL, {{0}}},
+        {"fmt_fixed 2 decimals", run_fmt_fixed, NULL, {{0}}},
+        {"snprintf %.2f", run_snprintf_float, NULL, {{0}}},
+        {"fmt_datetime", run_fmt_datetime, NULL, {{0}}},
+        {"snprintf datetime", run_snprintf_datetime, NULL, {{0}}},
+        {"fmt csv row", run_fmt_csv, NULL, {{0}}},
+        {"snprintf csv row", run_snprintf_csv, NULL, {{0}}},
+    };
+    const size_t count = sizeof(cases) / sizeof(cases[0]);
+    bench_result_t results[sizeof(cases) / sizeof(cases[0])];
+
+    bench_print_header(stdout);
+    for (size_t i = 0; i < count; i++)
+    {
+        bench_run(&config, &cases[i], &results[i]);
+        bench_print(stdout, &results[i]);
+    }
+    for (size_t i = 0; i + 1 < count; i += 2)
+    {
+        printf("%-28s %6.1fx faster than snprintf\n", results[i].name, results[i + 1].median / results[i].median);
+    }
+    if (json != NULL && bench_write_json(json, "fmt", results, count) != 0)
+    {
+        perror(json);
+        return 2;
+    }
+
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,416 @@
+/**
+ * @file layout_bench.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Row and columnar log blocks compared: space, and read time by query shape
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A day of logging is generated the way the device records it: 1 s samples
+ * with timestamp jitter, bursts at 250 ms with the rate records around them,
+ * a daily temperature swing, weather in the pressure and a discharging
+ * battery, all with sensor noise. It is stored once with log_block_t rows
+ * and once with log_columns_t.
+ *
+ * verify: both layouts decode to the records written, log_columns_read()
+ * agrees with the full decode for every column, and damaged directories are
+ * rejected rather than read past.
+ *
+ * store: the day encoded and sealed, the producer's cost on the device.
+ *
+ * queries, one operation is a pass over the whole day, blocks already CRC
+ * checked: the mean pressure (one channel), and every record decoded (full
+ * row). bytes_per_op counts the block bytes a query has to touch.
+ *
+ * ### Example
+ * ~~~
+ * layout_bench
+ * layout_bench --json layout.json
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "logfmt/log_block.h"
+#include "logfmt/log_columns.h"
+
+#define DAY_S 86400
+
+/**
+ * @brief One stored copy of the log
+ */
+typedef struct
+{
+    const char *name; /* Layout name */
+    log_block_t *blocks;
+    size_t count;     /* Blocks used */
+} layout_t;
+
+static log_record_t *records; /* The day, in logging order */
+static size_t record_count;
+static layout_t layouts[2] = {{"row", NULL, 0}, {"columnar", NULL, 0}};
+
+static uint64_t bytes; /* Block bytes touched by the queries */
+static uint64_t checked;
+static uint64_t failures;
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next_random(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+/**
+ * @brief Uniform integer in [-span, span]
+ */
+static int32_t next_noise(int32_t span)
+{
+    return (int32_t)(next_random() % (uint64_t)(2 * span + 1)) - span;
+}
+
+static bool expect(bool ok, const char *what, size_t index)
+{
+    checked++;
+    if (!ok && failures++ < 10)
+    {
+        printf("  %s: mismatch at %zu\n", what, index);
+    }
+    return ok;
+}
+
+/**
+ * @brief Append a rate record, pressure the new period and temperature the old one
+ */
+static void add_rate(int64_t time_us, uint32_t period_ms, uint32_t before_ms)
+{
+    log_record_t *r = &records[record_count++];
+    memset(r, 0, sizeof(*r));
+    r->time_us = time_us;
+    r->type = LOG_RECORD_RATE;
+    r->flags = 1;
+    r->pressure = period_ms;
+    r->temperature = (int32_t)before_ms;
+}
+
+/**
+ * @brief A day of samples with bursts of fast sampling every couple of hours
+ */
+static void generate(void)
+{
+    const int64_t start_us = 1792368000000000LL;
+    int64_t t_us = 0;
+    uint32_t period_ms = 1000;
+
+    records = malloc(sizeof(log_record_t) * (DAY_S * 4 + 64));
+    while (t_us < (int64_t)DAY_S * 1000000)
+    {
+        double t = (double)t_us / 1e6;
+        bool burst = fmod(t, 7200.0) < 600.0;
+        uint32_t want = burst ? 250 : 1000;
+        if (want != period_ms)
+        {
+            add_rate(start_us + t_us, want, period_ms);
+            period_ms = want;
+        }
+
+        log_record_t *r = &records[record_count++];
+        memset(r, 0, sizeof(*r));
+        r->time_us = start_us + t_us + next_noise(30);
+        r->type = LOG_RECORD_SAMPLE;
+        r->battery_mv = (uint16_t)(4150 - t / 180.0 + next_noise(2));
+        r->temperature = (int32_t)(2150 + 300 * sin(2 * M_PI * t / DAY_S) + next_noise(3));
+        r->pressure = (uint32_t)(101325 + 400 * sin(2 * M_PI * t / (3.0 * DAY_S)) + (burst ? 60 : 0) + next_noise(4));
+        t_us += (int64_t)period_ms * 1000;
+    }
+}
+
+/**
+ * @brief Store the day in one layout, with log_columns_t when cols is given
+ */
+static void store(layout_t *layout, log_columns_t *cols)
+{
+    layout->count = 0;
+    for (size_t i = 0; i < record_count;)
+    {
+        log_block_t *block = &layout->blocks[layout->count];
+        if (cols == NULL)
+        {
+            log_block_init(block, (uint32_t)layout->count);
+            while (i < record_count && log_block_append(block, &records[i]))
+            {
+                i++;
+            }
+            log_block_seal(block);
+        }
+        else
+        {
+            log_columns_init(cols, block, (uint32_t)layout->count);
+            while (i < record_count && !log_columns_full(cols))
+            {
+                *log_columns_reserve(cols) = records[i++];
+                log_columns_commit(cols);
+            }
+            log_columns_seal(cols);
+        }
+        layout->count++;
+    }
+}
+
+/**
+ * @brief Decode every block of a layout and compare with the records written
+ */
+static void verify_layout(const layout_t *layout)
+{
+    log_record_t decoded[LOG_COLUMNS_ROWS];
+    int64_t values[LOG_COLUMNS_ROWS];
+    size_t next = 0;
+
+    for (size_t b = 0; b < layout->count; b++)
+    {
+        const log_block_t *block = &layout->blocks[b];
+        int count = log_columns_decode(block, decoded);
+        if (!expect(log_block_verify(block) && count > 0 && next + (size_t)count <= record_count, layout->name, b))
+        {
+            return;
+        }
+        expect(memcmp(decoded, &records[next], (size_t)count * sizeof(log_record_t)) == 0, layout->name, b);
+
+        for (int c = 0; c < LOG_COLUMN_COUNT; c++)
+        {
+            bool same = log_columns_read(block, (log_column_t)c, values) == count;
+            for (int i = 0; same && i < count; i++)
+            {
+                log_record_t one = decoded[i];
+                switch (c)
+                {
+                case LOG_COLUMN_TIME:
+                    same = values[i] == one.time_us;
+                    break;
+                case LOG_COLUMN_TYPE:
+                    same = values[i] == one.type;
+                    break;
+                case LOG_COLUMN_FLAGS:
+                    same = values[i] == one.flags;
+                    break;
+                case LOG_COLUMN_BATTERY:
+                    same = values[i] == one.battery_mv;
+                    break;
+                case LOG_COLUMN_TEMPERATURE:
+                    same = values[i] == one.temperature;
+                    break;
+                default:
+                    same = values[i] == one.pressure;
+                    break;
+                }
+            }
+            expect(same, "log_columns_read", b);
+        }
+        next += (size_t)count;
+    }
+    expect(next == record_count, layout->name, next);
+}
+
+/**
+ * @brief Damaged directories and counts must fail the decode, not overrun
+ */
+static void verify_damage(void)
+{
+    log_record_t decoded[LOG_COLUMNS_ROWS];
+    int64_t values[LOG_COLUMNS_ROWS];
+    log_block_t block;
+
+    for (int i = 0; i < 2000; i++)
+    {
+        block = layouts[1].blocks[next_random() % layouts[1].count];
+        log_column_entry_t *directory = (log_column_entry_t *)block.payload;
+        switch (i % 4)
+        {
+        case 0:
+            directory[next_random() % LOG_COLUMN_COUNT].size += (uint16_t)(1 + next_random() % 600);
+            break;
+        case 1:
+            directory[next_random() % LOG_COLUMN_COUNT].codec = (uint8_t)(4 + next_random() % 250);
+            break;
+        case 2:
+            block.header.count = (uint16_t)(block.header.count + 1 + next_random() % 200);
+            break;
+        default:
+            /* Column bytes themselves, most damage still decodes to some values */
+            block.payload[LOG_COLUMNS_DIRECTORY + next_random() % 64] ^= (uint8_t)(1 + next_random() % 255);
+            log_columns_decode(&block, decoded);
+            continue;
+        }
+        expect(log_columns_decode(&block, decoded) < 0, "damaged decode", (size_t)i);
+        /* Columns ahead of a damaged directory entry still read */
+        if (i % 4 == 2)
+        {
+            expect(log_columns_read(&block, (log_column_t)(next_random() % LOG_COLUMN_COUNT), values) < 0,
+                   "damaged read", (size_t)i);
+        }
+    }
+
+    block = layouts[0].blocks[0];
+    block.header.count = LOG_BLOCK_RECORDS + 1;
+    expect(log_columns_decode(&block, decoded) < 0, "row count", 0);
+    block.header.layout = 7;
+    expect(log_columns_read(&block, LOG_COLUMN_TIME, values) < 0, "layout", 0);
+}
+
+static void run_store(void *ctx, uint64_t n)
+{
+    log_columns_t *cols = ctx;
+
+    for (uint64_t k = 0; k < n; k++)
+    {
+        store(&layouts[cols == NULL ? 0 : 1], cols);
+    }
+}
+
+static void run_pressure(void *ctx, uint64_t n)
+{
+    const layout_t *layout = ctx;
+    int64_t values[LOG_COLUMNS_ROWS];
+    int64_t sum = 0;
+
+    for (uint64_t k = 0; k < n; k++)
+    {
+        for (size_t b = 0; b < layout->count; b++)
+        {
+            const log_block_t *block = &layout->blocks[b];
+            int count = log_columns_read(block, LOG_COLUMN_PRESSURE, values);
+            for (int i = 0; i < count; i++)
+            {
+                sum += values[i];
+            }
+            if (block->header.layout == LOG_LAYOUT_ROW)
+            {
+                bytes += LOG_BLOCK_HEADER_SIZE + (uint64_t)count * sizeof(log_record_t);
+            }
+            else
+            {
+                const log_column_entry_t *directory = (const log_column_entry_t *)block->payload;
+                bytes += LOG_BLOCK_HEADER_SIZE + LOG_COLUMNS_DIRECTORY + directory[LOG_COLUMN_PRESSURE].size;
+            }
+        }
+    }
+    bench_sink += (uint64_t)sum;
+}
+
+static void run_decode(void *ctx, uint64_t n)
+{
+    const layout_t *layout = ctx;
+    log_record_t decoded[LOG_COLUMNS_ROWS];
+    uint64_t sum = 0;
+
+    for (uint64_t k = 0; k < n; k++)
+    {
+        for (size_t b = 0; b < layout->count; b++)
+        {
+            const log_block_t *block = &layout->blocks[b];
+            int count = log_columns_decode(block, decoded);
+            for (int i = 0; i < count; i++)
+            {
+                sum += (uint64_t)decoded[i].time_us + decoded[i].pressure + (uint32_t)decoded[i].temperature;
+            }
+            if (block->header.layout == LOG_LAYOUT_ROW)
+            {
+                bytes += LOG_BLOCK_HEADER_SIZE + (uint64_t)count * sizeof(log_record_t);
+            }
+            else
+            {
+                const log_column_entry_t *directory = (const log_column_entry_t *)block->payload;
+                bytes += LOG_BLOCK_HEADER_SIZE + LOG_COLUMNS_DIRECTORY;
+                for (int c = 0; c < LOG_COLUMN_COUNT; c++)
+                {
+                    bytes += directory[c].size;
+                }
+            }
+        }
+    }
+    bench_sink += sum;
+}
+
+int main(int argc, char **argv)
+{
+    bench_config_t config = BENCH_CONFIG_DEFAULT();
+    const char *json = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    generate();
+    log_columns_t *cols = malloc(sizeof(log_columns_t));
+    for (int l = 0; l < 2; l++)
+    {
+        layouts[l].blocks = malloc(sizeof(log_block_t) * (record_count / LOG_BLOCK_RECORDS + 1));
+    }
+    store(&layouts[0], NULL);
+    store(&layouts[1], cols);
+    verify_layout(&layouts[0]);
+    verify_layout(&layouts[1]);
+    verify_damage();
+    bool ok = failures == 0;
+    printf("verify: %" PRIu64 " checks, %" PRIu64 " failures\n\n", checked, failures);
+
+    printf("%zu records, a day of logging\n", record_count);
+    printf("%-10s %8s %10s %12s %14s\n", "layout", "blocks", "bytes", "records/blk", "bytes/record");
+    for (int l = 0; l < 2; l++)
+    {
+        const layout_t *layout = &layouts[l];
+        printf("%-10s %8zu %10zu %12.1f %14.2f\n", layout->name, layout->count, layout->count * LOG_BLOCK_SIZE,
+               (double)record_count / (double)layout->count,
+               (double)(layout->count * LOG_BLOCK_SIZE) / (double)record_count);
+    }
+    printf("columnar encoder RAM: %zu bytes\n\n", sizeof(log_columns_t));
+
+    const bench_case_t cases[] = {
+        {"row store", run_store, NULL, {{0}}},
+        {"columnar store", run_store, cols, {{0}}},
+        {"row pressure", run_pressure, &layouts[0], {{"bytes", &bytes}}},
+        {"columnar pressure", run_pressure, &layouts[1], {{"bytes", &bytes}}},
+        {"row full decode", run_decode, &layouts[0], {{"bytes", &bytes}}},
+        {"columnar full decode", run_decode, &layouts[1], {{"bytes", &bytes}}},
+    };
+    const size_t count = sizeof(cases) / sizeof(cases[0]);
+    bench_result_t results[sizeof(cases) / sizeof(cases[0])];
+
+    bench_print_header(stdout);
+    for (size_t i = 0; i < count; i++)
+    {
+        bench_run(&config, &cases[i], &results[i]);
+        bench_print(stdout, &results[i]);
+    }
+    printf("%-28s %6.2fx the row time, %.1f ns per record\n", "columnar store", results[1].median / results[0].median,
+           results[1].median / (double)record_count);
+    printf("%-28s %6.2fx the row time, %.2fx the bytes\n", "columnar pressure", results[3].median / results[2].median,
+           results[3].counter[0] / results[2].counter[0]);
+    printf("%-28s %6.2fx the row time, %.2fx the bytes\n", "columnar full decode",
+           results[5].median / results[4].median, results[5].counter[0] / results[4].counter[0]);
+    if (json != NULL && bench_write_json(json, "layout", results, count) != 0)
+    {
+        perror(json);
+        return 2;
+    }
+
+    free(cols);
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
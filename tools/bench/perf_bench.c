@@ -0,0 +1,400 @@
+/**
+ * @file perf_bench.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Performance suite for firmware components and the sampling path
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The driver sources are the firmware files, built against the host port in
+ * tools/port: GPIO writes and delays only count, so the LCD cases report the
+ * formatting cost in ns and the bus cost in GPIO writes and yields per call.
+ *
+ * The sample path replays sensorTask, dataTask and the writer: the three
+ * drivers of main.c through the executor, pipeline.c and logger.c, with a
+ * telemetry frame per record and a sink that drops the blocks. Locks and
+ * task switches are not included.
+ *
+ * ### Example
+ * ~~~
+ * perf_bench                                  # run everything
+ * perf_bench --filter lcd --reps 31
+ * perf_bench --json perf.json                 # save results
+ * perf_bench --baseline perf.json --threshold 5
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "port.h"
+#include "battery/battery.h"
+#include "epoch/epoch.h"
+#include "lcd/esp_lcd.h"
+#include "logfmt/log_block.h"
+#include "logger/logger.h"
+#include "pipeline/pipeline.h"
+#include "sensor/sample_join.h"
+#include "sensor/sensor.h"
+#include "sensor/sensor_drivers.h"
+#include "telemetry/frame.h"
+
+/* battery */
+
+static void run_battery_percentage(void *ctx, uint64_t n)
+{
+    battery_t *battery = ctx;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        battery->value = (int)(i & 4095);
+        sum += (uint64_t)battery_percentage(battery);
+    }
+    bench_sink += sum;
+}
+
+static void run_battery_voltage(void *ctx, uint64_t n)
+{
+    battery_t *battery = ctx;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        battery->value = (int)(i & 4095);
+        sum += (uint64_t)battery_voltage(battery);
+    }
+    bench_sink += sum;
+}
+
+/* lcd */
+
+static void run_lcd_set_int(void *ctx, uint64_t n)
+{
+    for (uint64_t i = 0; i < n; i++)
+    {
+        lcdSetInt(ctx, (int)(i * 7919u % 100000u), 8, 1);
+    }
+}
+
+static void run_lcd_set_text(void *ctx, uint64_t n)
+{
+    for (uint64_t i = 0; i < n; i++)
+    {
+        lcdSetText(ctx, "Count: ", 0, 1);
+    }
+}
+
+/* channel */
+
+static void run_channel(void *ctx, uint64_t n)
+{
+    channel_t *channel = ctx;
+    sensor_sample_t sample = {.sensor = 1, .count = 2};
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sample.seq = (uint32_t)i;
+        channel_push(channel, &sample);
+        channel_pop(channel, &sample);
+        sum += sample.seq;
+    }
+    bench_sink += sum;
+}
+
+/* sample join */
+
+static void on_row(void *arg, const sample_row_t *row)
+{
+    *(uint64_t *)arg += row->seq;
+}
+
+static void run_join(void *ctx, uint64_t n)
+{
+    sample_join_t *join = ctx;
+    sensor_sample_t rtc = {.sensor = 0, .count = 2};
+    sensor_sample_t pressure = {.sensor = 1, .count = 2};
+    for (uint64_t i = 0; i < n; i++)
+    {
+        rtc.seq = pressure.seq = (uint32_t)i;
+        rtc.stamp = pressure.stamp = (int64_t)i * 1000000;
+        sample_join_push(join, &rtc);
+        sample_join_push(join, &pressure);
+    }
+}
+
+/* log block */
+
+static void run_log_record(void *ctx, uint64_t n)
+{
+    log_block_t *block = ctx;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        log_record_t *record = log_block_reserve(block);
+        *record = (log_record_t){.time_us = (int64_t)i, .battery_mv = 3900, .temperature = 2150, .pressure = 101325};
+        log_block_commit(block);
+        if (log_block_full(block))
+        {
+            log_block_seal(block);
+            bench_sink += block->header.crc;
+            log_block_init(block, (uint32_t)i);
+        }
+    }
+}
+
+/* telemetry frame */
+
+static void run_frame(void *ctx, uint64_t n)
+{
+    const log_record_t *record = ctx;
+    uint8_t frame[FRAME_MAX_ENCODED];
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sum += frame_encode(1, (uint8_t)i, record, sizeof(*record), frame);
+    }
+    bench_sink += sum;
+}
+
+/* sample path: executor -> pipeline -> logger + telemetry frame */
+
+enum
+{
+    PATH_RTC,
+    PATH_PRESSURE,
+    PATH_BATTERY,
+    PATH_SENSORS,
+};
+
+typedef struct
+{
+    sensor_exec_t exec;
+    pipeline_t pipeline;
+    channel_t channels[PATH_SENSORS];
+    sensor_sample_t items[PATH_SENSORS][QUEUE_SIZE];
+    log_sink_t sink;
+    uint32_t seq;
+    uint64_t bytes; /* telemetry bytes encoded */
+} path_t;
+
+static path_t path;
+static i2c_sensor_t path_rtc;
+static i2c_sensor_t path_pressure;
+static battery_t path_battery;
+
+/* Sensor table of main.c, APP_SENSOR_TABLE */
+static const sensor_t path_sensors[] = {
+    {&ds3231_sensor, &path_rtc, CONFIG_LOGGER_RTC_SYNC_SAMPLES * PIPELINE_OVERSAMPLE},
+    {&bmp180_sensor, &path_pressure, 1},
+    {&battery_sensor, &path_battery, PIPELINE_OVERSAMPLE},
+};
+
+static const TickType_t path_timeouts[] = {0, 0, 0};
+
+static void path_wait(void *arg, uint32_t us)
+{
+    (void)arg;
+    port_time_us += us;
+}
+
+static int64_t path_now(void *arg)
+{
+    (void)arg;
+    return port_time_us;
+}
+
+static void path_row(void *arg, const log_record_t *record, bool stored)
+{
+    uint8_t frame[FRAME_MAX_ENCODED];
+    (void)arg;
+    (void)stored;
+
+    /* telemetry_send() */
+    path.bytes += frame_encode(1, (uint8_t)path.seq, record, sizeof(*record), frame);
+}
+
+static esp_err_t path_write(void *ctx, const log_block_t *blocks, size_t count)
+{
+    (void)ctx;
+    (void)blocks;
+    (void)count;
+    return ESP_OK;
+}
+
+static esp_err_t path_sync(void *ctx)
+{
+    (void)ctx;
+    return ESP_OK;
+}
+
+static void path_init(void)
+{
+    static const channel_policy_t policies[] = {CHANNEL_DROP_OLDEST, CHANNEL_COALESCE, CHANNEL_DROP_OLDEST};
+
+    path.exec = (sensor_exec_t){
+        .sensors = path_sensors,
+        .count = PATH_SENSORS,
+        .emit = pipeline_push,
+        .wait_us = path_wait,
+        .now_us = path_now,
+        .arg = &path.pipeline,
+    };
+    battery_default(&path_battery);
+    i2cdev_init();
+    sensor_exec_init(&path.exec);
+    for (int i = 0; i < PATH_SENSORS; i++)
+    {
+        channel_init(&path.channels[i], path.items[i], QUEUE_SIZE, policies[i]);
+    }
+    path.pipeline = (pipeline_t){
+        .sensors = path_sensors,
+        .channels = path.channels,
+        .timeouts = path_timeouts,
+        .count = PATH_SENSORS,
+        .rtc = PATH_RTC,
+        .pressure = PATH_PRESSURE,
+        .battery = PATH_BATTERY,
+        .row = path_row,
+    };
+    pipeline_init(&path.pipeline);
+    logger_init();
+    path.sink = (log_sink_t){.write = path_write, .sync = path_sync};
+}
+
+static void run_sample_path(void *ctx, uint64_t n)
+{
+    (void)ctx;
+
+    for (uint64_t i = 0; i < n; i++)
+    {
+        port_time_us += CONFIG_LOGGER_SAMPLE_PERIOD_MS * 1000 / PIPELINE_OVERSAMPLE;
+        sensor_exec_tick(&path.exec, path.seq++, port_time_us);
+
+        /* dataTask(), then the writer */
+        pipeline_drain(&path.pipeline);
+        logger_step(&path.sink);
+    }
+    bench_sink += path.bytes;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--reps N] [--warmup MS] [--min-rep MS] [--filter TEXT]\n"
+            "          [--json FILE] [--baseline FILE] [--threshold PERCENT]\n",
+            name);
+}
+
+int main(int argc, char **argv)
+{
+    bench_config_t config = BENCH_CONFIG_DEFAULT();
+    const char *json = NULL, *baseline = NULL;
+    double threshold = 10.0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (value == NULL)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        if (strcmp(arg, "--reps") == 0)
+            config.reps = (uint32_t)strtoul(value, NULL, 10);
+        else if (strcmp(arg, "--warmup") == 0)
+            config.warmup_ms = (uint32_t)strtoul(value, NULL, 10);
+        else if (strcmp(arg, "--min-rep") == 0)
+            config.min_rep_ms = (uint32_t)strtoul(value, NULL, 10);
+        else if (strcmp(arg, "--filter") == 0)
+            config.filter = value;
+        else if (strcmp(arg, "--json") == 0)
+            json = value;
+        else if (strcmp(arg, "--baseline") == 0)
+            baseline = value;
+        else if (strcmp(arg, "--threshold") == 0)
+            threshold = strtod(value, NULL);
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+
+    /* Fixtures */
+    static battery_t battery;
+    battery_default(&battery);
+
+    static lcd_t lcd;
+    lcdDefault(&lcd);
+
+    static sensor_sample_t channel_items[QUEUE_SIZE];
+    static channel_t channel;
+    channel_init(&channel, channel_items, QUEUE_SIZE, CHANNEL_DROP_OLDEST);
+
+    static uint64_t rows;
+    static sample_join_t join = {
+        .required = 3,
+        .key = SAMPLE_JOIN_SEQ,
+        .max_age_us = 3000000,
+        .emit = on_row,
+        .arg = &rows,
+    };
+    sample_join_init(&join);
+
+    static log_block_t block;
+    log_block_init(&block, 0);
+
+    static log_record_t record = {.time_us = 1666811220000000LL, .battery_mv = 3900, .temperature = 2150,
+                                  .pressure = 101325};
+
+    path_init();
+
+    const bench_case_t cases[] = {
+        {"battery_percentage", run_battery_percentage, &battery, {{0}}},
+        {"battery_voltage", run_battery_voltage, &battery, {{0}}},
+        {"lcdSetInt", run_lcd_set_int, &lcd,
+         {{"gpio_writes", &port_counters.gpio_writes}, {"yields", &port_counters.delays}}},
+        {"lcdSetText", run_lcd_set_text, &lcd,
+         {{"gpio_writes", &port_counters.gpio_writes}, {"yields", &port_counters.delays}}},
+        {"channel push+pop", run_channel, &channel, {{0}}},
+        {"sample_join row", run_join, &join, {{0}}},
+        {"log_block record", run_log_record, &block, {{0}}},
+        {"frame_encode record", run_frame, &record, {{0}}},
+        {"sample path", run_sample_path, NULL, {{"telemetry_bytes", &path.bytes}}},
+    };
+    const size_t count = sizeof(cases) / sizeof(cases[0]);
+    bench_result_t results[sizeof(cases) / sizeof(cases[0])];
+    size_t done = 0;
+
+    printf("%" PRIu32 " reps of >= %" PRIu32 " ms after %" PRIu32 " ms warmup\n\n", config.reps, config.min_rep_ms,
+           config.warmup_ms);
+    bench_print_header(stdout);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (bench_run(&config, &cases[i], &results[done]))
+        {
+            bench_print(stdout, &results[done++]);
+        }
+    }
+
+    if (json != NULL && bench_write_json(json, "perf", results, done) != 0)
+    {
+        perror(json);
+        return 2;
+    }
+    if (baseline != NULL)
+    {
+        int regressions = bench_compare(baseline, results, done, threshold);
+        if (regressions < 0)
+        {
+            perror(baseline);
+            return 2;
+        }
+        printf("\n%d regression%s over %.1f%%\n", regressions, regressions == 1 ? "" : "s", threshold);
+        return regressions > 0;
+    }
+    return 0;
+}
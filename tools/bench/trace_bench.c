@@ -0,0 +1,284 @@
+/**
+ * @file trace_bench.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Deferred trace cost, ring integrity under preemption, sample capture
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * cost: one TRACE_RING_WRITE() against formatting the same event with
+ * snprintf(), which is the least a printf() on the hot path costs before the
+ * UART is involved.
+ *
+ * integrity: producer threads preempt each other in the middle of writes
+ * while a consumer drains. Every record must arrive whole, in per-producer
+ * order, or be counted as dropped. A producer yields when its record is
+ * dropped, as a task blocks on the device, so most records get through and
+ * at most INTEGRITY_DROPS percent may be dropped.
+ *
+ * capture: with -o, writes a few records as TELEMETRY_TRACE frames and prints
+ * the text they must decode to. Built without PIE so string addresses fit in
+ * 32 bits, like on the ESP32:
+ * ~~~
+ * trace_bench -o trace.bin > expected.txt
+ * python3 tools/trace.py decode --elf trace_bench --file trace.bin --plain | diff - expected.txt
+ * ~~~
+ *
+ * ### Example
+ * ~~~
+ * trace_bench            # 10M records
+ * trace_bench 100000000  # 100M records
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "telemetry/frame.h"
+#include "trace/trace_ring.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES() __rdtsc()
+#else
+#define CYCLES() 0
+#endif
+
+#define TELEMETRY_TRACE 4 /* telemetry_type_t */
+#define PRODUCERS 4
+#define RING_SLOTS 64 /* TRACE_RING_SLOTS */
+#define INTEGRITY_DROPS 10 /* Largest share of dropped records, in percent */
+
+static const char *const sensor_names[] = {"ds3231", "bmp180", "battery"};
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief ns and TSC cycles per record, trace vs snprintf
+ */
+static void run_cost(uint32_t n)
+{
+    static trace_slot_t slots[RING_SLOTS];
+    trace_ring_t ring;
+    trace_slot_t slot;
+    char line[96];
+    uint32_t sink = 0;
+
+    trace_ring_init(&ring, slots, RING_SLOTS);
+
+    /* Drain every 32 records, like trace_task() keeping up */
+    double start = now_s();
+    uint64_t c0 = CYCLES();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        TRACE_RING_WRITE(&ring, i, "%s: sample %u dropped after %u ms", (uintptr_t)sensor_names[i % 3], i, 10);
+        if ((i & 31) == 31)
+        {
+            while (trace_ring_read(&ring, &slot))
+            {
+                sink += slot.arg[1];
+            }
+        }
+    }
+    uint64_t trace_cycles = CYCLES() - c0;
+    double trace_s = now_s() - start;
+
+    /* Write side alone: the ring is drained outside the timed region */
+    uint64_t write_cycles = 0;
+    double write_s = 0.0;
+    for (uint32_t i = 0; i < n; i += 32)
+    {
+        double t0 = now_s();
+        c0 = CYCLES();
+        for (uint32_t k = i; k < i + 32; k++)
+        {
+            TRACE_RING_WRITE(&ring, k, "%s: sample %u dropped after %u ms", (uintptr_t)sensor_names[k % 3], k,
+                             10);
+        }
+        write_cycles += CYCLES() - c0;
+        write_s += now_s() - t0;
+        while (trace_ring_read(&ring, &slot))
+        {
+            sink += slot.arg[1];
+        }
+    }
+
+    start = now_s();
+    c0 = CYCLES();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        int len = snprintf(line, sizeof(line), "%s: sample %u dropped after %u ms", sensor_names[i % 3], i, 10);
+        sink += (uint32_t)len + (uint8_t)line[len - 1];
+    }
+    uint64_t printf_cycles = CYCLES() - c0;
+    double printf_s = now_s() - start;
+
+    printf("%-22s %8.1f ns/record %8.1f cycles/record\n", "trace write", write_s * 1e9 / n,
+           (double)write_cycles / n);
+    printf("%-22s %8.1f ns/record %8.1f cycles/record\n", "trace write + drain", trace_s * 1e9 / n,
+           (double)trace_cycles / n);
+    printf("%-22s %8.1f ns/record %8.1f cycles/record %6.1fx\n", "snprintf", printf_s * 1e9 / n,
+           (double)printf_cycles / n, printf_s / write_s);
+    printf("dropped %" PRIu32 " (sink %" PRIu32 ")\n\n", trace_ring_dropped(&ring), sink & 1);
+}
+
+typedef struct
+{
+    trace_ring_t *ring;
+    uint32_t id;
+    uint32_t count;
+    uint32_t written;
+    uint32_t finished;
+} producer_t;
+
+static const char integrity_fmt[] = "producer %u record %u check %x %x";
+
+static void *producer(void *arg)
+{
+    producer_t *p = arg;
+    for (uint32_t i = 0; i < p->count; i++)
+    {
+        bool written = TRACE_RING_WRITE(p->ring, i, integrity_fmt, p->id, i, ~i, p->id ^ i);
+        p->written += written;
+        if (!written || (i & 31) == 31)
+        {
+            sched_yield(); /* let the consumer in on a single core, and when the ring is full */
+        }
+    }
+    __atomic_store_n(&p->finished, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/**
+ * @brief Concurrent producers, one consumer; returns true when every record checks out
+ */
+static bool run_integrity(uint32_t n)
+{
+    static trace_slot_t slots[RING_SLOTS];
+    trace_ring_t ring;
+    producer_t producers[PRODUCERS];
+    pthread_t threads[PRODUCERS];
+    uint32_t next[PRODUCERS] = {0};
+    uint32_t received = 0, torn = 0, disorder = 0, written = 0;
+    trace_slot_t slot;
+
+    trace_ring_init(&ring, slots, RING_SLOTS);
+    for (uint32_t p = 0; p < PRODUCERS; p++)
+    {
+        producers[p] = (producer_t){.ring = &ring, .id = p, .count = n / PRODUCERS};
+        pthread_create(&threads[p], NULL, producer, &producers[p]);
+    }
+
+    /* Drain until every producer is done and the ring is empty */
+    for (bool last = false; !last;)
+    {
+        last = true;
+        for (uint32_t p = 0; p < PRODUCERS; p++)
+        {
+            last &= __atomic_load_n(&producers[p].finished, __ATOMIC_ACQUIRE) != 0;
+        }
+        while (trace_ring_read(&ring, &slot))
+        {
+            uint32_t p = slot.arg[0];
+            if (slot.fmt != integrity_fmt || slot.nargs != 4 || p >= PRODUCERS || slot.arg[2] != ~slot.arg[1] ||
+                slot.arg[3] != (p ^ slot.arg[1]) || slot.stamp != slot.arg[1])
+            {
+                torn++;
+                continue;
+            }
+            disorder += slot.arg[1] < next[p];
+            next[p] = slot.arg[1] + 1;
+            received++;
+        }
+        sched_yield();
+    }
+
+    uint32_t produced = 0;
+    for (uint32_t p = 0; p < PRODUCERS; p++)
+    {
+        pthread_join(threads[p], NULL);
+        produced += producers[p].count;
+        written += producers[p].written;
+    }
+    uint32_t dropped = trace_ring_dropped(&ring);
+    /* Mostly delivered, or the run says little about the ring under contention */
+    bool contended = (uint64_t)dropped * 100 <= (uint64_t)produced * INTEGRITY_DROPS;
+    bool ok = torn == 0 && disorder == 0 && received == written && written + dropped == produced && contended;
+    printf("%u producers: produced %" PRIu32 " received %" PRIu32 " dropped %" PRIu32 " (%.2f%%) torn %" PRIu32
+           " out of order %" PRIu32 "  %s%s\n\n",
+           PRODUCERS, produced, received, dropped, 100.0 * dropped / produced, torn, disorder, ok ? "ok" : "FAIL",
+           contended ? "" : " too many drops");
+    return ok;
+}
+
+/**
+ * @brief Write TELEMETRY_TRACE frames to @p path, print the expected text
+ */
+static bool run_capture(const char *path)
+{
+    static trace_slot_t slots[RING_SLOTS];
+    trace_ring_t ring;
+    trace_slot_t slot;
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+    uint8_t frame[FRAME_MAX_ENCODED];
+    uint8_t seq = 0;
+    size_t len = 0;
+
+    FILE *out = fopen(path, "wb");
+    if (out == NULL)
+    {
+        perror(path);
+        return false;
+    }
+
+    trace_ring_init(&ring, slots, RING_SLOTS);
+    TRACE_RING_WRITE(&ring, 1000, "boot");
+    TRACE_RING_WRITE(&ring, 2000, "tick off by %d us", -1500);
+    TRACE_RING_WRITE(&ring, 3000, "%s: sample %u %s", (uintptr_t)sensor_names[1], 42,
+                     (uintptr_t) "queued, oldest dropped");
+    TRACE_RING_WRITE(&ring, 4000, "status 0x%08x, %5u%% full, [%-6s]", 0xBEEF, 87, (uintptr_t)sensor_names[0]);
+    TRACE_RING_WRITE(&ring, 5000, "logger full, row %u not stored", 4000000000u);
+    printf("boot\n");
+    printf("tick off by %d us\n", -1500);
+    printf("%s: sample %u %s\n", sensor_names[1], 42, "queued, oldest dropped");
+    printf("status 0x%08x, %5u%% full, [%-6s]\n", 0xBEEF, 87, sensor_names[0]);
+    printf("logger full, row %u not stored\n", 4000000000u);
+
+    /* Packed like trace_task() */
+    while (trace_ring_read(&ring, &slot))
+    {
+        if (len + TRACE_RECORD_MAX > sizeof(payload))
+        {
+            fwrite(frame, 1, frame_encode(TELEMETRY_TRACE, seq++, payload, len, frame), out);
+            len = 0;
+        }
+        len += trace_encode(&slot, 1, payload + len);
+    }
+    fwrite(frame, 1, frame_encode(TELEMETRY_TRACE, seq++, payload, len, frame), out);
+    return fclose(out) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 2 && strcmp(argv[1], "-o") == 0)
+    {
+        return run_capture(argv[2]) ? 0 : 1;
+    }
+
+    uint32_t n = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 10000000;
+    printf("%" PRIu32 " records, %d slot ring, %zu byte slots\n\n", n, RING_SLOTS, sizeof(trace_slot_t));
+    run_cost(n);
+    bool ok = run_integrity(n);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
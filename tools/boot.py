@@ -0,0 +1,235 @@
+"""
+Author: Jesus Minjares
+Date:   10-19-2026
+GitHub: https://github.com/jminjares4
+Brief:  Collect the boot stage trace of the logger and check the time to first sample
+"""
+import json
+import statistics
+import struct
+import sys
+import time
+
+import click
+
+from telemetry import TELEMETRY_BOOT, FrameDecoder
+
+# one stage, see firmware/components/boot/boot_trace.h
+RECORD = struct.Struct('<IIBBb14s')
+
+# stage that sets the time to first sample, see APP_BOOT_TABLE in main.c
+FIRST_SAMPLE = 'first_sample'
+
+
+class BootCollector:
+    """
+    Groups TELEMETRY_BOOT records into boots
+
+    The device sends its stages in index order once per boot, so index 0
+    starts a new boot.
+    """
+
+    def __init__(self):
+        self.boots = []
+
+    def feed(self, payload):
+        start_us, end_us, index, core, result, name = RECORD.unpack(payload)
+        if index == 0 or not self.boots:
+            self.boots.append([])
+        self.boots[-1].append({
+            'name': name.rstrip(b'\x00').decode('ascii', errors='replace'),
+            'start_us': start_us,
+            # a stage that never ended is sent with end 0 and result -1
+            'end_us': None if result < 0 and end_us == 0 else end_us,
+            'core': core,
+            'result': result,
+        })
+
+
+def summarize(boots):
+    """
+    Per stage min/median/max of the start and end times over several boots
+
+    boots (list) : boots, each a list of stages from BootCollector
+    """
+    summary = {}
+    for boot in boots:
+        for stage in boot:
+            entry = summary.setdefault(stage['name'], {'start': [], 'end': [], 'failed': 0})
+            if stage['end_us'] is None or stage['result'] != 0:
+                entry['failed'] += 1
+                continue
+            entry['start'].append(stage['start_us'])
+            entry['end'].append(stage['end_us'])
+    for entry in summary.values():
+        for key in ('start', 'end'):
+            values = entry.pop(key)
+            entry[key] = {
+                'min': min(values) if values else None,
+                'median': int(statistics.median(values)) if values else None,
+                'max': max(values) if values else None,
+            }
+    return summary
+
+
+def timeline(summary, width=40):
+    """
+    Median start to median end of every stage on a shared time axis
+
+    summary (dict) : from summarize()
+    width (int)    : characters
+    """
+    span = max([s['end']['median'] for s in summary.values() if s['end']['median'] is not None] or [0])
+    lines = []
+    for name, stage in summary.items():
+        start, end = stage['start']['median'], stage['end']['median']
+        bar = ''
+        for i in range(width):
+            lo, hi = span * i // width, span * (i + 1) // width
+            if span and start is not None and end is not None and start < hi and end >= lo:
+                bar += '|' if start == end else '#'
+            else:
+                bar += '.'
+        lines.append('%-12s |%s|' % (name, bar))
+    return lines
+
+
+def read_port(port, baudrate, runs, timeout):
+    """
+    Reset the board runs times through RTS and collect one boot each
+
+    port (str)      : serial/COM port, RTS wired to EN as on the devkits
+    baudrate (int)  : baudrate of serial port: bit/sec
+    runs (int)      : boots to collect
+    timeout (int)   : seconds to wait for each boot report
+    """
+    import serial
+
+    collector = BootCollector()
+    with serial.Serial(port, baudrate, timeout=0.05) as ser:
+        for run in range(runs):
+            # EN low then high, GPIO0 left high so the board boots the app
+            ser.dtr = False
+            ser.rts = True
+            time.sleep(0.1)
+            ser.rts = False
+            decoder = FrameDecoder()
+            before = len(collector.boots)
+            start_time = time.time()
+            while (time.time() - start_time) < timeout:
+                for rtype, _, payload in decoder.feed(ser.read(max(1, ser.in_waiting))):
+                    if rtype == TELEMETRY_BOOT:
+                        collector.feed(payload)
+                if len(collector.boots) > before and collector.boots[-1][-1]['name'] == FIRST_SAMPLE:
+                    break
+            print('run %d: %s' % (run + 1, 'ok' if len(collector.boots) > before else 'no boot report'),
+                  file=sys.stderr)
+    return collector.boots
+
+
+def read_file(path):
+    """
+    Every boot in a capture of the raw telemetry stream
+
+    path (str) : capture file
+    """
+    collector = BootCollector()
+    with open(path, 'rb') as f:
+        for rtype, _, payload in FrameDecoder().feed(f.read() + b'\x00'):
+            if rtype == TELEMETRY_BOOT:
+                collector.feed(payload)
+    return collector.boots
+
+
+@click.group()
+def main():
+    """
+    Boot stage trace of the logger
+    """
+
+
+# examples:
+# python3 boot.py report --port="serial-port" --runs=10 --json=boot.json
+# python3 boot.py report --file capture.bin --budget-ms=1000 --baseline=boot.json
+@main.command()
+@click.option('--port', '-p', default=None, help='Serial Port Number, the board is reset for every run')
+@click.option('--file', '-f', 'path', default=None, type=click.Path(exists=True), help='Captured telemetry stream')
+@click.option('--baudrate', '-b', default=921600, help='Serial Baudrate')
+@click.option('--runs', '-n', default=5, help='Boots to collect from the port')
+@click.option('--timeout', '-t', default=15, help='Seconds to wait for each boot report')
+@click.option('--budget-ms', default=1000, help='Time to first sample target in ms, provisional as in main.c')
+@click.option('--baseline', default=None, type=click.Path(exists=True), help='Summary of an earlier run to compare to')
+@click.option('--threshold', default=0.1, help='Allowed median growth over the baseline, as a fraction')
+@click.option('--json', 'json_path', default=None, help='Write the summary, usable as a later baseline')
+def report(port, path, baudrate, runs, timeout, budget_ms, baseline, threshold, json_path):
+    """
+    Summarize boot stages and check the time to first sample
+
+    Exits 1 when the median time to first sample misses the budget, a stage
+    failed, or a stage ends later than the baseline allows.
+
+    port (str)          : serial/COM port
+    path (str)          : capture of the raw telemetry stream
+    baudrate (int)      : baudrate of serial port: bit/sec
+    runs (int)          : boots to collect from the port
+    timeout (int)       : seconds per boot
+    budget_ms (int)     : time to first sample target, provisional until measured on a board
+    baseline (str)      : JSON written by an earlier --json
+    threshold (float)   : allowed growth of a median end time
+    json_path (str)     : summary output
+    """
+    if (port is None) == (path is None):
+        raise click.UsageError('give exactly one of --port and --file')
+
+    boots = read_port(port, baudrate, runs, timeout) if port else read_file(path)
+    if not boots:
+        print('no boot report found')
+        sys.exit(1)
+
+    summary = summarize(boots)
+    print('%d boots' % len(boots))
+    print('%-12s %10s %10s %10s %10s %7s' % ('stage', 'start', 'end min', 'end median', 'end max', 'failed'))
+    for name, stage in summary.items():
+        print('%-12s %10s %10s %10s %10s %7d' % (name, stage['start']['median'], stage['end']['min'],
+                                               stage['end']['median'], stage['end']['max'], stage['failed']))
+    print()
+    for line in timeline(summary):
+        print(line)
+    print()
+
+    ok = True
+    first = summary.get(FIRST_SAMPLE, {}).get('end', {}).get('median')
+    if first is None or first > budget_ms * 1000:
+        print('time to first sample: %s us, over the %d ms budget' % (first, budget_ms))
+        ok = False
+    else:
+        print('time to first sample: %d us, budget %d ms' % (first, budget_ms))
+    for name, stage in summary.items():
+        if stage['failed']:
+            print('%s: failed in %d of %d boots' % (name, stage['failed'], len(boots)))
+            ok = False
+
+    if baseline:
+        with open(baseline) as f:
+            reference = json.load(f)['stages']
+        for name, stage in summary.items():
+            before = reference.get(name, {}).get('end', {}).get('median')
+            now = stage['end']['median']
+            if before is None or now is None:
+                continue
+            if now > before * (1 + threshold):
+                print('%s: median end %d us, baseline %d us (+%.0f%%)' %
+                      (name, now, before, 100.0 * (now - before) / before))
+                ok = False
+
+    if json_path:
+        with open(json_path, 'w') as f:
+            json.dump({'boots': len(boots), 'budget_ms': budget_ms, 'stages': summary}, f, indent=2)
+
+    print('PASS' if ok else 'FAIL')
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    # Call main function
+    main()
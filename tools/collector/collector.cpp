@@ -0,0 +1,523 @@
+/**
+ * @file collector.cpp
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Telemetry collector for many loggers: one epoll loop over every serial port
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * One thread serves every port: ports are level triggered and read once per
+ * wakeup, so a busy device cannot starve the others, and nothing waits on a
+ * slow or vanished one. A port that hangs up is closed and opened again
+ * every REOPEN_S until the device is back.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "collector.h"
+#include "epoch/epoch.h"
+#include "fmt/fmt.h"
+#include "telemetry/frame.h"
+
+namespace collector
+{
+
+namespace
+{
+
+constexpr double REOPEN_S = 1.0;      /* delay between open attempts of a closed port */
+constexpr size_t READ_SIZE = 65536;   /* bytes per read, one read per port and wakeup */
+constexpr uint8_t TYPE_SAMPLE = 1;    /* TELEMETRY_SAMPLE, see telemetry.h */
+constexpr uint64_t WATCH_BIT = 1ull << 63;
+
+/* Longest run between delimiters: a range read chunk, see range_read.h */
+constexpr size_t RUN_MAX = FRAME_ENCODED_SIZE(544);
+
+/**
+ * @brief termios speed of a baudrate, B0 if unsupported
+ */
+speed_t baud_speed(int baudrate)
+{
+    switch (baudrate)
+    {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    case 1000000: return B1000000;
+    case 1500000: return B1500000;
+    case 2000000: return B2000000;
+    default: return B0;
+    }
+}
+
+} // namespace
+
+/**
+ * @struct Collector::Watch
+ * @brief Extra descriptor in the loop: signals, timers
+ */
+struct Collector::Watch
+{
+    int fd;
+    std::function<void()> ready;
+};
+
+double now_s()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Take bytes read from the port, calls handler once per valid frame
+ */
+void FrameParser::feed(const uint8_t *data, size_t len, Counters &counters, const Handler &handler)
+{
+    const uint8_t *end = data + len;
+    while (data < end)
+    {
+        const uint8_t *zero = (const uint8_t *)std::memchr(data, 0, (size_t)(end - data));
+        const uint8_t *stop = zero != nullptr ? zero : end;
+
+        /* Bytes up to the delimiter join the current run */
+        size_t n = (size_t)(stop - data);
+        if (!overflow_ && run_.size() + n > RUN_MAX)
+        {
+            overflow_ = true;
+            counters.overflows++;
+        }
+        if (!overflow_)
+        {
+            run_.insert(run_.end(), data, stop);
+        }
+        if (zero == nullptr)
+        {
+            break;
+        }
+        finish(counters, handler);
+        data = zero + 1;
+    }
+}
+
+/**
+ * @brief Decode the run before a delimiter
+ */
+void FrameParser::finish(Counters &counters, const Handler &handler)
+{
+    if (!overflow_ && !run_.empty())
+    {
+        uint8_t type;
+        uint8_t seq;
+        const uint8_t *payload;
+        int n = frame_decode(run_.data(), run_.size(), &type, &seq, &payload);
+        if (n < 0)
+        {
+            counters.errors++;
+        }
+        else
+        {
+            if (last_seq_ >= 0)
+            {
+                counters.lost += (uint8_t)(seq - last_seq_ - 1);
+            }
+            last_seq_ = seq;
+            counters.frames++;
+            handler(type, seq, payload, (size_t)n);
+        }
+    }
+    run_.clear();
+    overflow_ = false;
+}
+
+/**
+ * @brief Forget a partial run and the sequence number, after a reopen
+ */
+void FrameParser::reset()
+{
+    run_.clear();
+    overflow_ = false;
+    last_seq_ = -1;
+}
+
+SampleStore::~SampleStore()
+{
+    flush(true);
+    if (file_ != nullptr)
+    {
+        std::fclose(file_);
+    }
+}
+
+/**
+ * @brief Append written samples to a CSV file
+ */
+bool SampleStore::open(const std::string &path)
+{
+    file_ = std::fopen(path.c_str(), "a");
+    if (file_ == nullptr)
+    {
+        std::perror(path.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Put a sample in time order
+ */
+void SampleStore::add(const log_record_t &record, Counters &counters)
+{
+    if (written_ > 0 && record.time_us < last_written_)
+    {
+        counters.late++;
+        return;
+    }
+    if (any_ && record.time_us < newest_)
+    {
+        /* After any equal times, so equal samples keep their arrival order */
+        auto at = std::upper_bound(pending_.begin(), pending_.end(), record.time_us,
+                                   [](int64_t t, const log_record_t &r) { return t < r.time_us; });
+        pending_.insert(at, record);
+        counters.reordered++;
+    }
+    else
+    {
+        pending_.push_back(record);
+        newest_ = record.time_us;
+        any_ = true;
+    }
+    flush(false);
+}
+
+/**
+ * @brief Write samples older than the window, or all of them
+ */
+void SampleStore::flush(bool all)
+{
+    while (!pending_.empty() && (all || pending_.front().time_us < newest_ - window_us_))
+    {
+        write(pending_.front());
+        pending_.pop_front();
+    }
+    if (file_ != nullptr && all)
+    {
+        std::fflush(file_);
+    }
+}
+
+void SampleStore::write(const log_record_t &r)
+{
+    disorder_ += written_ > 0 && r.time_us < last_written_;
+    last_written_ = r.time_us;
+    time_sum_ += (uint64_t)r.time_us;
+    written_++;
+    if (file_ == nullptr)
+    {
+        return;
+    }
+
+    /* Same columns as logdecode's CSV */
+    char line[4 * FMT_INT_MAX + EPOCH_TEXT_MAX];
+    char *p = line;
+    p += fmt_int(p, r.time_us, 0, ' ');
+    *p++ = ',';
+    p += epoch_format(p, r.time_us, 3);
+    *p++ = ',';
+    p += fmt_fixed(p, r.temperature, 2, 0, ' ');
+    *p++ = ',';
+    p += fmt_uint(p, r.pressure, 0, ' ');
+    *p++ = ',';
+    p += fmt_uint(p, r.battery_mv, 0, ' ');
+    *p++ = '\n';
+    std::fwrite(line, 1, (size_t)(p - line), file_);
+}
+
+Device::Device(const std::string &path, int baudrate, int64_t window_us)
+    : path(path), name(path.substr(path.find_last_of('/') + 1)), baudrate(baudrate), store(window_us)
+{
+}
+
+Collector::Collector(int64_t window_us) : window_us_(window_us), buffer_(READ_SIZE)
+{
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_ < 0)
+    {
+        /* Reported once here, add() then refuses every port */
+        std::perror("epoll_create1");
+    }
+}
+
+Collector::~Collector()
+{
+    for (auto &device : devices_)
+    {
+        close(*device);
+    }
+    if (epoll_ >= 0)
+    {
+        ::close(epoll_);
+    }
+}
+
+/**
+ * @brief Add a port, opened now or retried from poll()
+ *
+ * @param path      serial port
+ * @param baudrate  bit/s
+ * @param out_dir   directory for name.csv, empty to keep samples in memory only
+ * @return bool     false without an epoll instance, on an unsupported baudrate or output file error
+ */
+bool Collector::add(const std::string &path, int baudrate, const std::string &out_dir)
+{
+    if (epoll_ < 0)
+    {
+        return false;
+    }
+    if (baud_speed(baudrate) == B0)
+    {
+        std::fprintf(stderr, "%s: unsupported baudrate %d\n", path.c_str(), baudrate);
+        return false;
+    }
+    auto device = std::make_unique<Device>(path, baudrate, window_us_);
+    if (!out_dir.empty())
+    {
+        mkdir(out_dir.c_str(), 0755);
+        if (!device->store.open(out_dir + "/" + device->name + ".csv"))
+        {
+            return false;
+        }
+    }
+    device->index = devices_.size();
+    devices_.push_back(std::move(device));
+    open(*devices_.back());
+    return true;
+}
+
+/**
+ * @brief Call ready() from poll() whenever fd is readable
+ */
+bool Collector::watch(int fd, std::function<void()> ready)
+{
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = WATCH_BIT | watches_.size();
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        return false;
+    }
+    watches_.push_back(std::make_unique<Watch>(Watch{fd, std::move(ready)}));
+    return true;
+}
+
+/**
+ * @brief Open a port raw and non-blocking and add it to the loop
+ */
+bool Collector::open(Device &device)
+{
+    int fd = ::open(device.path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+    {
+        device.reopen_at = now_s() + REOPEN_S;
+        return false;
+    }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        cfsetspeed(&tio, baud_speed(device.baudrate));
+        tio.c_cflag |= CLOCAL | CREAD;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = device.index;
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        ::close(fd);
+        device.reopen_at = now_s() + REOPEN_S;
+        return false;
+    }
+    device.fd = fd;
+    device.parser.reset();
+    return true;
+}
+
+void Collector::close(Device &device)
+{
+    if (device.fd >= 0)
+    {
+        epoll_ctl(epoll_, EPOLL_CTL_DEL, device.fd, nullptr);
+        ::close(device.fd);
+        device.fd = -1;
+        device.reopen_at = now_s() + REOPEN_S;
+    }
+}
+
+/**
+ * @brief One read from a ready port
+ */
+void Collector::read(Device &device)
+{
+    ssize_t n = ::read(device.fd, buffer_.data(), buffer_.size());
+    if (n < 0 && (errno == EAGAIN || errno == EINTR))
+    {
+        return;
+    }
+    if (n <= 0)
+    {
+        /* Unplugged or hung up: try again later */
+        close(device);
+        device.counters.reopens++;
+        return;
+    }
+
+    device.counters.bytes += (uint64_t)n;
+    device.parser.feed(buffer_.data(), (size_t)n, device.counters,
+                       [&device](uint8_t type, uint8_t, const uint8_t *payload, size_t len) {
+                           if (type == TYPE_SAMPLE && len == sizeof(log_record_t))
+                           {
+                               log_record_t record;
+                               std::memcpy(&record, payload, sizeof(record));
+                               device.counters.samples++;
+                               device.store.add(record, device.counters);
+                           }
+                       });
+}
+
+/**
+ * @brief Wait up to timeout_ms for input and serve every ready descriptor once
+ */
+void Collector::poll(int timeout_ms)
+{
+    /* Ports to open again */
+    double now = now_s();
+    for (auto &device : devices_)
+    {
+        if (device->fd < 0 && now >= device->reopen_at)
+        {
+            open(*device);
+        }
+    }
+
+    struct epoll_event events[64];
+    int n = epoll_wait(epoll_, events, 64, timeout_ms);
+    for (int i = 0; i < n; i++)
+    {
+        uint64_t id = events[i].data.u64;
+        if (id & WATCH_BIT)
+        {
+            watches_[id & ~WATCH_BIT]->ready();
+            continue;
+        }
+        Device &device = *devices_[id];
+        if (device.fd < 0)
+        {
+            continue;
+        }
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+        {
+            read(device);
+        }
+    }
+}
+
+/**
+ * @brief Write every sample still waiting in the stores
+ */
+void Collector::flush()
+{
+    for (auto &device : devices_)
+    {
+        device->store.flush(true);
+    }
+}
+
+/**
+ * @brief Table of rates since mark() and counters since start
+ *
+ * @param out       destination
+ * @param interval  seconds since mark()
+ */
+void Collector::report(FILE *out, double interval)
+{
+    std::fprintf(out, "%-16s %4s %10s %9s %9s %9s %8s %8s %8s %8s %7s\n", "device", "up", "B/s", "frames/s",
+                 "samples/s", "samples", "errors", "lost", "overflow", "reorder", "reopen");
+    for (auto &d : devices_)
+    {
+        const Counters &c = d->counters;
+        const Counters &p = d->previous;
+        std::fprintf(out, "%-16s %4s %10.0f %9.1f %9.1f %9llu %8llu %8llu %8llu %8llu %7llu\n", d->name.c_str(),
+                     d->fd >= 0 ? "yes" : "no", (double)(c.bytes - p.bytes) / interval,
+                     (double)(c.frames - p.frames) / interval, (double)(c.samples - p.samples) / interval,
+                     (unsigned long long)c.samples, (unsigned long long)c.errors, (unsigned long long)c.lost,
+                     (unsigned long long)c.overflows, (unsigned long long)c.reordered,
+                     (unsigned long long)c.reopens);
+    }
+    std::fflush(out);
+}
+
+/**
+ * @brief Same as report() as JSON, replaced atomically for other programs to poll
+ */
+bool Collector::write_stats(const std::string &path, double interval)
+{
+    std::string temp = path + ".tmp";
+    FILE *f = std::fopen(temp.c_str(), "w");
+    if (f == nullptr)
+    {
+        return false;
+    }
+    std::fprintf(f, "{\"time\": %lld, \"interval\": %.3f, \"devices\": [", (long long)std::time(nullptr),
+                 interval);
+    for (size_t i = 0; i < devices_.size(); i++)
+    {
+        const Device &d = *devices_[i];
+        const Counters &c = d.counters;
+        const Counters &p = d.previous;
+        std::fprintf(f,
+                     "%s\n  {\"name\": \"%s\", \"path\": \"%s\", \"up\": %s, \"bytes_per_s\": %.1f, "
+                     "\"frames_per_s\": %.1f, \"samples_per_s\": %.1f, \"bytes\": %llu, \"frames\": %llu, "
+                     "\"samples\": %llu, \"errors\": %llu, \"lost\": %llu, \"overflows\": %llu, "
+                     "\"reordered\": %llu, \"late\": %llu, \"reopens\": %llu}",
+                     i ? "," : "", d.name.c_str(), d.path.c_str(), d.fd >= 0 ? "true" : "false",
+                     (double)(c.bytes - p.bytes) / interval, (double)(c.frames - p.frames) / interval,
+                     (double)(c.samples - p.samples) / interval, (unsigned long long)c.bytes,
+                     (unsigned long long)c.frames, (unsigned long long)c.samples, (unsigned long long)c.errors,
+                     (unsigned long long)c.lost, (unsigned long long)c.overflows, (unsigned long long)c.reordered,
+                     (unsigned long long)c.late, (unsigned long long)c.reopens);
+    }
+    std::fputs("\n]}\n", f);
+    bool ok = std::fclose(f) == 0;
+    return ok && std::rename(temp.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * @brief Start a new rate interval
+ */
+void Collector::mark()
+{
+    for (auto &device : devices_)
+    {
+        device->previous = device->counters;
+    }
+}
+
+} // namespace collector
@@ -0,0 +1,186 @@
+/**
+ * @file collector.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Telemetry collector for many loggers: one epoll loop over every serial port
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Each port is read without blocking, its byte stream split into frames
+ * with the firmware's own frame_decode(), and its samples kept in time
+ * order in a store of their own. Counters per device give rates and the
+ * link errors seen so far.
+ */
+#ifndef _COLLECTOR_H_
+#define _COLLECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "logfmt/log_record.h"
+
+namespace collector
+{
+
+/**
+ * @struct Counters collector.h
+ * @brief Per device counters since start
+ */
+struct Counters
+{
+    uint64_t bytes = 0;     /*!< Bytes read */
+    uint64_t frames = 0;    /*!< Valid frames */
+    uint64_t errors = 0;    /*!< Delimited runs that were not a frame: CRC, COBS or console text */
+    uint64_t lost = 0;      /*!< Frames missing from sequence number gaps */
+    uint64_t overflows = 0; /*!< Runs longer than any frame, dropped */
+    uint64_t samples = 0;   /*!< TELEMETRY_SAMPLE records */
+    uint64_t reordered = 0; /*!< Samples older than the newest one, put in place */
+    uint64_t late = 0;      /*!< Samples older than the store already wrote, dropped */
+    uint64_t reopens = 0;   /*!< Port reopened after a hangup or error */
+};
+
+/**
+ * @class FrameParser collector.h
+ * @brief Splits a byte stream at 0x00 delimiters and decodes each run
+ */
+class FrameParser
+{
+public:
+    using Handler = std::function<void(uint8_t type, uint8_t seq, const uint8_t *payload, size_t len)>;
+
+    void feed(const uint8_t *data, size_t len, Counters &counters, const Handler &handler);
+
+    void reset();
+
+private:
+    void finish(Counters &counters, const Handler &handler);
+
+    std::vector<uint8_t> run_;
+    bool overflow_ = false;
+    int last_seq_ = -1;
+};
+
+/**
+ * @class SampleStore collector.h
+ * @brief Samples of one device in time order
+ *
+ * Samples wait in a window of window_us behind the newest one; a sample
+ * that arrives out of order within the window is put in place, anything
+ * older than what was written is counted late and dropped. Written
+ * samples go to a CSV file in logdecode's columns when one is open.
+ */
+class SampleStore
+{
+public:
+    explicit SampleStore(int64_t window_us) : window_us_(window_us) {}
+    ~SampleStore();
+
+    bool open(const std::string &path);
+
+    void add(const log_record_t &record, Counters &counters);
+
+    void flush(bool all);
+
+    uint64_t written() const { return written_; }
+    uint64_t disorder() const { return disorder_; }
+    uint64_t time_sum() const { return time_sum_; }
+    size_t pending() const { return pending_.size(); }
+
+private:
+    void write(const log_record_t &record);
+
+    int64_t window_us_;
+    std::deque<log_record_t> pending_;
+    FILE *file_ = nullptr;
+    bool any_ = false;
+    int64_t newest_ = 0;       /* newest time seen */
+    int64_t last_written_ = 0; /* newest time written */
+    uint64_t written_ = 0;
+    uint64_t disorder_ = 0;    /* writes that went back in time, 0 unless the store is broken */
+    uint64_t time_sum_ = 0;    /* sum of written times, for checks */
+};
+
+/**
+ * @struct Device collector.h
+ * @brief One logger on one serial port
+ */
+struct Device
+{
+    Device(const std::string &path, int baudrate, int64_t window_us);
+
+    std::string path;        /*!< Port path */
+    std::string name;        /*!< Port name without directories */
+    int baudrate;            /*!< Bit/s */
+    size_t index = 0;        /*!< Position in Collector::devices() */
+    int fd = -1;             /*!< Open port, -1 while closed */
+    double reopen_at = 0;    /*!< Next open attempt while closed, monotonic seconds */
+    FrameParser parser;      /*!< Stream state */
+    SampleStore store;       /*!< Samples in time order */
+    Counters counters;       /*!< Since start */
+    Counters previous;       /*!< At the previous report, for rates */
+};
+
+/**
+ * @class Collector collector.h
+ * @brief epoll loop over every device, plus any other descriptor to watch
+ *
+ * ### Example
+ * ~~~.cpp
+ * collector::Collector c;
+ * c.add("/dev/ttyUSB0", 921600, "logs");
+ * c.add("/dev/ttyUSB1", 921600, "logs");
+ * while (running)
+ * {
+ *      c.poll(1000);
+ * }
+ * c.flush();
+ * ~~~
+ */
+class Collector
+{
+public:
+    explicit Collector(int64_t window_us = 2000000);
+    ~Collector();
+
+    bool add(const std::string &path, int baudrate, const std::string &out_dir);
+
+    bool watch(int fd, std::function<void()> ready);
+
+    void poll(int timeout_ms);
+
+    void flush();
+
+    void report(FILE *out, double interval);
+
+    bool write_stats(const std::string &path, double interval);
+
+    void mark();
+
+    const std::vector<std::unique_ptr<Device>> &devices() const { return devices_; }
+
+private:
+    struct Watch;
+
+    bool open(Device &device);
+    void close(Device &device);
+    void read(Device &device);
+
+    int epoll_ = -1;
+    int64_t window_us_;
+    std::vector<std::unique_ptr<Device>> devices_;
+    std::vector<std::unique_ptr<Watch>> watches_;
+    std::vector<uint8_t> buffer_;
+};
+
+double now_s();
+
+} // namespace collector
+
+#endif
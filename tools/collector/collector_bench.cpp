@@ -0,0 +1,346 @@
+/**
+ * @file collector_bench.cpp
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Collector against many pseudo-terminal loggers at full baud
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * One writer thread plays every device: it writes device-format frames to
+ * the master side of a pty per device, paced to baudrate / 10 bytes per
+ * second each, while the collector reads the slave sides in its epoll loop.
+ * The stream carries what a real link does: samples with a pair swapped
+ * every 50, a battery frame after every 49 sample pairs, and one battery
+ * frame in 10 corrupted. The collector must account for every byte and
+ * frame, write every sample back in time order and keep up with the
+ * offered load.
+ *
+ * ### Example
+ * ~~~
+ * collector_bench               # 64 devices, 5 s, 921600 baud
+ * collector_bench 128 10 2000000
+ * ~~~
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "collector.h"
+#include "telemetry/frame.h"
+
+namespace
+{
+
+constexpr double TICK_S = 0.002;        /* writer pacing period */
+constexpr double DRAIN_S = 2.0;         /* longest wait for the collector after the writers stop */
+constexpr int64_t START_US = 1666811220000000;
+constexpr int64_t PERIOD_US = 1000;     /* sample spacing on each device */
+constexpr uint8_t TYPE_SAMPLE = 1;
+constexpr uint8_t TYPE_BATTERY = 2;
+
+/**
+ * @struct Source
+ * @brief Frame generator and pacing state of one emulated device
+ */
+struct Source
+{
+    int master = -1;
+    int slave = -1;
+    uint8_t seq = 0;
+    uint64_t slot = 0;           /* calls to generate() */
+    uint64_t sample = 0;         /* next sample index */
+    std::vector<uint8_t> pending;
+    size_t offset = 0;           /* written part of pending */
+
+    /* Expected results */
+    uint64_t bytes = 0;
+    uint64_t frames = 0;
+    uint64_t samples = 0;
+    uint64_t swaps = 0;
+    uint64_t corrupted = 0;
+    uint64_t time_sum = 0;
+    bool tail_corrupt = false;   /* last frame corrupted: its loss is never seen */
+    uint64_t stalls = 0;         /* writes refused by a full pty */
+};
+
+void append_frame(Source &s, uint8_t type, const void *payload, size_t len, bool corrupt)
+{
+    uint8_t frame[FRAME_MAX_ENCODED];
+    size_t n = frame_encode(type, s.seq++, payload, len, frame);
+    if (corrupt)
+    {
+        /* One body byte, kept non-zero so the frame still has one run */
+        uint8_t &b = frame[n / 2];
+        b = (b ^ 0x01) != 0 ? (uint8_t)(b ^ 0x01) : (uint8_t)(b ^ 0x02);
+        s.corrupted++;
+    }
+    else
+    {
+        s.frames++;
+    }
+    s.tail_corrupt = corrupt;
+    s.pending.insert(s.pending.end(), frame, frame + n);
+}
+
+log_record_t make_sample(uint64_t index)
+{
+    log_record_t r = {};
+    r.time_us = START_US + (int64_t)index * PERIOD_US;
+    r.battery_mv = 3900;
+    r.temperature = 2150 + (int32_t)(index % 100);
+    r.pressure = 101325 + (uint32_t)(index % 50);
+    return r;
+}
+
+/**
+ * @brief Queue the next frames of a device: a sample pair or a battery frame
+ */
+void generate(Source &s)
+{
+    uint64_t slot = s.slot++;
+    if (slot % 50 == 49)
+    {
+        uint8_t battery[5] = {0x10, 0x0F, 0x3C, 0x0F, 87};
+        append_frame(s, TYPE_BATTERY, battery, sizeof(battery), slot % 500 == 499);
+        return;
+    }
+    log_record_t a = make_sample(s.sample);
+    log_record_t b = make_sample(s.sample + 1);
+    bool swap = (s.sample / 2) % 25 == 24;
+    append_frame(s, TYPE_SAMPLE, swap ? &b : &a, sizeof(a), false);
+    append_frame(s, TYPE_SAMPLE, swap ? &a : &b, sizeof(a), false);
+    s.samples += 2;
+    s.swaps += swap;
+    s.time_sum += (uint64_t)a.time_us + (uint64_t)b.time_us;
+    s.sample += 2;
+}
+
+/**
+ * @brief Write every device up to its paced byte count until the deadline
+ */
+void writer(std::vector<Source> &sources, double rate, double seconds, std::atomic<bool> &done)
+{
+    double start = collector::now_s();
+    for (;;)
+    {
+        double elapsed = collector::now_s() - start;
+        bool last = elapsed >= seconds;
+        uint64_t target = (uint64_t)(rate * std::min(elapsed, seconds));
+        for (Source &s : sources)
+        {
+            while (s.bytes < target)
+            {
+                if (s.offset == s.pending.size())
+                {
+                    s.pending.clear();
+                    s.offset = 0;
+                    generate(s);
+                }
+                size_t n = std::min(s.pending.size() - s.offset, (size_t)(target - s.bytes));
+                ssize_t w = ::write(s.master, s.pending.data() + s.offset, n);
+                if (w <= 0)
+                {
+                    s.stalls++;
+                    break;
+                }
+                s.offset += (size_t)w;
+                s.bytes += (uint64_t)w;
+            }
+        }
+        if (last)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(TICK_S));
+    }
+
+    /* Finish the frames in flight so every counter is exact */
+    for (Source &s : sources)
+    {
+        while (s.offset < s.pending.size())
+        {
+            ssize_t w = ::write(s.master, s.pending.data() + s.offset, s.pending.size() - s.offset);
+            if (w > 0)
+            {
+                s.offset += (size_t)w;
+                s.bytes += (uint64_t)w;
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+    }
+    done = true;
+}
+
+double thread_cpu_s()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    long devices = 64, baudrate = 921600;
+    double seconds = 5.0;
+    char *end = nullptr;
+    bool valid = argc <= 4;
+    if (valid && argc > 1)
+    {
+        devices = std::strtol(argv[1], &end, 10);
+        valid = *end == '\0' && devices > 0 && devices <= INT_MAX;
+    }
+    if (valid && argc > 2)
+    {
+        seconds = std::strtod(argv[2], &end);
+        valid = *end == '\0' && seconds > 0.0;
+    }
+    if (valid && argc > 3)
+    {
+        baudrate = std::strtol(argv[3], &end, 10);
+        valid = *end == '\0' && baudrate > 0 && baudrate <= INT_MAX;
+    }
+    if (!valid)
+    {
+        std::fprintf(stderr, "usage: %s [devices > 0] [seconds > 0] [baudrate > 0]\n", argv[0]);
+        return 2;
+    }
+    double rate = baudrate / 10.0; /* 8N1 */
+
+    std::vector<Source> sources((size_t)devices);
+    collector::Collector collector;
+    for (Source &s : sources)
+    {
+        char path[64];
+        if (openpty(&s.master, &s.slave, path, nullptr, nullptr) != 0)
+        {
+            std::perror("openpty");
+            return 1;
+        }
+        struct termios tio;
+        tcgetattr(s.slave, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(s.slave, TCSANOW, &tio);
+        fcntl(s.master, F_SETFL, fcntl(s.master, F_GETFL) | O_NONBLOCK);
+        if (!collector.add(path, baudrate, ""))
+        {
+            return 1;
+        }
+    }
+
+    std::printf("%ld devices, %.1f s at %ld baud, offered %.2f MB/s\n", devices, seconds, baudrate,
+                rate * devices * 1e-6);
+
+    std::atomic<bool> done(false);
+    double cpu0 = thread_cpu_s();
+    double start = collector::now_s();
+    std::thread thread(writer, std::ref(sources), rate, seconds, std::ref(done));
+
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    double drain_until = 0;
+    for (;;)
+    {
+        collector.poll(10);
+        if (!done)
+        {
+            continue;
+        }
+        if (drain_until == 0)
+        {
+            drain_until = collector::now_s() + DRAIN_S;
+            for (const Source &s : sources)
+            {
+                sent += s.bytes;
+            }
+        }
+        received = 0;
+        for (const auto &d : collector.devices())
+        {
+            received += d->counters.bytes;
+        }
+        if (received >= sent || collector::now_s() > drain_until)
+        {
+            break;
+        }
+    }
+    double elapsed = collector::now_s() - start;
+    double cpu = thread_cpu_s() - cpu0;
+    thread.join();
+    collector.flush();
+
+    /* Compare every device against what was sent */
+    bool ok = received == sent;
+    uint64_t frames = 0;
+    uint64_t samples = 0;
+    uint64_t errors = 0;
+    uint64_t reordered = 0;
+    uint64_t stalls = 0;
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        const Source &s = sources[i];
+        const collector::Device &d = *collector.devices()[i];
+        const collector::Counters &c = d.counters;
+        bool match = c.bytes == s.bytes && c.frames == s.frames && c.samples == s.samples &&
+                     c.errors == s.corrupted && c.lost + s.tail_corrupt == s.corrupted && c.overflows == 0 &&
+                     c.reordered == s.swaps && c.late == 0 && c.reopens == 0 && d.store.written() == s.samples &&
+                     d.store.disorder() == 0 && d.store.time_sum() == s.time_sum;
+        if (!match)
+        {
+            std::printf("%s: bytes %llu/%llu frames %llu/%llu samples %llu/%llu errors %llu/%llu lost %llu "
+                        "reordered %llu/%llu late %llu written %llu disorder %llu\n",
+                        d.name.c_str(), (unsigned long long)c.bytes, (unsigned long long)s.bytes,
+                        (unsigned long long)c.frames, (unsigned long long)s.frames, (unsigned long long)c.samples,
+                        (unsigned long long)s.samples, (unsigned long long)c.errors,
+                        (unsigned long long)s.corrupted, (unsigned long long)c.lost,
+                        (unsigned long long)c.reordered, (unsigned long long)s.swaps, (unsigned long long)c.late,
+                        (unsigned long long)d.store.written(), (unsigned long long)d.store.disorder());
+            ok = false;
+        }
+        frames += c.frames;
+        samples += c.samples;
+        errors += c.errors;
+        reordered += c.reordered;
+        stalls += s.stalls;
+    }
+
+    double offered = rate * devices * seconds;
+    double achieved = (double)sent / offered;
+    ok = ok && achieved >= 0.95;
+
+    std::printf("sent       : %llu bytes, %.2f MB/s (%.1f%% of offered), %llu writer stalls\n",
+                (unsigned long long)sent, (double)sent / seconds * 1e-6, achieved * 100.0,
+                (unsigned long long)stalls);
+    std::printf("collected  : %llu bytes in %.2f s, %llu frames, %llu samples\n", (unsigned long long)received,
+                elapsed, (unsigned long long)frames, (unsigned long long)samples);
+    std::printf("link errors: %llu corrupt frames, %llu samples put back in order\n", (unsigned long long)errors,
+                (unsigned long long)reordered);
+    std::printf("collector  : %.2f s CPU, %.1f%% of one core, %.0f ns/byte\n", cpu, cpu / elapsed * 100.0,
+                cpu / (double)received * 1e9);
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+
+    for (Source &s : sources)
+    {
+        close(s.master);
+        close(s.slave);
+    }
+    return ok ? 0 : 1;
+}
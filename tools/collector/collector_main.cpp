@@ -0,0 +1,164 @@
+/**
+ * @file collector_main.cpp
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Collector daemon: telemetry from many loggers into one CSV per device
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Runs until SIGINT or SIGTERM. Signals and the report timer are read from
+ * descriptors in the same epoll loop as the ports, so no handler ever runs
+ * between a read and its decode. Samples still waiting in the stores are
+ * written on exit.
+ *
+ * ### Example
+ * ~~~
+ * collector -o logs /dev/ttyUSB0 /dev/ttyUSB1 /dev/ttyUSB2
+ * collector -b 2000000 -s /tmp/collector.json -i 5 /dev/ttyACM0 /dev/ttyACM1
+ * ~~~
+ */
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "collector.h"
+
+namespace
+{
+
+void usage()
+{
+    std::fputs("usage: collector [-b baudrate] [-o dir] [-s stats.json] [-i seconds] [-q] port...\n"
+               "  -b  port baudrate, default 921600\n"
+               "  -o  write samples to dir/<port>.csv\n"
+               "  -s  rewrite a JSON stats file every interval\n"
+               "  -i  report interval in seconds, default 10\n"
+               "  -q  no report table on stdout\n",
+               stderr);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int baudrate = 921600;
+    std::string out_dir;
+    std::string stats_path;
+    int interval = 10;
+    bool quiet = false;
+    std::vector<std::string> ports;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-b" && has_value)
+        {
+            baudrate = std::atoi(argv[++i]);
+        }
+        else if (arg == "-o" && has_value)
+        {
+            out_dir = argv[++i];
+        }
+        else if (arg == "-s" && has_value)
+        {
+            stats_path = argv[++i];
+        }
+        else if (arg == "-i" && has_value)
+        {
+            interval = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "-q")
+        {
+            quiet = true;
+        }
+        else if (arg[0] == '-')
+        {
+            usage();
+            return 2;
+        }
+        else
+        {
+            ports.push_back(arg);
+        }
+    }
+    if (ports.empty())
+    {
+        usage();
+        return 2;
+    }
+
+    collector::Collector collector;
+    for (const std::string &port : ports)
+    {
+        if (!collector.add(port, baudrate, out_dir))
+        {
+            return 1;
+        }
+    }
+
+    /* Signals as a descriptor, blocked so they are only seen there */
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signals, nullptr);
+    int signal_fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    bool running = true;
+    collector.watch(signal_fd, [&]() {
+        struct signalfd_siginfo info;
+        while (read(signal_fd, &info, sizeof(info)) == (ssize_t)sizeof(info))
+        {
+            running = false;
+        }
+    });
+
+    /* Periodic report */
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    struct itimerspec period = {{interval, 0}, {interval, 0}};
+    timerfd_settime(timer_fd, 0, &period, nullptr);
+
+    double marked = collector::now_s();
+    collector.watch(timer_fd, [&]() {
+        uint64_t expirations;
+        if (read(timer_fd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations))
+        {
+            return;
+        }
+        double now = collector::now_s();
+        if (!quiet)
+        {
+            collector.report(stdout, now - marked);
+        }
+        if (!stats_path.empty() && !collector.write_stats(stats_path, now - marked))
+        {
+            std::perror(stats_path.c_str());
+        }
+        collector.mark();
+        marked = now;
+    });
+
+    while (running)
+    {
+        collector.poll(1000);
+    }
+
+    collector.flush();
+    if (!quiet)
+    {
+        collector.report(stdout, collector::now_s() - marked);
+    }
+    close(timer_fd);
+    close(signal_fd);
+    return 0;
+}
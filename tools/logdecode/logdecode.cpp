@@ -0,0 +1,649 @@
+/**
+ * @file logdecode.cpp
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Parallel decoder for log files copied off the SD card
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Files are memory mapped and split at LOG_BLOCK_SIZE boundaries. Blocks are
+ * CRC checked and decoded by one worker per core; output is written in file
+ * order as CSV or as one flat little endian array per channel. Row and
+ * columnar blocks may be mixed in a file.
+ *
+ * ### Build
+ * ~~~
+ * cmake -S tools -B tools/build && cmake --build tools/build
+ * ~~~
+ *
+ * ### Example
+ * ~~~
+ * logdecode decode -o samples.csv LOG00001.BIN LOG00002.BIN
+ * logdecode decode -f columnar -o samples/ LOG00001.BIN
+ * logdecode generate -s 4096 synthetic.bin
+ * logdecode generate -c -s 4096 columnar.bin
+ * logdecode bench synthetic.bin
+ * ~~~
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "epoch/epoch.h"
+#include "fmt/fmt.h"
+#include "logfmt/log_block.h"
+#include "logfmt/log_columns.h"
+
+namespace
+{
+
+constexpr size_t CHUNK_BLOCKS = 16384; /* 8 MiB of blocks per worker and round */
+
+/**
+ * @brief Read only memory mapping of a whole file
+ */
+struct MappedFile
+{
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+    bool open(const char *path)
+    {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            std::perror(path);
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            std::perror(path);
+            ::close(fd);
+            return false;
+        }
+        size = (size_t)st.st_size;
+        if (size > 0)
+        {
+            void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                std::perror(path);
+                ::close(fd);
+                return false;
+            }
+            madvise(p, size, MADV_SEQUENTIAL | MADV_WILLNEED);
+            data = (const uint8_t *)p;
+        }
+        ::close(fd);
+        return true;
+    }
+
+    ~MappedFile()
+    {
+        if (data != nullptr)
+        {
+            munmap((void *)data, size);
+        }
+    }
+
+    size_t blocks() const { return size / LOG_BLOCK_SIZE; }
+};
+
+/**
+ * @brief Block and record counters
+ */
+struct Stats
+{
+    uint64_t blocks = 0;  /* valid blocks */
+    uint64_t empty = 0;   /* erased or zero filled blocks */
+    uint64_t corrupt = 0; /* bad magic or CRC */
+    uint64_t records = 0; /* decoded records */
+    uint64_t rates = 0;   /* sampling period changes, LOG_RECORD_RATE */
+
+    void add(const Stats &other)
+    {
+        blocks += other.blocks;
+        empty += other.empty;
+        corrupt += other.corrupt;
+        records += other.records;
+        rates += other.rates;
+    }
+};
+
+enum class Format
+{
+    None,
+    Csv,
+    Columnar,
+};
+
+/**
+ * @brief Decoded output of one worker for one chunk
+ */
+struct Output
+{
+    std::string csv;
+    std::vector<int64_t> time_us;
+    std::vector<uint8_t> type;
+    std::vector<int32_t> temperature;
+    std::vector<uint32_t> pressure;
+    std::vector<uint16_t> battery_mv;
+    uint64_t checksum = 0; /* keeps decode honest when output is discarded */
+
+    void clear()
+    {
+        csv.clear();
+        time_us.clear();
+        type.clear();
+        temperature.clear();
+        pressure.clear();
+        battery_mv.clear();
+    }
+};
+
+/**
+ * @brief Check if a block was never written (erased 0xFF or zero filled)
+ */
+bool block_blank(const uint8_t *p)
+{
+    uint8_t first = p[0];
+    if (first != 0x00 && first != 0xFF)
+    {
+        return false;
+    }
+    for (size_t i = 1; i < LOG_BLOCK_HEADER_SIZE; i++)
+    {
+        if (p[i] != first)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Append a record as one CSV line
+ */
+void append_csv(std::string &out, const log_record_t &r)
+{
+    char line[4 * FMT_INT_MAX + EPOCH_TEXT_MAX];
+    char *p = line;
+
+    p += fmt_int(p, r.time_us, 0, ' ');
+    *p++ = ',';
+    p += epoch_format(p, r.time_us, 3);
+    *p++ = ',';
+    /* temperature is in 0.01 degrees */
+    p += fmt_fixed(p, r.temperature, 2, 0, ' ');
+    *p++ = ',';
+    p += fmt_uint(p, r.pressure, 0, ' ');
+    *p++ = ',';
+    p += fmt_uint(p, r.battery_mv, 0, ' ');
+    *p++ = '\n';
+    out.append(line, (size_t)(p - line));
+}
+
+/**
+ * @brief Decode blocks [first, last) of a mapped file
+ */
+void decode_range(const uint8_t *base, size_t first, size_t last, Format format, Output &out, Stats &stats)
+{
+    for (size_t b = first; b < last; b++)
+    {
+        const uint8_t *p = base + b * LOG_BLOCK_SIZE;
+        const log_block_t *block = (const log_block_t *)p;
+
+        if (block_blank(p))
+        {
+            stats.empty++;
+            continue;
+        }
+        log_record_t records[LOG_COLUMNS_ROWS];
+        int count = log_block_verify(block) ? log_columns_decode(block, records) : -1;
+        if (count < 0)
+        {
+            stats.corrupt++;
+            continue;
+        }
+        stats.blocks++;
+        stats.records += (size_t)count;
+
+        for (int i = 0; i < count; i++)
+        {
+            const log_record_t &r = records[i];
+            stats.rates += r.type == LOG_RECORD_RATE;
+            switch (format)
+            {
+            case Format::Csv:
+                /* Samples only, their time_us carries the sampling period */
+                if (r.type == LOG_RECORD_SAMPLE)
+                {
+                    append_csv(out.csv, r);
+                }
+                break;
+            case Format::Columnar:
+                out.time_us.push_back(r.time_us);
+                out.type.push_back(r.type);
+                out.temperature.push_back(r.temperature);
+                out.pressure.push_back(r.pressure);
+                out.battery_mv.push_back(r.battery_mv);
+                break;
+            case Format::None:
+                out.checksum += (uint64_t)r.time_us + r.pressure + (uint32_t)r.temperature;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Destination of the decoded data, written in file order
+ */
+class Writer
+{
+public:
+    bool open(Format format, const std::string &path)
+    {
+        format_ = format;
+        if (format == Format::Csv)
+        {
+            csv_ = path == "-" ? stdout : std::fopen(path.c_str(), "w");
+            if (csv_ == nullptr)
+            {
+                std::perror(path.c_str());
+                return false;
+            }
+            std::fputs("time_us,time_utc,temperature_c,pressure_pa,battery_mv\n", csv_);
+        }
+        else if (format == Format::Columnar)
+        {
+            dir_ = path;
+            mkdir(path.c_str(), 0755);
+            static const char *names[] = {"time_us.i64", "type.u8", "temperature_cc.i32",
+                                          "pressure_pa.u32", "battery_mv.u16"};
+            for (int i = 0; i < 5; i++)
+            {
+                std::string file = dir_ + "/" + names[i];
+                columns_[i] = std::fopen(file.c_str(), "wb");
+                if (columns_[i] == nullptr)
+                {
+                    std::perror(file.c_str());
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void write(const Output &out)
+    {
+        if (format_ == Format::Csv)
+        {
+            std::fwrite(out.csv.data(), 1, out.csv.size(), csv_);
+        }
+        else if (format_ == Format::Columnar)
+        {
+            put(columns_[0], out.time_us);
+            put(columns_[1], out.type);
+            put(columns_[2], out.temperature);
+            put(columns_[3], out.pressure);
+            put(columns_[4], out.battery_mv);
+            rows_ += out.time_us.size();
+        }
+    }
+
+    void close()
+    {
+        if (csv_ != nullptr && csv_ != stdout)
+        {
+            std::fclose(csv_);
+        }
+        csv_ = nullptr;
+        if (format_ == Format::Columnar)
+        {
+            for (FILE *&f : columns_)
+            {
+                if (f != nullptr)
+                {
+                    std::fclose(f);
+                    f = nullptr;
+                }
+            }
+            /* Column manifest: one line per array */
+            std::string file = dir_ + "/columns.txt";
+            FILE *m = std::fopen(file.c_str(), "w");
+            if (m != nullptr)
+            {
+                std::fprintf(m, "rows %llu\n", (unsigned long long)rows_);
+                std::fputs("time_us.i64 epoch microseconds\n"
+                           "type.u8 log_record_type_t\n"
+                           "temperature_cc.i32 0.01 degrees Celsius\n"
+                           "pressure_pa.u32 Pa\n"
+                           "battery_mv.u16 mV\n",
+                           m);
+                std::fclose(m);
+            }
+        }
+    }
+
+private:
+    template <typename T>
+    static void put(FILE *f, const std::vector<T> &v)
+    {
+        std::fwrite(v.data(), sizeof(T), v.size(), f);
+    }
+
+    Format format_ = Format::None;
+    FILE *csv_ = nullptr;
+    FILE *columns_[5] = {};
+    std::string dir_;
+    uint64_t rows_ = 0;
+};
+
+/**
+ * @brief Decode one mapped file with @p threads workers
+ *
+ * Work proceeds in rounds: every worker decodes one chunk, then the chunks
+ * are written in order. Memory stays bounded by threads * CHUNK_BLOCKS.
+ */
+Stats decode_file(const MappedFile &file, unsigned threads, Format format, Writer *writer,
+                  uint64_t *checksum)
+{
+    const size_t blocks = file.blocks();
+    std::vector<Output> outputs(threads);
+    std::vector<Stats> stats(threads);
+
+    for (size_t round = 0; round < blocks; round += (size_t)threads * CHUNK_BLOCKS)
+    {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++)
+        {
+            size_t first = std::min(blocks, round + t * CHUNK_BLOCKS);
+            size_t last = std::min(blocks, first + CHUNK_BLOCKS);
+            outputs[t].clear();
+            if (first == last)
+            {
+                continue;
+            }
+            workers.emplace_back(decode_range, file.data, first, last, format, std::ref(outputs[t]),
+                                 std::ref(stats[t]));
+        }
+        for (std::thread &w : workers)
+        {
+            w.join();
+        }
+        if (writer != nullptr)
+        {
+            for (const Output &out : outputs)
+            {
+                writer->write(out);
+            }
+        }
+    }
+
+    Stats total;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        total.add(stats[t]);
+        if (checksum != nullptr)
+        {
+            *checksum += outputs[t].checksum;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Write a synthetic log: 1 Hz samples, slowly drifting values
+ */
+int generate(const char *path, size_t size_mb, bool columnar)
+{
+    FILE *f = std::fopen(path, "wb");
+    if (f == nullptr)
+    {
+        std::perror(path);
+        return 1;
+    }
+
+    const size_t blocks = size_mb * 1024 * 1024 / LOG_BLOCK_SIZE;
+    std::vector<log_block_t> batch(2048);
+    int64_t time_us = 1666811220000000LL;
+    uint32_t seq = 0;
+    uint32_t noise = 1;
+    size_t records = 0;
+    log_columns_t cols;
+
+    for (size_t done = 0; done < blocks;)
+    {
+        size_t n = std::min(batch.size(), blocks - done);
+        for (size_t i = 0; i < n; i++)
+        {
+            log_block_t *block = &batch[i];
+            if (columnar)
+            {
+                log_columns_init(&cols, block, seq++);
+            }
+            else
+            {
+                log_block_init(block, seq++);
+            }
+            while (columnar ? !log_columns_full(&cols) : !log_block_full(block))
+            {
+                noise = noise * 1103515245u + 12345u;
+                log_record_t *r = columnar ? log_columns_reserve(&cols) : log_block_reserve(block);
+                r->time_us = time_us;
+                r->type = LOG_RECORD_SAMPLE;
+                r->battery_mv = (uint16_t)(4200 - (time_us / 1000000 / 3600) % 900);
+                r->temperature = 2150 + (int32_t)((noise >> 16) % 200) - 100;
+                r->pressure = 101325 + ((noise >> 8) % 400) - 200;
+                if (columnar)
+                {
+                    log_columns_commit(&cols);
+                }
+                else
+                {
+                    log_block_commit(block);
+                }
+                time_us += 1000000;
+            }
+            records += block->header.count;
+            if (columnar)
+            {
+                log_columns_seal(&cols);
+            }
+            else
+            {
+                log_block_seal(block);
+            }
+        }
+        std::fwrite(batch.data(), LOG_BLOCK_SIZE, n, f);
+        done += n;
+    }
+    std::fclose(f);
+    std::printf("%s: %zu blocks, %zu records\n", path, blocks, records);
+    return 0;
+}
+
+/**
+ * @brief Time the decoder on one file for 1..N workers
+ */
+int bench(const char *path, Format format)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        return 1;
+    }
+
+    /* Fault the whole mapping in first so every run measures decoding */
+    uint64_t warm = 0;
+    decode_file(file, std::max(1u, std::thread::hardware_concurrency()), Format::None, nullptr, &warm);
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned n = 1; n < cores; n *= 2)
+    {
+        counts.push_back(n);
+    }
+    counts.push_back(cores);
+
+    std::printf("%-8s %10s %10s %8s %10s\n", "threads", "seconds", "MiB/s", "speedup", "efficiency");
+    double base = 0.0;
+    for (unsigned n : counts)
+    {
+        uint64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        Stats stats = decode_file(file, n, format, nullptr, &checksum);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (base == 0.0)
+        {
+            base = seconds;
+        }
+        double speedup = base / seconds;
+        std::printf("%-8u %10.3f %10.1f %8.2f %9.0f%%\n", n, seconds,
+                    (double)file.size / (1024.0 * 1024.0) / seconds, speedup, 100.0 * speedup / n);
+        if (stats.corrupt != 0)
+        {
+            std::fprintf(stderr, "%llu corrupt blocks\n", (unsigned long long)stats.corrupt);
+        }
+    }
+    return 0;
+}
+
+void usage()
+{
+    std::fputs("usage:\n"
+               "  logdecode decode [-j threads] [-f csv|columnar] -o output file...\n"
+               "  logdecode generate [-c] [-s size_mb] file\n"
+               "  logdecode bench [-f none|csv|columnar] file\n",
+               stderr);
+}
+
+bool parse_format(const char *name, Format *format)
+{
+    if (std::strcmp(name, "csv") == 0)
+    {
+        *format = Format::Csv;
+    }
+    else if (std::strcmp(name, "columnar") == 0)
+    {
+        *format = Format::Columnar;
+    }
+    else if (std::strcmp(name, "none") == 0)
+    {
+        *format = Format::None;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        usage();
+        return 2;
+    }
+
+    std::string command = argv[1];
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    Format format = command == "bench" ? Format::None : Format::Csv;
+    std::string output;
+    size_t size_mb = 1024;
+    bool columnar = false;
+    std::vector<const char *> files;
+
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-j" && has_value)
+        {
+            threads = (unsigned)std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "-f" && has_value)
+        {
+            if (!parse_format(argv[++i], &format))
+            {
+                usage();
+                return 2;
+            }
+        }
+        else if (arg == "-o" && has_value)
+        {
+            output = argv[++i];
+        }
+        else if (arg == "-c")
+        {
+            columnar = true;
+        }
+        else if (arg == "-s" && has_value)
+        {
+            size_mb = (size_t)std::strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (command == "generate" && files.size() == 1)
+    {
+        return generate(files[0], size_mb, columnar);
+    }
+    if (command == "bench" && files.size() == 1)
+    {
+        return bench(files[0], format);
+    }
+    if (command != "decode" || files.empty() || output.empty() || format == Format::None)
+    {
+        usage();
+        return 2;
+    }
+
+    Writer writer;
+    if (!writer.open(format, output))
+    {
+        return 1;
+    }
+
+    Stats total;
+    for (const char *path : files)
+    {
+        MappedFile file;
+        if (!file.open(path))
+        {
+            return 1;
+        }
+        if (file.size % LOG_BLOCK_SIZE != 0)
+        {
+            std::fprintf(stderr, "%s: ignoring %zu trailing bytes\n", path, file.size % LOG_BLOCK_SIZE);
+        }
+        total.add(decode_file(file, threads, format, &writer, nullptr));
+    }
+    writer.close();
+
+    std::fprintf(stderr, "blocks %llu, records %llu, rate changes %llu, empty %llu, corrupt %llu\n",
+                 (unsigned long long)total.blocks, (unsigned long long)total.records,
+                 (unsigned long long)total.rates, (unsigned long long)total.empty,
+                 (unsigned long long)total.corrupt);
+    return total.corrupt == 0 ? 0 : 3;
+}
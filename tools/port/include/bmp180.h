@@ -0,0 +1,37 @@
+/**
+ * @file bmp180.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the esp-idf-lib bmp180.h
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PORT_BMP180_H_
+#define _PORT_BMP180_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "i2cdev.h"
+
+typedef enum
+{
+    BMP180_MODE_ULTRA_LOW_POWER = 0,
+    BMP180_MODE_STANDARD,
+    BMP180_MODE_HIGH_RESOLUTION,
+    BMP180_MODE_ULTRA_HIGH_RESOLUTION,
+} bmp180_mode_t;
+
+typedef struct
+{
+    i2c_dev_t i2c_dev; /*!< I2C device */
+} bmp180_dev_t;
+
+esp_err_t bmp180_init_desc(bmp180_dev_t *dev, i2c_port_t port, gpio_num_t sda_gpio, gpio_num_t scl_gpio);
+
+esp_err_t bmp180_init(bmp180_dev_t *dev);
+
+esp_err_t bmp180_measure(bmp180_dev_t *dev, float *temperature, uint32_t *pressure, bmp180_mode_t oss);
+
+#endif
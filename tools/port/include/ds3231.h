@@ -0,0 +1,31 @@
+/**
+ * @file ds3231.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the esp-idf-lib ds3231.h
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PORT_DS3231_H_
+#define _PORT_DS3231_H_
+
+#include <stdbool.h>
+#include <time.h>
+#include "esp_err.h"
+#include "i2cdev.h"
+
+esp_err_t ds3231_init_desc(i2c_dev_t *dev, i2c_port_t port, gpio_num_t sda_gpio, gpio_num_t scl_gpio);
+
+esp_err_t ds3231_get_oscillator_stop_flag(i2c_dev_t *dev, bool *flag);
+
+esp_err_t ds3231_clear_oscillator_stop_flag(i2c_dev_t *dev);
+
+esp_err_t ds3231_set_time(i2c_dev_t *dev, struct tm *time);
+
+esp_err_t ds3231_get_time(i2c_dev_t *dev, struct tm *time);
+
+esp_err_t ds3231_get_temp_float(i2c_dev_t *dev, float *temp);
+
+#endif
@@ -0,0 +1,16 @@
+/**
+ * @file esp_attr.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the ESP-IDF placement attributes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PORT_ESP_ATTR_H_
+#define _PORT_ESP_ATTR_H_
+
+#define DMA_ATTR /* any RAM is DMA capable on the host */
+
+#endif
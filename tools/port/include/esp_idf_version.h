@@ -0,0 +1,17 @@
+/**
+ * @file esp_idf_version.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for ESP-IDF esp_idf_version.h, reports v5.1
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PORT_ESP_IDF_VERSION_H_
+#define _PORT_ESP_IDF_VERSION_H_
+
+#define ESP_IDF_VERSION_VAL(major, minor, patch) (((major) << 16) | ((minor) << 8) | (patch))
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(5, 1, 0)
+
+#endif
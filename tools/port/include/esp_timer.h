@@ -0,0 +1,26 @@
+/**
+ * @file esp_timer.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the esp_timer clock
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PORT_ESP_TIMER_H_
+#define _PORT_ESP_TIMER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
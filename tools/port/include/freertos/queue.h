@@ -0,0 +1,40 @@
+/**
+ * @file queue.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the FreeRTOS queue calls used by the logger
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A real ring of fixed size items. Nothing else runs on the host, so a call
+ * that would block on the device returns at once.
+ */
+#ifndef _PORT_FREERTOS_QUEUE_H_
+#define _PORT_FREERTOS_QUEUE_H_
+
+#include "FreeRTOS.h"
+
+typedef struct
+{
+    uint8_t *storage;    /* length items of size bytes */
+    UBaseType_t length;  /* Items the queue holds */
+    UBaseType_t size;    /* Item size in bytes */
+    UBaseType_t head;    /* Oldest item */
+    UBaseType_t waiting; /* Items queued */
+} StaticQueue_t;
+
+typedef StaticQueue_t *QueueHandle_t;
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t *pucQueueStorage,
+                                 StaticQueue_t *pxQueueBuffer);
+
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait);
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+
+#endif
@@ -0,0 +1,33 @@
+/**
+ * @file semphr.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the FreeRTOS binary semaphore used by the logger and the sample path
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Take returns at once whether or not the semaphore was given, the caller
+ * then goes on as after a timeout.
+ */
+#ifndef _PORT_FREERTOS_SEMPHR_H_
+#define _PORT_FREERTOS_SEMPHR_H_
+
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+
+typedef struct
+{
+    bool given; /* Given and not taken since */
+} StaticSemaphore_t;
+
+typedef StaticSemaphore_t *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer);
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime);
+
+#endif
@@ -0,0 +1,22 @@
+/**
+ * @file task.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the FreeRTOS task calls used by the drivers and the sample path
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PORT_FREERTOS_TASK_H_
+#define _PORT_FREERTOS_TASK_H_
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+void vTaskDelay(const TickType_t xTicksToDelay);
+
+TickType_t xTaskGetTickCount(void);
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file i2cdev.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the esp-idf-lib i2cdev.h
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _PORT_I2CDEV_H_
+#define _PORT_I2CDEV_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+typedef int i2c_port_t;
+
+typedef struct
+{
+    i2c_port_t port; /*!< I2C port */
+    uint8_t addr;    /*!< Device address */
+} i2c_dev_t;
+
+esp_err_t i2cdev_init(void);
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file port.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-ins for the ESP-IDF calls made by the firmware drivers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Lets driver sources such as battery.c, esp_lcd.c and sensor_drivers.c
+ * build unmodified on the host. GPIO writes and delays do nothing but
+ * count, the ADC returns port_adc_raw and the I2C sensors port_sensors.
+ * Like esp-idf-lib, every I2C call fails until i2cdev_init().
+ *
+ * logger.c and pipeline.c run on one thread: esp_timer and the tick count
+ * read port_time_us, which the host moves, queues are plain rings and
+ * nothing blocks. TRACE() events are counted and dropped.
+ */
+#ifndef _PORT_H_
+#define _PORT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct port_counters_t port.h
+ * @brief Hardware calls made since the last reset
+ */
+typedef struct
+{
+    uint64_t gpio_writes; /*!< gpio_set_level() calls */
+    uint64_t delays;      /*!< vTaskDelay() calls, each one a yield on the device */
+    uint64_t delay_ticks; /*!< Ticks passed to vTaskDelay() */
+    uint64_t adc_reads;   /*!< adc1_get_raw() calls */
+    uint64_t i2c_reads;   /*!< BMP180 and DS3231 reads */
+    uint64_t traces;      /*!< TRACE() events */
+} port_counters_t;
+
+/**
+ * @struct port_sensors_t port.h
+ * @brief What the BMP180 and DS3231 stand-ins report
+ */
+typedef struct
+{
+    float temperature; /*!< BMP180 and DS3231 temperature in C */
+    uint32_t pressure; /*!< BMP180 pressure in Pa */
+    int64_t time;      /*!< DS3231 time in seconds since 1970 */
+    bool fail;         /*!< Every BMP180 and DS3231 call fails, as without a device */
+} port_sensors_t;
+
+extern port_counters_t port_counters;
+
+extern int port_adc_raw;
+
+extern port_sensors_t port_sensors;
+
+extern int64_t port_time_us;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
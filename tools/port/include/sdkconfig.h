@@ -0,0 +1,29 @@
+/**
+ * @file sdkconfig.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-in for the generated sdkconfig.h
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Only what the host-built firmware sources test, as in the default
+ * configuration: every on-board sensor, SD card logging and the sample
+ * path settings. The columnar block layout is left to the build, off
+ * unless CONFIG_LOGGER_LOG_COLUMNAR is defined.
+ */
+#ifndef _PORT_SDKCONFIG_H_
+#define _PORT_SDKCONFIG_H_
+
+#define CONFIG_LOGGER_RTC 1
+#define CONFIG_LOGGER_BATTERY 1
+#define CONFIG_LOGGER_SD 1
+#define CONFIG_LOGGER_RTC_SYNC_SAMPLES 60
+#define CONFIG_LOGGER_SAMPLE_PERIOD_MS 1000
+#define CONFIG_LOGGER_SAMPLE_RATE_ADAPTIVE 1
+#define CONFIG_LOGGER_PRESSURE_OVERSAMPLE 8
+#define CONFIG_LOGGER_PRESSURE_FILTER_CIC 1
+#define CONFIG_LOGGER_PRESSURE_CIC_ORDER 3
+#define CONFIG_LOGGER_PRESSURE_SMOOTH_SHIFT 0
+
+#endif
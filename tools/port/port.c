@@ -0,0 +1,272 @@
+/**
+ * @file port.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Host stand-ins for the ESP-IDF calls made by the firmware drivers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+#include "port.h"
+#include "bmp180.h"
+#include "ds3231.h"
+#include "driver/adc.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "trace/trace.h"
+
+port_counters_t port_counters; /* Hardware calls */
+int port_adc_raw = 2048;       /* Value returned by adc1_get_raw() */
+int64_t port_time_us;          /* Value returned by esp_timer_get_time() */
+
+/* Readings of the I2C sensors, 2022-11-26 19:07:00 at sea level */
+port_sensors_t port_sensors = {.temperature = 21.5f, .pressure = 101325, .time = 1669489620};
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    (void)gpio_num;
+    (void)level;
+    port_counters.gpio_writes++;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    (void)gpio_num;
+    return 0;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+    (void)gpio_num;
+    (void)mode;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+    (void)gpio_num;
+    (void)pull;
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+    (void)gpio_num;
+    return ESP_OK;
+}
+
+void esp_rom_gpio_pad_select_gpio(uint32_t iopad_num)
+{
+    (void)iopad_num;
+}
+
+esp_err_t adc1_config_width(adc_bits_width_t width_bit)
+{
+    (void)width_bit;
+    return ESP_OK;
+}
+
+esp_err_t adc1_config_channel_atten(adc1_channel_t channel, adc_atten_t atten)
+{
+    (void)channel;
+    (void)atten;
+    return ESP_OK;
+}
+
+int adc1_get_raw(adc1_channel_t channel)
+{
+    (void)channel;
+    port_counters.adc_reads++;
+    return port_adc_raw;
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    port_counters.delays++;
+    port_counters.delay_ticks += xTicksToDelay;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(port_time_us / 1000 / portTICK_PERIOD_MS);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return port_time_us;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t *pucQueueStorage,
+                                 StaticQueue_t *pxQueueBuffer)
+{
+    *pxQueueBuffer = (StaticQueue_t){.storage = pucQueueStorage, .length = uxQueueLength, .size = uxItemSize};
+    return pxQueueBuffer;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+    (void)xTicksToWait;
+    if (xQueue->waiting == xQueue->length)
+    {
+        return pdFAIL;
+    }
+    UBaseType_t tail = (xQueue->head + xQueue->waiting) % xQueue->length;
+    memcpy(xQueue->storage + tail * xQueue->size, pvItemToQueue, xQueue->size);
+    xQueue->waiting++;
+    return pdPASS;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+    (void)xTicksToWait;
+    if (xQueue->waiting == 0)
+    {
+        return pdFAIL;
+    }
+    memcpy(pvBuffer, xQueue->storage + xQueue->head * xQueue->size, xQueue->size);
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+    if (xQueuePeek(xQueue, pvBuffer, xTicksToWait) != pdPASS)
+    {
+        return pdFAIL;
+    }
+    xQueue->head = (xQueue->head + 1) % xQueue->length;
+    xQueue->waiting--;
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue)
+{
+    return xQueue->waiting;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer)
+{
+    pxSemaphoreBuffer->given = false;
+    return pxSemaphoreBuffer;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore)
+{
+    if (xSemaphore->given)
+    {
+        return pdFAIL;
+    }
+    xSemaphore->given = true;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime)
+{
+    (void)xBlockTime;
+    bool given = xSemaphore->given;
+    xSemaphore->given = false;
+    return given ? pdTRUE : pdFALSE;
+}
+
+bool trace_write(const char *fmt, const uint32_t *args, size_t nargs)
+{
+    (void)fmt;
+    (void)args;
+    (void)nargs;
+    port_counters.traces++;
+    return true;
+}
+
+/* Set by i2cdev_init(), without it the port mutexes do not exist */
+static bool port_i2c_ready;
+
+esp_err_t i2cdev_init(void)
+{
+    port_i2c_ready = true;
+    return ESP_OK;
+}
+
+static esp_err_t port_i2c(void)
+{
+    if (!port_i2c_ready)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return port_sensors.fail ? ESP_FAIL : ESP_OK;
+}
+
+esp_err_t bmp180_init_desc(bmp180_dev_t *dev, i2c_port_t port, gpio_num_t sda_gpio, gpio_num_t scl_gpio)
+{
+    (void)sda_gpio;
+    (void)scl_gpio;
+    dev->i2c_dev.port = port;
+    return ESP_OK;
+}
+
+esp_err_t bmp180_init(bmp180_dev_t *dev)
+{
+    (void)dev;
+    return port_i2c();
+}
+
+esp_err_t bmp180_measure(bmp180_dev_t *dev, float *temperature, uint32_t *pressure, bmp180_mode_t oss)
+{
+    (void)dev;
+    (void)oss;
+    port_counters.i2c_reads++;
+    *temperature = port_sensors.temperature;
+    *pressure = port_sensors.pressure;
+    return port_i2c();
+}
+
+esp_err_t ds3231_init_desc(i2c_dev_t *dev, i2c_port_t port, gpio_num_t sda_gpio, gpio_num_t scl_gpio)
+{
+    (void)sda_gpio;
+    (void)scl_gpio;
+    dev->port = port;
+    return ESP_OK;
+}
+
+esp_err_t ds3231_get_oscillator_stop_flag(i2c_dev_t *dev, bool *flag)
+{
+    (void)dev;
+    *flag = false;
+    return port_i2c();
+}
+
+esp_err_t ds3231_clear_oscillator_stop_flag(i2c_dev_t *dev)
+{
+    (void)dev;
+    return port_i2c();
+}
+
+esp_err_t ds3231_set_time(i2c_dev_t *dev, struct tm *time)
+{
+    (void)dev;
+    port_sensors.time = (int64_t)timegm(time);
+    return port_i2c();
+}
+
+esp_err_t ds3231_get_time(i2c_dev_t *dev, struct tm *time)
+{
+    time_t now = (time_t)port_sensors.time;
+
+    (void)dev;
+    port_counters.i2c_reads++;
+    gmtime_r(&now, time);
+    return port_i2c();
+}
+
+esp_err_t ds3231_get_temp_float(i2c_dev_t *dev, float *temp)
+{
+    (void)dev;
+    port_counters.i2c_reads++;
+    *temp = port_sensors.temperature;
+    return port_i2c();
+}
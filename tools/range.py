@@ -0,0 +1,541 @@
+"""
+Author: Jesus Minjares
+Date:   10-19-2026
+GitHub: https://github.com/jminjares4
+Brief:  Pull logged data from the card over the telemetry UART, see firmware/components/telemetry/range_read.h
+"""
+import calendar
+import os
+import select
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import termios
+import time
+import tty
+import zlib
+
+import click
+
+from telemetry import FrameDecoder, encode_frame, utc_text
+
+# frame types, see range_type_t in range_read.h
+RANGE_SEGMENT = 6
+RANGE_SPAN = 7
+RANGE_CHUNK = 8
+RANGE_LIST = 0x81
+RANGE_READ = 0x82
+RANGE_ABORT = 0x83
+
+# range_status_t
+STARTED, DONE, ABORTED, NO_SEGMENT, READ_ERROR = range(5)
+
+SEGMENT = struct.Struct('<HIqq24s')    # range_segment_t
+REQUEST = struct.Struct('<HIqq')       # range_request_t
+SPAN = struct.Struct('<HBII')          # range_span_t
+CHUNK = struct.Struct('<I')            # range_chunk_t without the block
+HEADER = struct.Struct('<IBBHIIqq')    # log_block_header_t
+
+BLOCK_SIZE = 512
+BLOCK_MAGIC = 0x424C4453
+INT64_MIN = -(1 << 63)
+INT64_MAX = (1 << 63) - 1
+
+REPLY_TIMEOUT = 2.0  # seconds without a valid frame before asking again
+RETRIES = 20         # requests per read before giving up
+
+
+def block_intact(block):
+    """
+    Check magic and CRC of a block like log_block_verify()
+
+    block (bytes) : one 512 byte block
+    """
+    magic, version = HEADER.unpack_from(block)[:2]
+    crc = HEADER.unpack_from(block)[5]
+    return magic == BLOCK_MAGIC and version == 1 and zlib.crc32(block[:12] + block[16:]) == crc
+
+
+class RawPort:
+    """
+    Serial port over a tty path with termios only, enough for a pseudo-terminal
+
+    port (str) : device path
+    """
+
+    def __init__(self, port):
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)  # binary safe: no echo, no newline translation
+        termios.tcflush(self.fd, termios.TCIFLUSH)
+
+    def read(self, timeout):
+        if not select.select([self.fd], [], [], timeout)[0]:
+            return b''
+        return os.read(self.fd, 65536)
+
+    def write(self, data):
+        while data:
+            data = data[os.write(self.fd, data):]
+
+    def close(self):
+        os.close(self.fd)
+
+
+class SerialPort:
+    """
+    Same interface over pyserial, for the device
+
+    port (str)      : serial/COM port
+    baudrate (int)  : baudrate of serial port: bit/sec
+    """
+
+    def __init__(self, port, baudrate):
+        import serial
+        self.ser = serial.Serial(port, baudrate, timeout=0)
+        self.ser.reset_input_buffer()
+
+    def read(self, timeout):
+        self.ser.timeout = timeout
+        return self.ser.read(max(1, self.ser.in_waiting))
+
+    def write(self, data):
+        self.ser.write(data)
+
+    def close(self):
+        self.ser.close()
+
+
+def open_port(port, baudrate):
+    """
+    pyserial for real ports, termios for pseudo-terminals or without pyserial
+
+    port (str)      : serial/COM port
+    baudrate (int)  : baudrate of serial port: bit/sec
+    """
+    if port.startswith('/dev/pts/'):
+        return RawPort(port)
+    try:
+        return SerialPort(port, baudrate)
+    except ImportError:
+        return RawPort(port)
+
+
+def parse_time(text):
+    """
+    Microseconds since 1970 from "YYYY-MM-DD hh:mm:ss" (UTC) or a plain number
+
+    text (str) : time, None for no bound
+    """
+    if text is None:
+        return None
+    if text.lstrip('-').isdigit():
+        return int(text)
+    for layout in ('%Y-%m-%d %H:%M:%S', '%Y-%m-%dT%H:%M:%S', '%Y-%m-%d'):
+        try:
+            return calendar.timegm(time.strptime(text, layout)) * 1000000
+        except ValueError:
+            pass
+    raise click.BadParameter('%r: use microseconds or "YYYY-MM-DD hh:mm:ss"' % text)
+
+
+class RangeClient:
+    """
+    Range read requests over an open port
+
+    Every chunk carries its block number, so a frame lost to a CRC error or
+    to console text on the port shows up as a gap; the read is then aborted
+    and asked again from the missing block.
+    """
+
+    def __init__(self, port):
+        self.port = port
+        self.decoder = FrameDecoder()
+        self.seq = 0
+        self.retries = 0
+        self.torn = 0
+
+    def send(self, rtype, payload=b''):
+        self.port.write(encode_frame(rtype, self.seq, payload))
+        self.seq += 1
+
+    def receive(self, timeout=REPLY_TIMEOUT):
+        """
+        Valid frames from one read of the port, [] after timeout seconds of silence
+        """
+        data = self.port.read(timeout)
+        return [(rtype, payload) for rtype, _, payload in self.decoder.feed(data) if rtype is not None]
+
+    def abort(self):
+        """
+        Stop what the device is sending and wait until it says so
+        """
+        self.send(RANGE_ABORT)
+        while True:
+            frames = self.receive()
+            if not frames:
+                return
+            for rtype, payload in frames:
+                if rtype == RANGE_SPAN and SPAN.unpack(payload)[1] == ABORTED:
+                    return
+
+    def segments(self):
+        """
+        List the log files on the card, as dicts
+        """
+        for _ in range(RETRIES):
+            self.send(RANGE_LIST)
+            found = {}
+            while True:
+                frames = self.receive()
+                if not frames:
+                    break
+                count = None
+                for rtype, payload in frames:
+                    if rtype == RANGE_SEGMENT:
+                        index, blocks, first_us, last_us, name = SEGMENT.unpack(payload)
+                        found[index] = {'index': index, 'blocks': blocks, 'first_us': first_us,
+                                        'last_us': last_us, 'name': name.rstrip(b'\x00').decode('ascii', 'replace')}
+                    elif rtype == RANGE_SPAN and SPAN.unpack(payload)[1] == DONE:
+                        count = SPAN.unpack(payload)[0]
+                if count is not None:
+                    if len(found) == count:
+                        return [found[i] for i in sorted(found)]
+                    break
+            self.retries += 1
+        raise click.ClickException('no complete segment list after %d requests' % RETRIES)
+
+    def read(self, segment, from_us, to_us, out, resume=0, limit=None, started=None):
+        """
+        Append the blocks of a range to a file
+
+        segment (int)   : segment number
+        from_us (int)   : range start, INT64_MIN for the segment start
+        to_us (int)     : range end, INT64_MAX for the segment end
+        out (file)      : binary file, blocks are appended in order
+        resume (int)    : block to continue from, 0 to search from_us
+        limit (int)     : stop after this many blocks, None for no limit
+        started (func)  : called with the first block of the read once known
+        return (tuple)  : (first block, one past the last block written, complete)
+        """
+        expected = resume if resume else None
+        first = None
+        written = 0
+        for _ in range(RETRIES):
+            self.send(RANGE_READ, REQUEST.pack(segment, expected or 0, from_us, to_us))
+            opened = False
+            gap = False
+            while not gap:
+                frames = self.receive()
+                if not frames:
+                    break
+                for rtype, payload in frames:
+                    if rtype == RANGE_SPAN:
+                        span_segment, status, span_first, span_next = SPAN.unpack(payload)
+                        if span_segment != segment:
+                            continue
+                        if status == STARTED:
+                            opened = True
+                            if expected is None:
+                                expected = span_first
+                            if first is None:
+                                first = span_first
+                                if started:
+                                    started(first)
+                            continue
+                        if not opened:
+                            continue
+                        if status == NO_SEGMENT:
+                            raise click.ClickException('no segment %d' % segment)
+                        if status == DONE and span_next == expected:
+                            return first, expected, True
+                        # read error, or chunks lost at the end: ask again
+                        gap = True
+                        break
+                    elif rtype == RANGE_CHUNK and opened:
+                        block = CHUNK.unpack_from(payload)[0]
+                        if block != expected:
+                            gap = True
+                            break
+                        data = payload[CHUNK.size:]
+                        self.torn += not block_intact(data)
+                        out.write(data)
+                        expected += 1
+                        written += 1
+                        if limit is not None and written >= limit:
+                            self.abort()
+                            return first, expected, False
+            self.retries += 1
+            self.abort()
+        raise click.ClickException('segment %d: gave up at block %s after %d requests' % (segment, expected, RETRIES))
+
+
+def download(client, segment, from_us, to_us, path, resume=False, limit=None):
+    """
+    Read a range into a file, with a path.part sidecar so an interrupted download can be resumed
+
+    client (RangeClient)    : open client
+    segment (int)           : segment number
+    from_us (int)           : range start
+    to_us (int)             : range end
+    path (str)              : output file
+    resume (bool)           : continue from path.part instead of starting over
+    limit (int)             : stop after this many blocks, None for no limit
+    return (tuple)          : (blocks written by this call, complete)
+    """
+    part = path + '.part'
+    start = 0
+    mode = 'wb'
+    if resume and os.path.exists(part):
+        with open(part) as f:
+            segment, from_us, to_us, first = (int(v) for v in f.read().split())
+        # whole blocks only, a block cut by the interruption is read again
+        have = os.path.getsize(path) // BLOCK_SIZE if os.path.exists(path) else 0
+        with open(path, 'ab') as f:
+            f.truncate(have * BLOCK_SIZE)
+        start = first + have
+        mode = 'ab'
+
+    def started(first):
+        if not resume:
+            with open(part, 'w') as f:
+                f.write('%d %d %d %d\n' % (segment, from_us, to_us, first))
+
+    with open(path, mode) as out:
+        first, end, complete = client.read(segment, from_us, to_us, out, resume=start, limit=limit, started=started)
+    if complete and os.path.exists(part):
+        os.remove(part)
+    return end - (start or first), complete
+
+
+@click.group()
+def main():
+    """
+    Pull logged data over the telemetry UART without removing the card
+    """
+
+
+# example:
+# python3 range.py list --port="serial-port"
+@main.command('list')
+@click.option('--port', '-p', required=True, help='Serial Port Number')
+@click.option('--baudrate', '-b', default=921600, help='Serial Baudrate')
+def list_segments(port, baudrate):
+    """
+    List the log files on the card with their time span
+
+    port (str)      : serial/COM port
+    baudrate (int)  : baudrate of serial port: bit/sec
+    """
+    link = open_port(port, baudrate)
+    try:
+        for s in RangeClient(link).segments():
+            span = '%s .. %s' % (utc_text(s['first_us']), utc_text(s['last_us'])) if s['first_us'] else 'no intact block'
+            print('%4d  %-20s %8d blocks  %s' % (s['index'], s['name'], s['blocks'], span))
+    finally:
+        link.close()
+
+
+# default example
+# python3 range.py read --port="serial-port" --segment=0 --out=seg0.bin
+#
+# custom example:
+# python3 range.py read --port="serial-port" --segment=3 --start="2026-10-19 08:00:00" --end="2026-10-19 09:00:00" --out=hour.bin
+# python3 range.py read --port="serial-port" --segment=3 --out=hour.bin --resume
+@main.command()
+@click.option('--port', '-p', required=True, help='Serial Port Number')
+@click.option('--baudrate', '-b', default=921600, help='Serial Baudrate')
+@click.option('--segment', '-s', required=True, type=int, help='Segment number, see list')
+@click.option('--start', default=None, help='Range start, UTC "YYYY-MM-DD hh:mm:ss" or microseconds')
+@click.option('--end', default=None, help='Range end, UTC "YYYY-MM-DD hh:mm:ss" or microseconds')
+@click.option('--out', '-o', required=True, help='Output file, decode with logdecode')
+@click.option('--resume', is_flag=True, help='Continue an interrupted download of --out')
+def read(port, baudrate, segment, start, end, out, resume):
+    """
+    Download a time range of one log file, blocks exactly as stored
+
+    port (str)      : serial/COM port
+    baudrate (int)  : baudrate of serial port: bit/sec
+    segment (int)   : segment number
+    start (str)     : range start, None for the segment start
+    end (str)       : range end, None for the segment end
+    out (str)       : output file
+    resume (bool)   : continue from out.part
+    """
+    from_us = parse_time(start)
+    to_us = parse_time(end)
+    link = open_port(port, baudrate)
+    client = RangeClient(link)
+    t0 = time.time()
+    try:
+        blocks, _ = download(client, segment, INT64_MIN if from_us is None else from_us,
+                             INT64_MAX if to_us is None else to_us, out, resume=resume)
+    except KeyboardInterrupt:
+        client.abort()
+        print('interrupted, continue with --resume')
+        sys.exit(1)
+    finally:
+        link.close()
+    elapsed = time.time() - t0
+    print('%d blocks, %d bytes in %.1f s (%.0f B/s), %d retries, %d torn blocks' %
+          (blocks, blocks * BLOCK_SIZE, elapsed, blocks * BLOCK_SIZE / elapsed if elapsed else 0,
+           client.retries, client.torn))
+
+
+def make_segment(path, seq, start_us, blocks, period_us=250000):
+    """
+    Write a log file like the firmware's: row layout blocks of 24 samples
+
+    path (str)      : file path
+    seq (int)       : first block sequence number
+    start_us (int)  : first sample time
+    blocks (int)    : number of blocks
+    period_us (int) : sample period
+    """
+    record = struct.Struct('<qBBHiI')  # log_record_t
+    per_block = (BLOCK_SIZE - HEADER.size) // record.size
+    data = bytearray()
+    t = start_us
+    for i in range(blocks):
+        payload = bytearray()
+        first = t
+        for _ in range(per_block):
+            payload += record.pack(t, 0, 0, 3900, 2150 + t // 60000000 % 100, 101325 - t // 1000000 % 500)
+            t += period_us
+        payload += bytes(BLOCK_SIZE - HEADER.size - len(payload))
+        header = HEADER.pack(BLOCK_MAGIC, 1, 0, per_block, seq + i, 0, first, t - period_us)
+        block = header + payload
+        crc = zlib.crc32(block[:12] + block[16:])
+        data += block[:12] + struct.pack('<I', crc) + block[16:]
+    with open(path, 'wb') as f:
+        f.write(data)
+    return bytes(data)
+
+
+# example:
+# python3 range.py selftest --host=build/range_host
+@main.command()
+@click.option('--host', 'host', required=True, help='range_host executable, built from tools/CMakeLists.txt')
+@click.option('--baudrate', '-b', default=921600, help='Emulated link baudrate, 0 for unpaced')
+@click.option('--blocks', '-n', default=1000, help='Blocks in the largest segment')
+@click.option('--corrupt', '-c', default=150, help='Corrupt one frame in this many, 0 for none')
+def selftest(host, baudrate, blocks, corrupt):
+    """
+    Serve generated logs with the firmware's range service over a pty and check every download byte for byte
+
+    host (str)      : range_host path
+    baudrate (int)  : emulated baudrate, 8N1 (10 bits per byte)
+    blocks (int)    : blocks in the largest segment
+    corrupt (int)   : one corrupted frame in this many
+    """
+    root = tempfile.mkdtemp(prefix='range_')
+    t0 = 1792396800 * 1000000  # 2026-10-19 00:00:00 UTC
+    files = {}
+
+    # a day directory, a file from before the clock was known, and things to skip
+    os.mkdir(os.path.join(root, '20261019'))
+    os.mkdir(os.path.join(root, 'MISC'))
+    files['20261019/080000.BIN'] = make_segment(os.path.join(root, '20261019/080000.BIN'), 0, t0 + 8 * 3600000000, blocks)
+    torn = bytearray(make_segment(os.path.join(root, '20261019/093000.BIN'), 5000, t0 + 34200000000, blocks // 2))
+    torn[BLOCK_SIZE * (blocks // 4) + 100] ^= 0xFF   # a torn block in the middle
+    torn += bytes(BLOCK_SIZE)                         # and an unwritten one at the end
+    with open(os.path.join(root, '20261019/093000.BIN'), 'wb') as f:
+        f.write(torn)
+    files['20261019/093000.BIN'] = bytes(torn)
+    files['LOG00000.BIN'] = make_segment(os.path.join(root, 'LOG00000.BIN'), 9000, 0, 10)
+    make_segment(os.path.join(root, 'MISC', 'OTHER.BIN'), 0, 0, 1)
+    with open(os.path.join(root, 'README.TXT'), 'w') as f:
+        f.write('not a log\n')
+
+    server = subprocess.Popen([host, '-b', str(baudrate), '-c', str(corrupt), root],
+                              stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+    results = []
+
+    def check(name, ok, detail=''):
+        results.append(ok)
+        print('%-28s %s  %s' % (name, 'ok  ' if ok else 'FAIL', detail))
+
+    try:
+        pty_path = server.stdout.readline().decode().strip()
+        link = RawPort(pty_path)
+        client = RangeClient(link)
+        out = os.path.join(root, 'MISC', 'download.bin')  # outside the served tree
+        link_rate = baudrate / 10.0 if baudrate else float('nan')
+
+        # segments with times from their first and last intact blocks
+        segments = {s['name']: s for s in client.segments()}
+        ok = sorted(segments) == sorted(files)
+        for name, data in files.items():
+            s = segments.get(name)
+            intact = [data[i:i + BLOCK_SIZE] for i in range(0, len(data), BLOCK_SIZE)]
+            intact = [b for b in intact if block_intact(b)]
+            ok = ok and s is not None and s['blocks'] == len(data) // BLOCK_SIZE
+            ok = ok and s['first_us'] == HEADER.unpack_from(intact[0])[6] and s['last_us'] == HEADER.unpack_from(intact[-1])[7]
+        check('list', ok, '%d segments' % len(segments))
+
+        # whole segment, timed
+        big = segments['20261019/080000.BIN']
+        client.retries = 0
+        start = time.perf_counter()
+        download(client, big['index'], INT64_MIN, INT64_MAX, out)
+        elapsed = time.perf_counter() - start
+        with open(out, 'rb') as f:
+            got = f.read()
+        rate = len(got) / elapsed
+        check('full read', got == files[big['name']],
+              '%d blocks, %.0f B/s payload (link %.0f B/s), %d retries' %
+              (len(got) // BLOCK_SIZE, rate, link_rate, client.retries))
+        if baudrate:
+            # one 516 byte chunk costs about 530 bytes on the wire
+            check('link use', rate / link_rate > 0.75, '%.0f%% of the link as block payload' % (100 * rate / link_rate))
+
+        # time range: from the first block reaching start to the last block starting by end
+        data = files[big['name']]
+        headers = [HEADER.unpack_from(data, i) for i in range(0, len(data), BLOCK_SIZE)]
+        from_us = headers[len(headers) // 3][6] + 3000000
+        to_us = headers[len(headers) // 2][7] - 2000000
+        first = next(i for i, h in enumerate(headers) if h[7] >= from_us)
+        last = max(i for i, h in enumerate(headers) if h[6] <= to_us)
+        download(client, big['index'], from_us, to_us, out)
+        with open(out, 'rb') as f:
+            got = f.read()
+        check('time range', got == data[first * BLOCK_SIZE:(last + 1) * BLOCK_SIZE],
+              'blocks %d..%d of %d' % (first, last, len(headers)))
+
+        # interrupted after a third, then resumed from the sidecar
+        mid = segments['20261019/093000.BIN']
+        client.torn = 0
+        _, complete = download(client, mid['index'], INT64_MIN, INT64_MAX, out, limit=mid['blocks'] // 3)
+        partial = os.path.getsize(out) // BLOCK_SIZE
+        with open(out, 'ab') as f:
+            f.write(bytes(100))  # a block cut by the interruption
+        download(client, mid['index'], INT64_MIN, INT64_MAX, out, resume=True)
+        with open(out, 'rb') as f:
+            got = f.read()
+        check('interrupt and resume', not complete and got == files[mid['name']] and not os.path.exists(out + '.part'),
+              'stopped at %d of %d blocks, %d torn blocks passed through' % (partial, mid['blocks'], client.torn))
+
+        # a segment that does not exist
+        try:
+            with open(out, 'wb') as f:
+                client.read(99, INT64_MIN, INT64_MAX, f)
+            check('missing segment', False)
+        except click.ClickException:
+            check('missing segment', True)
+
+        link.close()
+        print('frames: %d, invalid: %d' % (client.decoder.frames, client.decoder.errors))
+    finally:
+        server.terminate()
+        server.wait()
+        shutil.rmtree(root)
+
+    ok = len(results) > 0 and all(results)
+    print('PASS' if ok else 'FAIL')
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    # Call main function
+    main()
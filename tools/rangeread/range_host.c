@@ -0,0 +1,208 @@
+/**
+ * @file range_host.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Serve log range reads from a directory over a pseudo-terminal
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Host build of the device side: the same range_read.c and log_dir.c the
+ * firmware runs, with a pty standing in for the telemetry UART. Frames are
+ * paced to the emulated baudrate, and every Nth frame can be corrupted to
+ * exercise the client's retries. Prints the pty path on the first line of
+ * stdout, then serves until killed.
+ *
+ * ### Example
+ * ~~~
+ * range_host logs                   # 921600 baud
+ * range_host -b 0 -c 100 logs       # unpaced, one frame in 100 corrupted
+ * python3 tools/range.py list --port=/dev/pts/N
+ * ~~~
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <pty.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "logger/log_dir.h"
+#include "telemetry/frame.h"
+#include "telemetry/range_read.h"
+
+#define IDLE_MS 100 /* poll timeout while no read is in progress */
+
+typedef struct
+{
+    int fd;                 /* pty master */
+    double rate;            /* bytes per second, 0 for unpaced */
+    double due;             /* time the next frame may start */
+    uint32_t corrupt_every; /* 0 for never */
+    uint32_t frames;
+    uint32_t corrupted;
+    uint64_t bytes;
+    uint8_t seq;
+} link_t;
+
+static void usage(void)
+{
+    fputs("usage: range_host [-b baudrate] [-c every] dir\n"
+          "  -b   emulated baudrate, 8N1, 0 for unpaced (default 921600)\n"
+          "  -c   corrupt one frame in every, 0 for none (default 0)\n",
+          stderr);
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int dir_segment(void *ctx, uint16_t index, char *name, size_t size, uint32_t *blocks)
+{
+    return log_dir_segment(ctx, index, name, size, blocks);
+}
+
+static int dir_read(void *ctx, uint16_t index, uint32_t block, log_block_t *dst)
+{
+    return log_dir_read(ctx, index, block, dst);
+}
+
+/**
+ * @brief range_read_t send(): encode, pace like the UART and write, blocking while the pty is full
+ */
+static bool link_send(void *ctx, uint8_t *raw, size_t len)
+{
+    link_t *link = ctx;
+    uint8_t frame[FRAME_ENCODED_SIZE(sizeof(range_chunk_t))];
+
+    raw[1] = link->seq++;
+    size_t n = frame_seal(raw, len, frame);
+
+    /* Flip a byte inside the frame, never into a delimiter */
+    link->frames++;
+    if (link->corrupt_every != 0 && link->frames % link->corrupt_every == 0)
+    {
+        frame[n / 2] = frame[n / 2] == 0x55 ? 0xAA : frame[n / 2] ^ 0x55;
+        link->corrupted++;
+    }
+
+    if (link->rate > 0)
+    {
+        double now = now_s();
+        if (link->due < now)
+        {
+            link->due = now;
+        }
+        double wait = link->due - now;
+        if (wait > 0)
+        {
+            struct timespec ts = {(time_t)wait, (long)((wait - (double)(time_t)wait) * 1e9)};
+            nanosleep(&ts, NULL);
+        }
+        link->due += (double)n / link->rate;
+    }
+
+    for (size_t done = 0; done < n;)
+    {
+        ssize_t w = write(link->fd, &frame[done], n - done);
+        if (w < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        done += (size_t)w;
+    }
+    link->bytes += n;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    long baudrate = 921600;
+    long corrupt = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:c:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            baudrate = strtol(optarg, NULL, 0);
+            break;
+        case 'c':
+            corrupt = strtol(optarg, NULL, 0);
+            break;
+        default:
+            usage();
+            return 2;
+        }
+    }
+    if (optind != argc - 1 || baudrate < 0 || corrupt < 0)
+    {
+        usage();
+        return 2;
+    }
+
+    /* Raw pty: binary safe, no echo. The slave stays open here so the master never reads EIO between clients */
+    int master, slave;
+    if (openpty(&master, &slave, NULL, NULL, NULL) != 0)
+    {
+        perror("openpty");
+        return 1;
+    }
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    printf("%s\n", ttyname(slave));
+    fflush(stdout);
+
+    log_dir_t dir;
+    log_dir_init(&dir, argv[optind]);
+    link_t link = {
+        .fd = master,
+        .rate = (double)baudrate / 10.0,
+        .corrupt_every = (uint32_t)corrupt,
+    };
+    range_read_t range = {
+        .store = {.ctx = &dir, .segment = dir_segment, .read = dir_read},
+        .send = link_send,
+        .send_ctx = &link,
+    };
+    range_read_init(&range);
+
+    bool busy = false;
+    uint8_t rx[256];
+    while (1)
+    {
+        struct pollfd fds = {.fd = master, .events = POLLIN};
+        if (poll(&fds, 1, busy ? 0 : IDLE_MS) > 0 && (fds.revents & POLLIN))
+        {
+            ssize_t n = read(master, rx, sizeof(rx));
+            if (n > 0)
+            {
+                range_read_feed(&range, rx, (size_t)n);
+            }
+        }
+        bool was_busy = busy;
+        busy = range_read_poll(&range);
+        if (was_busy && !busy)
+        {
+            fprintf(stderr, "range_host: requests %" PRIu32 ", chunks %" PRIu32 ", bad frames %" PRIu32
+                            ", frames %" PRIu32 ", corrupted %" PRIu32 ", bytes %" PRIu64 "\n",
+                    range.stats.requests, range.stats.chunks, range.stats.bad_frames, link.frames,
+                    link.corrupted, link.bytes);
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file file_blockdev.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Block device backed by a Linux file or device node
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Stand-in for the SD card so the raw logging mode runs on the host. An SD
+ * card image dumped with dd, or the card reader device itself, works too.
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "file_blockdev.h"
+
+#define SECTOR 512
+
+static int file_read(void *ctx, uint32_t sector, void *dst, uint32_t count)
+{
+    file_blockdev_t *file = ctx;
+    size_t size = (size_t)count * SECTOR;
+
+    file->reads++;
+    return pread(file->fd, dst, size, (off_t)sector * SECTOR) == (ssize_t)size ? 0 : -1;
+}
+
+static int file_write(void *ctx, uint32_t sector, const void *src, uint32_t count)
+{
+    file_blockdev_t *file = ctx;
+    size_t size = (size_t)count * SECTOR;
+
+    file->writes++;
+    file->sectors += count;
+    if (pwrite(file->fd, src, size, (off_t)sector * SECTOR) != (ssize_t)size)
+    {
+        return -1;
+    }
+    return file->sync && fdatasync(file->fd) != 0 ? -1 : 0;
+}
+
+static int file_erase(void *ctx, uint32_t sector, uint32_t count)
+{
+    file_blockdev_t *file = ctx;
+
+    /* Reads back as zeros, like a card erase */
+    return fallocate(file->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t)sector * SECTOR,
+                     (off_t)count * SECTOR);
+}
+
+/**
+ * @brief Open an image
+ *
+ * @param file      pointer to device
+ * @param path      image path
+ * @param sectors   size when creating, ignored otherwise
+ * @param create    create or truncate the image
+ * @return int 0 success, -1 failure
+ */
+int file_blockdev_open(file_blockdev_t *file, const char *path, uint32_t sectors, bool create)
+{
+    struct stat st;
+
+    file->fd = open(path, create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0644);
+    if (file->fd < 0 || fstat(file->fd, &st) != 0)
+    {
+        return -1;
+    }
+    if (create && ftruncate(file->fd, (off_t)sectors * SECTOR) != 0)
+    {
+        close(file->fd);
+        return -1;
+    }
+    if (!create)
+    {
+        /* Regular file size, or the size of a block device node */
+        off_t size = S_ISREG(st.st_mode) ? st.st_size : lseek(file->fd, 0, SEEK_END);
+        sectors = size > 0 ? (uint32_t)(size / SECTOR) : 0;
+    }
+    file->dev = (blockdev_t){
+        .ctx = file,
+        .sectors = sectors,
+        .read = file_read,
+        .write = file_write,
+        .erase = S_ISREG(st.st_mode) ? file_erase : NULL,
+    };
+    file->sync = false;
+    file->reads = file->writes = file->sectors = 0;
+    return 0;
+}
+
+/**
+ * @brief Close an image
+ *
+ * @param file  pointer to device
+ */
+void file_blockdev_close(file_blockdev_t *file)
+{
+    close(file->fd);
+    file->fd = -1;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file file_blockdev.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Block device backed by a Linux file or device node
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _FILE_BLOCKDEV_H_
+#define _FILE_BLOCKDEV_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "logger/raw_log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct file_blockdev_t file_blockdev.h
+ * @brief Open image, counts the I/O it served
+ */
+typedef struct
+{
+    blockdev_t dev;   /*!< Device interface, pass &dev to raw_log */
+    int fd;           /*!< File descriptor */
+    bool sync;        /*!< fdatasync() after every write, like a card write completing */
+    uint64_t reads;   /*!< Read calls */
+    uint64_t writes;  /*!< Write calls */
+    uint64_t sectors; /*!< Sectors written */
+} file_blockdev_t;
+
+int file_blockdev_open(file_blockdev_t *file, const char *path, uint32_t sectors, bool create);
+
+void file_blockdev_close(file_blockdev_t *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,376 @@
+/**
+ * @file rawlog.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Create, benchmark and extract raw log partitions
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ### Example
+ * ~~~
+ * rawlog image -s 256 card.img          # MBR + 0xDA partition, formatted
+ * rawlog bench -n 65536 card.img        # write speed per batch size, recovery check
+ * rawlog info /dev/sdX                  # header of a real card
+ * rawlog extract -o logs card.img       # one LOGnnnnn.BIN per session, see logdecode
+ * ~~~
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "file_blockdev.h"
+#include "logfmt/log_block.h"
+
+#define PARTITION_START 2048 /* 1 MiB aligned, like fdisk */
+#define EXTRACT_CHUNK 256    /* Sectors per read while extracting */
+
+static void usage(void)
+{
+    fputs("usage:\n"
+          "  rawlog image -s MB image         create an image with a formatted raw log partition\n"
+          "  rawlog bench [-n blocks] [-y] image\n"
+          "                                   write blocks with several batch sizes, -y syncs each write\n"
+          "  rawlog info image                print the raw log header\n"
+          "  rawlog extract -o dir image      write every session to dir/LOGnnnnn.BIN\n",
+          stderr);
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void put_le32(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Open an image and its raw log partition
+ */
+static int open_log(file_blockdev_t *file, raw_log_t *raw, const char *path, uint32_t *first, uint32_t *count)
+{
+    if (file_blockdev_open(file, path, 0, false) != 0)
+    {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    if (raw_log_find_partition(&file->dev, first, count) != 0)
+    {
+        fprintf(stderr, "%s: no partition of type 0x%02X\n", path, RAW_LOG_PARTITION_TYPE);
+        return -1;
+    }
+    if (raw == NULL)
+    {
+        return 0;
+    }
+    int opened = raw_log_open(raw, &file->dev, *first, *count);
+    if (opened < 0 || opened == RAW_LOG_EMPTY)
+    {
+        fprintf(stderr, "%s: %s\n", path, opened < 0 ? "read failed" : "no raw log");
+        return -1;
+    }
+    if (opened == RAW_LOG_RECOVERED)
+    {
+        fprintf(stderr, "%s: header rebuilt from the blocks\n", path);
+    }
+    return 0;
+}
+
+static int cmd_image(const char *path, uint32_t mb)
+{
+    uint32_t sectors = mb * 2048;
+    file_blockdev_t file;
+    raw_log_t raw;
+    uint8_t mbr[LOG_BLOCK_SIZE] = {0};
+
+    if (sectors <= PARTITION_START + 1 || file_blockdev_open(&file, path, sectors, true) != 0)
+    {
+        fprintf(stderr, "%s: cannot create\n", path);
+        return 1;
+    }
+
+    /* One primary partition covering the rest of the image */
+    uint8_t *entry = &mbr[446];
+    entry[4] = RAW_LOG_PARTITION_TYPE;
+    put_le32(&entry[8], PARTITION_START);
+    put_le32(&entry[12], sectors - PARTITION_START);
+    mbr[510] = 0x55;
+    mbr[511] = 0xAA;
+    if (file.dev.write(file.dev.ctx, 0, mbr, 1) != 0 ||
+        raw_log_format(&raw, &file.dev, PARTITION_START, sectors - PARTITION_START) != 0)
+    {
+        fprintf(stderr, "%s: write failed\n", path);
+        return 1;
+    }
+    printf("%s: %" PRIu32 " MiB, raw log of %" PRIu32 " blocks at sector %d\n", path, mb, raw.header.sectors,
+           PARTITION_START);
+    file_blockdev_close(&file);
+    return 0;
+}
+
+/**
+ * @brief Fill blocks the way the logger does
+ */
+static void fill_blocks(log_block_t *blocks, uint32_t count, uint32_t *seq, int64_t *time_us)
+{
+    for (uint32_t b = 0; b < count; b++)
+    {
+        log_block_init(&blocks[b], (*seq)++);
+        while (!log_block_full(&blocks[b]))
+        {
+            log_record_t *record = log_block_reserve(&blocks[b]);
+            *record = (log_record_t){
+                .time_us = *time_us,
+                .type = LOG_RECORD_SAMPLE,
+                .battery_mv = 3900,
+                .temperature = 2150,
+                .pressure = 101325,
+            };
+            log_block_commit(&blocks[b]);
+            *time_us += 1000000;
+        }
+        log_block_seal(&blocks[b]);
+    }
+}
+
+/**
+ * @brief Overwrite the header sector: torn, our magic and a bad CRC (0), or blank (1)
+ */
+static void raw_log_write_damaged(file_blockdev_t *file, uint32_t first, uint8_t *sector, int damage)
+{
+    file->dev.read(file->dev.ctx, first, sector, 1);
+    if (damage == 0)
+    {
+        sector[8] ^= 0x5A;
+    }
+    else
+    {
+        memset(sector, 0xFF, LOG_BLOCK_SIZE);
+    }
+    file->dev.write(file->dev.ctx, first, sector, 1);
+}
+
+static int cmd_bench(const char *path, uint32_t blocks, bool sync)
+{
+    static const uint32_t batches[] = {1, 8, 64};
+    file_blockdev_t file;
+    raw_log_t raw;
+    uint32_t first, count;
+    int status = 0;
+
+    if (open_log(&file, NULL, path, &first, &count) != 0)
+    {
+        return 1;
+    }
+    if (blocks > count - 1)
+    {
+        blocks = count - 1;
+    }
+    file.sync = sync;
+
+    log_block_t *buffer = malloc(batches[2] * sizeof(log_block_t));
+    printf("%" PRIu32 " blocks (%.1f MiB), %s\n\n", blocks, blocks / 2048.0, sync ? "synced writes" : "page cache");
+    for (size_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++)
+    {
+        uint32_t batch = batches[i];
+        uint32_t seq = 0;
+        int64_t time_us = 1666811220000000LL;
+
+        raw_log_format(&raw, &file.dev, first, count);
+        raw_log_start(&raw);
+        file.writes = file.sectors = 0;
+
+        double busy = 0.0;
+        for (uint32_t done = 0; done < blocks;)
+        {
+            uint32_t n = blocks - done < batch ? blocks - done : batch;
+            fill_blocks(buffer, n, &seq, &time_us);
+            double start = now_s();
+            if (raw_log_write(&raw, buffer, n) != 0)
+            {
+                fprintf(stderr, "write failed at block %" PRIu32 "\n", done);
+                status = 1;
+                break;
+            }
+            busy += now_s() - start;
+            done += n;
+        }
+
+        /* Power loss: no final sync, the head must be recovered by scanning */
+        raw_log_t check;
+        bool recovered = raw_log_open(&check, &file.dev, first, count) == 0 && check.head == raw.head;
+
+        /* Header torn during its rewrite, then lost: rebuilt from the blocks, nothing erased */
+        bool rebuilt = true;
+        uint8_t header[LOG_BLOCK_SIZE];
+        for (int damage = 0; damage < 2; damage++)
+        {
+            raw_log_write_damaged(&file, first, header, damage);
+            rebuilt &= raw_log_open(&check, &file.dev, first, count) == RAW_LOG_RECOVERED && check.head == raw.head;
+        }
+        raw_log_start(&check);
+        status |= !recovered || !rebuilt;
+
+        printf("batch %3" PRIu32 ": %8.1f MiB/s %8" PRIu64 " device writes, %5.2f%% header sectors, "
+               "recovered head %s, rebuilt header %s\n",
+               batch, blocks / 2048.0 / busy, file.writes,
+               100.0 * (double)(file.sectors - blocks) / (double)file.sectors, recovered ? "ok" : "FAIL",
+               rebuilt ? "ok" : "FAIL");
+    }
+    free(buffer);
+    file_blockdev_close(&file);
+    return status;
+}
+
+static int cmd_info(const char *path)
+{
+    file_blockdev_t file;
+    raw_log_t raw;
+    uint32_t first, count;
+
+    if (open_log(&file, &raw, path, &first, &count) != 0)
+    {
+        return 1;
+    }
+    printf("partition  : sector %" PRIu32 ", %" PRIu32 " sectors\n", first, count);
+    printf("sessions   : %" PRIu32 "\n", raw.header.sessions);
+    printf("head       : %" PRIu32 " stored, %" PRIu32 " recovered, %.2f%% used\n", raw.header.head, raw.head,
+           100.0 * raw.head / raw.header.sectors);
+    file_blockdev_close(&file);
+    return 0;
+}
+
+static int cmd_extract(const char *path, const char *dir)
+{
+    file_blockdev_t file;
+    raw_log_t raw;
+    uint32_t first, count;
+    FILE *out = NULL;
+    uint32_t files = 0, written = 0, invalid = 0;
+
+    if (open_log(&file, &raw, path, &first, &count) != 0)
+    {
+        return 1;
+    }
+    mkdir(dir, 0755);
+
+    log_block_t *chunk = malloc(EXTRACT_CHUNK * sizeof(log_block_t));
+    for (uint32_t at = 0; at < raw.head; at += EXTRACT_CHUNK)
+    {
+        uint32_t n = raw.head - at < EXTRACT_CHUNK ? raw.head - at : EXTRACT_CHUNK;
+        if (file.dev.read(file.dev.ctx, first + 1 + at, chunk, n) != 0)
+        {
+            fprintf(stderr, "%s: read failed at sector %" PRIu32 "\n", path, first + 1 + at);
+            break;
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (!log_block_verify(&chunk[i]))
+            {
+                invalid++;
+                continue;
+            }
+            /* Every boot restarts the block sequence */
+            if (out == NULL || chunk[i].header.seq == 0)
+            {
+                char name[4096];
+                if (out != NULL)
+                {
+                    fclose(out);
+                }
+                snprintf(name, sizeof(name), "%s/LOG%05" PRIu32 ".BIN", dir, files++);
+                out = fopen(name, "wb");
+                if (out == NULL)
+                {
+                    fprintf(stderr, "%s: %s\n", name, strerror(errno));
+                    free(chunk);
+                    return 1;
+                }
+            }
+            fwrite(&chunk[i], sizeof(log_block_t), 1, out);
+            written++;
+        }
+    }
+    if (out != NULL)
+    {
+        fclose(out);
+    }
+    free(chunk);
+    printf("%" PRIu32 " blocks in %" PRIu32 " files, %" PRIu32 " invalid\n", written, files, invalid);
+    file_blockdev_close(&file);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *output = NULL;
+    const char *image = NULL;
+    uint32_t size_mb = 0;
+    uint32_t blocks = 65536;
+    bool sync = false;
+
+    if (argc < 3)
+    {
+        usage();
+        return 2;
+    }
+    for (int i = 2; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc)
+        {
+            size_mb = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+        {
+            blocks = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-y"))
+        {
+            sync = true;
+        }
+        else
+        {
+            image = argv[i];
+        }
+    }
+    if (image == NULL)
+    {
+        usage();
+        return 2;
+    }
+
+    const char *command = argv[1];
+    if (!strcmp(command, "image") && size_mb > 0)
+    {
+        return cmd_image(image, size_mb);
+    }
+    if (!strcmp(command, "bench"))
+    {
+        return cmd_bench(image, blocks, sync);
+    }
+    if (!strcmp(command, "info"))
+    {
+        return cmd_info(image);
+    }
+    if (!strcmp(command, "extract") && output != NULL)
+    {
+        return cmd_extract(image, output);
+    }
+    usage();
+    return 2;
+}
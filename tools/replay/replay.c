@@ -0,0 +1,568 @@
+/**
+ * @file replay.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Record sensor captures and replay them through the acquisition, processing and storage code
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A capture holds every sensor access the executor made, raw bytes and
+ * timing included, as sensor_capture_t records back to back. The device
+ * sends them with CONFIG_LOGGER_SENSOR_CAPTURE and `telemetry.py capture`
+ * saves them to a file.
+ *
+ * run feeds a capture back through sensor_exec_replay(): the drivers'
+ * decode, then pipeline.c and logger.c as main.c runs them, with the
+ * default configuration of tools/port/include/sdkconfig.h. esp_timer follows
+ * the capture's ticks and the logger's writer runs after every tick, so the
+ * block pool and the flush policy see the device's timing; the controller's
+ * period changes are logged but do not move the ticks. replay_columnar is
+ * the same with CONFIG_LOGGER_LOG_COLUMNAR. The log decodes with logdecode
+ * and its CRC only depends on the capture and the code: every pass must
+ * give the same one, and -x checks it against a known value, which makes a
+ * field capture a regression test. As fast as possible it measures
+ * throughput, with -r it keeps the original pace and reports how late ticks
+ * were delivered.
+ *
+ * record makes a capture on the host: the real drivers on the port
+ * stand-ins, a synthetic pressure trace with a front and I2C glitches, the
+ * executor on a virtual clock and a capture hook like the firmware's.
+ *
+ * ### Example
+ * ~~~
+ * replay record -s 3600 synth.cap                  # an hour at the default rate
+ * replay run field.cap                             # as fast as possible
+ * replay run -r field.cap                          # at the original pace
+ * replay run -n 20 -o field.BIN -x 0x1c2b3a49 field.cap
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "port.h"
+#include "crc/crc32.h"
+#include "logger/logger.h"
+#include "pipeline/pipeline.h"
+#include "sensor/sensor.h"
+#include "sensor/sensor_drivers.h"
+
+#define TICK_US (CONFIG_LOGGER_SAMPLE_PERIOD_MS * 1000 / PIPELINE_OVERSAMPLE)
+#define GLITCH_EVERY 997 /* record: ticks between I2C failures */
+#define PI 3.14159265358979323846
+
+/* Sensor table of main.c, APP_SENSOR_TABLE */
+enum
+{
+    SENSOR_RTC,
+    SENSOR_PRESSURE,
+    SENSOR_BATTERY,
+    SENSOR_COUNT
+};
+
+static i2c_sensor_t rtc_device;
+static i2c_sensor_t pressure_device;
+static battery_t battery_device;
+
+static const sensor_t sensors[] = {
+    {&ds3231_sensor, &rtc_device, CONFIG_LOGGER_RTC_SYNC_SAMPLES * PIPELINE_OVERSAMPLE},
+    {&bmp180_sensor, &pressure_device, 1},
+    {&battery_sensor, &battery_device, PIPELINE_OVERSAMPLE},
+};
+
+static const channel_policy_t policies[] = {CHANNEL_DROP_OLDEST, CHANNEL_COALESCE, CHANNEL_DROP_OLDEST};
+static const TickType_t timeouts[] = {0, 0, 0};
+
+/**
+ * @struct replay_t
+ * @brief Executor, sample path and log sink of one pass
+ */
+typedef struct
+{
+    sensor_exec_t exec;
+    pipeline_t pipeline;
+    channel_t channels[SENSOR_COUNT];
+    sensor_sample_t items[SENSOR_COUNT][QUEUE_SIZE];
+    log_sink_t sink;  /* the logger's, counts and forwards to file */
+    log_sink_t file;  /* log file, valid with out */
+    bool out;         /* writing a log file */
+    uint32_t crc;     /* of every written block */
+    uint32_t blocks;  /* written blocks */
+} replay_t;
+
+/**
+ * @struct capture_file_t
+ * @brief Capture loaded into memory, so file reads stay out of the timing
+ */
+typedef struct
+{
+    uint8_t *data;
+    size_t size;   /* valid bytes */
+    size_t total;  /* file size */
+    uint32_t count; /* records */
+} capture_file_t;
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Storage: the sink of sdcardTask */
+
+static esp_err_t replay_write(void *ctx, const log_block_t *blocks, size_t count)
+{
+    replay_t *r = ctx;
+
+    r->crc = crc32_update(r->crc, blocks, count * sizeof(*blocks));
+    r->blocks += count;
+    return r->out ? r->file.write(r->file.ctx, blocks, count) : ESP_OK;
+}
+
+static esp_err_t replay_sync(void *ctx)
+{
+    replay_t *r = ctx;
+
+    return r->out ? r->file.sync(r->file.ctx) : ESP_OK;
+}
+
+static int replay_init(replay_t *r, const char *output)
+{
+    memset(r, 0, sizeof(*r));
+    r->exec = (sensor_exec_t){
+        .sensors = sensors,
+        .count = SENSOR_COUNT,
+        .emit = pipeline_push,
+        .arg = &r->pipeline,
+    };
+    for (size_t i = 0; i < SENSOR_COUNT; i++)
+    {
+        stats_reset(&r->exec.status[i].latency);
+        channel_init(&r->channels[i], r->items[i], QUEUE_SIZE, policies[i]);
+    }
+    r->pipeline = (pipeline_t){
+        .sensors = sensors,
+        .channels = r->channels,
+        .timeouts = timeouts,
+        .count = SENSOR_COUNT,
+        .rtc = SENSOR_RTC,
+        .pressure = SENSOR_PRESSURE,
+        .battery = SENSOR_BATTERY,
+    };
+    pipeline_init(&r->pipeline);
+    logger_init();
+    r->sink = (log_sink_t){.ctx = r, .write = replay_write, .sync = replay_sync};
+    if (output != NULL)
+    {
+        if (logger_file_sink(&r->file, output) != ESP_OK)
+        {
+            perror(output);
+            return -1;
+        }
+        r->out = true;
+    }
+
+    /* The battery decode converts with the divider and ADC settings */
+    battery_default(&battery_device);
+    return 0;
+}
+
+/* dataTask, then the writer of sdcardTask, once a tick's samples are queued */
+static void replay_drain(replay_t *r)
+{
+    pipeline_drain(&r->pipeline);
+    logger_step(&r->sink);
+}
+
+static void replay_finish(replay_t *r)
+{
+    logger_stats_t stats;
+
+    replay_drain(r);
+    logger_flush();
+
+    /* Let the writer's deadlines pass on the virtual clock until every block is written */
+    logger_get_stats(&stats);
+    while (stats.available < LOGGER_POOL_BLOCKS)
+    {
+        uint32_t wait = logger_step(&r->sink);
+        if (wait == FLUSH_WAIT_FOREVER)
+        {
+            break;
+        }
+        port_time_us += ((int64_t)wait + 1) * 1000;
+        logger_get_stats(&stats);
+    }
+    if (r->out)
+    {
+        logger_file_close(&r->file);
+    }
+}
+
+/* Capture files */
+
+static int capture_load(capture_file_t *file, const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    file->data = malloc(length > 0 ? (size_t)length : 1);
+    file->total = fread(file->data, 1, length > 0 ? (size_t)length : 0, f);
+    fclose(f);
+
+    /* Stop at the first record that cannot be one, a cut or garbled tail */
+    size_t at = 0;
+    file->count = 0;
+    while (at + sizeof(sensor_capture_t) <= file->total)
+    {
+        sensor_capture_t capture;
+        memcpy(&capture, file->data + at, sizeof(capture));
+        bool ok = capture.result == SENSOR_CAPTURE_OK ? capture.size > 0 && capture.size <= SENSOR_RAW_MAX
+                                                      : capture.result <= SENSOR_CAPTURE_READ_FAILED && capture.size == 0;
+        if (!ok || at + sizeof(capture) + capture.size > file->total)
+        {
+            break;
+        }
+        at += sizeof(capture) + capture.size;
+        file->count++;
+    }
+    file->size = at;
+    return 0;
+}
+
+static void print_stats(const char *what, const stats_t *stats)
+{
+    if (stats->count == 0)
+    {
+        printf("%-24s -\n", what);
+        return;
+    }
+    printf("%-24s mean %" PRId64 " us, max %" PRId64 " us\n", what, stats_mean(stats), stats->max);
+}
+
+static int cmd_run(const char *path, const char *output, uint32_t passes, bool realtime, bool check, uint32_t expect)
+{
+    capture_file_t file;
+    if (capture_load(&file, path) != 0)
+    {
+        return 1;
+    }
+    if (file.count == 0)
+    {
+        fprintf(stderr, "%s: no capture records\n", path);
+        return 1;
+    }
+
+    sensor_capture_t first, last = {0};
+    memcpy(&first, file.data, sizeof(first));
+    int64_t first_tick = first.tick_us;
+    int64_t span_us = 0;
+
+    static replay_t replay;
+    replay_t *r = &replay;
+    uint32_t digest = 0;
+    uint32_t unmatched = 0;
+    bool repeatable = true;
+    stats_t lateness;
+    stats_reset(&lateness);
+    double best = 0;
+
+    for (uint32_t pass = 0; pass < passes; pass++)
+    {
+        if (replay_init(r, pass == 0 ? output : NULL) != 0)
+        {
+            return 1;
+        }
+        port_time_us = first.tick_us;
+        unmatched = 0;
+
+        double start = now_s();
+        uint32_t tick_seq = first.seq;
+        for (size_t at = 0; at < file.size;)
+        {
+            sensor_capture_t capture;
+            memcpy(&capture, file.data + at, sizeof(capture));
+            const uint8_t *raw = file.data + at + sizeof(capture);
+            at += sizeof(capture) + capture.size;
+
+            if (capture.seq != tick_seq)
+            {
+                replay_drain(r);
+                tick_seq = capture.seq;
+                port_time_us = capture.tick_us;
+                if (realtime)
+                {
+                    double due = start + (double)(capture.tick_us - first_tick) * 1e-6;
+                    double wait = due - now_s();
+                    if (wait > 0)
+                    {
+                        struct timespec ts = {(time_t)wait, (long)((wait - (double)(time_t)wait) * 1e9)};
+                        nanosleep(&ts, NULL);
+                    }
+                    stats_add(&lateness, (int64_t)((now_s() - due) * 1e6));
+                }
+            }
+            if (sensor_exec_replay(&r->exec, &capture, raw) != 0)
+            {
+                unmatched++;
+            }
+            last = capture;
+        }
+        replay_finish(r);
+        double elapsed = now_s() - start;
+        span_us = last.tick_us - first_tick;
+        if (pass == 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+        if (pass == 0)
+        {
+            digest = r->crc;
+        }
+        repeatable = repeatable && r->crc == digest;
+    }
+
+    printf("%s: %" PRIu32 " accesses over %.1f s", path, file.count, (double)span_us * 1e-6);
+    if (file.size < file.total)
+    {
+        printf(", %zu trailing bytes ignored", file.total - file.size);
+    }
+    printf("\n\n%-10s %10s %8s %10s %10s %10s %10s\n", "sensor", "samples", "errors", "enqueued", "coalesced",
+           "dropped", "latency us");
+    for (size_t i = 0; i < SENSOR_COUNT; i++)
+    {
+        const sensor_status_t *status = &r->exec.status[i];
+        const channel_stats_t *channel = &r->channels[i].stats;
+        printf("%-10s %10" PRIu32 " %8" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRId64 "\n",
+               sensors[i].driver->name, status->samples, status->errors, channel->enqueued, channel->coalesced,
+               channel->dropped, status->latency.count ? stats_mean(&status->latency) : 0);
+    }
+    if (unmatched > 0)
+    {
+        printf("%" PRIu32 " accesses do not fit the sensor table, captured with another configuration?\n", unmatched);
+    }
+    const pipeline_t *p = &r->pipeline;
+    logger_stats_t logger;
+    logger_get_stats(&logger);
+    printf("\nrate: %" PRIu32 " period changes, last period %" PRIu32 " ms\n", p->rate.changes, p->rate.period_ms);
+    printf("log: %" PRIu32 " samples, %" PRIu32 " rate records, %" PRIu32 " blocks, crc 0x%08" PRIx32 "%s%s\n",
+           p->samples, p->rates, r->blocks, digest, output ? " in " : "", output ? output : "");
+    printf("logger: %" PRIu32 " writes, %" PRIu32 " syncs, %" PRIu32 " partial blocks, %" PRIu32
+           " records not stored, %u blocks free at least\n",
+           logger.writes, logger.syncs, logger.partial, p->unstored, logger.low);
+
+    uint32_t accesses = file.count;
+    printf("\n%-24s %.3f ms%s\n", "replay", best * 1e3, passes > 1 ? ", best pass" : "");
+    printf("%-24s %.0f accesses/s, %.0f ns per access, %.0f records/s\n", "throughput", accesses / best,
+           best * 1e9 / accesses, (p->samples + p->rates) / best);
+    printf("%-24s %.1fx real time\n", "speed", span_us > 0 ? (double)span_us * 1e-6 / best : 0.0);
+    if (realtime)
+    {
+        print_stats("tick lateness", &lateness);
+    }
+
+    bool ok = repeatable && p->unstored == 0 && (!check || digest == expect);
+    if (!repeatable)
+    {
+        printf("passes gave different logs\n");
+    }
+    if (p->unstored > 0)
+    {
+        printf("the logger ran out of blocks\n");
+    }
+    if (check && digest != expect)
+    {
+        printf("crc 0x%08" PRIx32 ", expected 0x%08" PRIx32 "\n", digest, expect);
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    free(file.data);
+    return ok ? 0 : 1;
+}
+
+/* Synthetic capture */
+
+static uint64_t rng_state = 0x2545F4914F6CDD1Dull;
+static int64_t clock_us; /* Virtual time */
+
+static double uniform(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (double)(rng_state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double gaussian(void)
+{
+    return sqrt(-2.0 * log(1.0 - uniform())) * cos(2.0 * PI * uniform());
+}
+
+static void record_capture(void *arg, const sensor_capture_t *capture, const void *raw)
+{
+    FILE *out = arg;
+
+    fwrite(capture, sizeof(*capture), 1, out);
+    fwrite(raw, 1, capture->size, out);
+}
+
+static void record_emit(void *arg, const sensor_sample_t *sample)
+{
+    (void)arg;
+    (void)sample;
+}
+
+static void record_wait(void *arg, uint32_t us)
+{
+    (void)arg;
+    clock_us += us;
+}
+
+static int64_t record_now(void *arg)
+{
+    (void)arg;
+    return clock_us;
+}
+
+static int cmd_record(const char *path, uint32_t seconds)
+{
+    FILE *out = fopen(path, "wb");
+    if (out == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+
+    static sensor_exec_t exec;
+    exec = (sensor_exec_t){
+        .sensors = sensors,
+        .count = SENSOR_COUNT,
+        .emit = record_emit,
+        .wait_us = record_wait,
+        .now_us = record_now,
+        .capture = record_capture,
+        .arg = out,
+    };
+    int64_t start_time = port_sensors.time;
+    i2cdev_init();
+    if (sensor_exec_init(&exec) != SENSOR_COUNT)
+    {
+        fprintf(stderr, "sensor init failed\n");
+        fclose(out);
+        return 1;
+    }
+
+    /* Tide, a front halfway dropping 250 Pa over 20 minutes with gusts, 5 Pa noise */
+    uint32_t ticks = (uint32_t)((uint64_t)seconds * 1000000 / TICK_US);
+    for (uint32_t seq = 0; seq < ticks; seq++)
+    {
+        int64_t tick_us = (int64_t)seq * TICK_US;
+        double t = (double)tick_us * 1e-6;
+        double front = (t - seconds / 2.0) / 600.0;
+        double gust = fabs(front) < 1.0 ? 20.0 * sin(2.0 * PI * t / 7.0) : 0.0;
+        double pressure = 101325.0 + 80.0 * sin(2.0 * PI * t / 43200.0) - 125.0 * (1.0 + tanh(front)) + gust;
+
+        clock_us = tick_us;
+        port_sensors.pressure = (uint32_t)lround(pressure + 5.0 * gaussian());
+        port_sensors.temperature = (float)(21.5 + 2.0 * sin(2.0 * PI * t / 86400.0));
+        port_sensors.time = start_time + (int64_t)t;
+        port_sensors.fail = seq % GLITCH_EVERY == GLITCH_EVERY - 1;
+        port_adc_raw = 2300 - (int)(t / 60.0);
+        sensor_exec_tick(&exec, seq, tick_us);
+    }
+    port_sensors.fail = false;
+
+    long size = ftell(out);
+    fclose(out);
+    printf("%s: %" PRIu32 " ticks, %ld bytes, %u s\n", path, ticks, size, (unsigned)seconds);
+    for (size_t i = 0; i < SENSOR_COUNT; i++)
+    {
+        printf("%-10s %8" PRIu32 " samples %6" PRIu32 " errors\n", sensors[i].driver->name, exec.status[i].samples,
+               exec.status[i].errors);
+    }
+    return 0;
+}
+
+static void usage(void)
+{
+    fputs("usage:\n"
+          "  replay record [-s seconds] capture\n"
+          "                                   synthetic capture from the drivers on the host stand-ins\n"
+          "  replay run [-r] [-n passes] [-o log] [-x crc] capture\n"
+          "                                   replay through the pipeline, -r at the original pace,\n"
+          "                                   -o writes the log, -x checks its crc\n",
+          stderr);
+}
+
+int main(int argc, char **argv)
+{
+    const char *capture = NULL;
+    const char *output = NULL;
+    uint32_t seconds = 3600;
+    uint32_t passes = 1;
+    bool realtime = false;
+    bool check = false;
+    uint32_t expect = 0;
+
+    if (argc < 3)
+    {
+        usage();
+        return 2;
+    }
+    for (int i = 2; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc)
+        {
+            seconds = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+        {
+            passes = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-x") && i + 1 < argc)
+        {
+            check = true;
+            expect = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (!strcmp(argv[i], "-r"))
+        {
+            realtime = true;
+        }
+        else
+        {
+            capture = argv[i];
+        }
+    }
+    if (capture == NULL || passes == 0)
+    {
+        usage();
+        return 2;
+    }
+
+    const char *command = argv[1];
+    if (!strcmp(command, "record") && seconds > 0)
+    {
+        return cmd_record(capture, seconds);
+    }
+    if (!strcmp(command, "run"))
+    {
+        return cmd_run(capture, output, passes, realtime, check, expect);
+    }
+    usage();
+    return 2;
+}
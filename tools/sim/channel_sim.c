@@ -0,0 +1,199 @@
+/**
+ * @file channel_sim.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sensor channel overflow policies under a stalled consumer
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * One channel per policy gets a sample every tick. The consumer takes up to
+ * a few samples per tick, except during stalls. CHANNEL_BLOCK producers
+ * wait up to their timeout, measured in ticks, for the consumer to make room.
+ * Checks per channel:
+ *
+ * - every sample is consumed, dropped or coalesced, exactly once
+ * - everything enqueued is consumed, unless drop-oldest evicted it later
+ * - consumed samples come out in order and the policy kept the right ones
+ * - aggregates average exactly the samples folded into them, or once their
+ *   merge count saturates, stay within the ticks they could have folded in
+ *
+ * ### Example
+ * ~~~
+ * channel_sim                 # 100000 ticks
+ * channel_sim 1000000 10 50   # 1M ticks, queue of 10, stalls of 50 ticks
+ * channel_sim 300000 10 100000 # stalls long enough to saturate the merge count
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sensor/channel.h"
+
+#define POLICIES 4
+#define BLOCK_TIMEOUT 3 /* ticks */
+
+typedef struct
+{
+    channel_t channel;
+    sensor_sample_t items[256];
+    uint32_t produced;
+    uint32_t consumed;
+    uint32_t last_seq;       /* seq of the last consumed sample */
+    uint32_t disorder;       /* consumed out of order */
+    uint32_t wrong_mean;     /* aggregate value not the mean of its seqs */
+    uint32_t saturated;      /* aggregates with a saturated merge count */
+    uint32_t lost_newest;    /* drop-oldest: newest sample not at the tail after a push */
+    uint32_t pending;        /* CHANNEL_BLOCK: seq waiting for room, UINT32_MAX if none */
+    uint32_t pending_since;
+} lane_t;
+
+static uint32_t rng = 1;
+static uint32_t span; /* Most ticks one aggregate can fold in: a stall plus the queue */
+
+static uint32_t next_random(void)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static void consume(lane_t *lane, const sensor_sample_t *sample)
+{
+    if (lane->consumed > 0 && sample->seq <= lane->last_seq)
+    {
+        lane->disorder++;
+    }
+    /* Values are the seq; an aggregate of seqs a..b has the mean of a..b (consecutive) */
+    if (sample->merged == UINT16_MAX)
+    {
+        lane->saturated++;
+        lane->wrong_mean += sample->value[0] > (int64_t)sample->seq || sample->value[0] < (int64_t)sample->seq - span;
+    }
+    else if (sample->merged > 0)
+    {
+        int64_t first = (int64_t)sample->seq - sample->merged;
+        int64_t mean = (first + sample->seq) / 2;
+        int64_t error = sample->value[0] - mean;
+        lane->wrong_mean += error > 1 || error < -1;
+    }
+    lane->last_seq = sample->seq;
+    lane->consumed++;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ticks = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 100000;
+    uint16_t length = argc > 2 ? (uint16_t)strtoul(argv[2], NULL, 10) : 10;
+    uint32_t stall = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : 30;
+    static lane_t lanes[POLICIES];
+    uint32_t stalled = 0, stalls = 0;
+
+    if (length == 0 || length > 256)
+    {
+        fprintf(stderr, "queue length 1..256\n");
+        return 2;
+    }
+    for (int p = 0; p < POLICIES; p++)
+    {
+        channel_init(&lanes[p].channel, lanes[p].items, length, (channel_policy_t)p);
+        lanes[p].pending = UINT32_MAX;
+    }
+
+    span = stall + length;
+    uint32_t stall_left = 0;
+    for (uint32_t tick = 0; tick < ticks; tick++)
+    {
+        /* Producer */
+        for (int p = 0; p < POLICIES; p++)
+        {
+            lane_t *lane = &lanes[p];
+            sensor_sample_t sample = {.sensor = (uint8_t)p, .count = 1, .seq = tick, .value = {(int32_t)tick}};
+
+            /* A blocked producer retries first and gives up after its timeout */
+            if (lane->pending != UINT32_MAX)
+            {
+                sensor_sample_t retry = {.sensor = (uint8_t)p, .count = 1, .seq = lane->pending,
+                                         .value = {(int32_t)lane->pending}};
+                if (channel_push(&lane->channel, &retry) == CHANNEL_FULL)
+                {
+                    if (tick - lane->pending_since < BLOCK_TIMEOUT)
+                    {
+                        continue; /* still blocked, this tick's sample is not produced yet */
+                    }
+                    channel_timeout(&lane->channel);
+                }
+                lane->pending = UINT32_MAX;
+            }
+
+            lane->produced++;
+            channel_t *channel = &lane->channel;
+            if (channel_push(channel, &sample) == CHANNEL_FULL)
+            {
+                lane->pending = tick;
+                lane->pending_since = tick;
+            }
+            if (p == CHANNEL_DROP_OLDEST && channel->items[(channel->head + channel->count - 1) % channel->length].seq != tick)
+            {
+                lane->lost_newest++;
+            }
+        }
+
+        /* Consumer: random stalls, otherwise up to 3 samples per tick */
+        if (stall_left == 0 && next_random() % 1000 < 5)
+        {
+            stall_left = stall;
+            stalls++;
+        }
+        if (stall_left > 0)
+        {
+            stall_left--;
+            stalled++;
+            continue;
+        }
+        for (int p = 0; p < POLICIES; p++)
+        {
+            sensor_sample_t sample;
+            for (uint32_t n = 1 + next_random() % 3; n > 0 && channel_pop(&lanes[p].channel, &sample); n--)
+            {
+                consume(&lanes[p], &sample);
+            }
+        }
+    }
+
+    /* Blocked producers abandon their sample, then drain */
+    int ok = 1;
+    printf("%" PRIu32 " ticks, queue %u, %" PRIu32 " stalls of %" PRIu32 " ticks (%.1f%% stalled)\n\n", ticks,
+           length, stalls, stall, 100.0 * stalled / ticks);
+    printf("%-12s %9s %9s %9s %9s %9s %5s %9s %s\n", "policy", "produced", "enqueued", "dropped", "coalesced",
+           "consumed", "high", "saturated", "checks");
+    for (int p = 0; p < POLICIES; p++)
+    {
+        lane_t *lane = &lanes[p];
+        sensor_sample_t sample;
+
+        if (lane->pending != UINT32_MAX)
+        {
+            channel_timeout(&lane->channel); /* produced when first pushed */
+        }
+        while (channel_pop(&lane->channel, &sample))
+        {
+            consume(lane, &sample);
+        }
+
+        const channel_stats_t *stats = &lane->channel.stats;
+        int accounted = lane->consumed + stats->dropped + stats->coalesced == lane->produced;
+        int delivered = lane->consumed + (p == CHANNEL_DROP_OLDEST ? stats->dropped : 0) == stats->enqueued;
+        int ordered = lane->disorder == 0 && lane->wrong_mean == 0 && lane->lost_newest == 0;
+        int bounded = stats->high_water <= length;
+        int lane_ok = accounted && delivered && ordered && bounded;
+        ok &= lane_ok;
+        printf("%-12s %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %5u %9" PRIu32 " %s%s%s%s%s\n",
+               channel_policy_name((channel_policy_t)p), lane->produced, stats->enqueued, stats->dropped,
+               stats->coalesced, lane->consumed, stats->high_water, lane->saturated, lane_ok ? "ok" : "FAIL",
+               accounted ? "" : " accounting", delivered ? "" : " delivery", ordered ? "" : " order",
+               bounded ? "" : " bound");
+    }
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
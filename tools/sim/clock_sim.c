@@ -0,0 +1,416 @@
+/**
+ * @file clock_sim.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Sampling clock policies against the task dispatched esp_timer
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A 1 MHz timer ticks every PERIOD_US. Its interrupt comes a few us after
+ * the trigger edge, or after the end of a flash write holding interrupts
+ * off. The sampling task wakes on the notification and reads the sensors
+ * for about 13 ms, now and then for a few periods more. Halfway through the
+ * period doubles, changed while an alarm is signalled but not yet handled.
+ *
+ * The same environment runs the old esp_timer: callbacks in the esp_timer
+ * task, sometimes queued behind another callback, every missed period run
+ * back to back, a notification value overwritten while the task is busy and
+ * the reading stamped with the callback time.
+ *
+ * "woken, no flash" is the trigger edge to read delay of the ticks the task
+ * was idle for, with no flash write in between: the jitter of the dispatch
+ * path itself.
+ *
+ * Checks per sample_clock_t policy:
+ *
+ * - every grid tick is read, missed, dropped or still queued, exactly once
+ * - ticks are read in order, CATCH_UP misses none
+ * - stamps stay on the grid, RESYNC only moves it later
+ * - an alarm signalled before a period change is ignored
+ *
+ * ### Example
+ * ~~~
+ * clock_sim                 # 100000 ticks
+ * clock_sim 1000000 60 7    # 1M ticks, flash writes up to 60 ms, seed 7
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "stats/stats.h"
+#include "timer/sample_clock.h"
+
+#define PERIOD_US 15625     /* 125 ms sample period, 8 pressure reads per sample */
+#define OFFSET_US 1000000   /* esp_timer time at counter 0 */
+#define READ_US 12500       /* sensor reads per tick, plus up to 1 ms */
+#define MAX_HOLDS 65536
+#define VARIANTS 4          /* esp_timer, then the sample_clock_t policies */
+
+typedef struct
+{
+    uint64_t start;
+    uint64_t end;
+} hold_t;
+
+typedef struct
+{
+    uint32_t reads;
+    uint32_t missed;
+    uint32_t dropped;
+    uint32_t backlog;  /* reads started as soon as the one before ended */
+    uint32_t late;     /* reads started more than 1 ms after their trigger edge */
+    stats_t latency;   /* trigger edge to handler */
+    stats_t delay;     /* trigger edge to sensor reads */
+    stats_t woken;     /* the same, task woken for the tick outside a flash write */
+    bool ok;
+    const char *failed;
+} result_t;
+
+static hold_t holds[MAX_HOLDS];
+static size_t hold_count;
+static uint32_t rng;
+
+static uint32_t next_random(void)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static uint32_t uniform(uint32_t lo, uint32_t hi)
+{
+    return lo + next_random() % (hi - lo + 1);
+}
+
+/* Flash writes: interrupts and the sampling task held off, every 40 to 120 periods */
+static void make_holds(uint64_t end, uint32_t max_us, uint32_t seed)
+{
+    rng = seed;
+    hold_count = 0;
+    for (uint64_t t = (uint64_t)PERIOD_US * 40; t < end && hold_count < MAX_HOLDS; hold_count++)
+    {
+        t += (uint64_t)PERIOD_US * uniform(40, 120);
+        holds[hold_count] = (hold_t){t, t + uniform(1000, max_us)};
+        t = holds[hold_count].end;
+    }
+}
+
+/**
+ * @brief First instant at or after t outside the flash writes
+ *
+ * @param cursor    per caller, the times it asks for never decrease
+ */
+static uint64_t after_holds(size_t *cursor, uint64_t t)
+{
+    while (*cursor < hold_count && holds[*cursor].end <= t)
+    {
+        (*cursor)++;
+    }
+    if (*cursor < hold_count && holds[*cursor].start <= t)
+    {
+        return holds[*cursor].end;
+    }
+    return t;
+}
+
+/**
+ * @brief Whether a flash write overlaps [from, to]
+ *
+ * @param cursor    per caller, the from times it asks for never decrease
+ */
+static bool held_between(size_t *cursor, uint64_t from, uint64_t to)
+{
+    while (*cursor < hold_count && holds[*cursor].end <= from)
+    {
+        (*cursor)++;
+    }
+    return *cursor < hold_count && holds[*cursor].start <= to;
+}
+
+static uint32_t isr_latency(void)
+{
+    return uniform(2, 8);
+}
+
+static uint32_t wake_latency(void)
+{
+    return uniform(5, 15);
+}
+
+static uint32_t read_time(void)
+{
+    /* A sensor retry or bus timeout now and then */
+    uint32_t overrun = next_random() % 1000 < 3 ? PERIOD_US * uniform(1, 3) : 0;
+    return READ_US + uniform(0, 1000) + overrun;
+}
+
+/**
+ * @brief Count a read of the tick triggered at edge
+ *
+ * @param cursor    flash write cursor of the edges
+ * @param woke      the task was woken for this tick rather than busy
+ */
+static void account_read(result_t *r, size_t *cursor, int64_t edge, int64_t start, bool woke)
+{
+    int64_t delay = start - edge;
+    stats_add(&r->delay, delay);
+    if (!woke)
+    {
+        r->backlog++;
+    }
+    else if (!held_between(cursor, (uint64_t)edge, (uint64_t)start))
+    {
+        stats_add(&r->woken, delay);
+    }
+    r->late += delay > 1000;
+    r->reads++;
+}
+
+static void fail(result_t *r, const char *what)
+{
+    if (r->ok)
+    {
+        r->ok = false;
+        r->failed = what;
+    }
+}
+
+/**
+ * @brief The old timer: esp_timer periodic, ESP_TIMER_TASK, skip_unhandled_events = false
+ */
+static result_t run_esp_timer(uint64_t end, uint32_t seed)
+{
+    result_t r = {.ok = true};
+    size_t isr_cursor = 0, task_cursor = 0, edge_cursor = 0;
+    uint64_t period = PERIOD_US, alarm = 0;
+    uint64_t task_free = 0;  /* esp_timer task */
+    uint64_t reader = 0;     /* sampling task free from */
+    bool idle = true, woke = false, pending = false, changed = false;
+    int64_t pending_edge = 0;
+
+    rng = seed;
+    while (alarm < end)
+    {
+        /* Interrupt, then the esp_timer task, sometimes behind another callback */
+        uint64_t dispatch = after_holds(&isr_cursor, alarm) + isr_latency() + uniform(15, 40);
+        if (next_random() % 100 < 3)
+        {
+            dispatch += uniform(200, 2500);
+        }
+        uint64_t callback = dispatch > task_free ? dispatch : task_free;
+        task_free = callback + 5;
+        stats_add(&r.latency, (int64_t)(callback - alarm));
+
+        /* The sampling task reads what it was notified of before this callback */
+        while (!idle && reader < callback)
+        {
+            reader = after_holds(&task_cursor, reader);
+            if (reader >= callback)
+            {
+                break;
+            }
+            if (!pending)
+            {
+                idle = true;
+                break;
+            }
+            pending = false;
+            account_read(&r, &edge_cursor, pending_edge, (int64_t)reader, woke);
+            woke = false;
+            reader += read_time();
+        }
+
+        /* eSetValueWithOverwrite: a notification not yet taken is lost */
+        if (pending)
+        {
+            r.missed++;
+        }
+        pending = true;
+        pending_edge = (int64_t)alarm;
+        if (idle)
+        {
+            idle = false;
+            woke = true;
+            reader = callback + wake_latency();
+        }
+
+        /* esp_timer_restart from dataTask, the period doubles */
+        if (!changed && alarm >= end / 2)
+        {
+            period *= 2;
+            alarm = callback + period;
+            changed = true;
+            continue;
+        }
+        alarm += period;
+    }
+    return r;
+}
+
+/**
+ * @brief The hardware timer running a sample_clock_t
+ */
+static result_t run_sample_clock(sample_clock_policy_t policy, uint64_t end, uint32_t seed)
+{
+    result_t r = {.ok = true};
+    sample_clock_t clock;
+    size_t isr_cursor = 0, task_cursor = 0, edge_cursor = 0;
+    uint64_t reader = 0;
+    bool idle = true, woke = false, changed = false;
+    uint32_t change_seq = 0, last_seq = 0;
+    int64_t ref_time = 0;
+    uint32_t ref_seq = 0;
+    bool have_ref = false;
+
+    rng = seed;
+    sample_clock_init(&clock, PERIOD_US, policy);
+    uint64_t alarm = sample_clock_start(&clock, 0);
+    while (alarm < end)
+    {
+        uint64_t entry = after_holds(&isr_cursor, alarm) + isr_latency();
+
+        /* The sampling task reads the queued ticks it gets to before this interrupt */
+        while (!idle && reader < entry)
+        {
+            reader = after_holds(&task_cursor, reader);
+            if (reader >= entry)
+            {
+                break;
+            }
+            sample_clock_tick_t tick;
+            if (!sample_clock_take(&clock, &tick))
+            {
+                idle = true;
+                break;
+            }
+            int64_t edge = tick.time_us - OFFSET_US;
+            stats_add(&r.latency, tick.latency_us);
+            if (r.reads > 0 && tick.seq <= last_seq)
+            {
+                fail(&r, "order");
+            }
+            if (policy == SAMPLE_CLOCK_CATCH_UP && r.reads > 0 && tick.seq != last_seq + 1 && clock.dropped == 0)
+            {
+                fail(&r, "catch-up gap");
+            }
+
+            /* Grid check from the first tick of each period */
+            uint32_t period = tick.seq < change_seq || !changed ? PERIOD_US : PERIOD_US * 2;
+            if (!have_ref || (changed && ref_seq < change_seq && tick.seq >= change_seq))
+            {
+                ref_seq = tick.seq;
+                ref_time = edge;
+                have_ref = true;
+            }
+            int64_t grid = ref_time + (int64_t)(tick.seq - ref_seq) * period;
+            if (policy == SAMPLE_CLOCK_RESYNC ? edge < grid : edge != grid)
+            {
+                fail(&r, "grid");
+            }
+            if (policy == SAMPLE_CLOCK_RESYNC)
+            {
+                ref_seq = tick.seq;
+                ref_time = edge;
+            }
+            last_seq = tick.seq;
+            account_read(&r, &edge_cursor, edge, (int64_t)reader, woke);
+            woke = false;
+            reader += read_time();
+        }
+
+        /* Period change with this alarm signalled, its interrupt not yet run */
+        if (!changed && alarm >= end / 2)
+        {
+            uint32_t fired = clock.fired, head = clock.head;
+            uint64_t due = sample_clock_set_period(&clock, PERIOD_US * 2, alarm + 1);
+            change_seq = clock.seq;
+            changed = true;
+            if (entry + SAMPLE_CLOCK_MARGIN_US < due)
+            {
+                if (sample_clock_fire(&clock, entry, (int64_t)entry + OFFSET_US) != due || clock.fired != fired ||
+                    clock.head != head)
+                {
+                    fail(&r, "stale alarm");
+                }
+            }
+            alarm = due;
+            continue;
+        }
+
+        uint32_t head = clock.head;
+        alarm = sample_clock_fire(&clock, entry, (int64_t)entry + OFFSET_US);
+        if (alarm < entry + SAMPLE_CLOCK_MARGIN_US)
+        {
+            fail(&r, "alarm in the past");
+        }
+        if (idle && clock.head != head)
+        {
+            idle = false;
+            woke = true;
+            reader = entry + wake_latency();
+        }
+    }
+
+    uint32_t queued = clock.head - clock.tail;
+    r.missed = clock.missed;
+    r.dropped = clock.dropped;
+    if (r.reads + r.missed + r.dropped + queued != clock.seq)
+    {
+        fail(&r, "accounting");
+    }
+    if (policy == SAMPLE_CLOCK_CATCH_UP && r.missed != 0)
+    {
+        fail(&r, "catch-up missed");
+    }
+    return r;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ticks = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 100000;
+    uint32_t hold_ms = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 40;
+    uint32_t seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : 1;
+    static const char *const names[VARIANTS] = {"esp_timer", "skip", "catch-up", "resync"};
+    result_t results[VARIANTS];
+
+    if (ticks < 100 || hold_ms < 1)
+    {
+        fprintf(stderr, "at least 100 ticks and 1 ms flash writes\n");
+        return 2;
+    }
+    uint64_t end = (uint64_t)ticks * PERIOD_US;
+    make_holds(end, hold_ms * 1000, seed);
+
+    results[0] = run_esp_timer(end, seed);
+    results[1] = run_sample_clock(SAMPLE_CLOCK_SKIP, end, seed);
+    results[2] = run_sample_clock(SAMPLE_CLOCK_CATCH_UP, end, seed);
+    results[3] = run_sample_clock(SAMPLE_CLOCK_RESYNC, end, seed);
+
+    int ok = 1;
+    printf("%" PRIu32 " ticks of %u us, period doubled halfway, %zu flash writes up to %" PRIu32 " ms\n\n", ticks,
+           PERIOD_US, hold_count, hold_ms);
+    printf("%-10s %8s %7s %7s %7s %6s %16s %20s %20s %s\n", "", "reads", "missed", "dropped", "backlog", "late",
+           "latency mean/max", "edge to read", "woken, no flash", "checks");
+    printf("%-10s %8s %7s %7s %7s %6s %16s %20s %20s\n", "", "", "", "", "", "", "us", "mean/sd/max us",
+           "mean/sd/max us");
+    for (int v = 0; v < VARIANTS; v++)
+    {
+        result_t *r = &results[v];
+        char latency[32], delay[32], woken[32];
+        snprintf(latency, sizeof(latency), "%" PRId64 "/%" PRId64, stats_mean(&r->latency), r->latency.max);
+        snprintf(delay, sizeof(delay), "%" PRId64 "/%" PRId64 "/%" PRId64, stats_mean(&r->delay),
+                 stats_stddev(&r->delay), r->delay.max);
+        snprintf(woken, sizeof(woken), "%" PRId64 "/%" PRId64 "/%" PRId64, stats_mean(&r->woken),
+                 stats_stddev(&r->woken), r->woken.max);
+        ok &= r->ok;
+        printf("%-10s %8" PRIu32 " %7" PRIu32 " %7" PRIu32 " %7" PRIu32 " %6" PRIu32 " %16s %20s %20s %s%s%s\n",
+               names[v], r->reads, r->missed, r->dropped, r->backlog, r->late, latency, delay, woken,
+               v == 0 ? "-" : (r->ok ? "ok" : "FAIL"), r->ok ? "" : " ", r->ok ? "" : r->failed);
+    }
+    printf("\nesp_timer stamps a reading with its callback time, off by the latency; "
+           "the others with the trigger edge\n");
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
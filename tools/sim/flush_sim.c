@@ -0,0 +1,405 @@
+/**
+ * @file flush_sim.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Flush policies over a battery discharge: writes, data at risk and energy
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Runs the logger's flush decisions (logger/flush_policy.c) against a
+ * simulated block pool from full charge until the cell is empty, once per
+ * policy:
+ *
+ * - immediate  the logger before flush_policy: every full block written at
+ *              once, synced 2 s later
+ * - bulk       FLUSH_BULK limits at any battery level
+ * - eager      FLUSH_EAGER limits at any battery level
+ * - adaptive   FLUSH_POLICY_DEFAULT(), battery and events pick the mode
+ *
+ * Records at risk are the ones a power cut would lose: in RAM, or written
+ * but not synced, since FAT only updates the file size on a sync. Energy
+ * counts the card operations only, from per-call costs below; they drain the
+ * same cell as the base load, so eager policies also shorten the run.
+ * Events are flagged at random; their exposure is the time until every
+ * record logged before them is synced.
+ *
+ * ### Example
+ * ~~~
+ * flush_sim               # 1 record/s, 2000 mAh, 60 mA base load
+ * flush_sim 10 1000 80    # 10 records/s, 1000 mAh, 80 mA
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "logger/logger.h"
+
+#define TICK_MS 100          /* simulation step */
+#define WRITE_MJ 0.8         /* card wake, command and busy wait per write call */
+#define BLOCK_MJ 0.13        /* per 512 byte sector */
+#define SYNC_MJ 2.6          /* FAT and directory entry sector updates */
+#define CELL_MOHM 100        /* internal resistance, sags the reading under the base load */
+#define NOISE_MV 8           /* ADC noise on the battery reading, +- */
+#define EVENT_MEAN_S 1800    /* mean time between flagged events */
+#define LEGACY_SYNC_MS 2000  /* idle time before the old logger synced */
+#define LANES 4
+
+typedef struct
+{
+    uint16_t records;
+    uint32_t first_ms;
+} sim_block_t;
+
+typedef struct
+{
+    const char *name;
+    flush_policy_t policy;
+    bool events; /* calls logger_flag_event() */
+
+    /* Logger */
+    flush_mode_t mode;
+    uint16_t open;
+    uint32_t open_ms;
+    sim_block_t queue[LOGGER_POOL_BLOCKS];
+    uint16_t sealed;
+    uint32_t unsynced_records;
+    bool unsynced;
+    uint32_t written_ms;
+    bool urgent;
+    bool held;
+    uint32_t event_ms;
+
+    /* Battery */
+    double charge_mas;
+
+    /* Results */
+    uint64_t records;
+    uint64_t synced;
+    uint32_t dropped;
+    uint32_t writes;
+    uint32_t syncs;
+    uint32_t blocks;
+    uint32_t partial;
+    double sd_mj;
+    double risk_sum;
+    uint64_t risk_ticks;
+    double low_risk_sum;
+    uint64_t low_ticks;
+    uint32_t risk_max;
+    uint32_t lost_at_cutoff;
+    uint64_t mode_ticks[FLUSH_MODES];
+    uint32_t runtime_ms;
+    uint64_t event_target;
+    uint32_t event_start;
+    bool exposed;
+    uint32_t exposures;
+    double exposure_sum;
+    uint32_t exposure_max;
+} lane_t;
+
+/* Open circuit voltage of a Li-ion cell by state of charge, 0..100 % in 10 % steps */
+static const uint16_t ocv_mv[11] = {3300, 3450, 3550, 3620, 3680, 3730, 3780, 3850, 3950, 4060, 4200};
+
+static uint32_t rng = 1;
+
+static uint32_t next_random(void)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static double cell_mv(double soc)
+{
+    double x = soc * 10.0;
+    int i = x >= 10.0 ? 9 : (int)x;
+    return ocv_mv[i] + (ocv_mv[i + 1] - ocv_mv[i]) * (x - i);
+}
+
+/* battery_percentage(): linear between 3300 and 4200 mV */
+static uint8_t percentage_of(int mv)
+{
+    int percentage = 100 * (mv - 3300) / (4200 - 3300);
+    return (uint8_t)(percentage < 0 ? 0 : percentage > 100 ? 100 : percentage);
+}
+
+static uint32_t at_risk(const lane_t *lane)
+{
+    uint32_t records = lane->open + lane->unsynced_records;
+    for (uint16_t i = 0; i < lane->sealed; i++)
+    {
+        records += lane->queue[i].records;
+    }
+    return records;
+}
+
+static void seal(lane_t *lane)
+{
+    lane->queue[lane->sealed++] = (sim_block_t){lane->open, lane->open_ms};
+    lane->partial += lane->open < LOG_BLOCK_RECORDS;
+    lane->open = 0;
+}
+
+static void produce(lane_t *lane, uint32_t now)
+{
+    if (lane->open == 0)
+    {
+        if (lane->sealed + 1 > LOGGER_POOL_BLOCKS)
+        {
+            lane->dropped++;
+            return;
+        }
+        lane->open_ms = now;
+    }
+    lane->open++;
+    lane->records++;
+    if (lane->open == LOG_BLOCK_RECORDS)
+    {
+        seal(lane);
+        return;
+    }
+    flush_view_t view = {.now_ms = now, .free = LOGGER_POOL_BLOCKS, .open_records = lane->open,
+                         .oldest_ms = lane->open_ms};
+    if (flush_decide(&lane->policy, lane->mode, &view) & FLUSH_SEAL)
+    {
+        seal(lane);
+    }
+}
+
+static void writer(lane_t *lane, uint32_t now)
+{
+    flush_view_t view = {
+        .now_ms = now,
+        .sealed = lane->sealed,
+        .free = (uint16_t)(LOGGER_POOL_BLOCKS - lane->sealed - (lane->open > 0)),
+        .oldest_ms = lane->sealed > 0 ? lane->queue[0].first_ms : 0,
+        .unsynced = lane->unsynced,
+        .written_ms = lane->written_ms,
+        .urgent = lane->urgent,
+    };
+    lane->urgent = false;
+
+    unsigned actions = flush_decide(&lane->policy, lane->mode, &view);
+    if (actions & FLUSH_WRITE)
+    {
+        /* Pool order, so a write call per LOGGER_WRITE_BLOCKS blocks */
+        uint32_t calls = (lane->sealed + LOGGER_WRITE_BLOCKS - 1) / LOGGER_WRITE_BLOCKS;
+        lane->writes += calls;
+        lane->blocks += lane->sealed;
+        lane->sd_mj += calls * WRITE_MJ + lane->sealed * BLOCK_MJ;
+        for (uint16_t i = 0; i < lane->sealed; i++)
+        {
+            lane->unsynced_records += lane->queue[i].records;
+        }
+        lane->sealed = 0;
+        if (!lane->unsynced)
+        {
+            lane->unsynced = true;
+            lane->written_ms = now;
+        }
+    }
+    if (actions & FLUSH_SYNC)
+    {
+        lane->syncs++;
+        lane->sd_mj += SYNC_MJ;
+        lane->synced += lane->unsynced_records;
+        lane->unsynced_records = 0;
+        lane->unsynced = false;
+    }
+}
+
+static void flag_event(lane_t *lane, uint32_t now)
+{
+    if (!lane->exposed)
+    {
+        lane->exposed = true;
+        lane->event_start = now;
+        lane->event_target = lane->records;
+    }
+    if (!lane->events)
+    {
+        return;
+    }
+    /* logger_flag_event() */
+    if (lane->open > 0)
+    {
+        seal(lane);
+    }
+    lane->urgent = true;
+    lane->held = true;
+    lane->event_ms = now;
+}
+
+static void run(lane_t *lane, double rate_hz, double capacity_mah, double base_ma, uint32_t seed)
+{
+    uint32_t record_ms = (uint32_t)(1000.0 / rate_hz);
+    double capacity_mas = capacity_mah * 3600.0;
+    uint32_t next_record = 0;
+    uint32_t next_event = 0;
+
+    rng = seed;
+    lane->charge_mas = capacity_mas;
+    lane->mode = FLUSH_BULK;
+    next_event = (next_random() % (2 * EVENT_MEAN_S)) * 1000;
+
+    for (uint32_t now = 0;; now += TICK_MS)
+    {
+        double soc = lane->charge_mas / capacity_mas;
+        double mv = cell_mv(soc > 0 ? soc : 0);
+
+        /* Battery reading once a second, as dataTask forwards it */
+        if (now % 1000 == 0)
+        {
+            int noise = (int)(next_random() % (2 * NOISE_MV + 1)) - NOISE_MV;
+            int reading = (int)(mv - base_ma * CELL_MOHM / 1000.0) + noise;
+            if (lane->held && now - lane->event_ms >= lane->policy.event_hold_ms)
+            {
+                lane->held = false;
+            }
+            lane->mode = flush_mode(&lane->policy, lane->mode, percentage_of(reading), (uint16_t)reading,
+                                    lane->held);
+        }
+
+        if (now >= next_event)
+        {
+            flag_event(lane, now);
+            next_event = now + (next_random() % (2 * EVENT_MEAN_S) + 1) * 1000;
+        }
+
+        while (next_record <= now)
+        {
+            produce(lane, now);
+            next_record += record_ms;
+        }
+
+        double mj = lane->sd_mj;
+        writer(lane, now);
+
+        /* Event exposure ends once everything logged before it is synced */
+        if (lane->exposed && lane->synced >= lane->event_target)
+        {
+            uint32_t exposure = now - lane->event_start;
+            lane->exposed = false;
+            lane->exposures++;
+            lane->exposure_sum += exposure;
+            lane->exposure_max = exposure > lane->exposure_max ? exposure : lane->exposure_max;
+        }
+
+        uint32_t risk = at_risk(lane);
+        lane->risk_sum += risk;
+        lane->risk_ticks++;
+        lane->risk_max = risk > lane->risk_max ? risk : lane->risk_max;
+        if (soc < 0.10)
+        {
+            lane->low_risk_sum += risk;
+            lane->low_ticks++;
+        }
+        lane->mode_ticks[lane->mode]++;
+
+        /* Base load plus the card, charge = energy / voltage */
+        lane->charge_mas -= base_ma * TICK_MS / 1000.0 + (lane->sd_mj - mj) / (mv / 1000.0);
+        if (lane->charge_mas <= 0)
+        {
+            lane->lost_at_cutoff = risk;
+            lane->runtime_ms = now;
+            return;
+        }
+    }
+}
+
+static flush_policy_t fixed(flush_mode_t mode)
+{
+    flush_policy_t policy = FLUSH_POLICY_DEFAULT();
+    for (int m = 0; m < FLUSH_MODES; m++)
+    {
+        policy.tier[m] = policy.tier[mode];
+    }
+    return policy;
+}
+
+int main(int argc, char **argv)
+{
+    double rate = argc > 1 ? strtod(argv[1], NULL) : 1.0;
+    double capacity = argc > 2 ? strtod(argv[2], NULL) : 2000.0;
+    double base = argc > 3 ? strtod(argv[3], NULL) : 60.0;
+    static lane_t lanes[LANES];
+
+    if (rate <= 0 || rate > 1000.0 / TICK_MS * 10 || capacity <= 0 || base <= 0)
+    {
+        fprintf(stderr, "usage: flush_sim [records/s, up to 100] [mAh] [base mA]\n");
+        return 2;
+    }
+
+    flush_policy_t legacy = FLUSH_POLICY_DEFAULT();
+    for (int m = 0; m < FLUSH_MODES; m++)
+    {
+        legacy.tier[m] = (flush_tier_t){.batch_blocks = 1, .max_age_ms = UINT32_MAX, .sync_ms = LEGACY_SYNC_MS};
+    }
+    lanes[0] = (lane_t){.name = "immediate", .policy = legacy};
+    lanes[1] = (lane_t){.name = "bulk", .policy = fixed(FLUSH_BULK)};
+    lanes[2] = (lane_t){.name = "eager", .policy = fixed(FLUSH_EAGER), .events = true};
+    lanes[3] = (lane_t){.name = "adaptive", .policy = FLUSH_POLICY_DEFAULT(), .events = true};
+
+    printf("%.1f records/s, %.0f mAh, %.0f mA base load, %zu records per block, pool %d blocks\n", rate, capacity,
+           base, (size_t)LOG_BLOCK_RECORDS, LOGGER_POOL_BLOCKS);
+    printf("card costs: write call %.2f mJ, sector %.2f mJ, sync %.2f mJ; event every %d s on average\n\n",
+           WRITE_MJ, BLOCK_MJ, SYNC_MJ, EVENT_MEAN_S);
+    printf("%-10s %8s %8s %8s %8s %9s %7s %8s %9s %9s %8s %9s %9s\n", "policy", "writes", "syncs", "sectors",
+           "partial", "card J", "card %", "hours", "risk avg", "risk low", "risk max", "cutoff", "event s");
+
+    for (int l = 0; l < LANES; l++)
+    {
+        lane_t *lane = &lanes[l];
+        run(lane, rate, capacity, base, 12345);
+
+        double total_j = capacity * 3600.0 * 3.7 / 1000.0;
+        printf("%-10s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %9.1f %7.3f %8.2f %9.1f %9.1f %8" PRIu32
+               " %9" PRIu32 " %4.1f/%-4.0f\n",
+               lane->name, lane->writes, lane->syncs, lane->blocks, lane->partial, lane->sd_mj / 1000.0,
+               100.0 * lane->sd_mj / 1000.0 / total_j, lane->runtime_ms / 3600000.0,
+               lane->risk_sum / lane->risk_ticks, lane->low_ticks ? lane->low_risk_sum / lane->low_ticks : 0.0,
+               lane->risk_max, lane->lost_at_cutoff,
+               lane->exposures ? lane->exposure_sum / lane->exposures / 1000.0 : 0.0,
+               lane->exposure_max / 1000.0);
+    }
+
+    const lane_t *adaptive = &lanes[3];
+    uint64_t ticks = adaptive->risk_ticks;
+    printf("\nadaptive modes: bulk %.1f%%, balanced %.1f%%, eager %.1f%% of the run\n",
+           100.0 * adaptive->mode_ticks[FLUSH_BULK] / ticks, 100.0 * adaptive->mode_ticks[FLUSH_BALANCED] / ticks,
+           100.0 * adaptive->mode_ticks[FLUSH_EAGER] / ticks);
+    printf("risk avg: records a power cut at a random time loses; risk low: same below 10%% charge;\n"
+           "cutoff: records lost when the cell runs empty; event s: mean/max until pre-event records are synced\n\n");
+
+    /* Checks: nothing dropped, adaptive cheaper than writing every block, and as safe as eager when it counts */
+    int ok = 1;
+    for (int l = 0; l < LANES; l++)
+    {
+        if (lanes[l].dropped > 0)
+        {
+            printf("%s: %" PRIu32 " records dropped\n", lanes[l].name, lanes[l].dropped);
+            ok = 0;
+        }
+    }
+    uint32_t eager_records = (uint32_t)(rate * adaptive->policy.tier[FLUSH_EAGER].max_age_ms / 1000.0) + 1;
+    if (adaptive->sd_mj >= lanes[0].sd_mj)
+    {
+        printf("adaptive: card energy not below immediate\n");
+        ok = 0;
+    }
+    if (adaptive->lost_at_cutoff > eager_records)
+    {
+        printf("adaptive: %" PRIu32 " records lost at cutoff, eager bound %" PRIu32 "\n", adaptive->lost_at_cutoff,
+               eager_records);
+        ok = 0;
+    }
+    if (adaptive->exposure_max > TICK_MS)
+    {
+        printf("adaptive: events wait %" PRIu32 " ms for a sync\n", adaptive->exposure_max);
+        ok = 0;
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file join_sim.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Feed the sample join with dropped, reordered, late and duplicated samples
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Two joined sensors and one passthrough sensor tick once per second. A
+ * seeded generator drops, delays and duplicates samples, then the stream is
+ * delivered in arrival order to the join and, for comparison, to the old
+ * "next sample of each queue" pairing. Checks:
+ *
+ * - no row mixes samples of different ticks
+ * - every tick whose samples all arrive in time yields a row
+ * - every joined sample is accounted for as row, late, orphaned or duplicate
+ *
+ * ### Example
+ * ~~~
+ * join_sim              # 100000 ticks, seed 1
+ * join_sim 1000000 7    # 1M ticks, seed 7
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sensor/sample_join.h"
+
+#define SENSORS 3          /* 0 and 1 joined, 2 passes through */
+#define TICK_US 1000000    /* Sampling period */
+#define MAX_AGE_US 3000000 /* Join window */
+
+/* Injection rates in 1/1000 per sample */
+#define DROP 20
+#define REORDER 50 /* arrives 1 or 2 ticks late, inside the window */
+#define LATE 5     /* arrives 6 ticks late, outside the window */
+#define DUPLICATE 5
+
+typedef struct
+{
+    int64_t arrival;
+    sensor_sample_t sample;
+} event_t;
+
+static uint32_t rng = 1;
+
+static uint32_t next_random(void)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static int by_arrival(const void *a, const void *b)
+{
+    const event_t *x = a, *y = b;
+    if (x->arrival != y->arrival)
+    {
+        return x->arrival < y->arrival ? -1 : 1;
+    }
+    return x->sample.sensor - y->sample.sensor;
+}
+
+static uint32_t mixed; /* rows with samples of different ticks */
+
+static void on_row(void *arg, const sample_row_t *row)
+{
+    (void)arg;
+    if (row->sample[0].seq != row->seq || row->sample[1].seq != row->seq)
+    {
+        mixed++;
+    }
+}
+
+/**
+ * @brief Run one scenario
+ *
+ * @param key       join key
+ * @param jitter_us per sensor stamp jitter, exercises SAMPLE_JOIN_TIME
+ * @return int 1 pass
+ */
+static int run(uint32_t ticks, sample_join_key_t key, int64_t jitter_us)
+{
+    event_t *events = malloc(sizeof(event_t) * ticks * SENSORS * 2);
+    size_t count = 0;
+    uint32_t complete = 0, dropped = 0, delayed = 0, late = 0, duplicated = 0, joined = 0;
+
+    /* Build the delivered stream and the expected number of rows */
+    for (uint32_t seq = 0; seq < ticks; seq++)
+    {
+        int on_time = 0;
+        for (uint8_t sensor = 0; sensor < SENSORS; sensor++)
+        {
+            uint32_t roll = next_random() % 1000;
+            int64_t stamp = (int64_t)seq * TICK_US + (jitter_us ? (int64_t)(next_random() % (2 * jitter_us)) - jitter_us : 0);
+            event_t event = {
+                .arrival = stamp + 1000 * sensor,
+                .sample = {.sensor = sensor, .count = 1, .seq = seq, .stamp = stamp, .value = {(int32_t)seq}},
+            };
+            if (roll < DROP)
+            {
+                dropped++;
+                continue;
+            }
+            if (roll < DROP + REORDER)
+            {
+                event.arrival += (int64_t)(1 + next_random() % 2) * TICK_US;
+                delayed++;
+            }
+            else if (roll < DROP + REORDER + LATE)
+            {
+                event.arrival += 6 * (int64_t)TICK_US;
+                late += sensor < 2;
+                events[count++] = event;
+                continue;
+            }
+            else if (roll < DROP + REORDER + LATE + DUPLICATE)
+            {
+                events[count] = event;
+                events[count++].arrival += 500;
+                duplicated++;
+            }
+            on_time += sensor < 2;
+            events[count++] = event;
+        }
+        complete += on_time == 2;
+    }
+    qsort(events, count, sizeof(event_t), by_arrival);
+
+    /* Join */
+    static sample_join_t join;
+    join = (sample_join_t){
+        .required = 0x3,
+        .key = key,
+        .tolerance_us = 4 * jitter_us,
+        .max_age_us = MAX_AGE_US,
+        .emit = on_row,
+    };
+    sample_join_init(&join);
+    mixed = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        joined += events[i].sample.sensor < 2;
+        sample_join_push(&join, &events[i].sample);
+    }
+    sample_join_expire(&join, INT64_MAX);
+
+    /* Old pairing: next sample of sensor 0 with next sample of sensor 1 */
+    uint32_t next0 = 0, next1 = 0, pairs = 0, misaligned = 0;
+    while (1)
+    {
+        while (next0 < count && events[next0].sample.sensor != 0)
+        {
+            next0++;
+        }
+        while (next1 < count && events[next1].sample.sensor != 1)
+        {
+            next1++;
+        }
+        if (next0 >= count || next1 >= count)
+        {
+            break;
+        }
+        pairs++;
+        misaligned += events[next0++].sample.seq != events[next1++].sample.seq;
+    }
+
+    const sample_join_stats_t *stats = &join.stats;
+    uint32_t accounted = 2 * stats->rows + stats->late + stats->orphaned + stats->duplicates;
+    int ok = mixed == 0 && stats->rows == complete && accounted == joined;
+
+    printf("%s key, %" PRIu32 " ticks, jitter %" PRId64 " us\n", key == SAMPLE_JOIN_SEQ ? "seq" : "time", ticks,
+           jitter_us);
+    printf("  injected : dropped %" PRIu32 ", reordered %" PRIu32 ", late %" PRIu32 ", duplicated %" PRIu32 "\n",
+           dropped, delayed, late, duplicated);
+    printf("  join     : rows %" PRIu32 "/%" PRIu32 " expected, mixed %" PRIu32 ", late %" PRIu32 ", orphaned %" PRIu32
+           ", duplicates %" PRIu32 ", missing %" PRIu32 "/%" PRIu32 ", ignored %" PRIu32 "\n",
+           stats->rows, complete, mixed, stats->late, stats->orphaned, stats->duplicates, stats->missing[0],
+           stats->missing[1], stats->ignored);
+    printf("  accounted: %" PRIu32 "/%" PRIu32 " joined samples\n", accounted, joined);
+    printf("  old pairs: %" PRIu32 " rows, %" PRIu32 " misaligned (%.1f%%)\n", pairs, misaligned,
+           pairs ? 100.0 * misaligned / pairs : 0.0);
+    printf("  %s\n\n", ok ? "ok" : "FAIL");
+    free(events);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ticks = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 100000;
+    rng = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1;
+
+    int ok = run(ticks, SAMPLE_JOIN_SEQ, 0);
+    ok &= run(ticks, SAMPLE_JOIN_TIME, 2000);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file nor_flash.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief NOR flash region in RAM, checks erase and program rules
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "nor_flash.h"
+
+static bool nor_flash_range(nor_flash_t *flash, uint32_t offset, uint32_t len)
+{
+    if (offset > flash->dev.size || len > flash->dev.size - offset)
+    {
+        flash->violations++;
+        return false;
+    }
+    return true;
+}
+
+static int nor_flash_read(void *ctx, uint32_t offset, void *dst, uint32_t len)
+{
+    nor_flash_t *flash = ctx;
+    if (flash->off || !nor_flash_range(flash, offset, len))
+    {
+        return -1;
+    }
+    memcpy(dst, flash->mem + offset, len);
+    return 0;
+}
+
+static int nor_flash_write(void *ctx, uint32_t offset, const void *src, uint32_t len)
+{
+    nor_flash_t *flash = ctx;
+    const uint8_t *bytes = src;
+
+    if (flash->off || !nor_flash_range(flash, offset, len))
+    {
+        return -1;
+    }
+    for (uint32_t i = 0; i < len; i++)
+    {
+        uint8_t *cell = &flash->mem[offset + i];
+        if ((*cell & bytes[i]) != bytes[i])
+        {
+            flash->violations++;
+        }
+        *cell &= bytes[i];
+        if (flash->cut_after > 0 && --flash->cut_after == 0)
+        {
+            flash->off = true;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int nor_flash_erase(void *ctx, uint32_t offset, uint32_t len)
+{
+    nor_flash_t *flash = ctx;
+
+    if (flash->off || !nor_flash_range(flash, offset, len))
+    {
+        return -1;
+    }
+    if (offset % flash->dev.erase_size != 0 || len % flash->dev.erase_size != 0)
+    {
+        flash->violations++;
+        return -1;
+    }
+    memset(flash->mem + offset, 0xFF, len);
+    for (uint32_t unit = offset / flash->dev.erase_size; unit < (offset + len) / flash->dev.erase_size; unit++)
+    {
+        flash->erases[unit]++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Create a region, all bits set as if never programmed
+ *
+ * @param flash         pointer to region
+ * @param size          bytes, a multiple of erase_size
+ * @param erase_size    erase unit in bytes
+ * @return int 0 success, -1 out of memory
+ */
+int nor_flash_init(nor_flash_t *flash, uint32_t size, uint32_t erase_size)
+{
+    memset(flash, 0, sizeof(*flash));
+    flash->mem = malloc(size);
+    flash->erases = calloc(size / erase_size, sizeof(uint32_t));
+    if (flash->mem == NULL || flash->erases == NULL)
+    {
+        nor_flash_free(flash);
+        return -1;
+    }
+    memset(flash->mem, 0xFF, size);
+    flash->dev = (spill_dev_t){
+        .ctx = flash,
+        .size = size,
+        .erase_size = erase_size,
+        .read = nor_flash_read,
+        .write = nor_flash_write,
+        .erase = nor_flash_erase,
+    };
+    return 0;
+}
+
+/**
+ * @brief Release a region
+ *
+ * @param flash pointer to region
+ */
+void nor_flash_free(nor_flash_t *flash)
+{
+    free(flash->mem);
+    free(flash->erases);
+    flash->mem = NULL;
+    flash->erases = NULL;
+}
+
+/**
+ * @brief Restore power after a cut, contents stay as they were
+ *
+ * @param flash pointer to region
+ */
+void nor_flash_reboot(nor_flash_t *flash)
+{
+    flash->off = false;
+    flash->cut_after = 0;
+}
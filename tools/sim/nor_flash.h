@@ -0,0 +1,51 @@
+/**
+ * @file nor_flash.h
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief NOR flash region in RAM, checks erase and program rules
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _NOR_FLASH_H_
+#define _NOR_FLASH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "logger/spill_ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct nor_flash_t nor_flash.h
+ * @brief Region, counts rule violations and erases per unit
+ *
+ * Programming can only clear bits, a write that would set one is counted
+ * in violations and stored ANDed like real NOR. Setting cut_after cuts the
+ * power once that many more bytes were programmed: the write in progress
+ * stops half way and every call fails until nor_flash_reboot().
+ */
+typedef struct
+{
+    spill_dev_t dev;     /*!< Region interface, pass &dev to spill_ring */
+    uint8_t *mem;        /*!< Contents */
+    uint32_t *erases;    /*!< Erase count per unit */
+    uint32_t violations; /*!< Misaligned erases, out of range calls, 0 to 1 programs */
+    uint32_t cut_after;  /*!< Bytes until the power cut, 0 for none */
+    bool off;            /*!< Power is cut */
+} nor_flash_t;
+
+int nor_flash_init(nor_flash_t *flash, uint32_t size, uint32_t erase_size);
+
+void nor_flash_free(nor_flash_t *flash);
+
+void nor_flash_reboot(nor_flash_t *flash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
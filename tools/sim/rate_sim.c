@@ -0,0 +1,370 @@
+/**
+ * @file rate_sim.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Adaptive pressure sampling: samples stored against reconstruction error
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Replays a pressure trace through fixed periods and the firmware's
+ * adaptive controller (sensor/adaptive_rate.c). Each policy stores the
+ * readings it would have taken, plus one record per period change; the
+ * trace is then rebuilt by linear interpolation between stored readings
+ * and compared with the trace at every point.
+ *
+ * Without a file the trace is synthetic, a day at 4 Hz: pressure tide,
+ * a front with a squall jump and gusts, an elevator ride, a hill walk and
+ * a windy spell, with 5 Pa of sensor noise. Errors are measured against the
+ * noise-free signal and split into active stretches (the events) and calm
+ * ones. The synthetic run checks that the adaptive policy stores less than
+ * half of what 1 Hz does, with no more error than 1 Hz when it matters.
+ *
+ * A CSV from `logdecode --csv` replays a recorded log instead: its readings
+ * are the reference, the shortest period is the trace's own, and the run
+ * only reports.
+ *
+ * ### Example
+ * ~~~
+ * rate_sim                 # synthetic trace
+ * rate_sim log.csv         # recorded trace
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sensor/adaptive_rate.h"
+
+#define SYNTH_STEP_US 250000            /* synthetic trace, 4 Hz */
+#define SYNTH_HOURS 24
+#define NOISE_PA 5.0                    /* BMP180 standard mode */
+#define ACTIVE_SLOPE 0.5                /* Pa/s of the clean signal marking an active stretch */
+#define PI 3.14159265358979323846
+
+typedef struct
+{
+    int64_t *time_us;
+    double *clean;    /* reference */
+    int32_t *reading; /* what the sensor returns */
+    bool *active;
+    size_t count;
+    bool labelled; /* synthetic: clean and active are known */
+} trace_t;
+
+typedef struct
+{
+    const char *name;
+    uint32_t period_ms; /* fixed period, 0 for adaptive */
+} policy_t;
+
+typedef struct
+{
+    size_t stored;
+    uint32_t changes;
+    double sq_all, sq_active, sq_calm;
+    double max_active;
+    size_t n_active, n_calm;
+    uint32_t react_ms; /* longest time from an event start to the shortest period */
+} result_t;
+
+static uint64_t rng_state = 0x2545F4914F6CDD1Dull;
+
+static double uniform(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return ((rng_state >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double gaussian(void)
+{
+    return sqrt(-2.0 * log(uniform())) * cos(2.0 * PI * uniform());
+}
+
+/**
+ * @brief Smooth step from 0 to 1 centred on t0, about width seconds wide
+ */
+static double step(double t, double t0, double width)
+{
+    return 0.5 * (1.0 + tanh((t - t0) / (width / 4.0)));
+}
+
+/**
+ * @brief Up at t0 over ramp seconds, stay for hold seconds, back down
+ */
+static double ride(double t, double t0, double ramp, double hold)
+{
+    double up = t < t0 ? 0 : t < t0 + ramp ? 0.5 - 0.5 * cos(PI * (t - t0) / ramp) : 1;
+    double t1 = t0 + ramp + hold;
+    double down = t < t1 ? 0 : t < t1 + ramp ? 0.5 - 0.5 * cos(PI * (t - t1) / ramp) : 1;
+    return up - down;
+}
+
+static void trace_alloc(trace_t *trace, size_t count)
+{
+    trace->time_us = calloc(count, sizeof(int64_t));
+    trace->clean = calloc(count, sizeof(double));
+    trace->reading = calloc(count, sizeof(int32_t));
+    trace->active = calloc(count, sizeof(bool));
+    trace->count = count;
+}
+
+static void trace_synth(trace_t *trace)
+{
+    size_t count = (size_t)SYNTH_HOURS * 3600 * 1000000 / SYNTH_STEP_US;
+    trace_alloc(trace, count);
+    trace->labelled = true;
+
+    double gust = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        double t = (double)i * SYNTH_STEP_US / 1e6;
+        double p = 101325 + 80 * sin(2 * PI * t / (12 * 3600.0));
+
+        /* Front: slow fall, a squall jump, then gusts for 5 minutes */
+        p -= 250 * step(t, 5400, 1200);
+        p += 150 * step(t, 5700, 60);
+        bool windy = (t > 5700 && t < 6000) || (t > 18000 && t < 18600);
+
+        /* Elevator 20 m up in 25 s, 3 minutes upstairs, hill walk of 60 m over 10 minutes */
+        p -= 240 * ride(t, 10800, 25, 180);
+        p -= 720 * ride(t, 14400, 600, 300);
+
+        /* Wind: low passed noise, 12 Pa RMS */
+        double w = windy ? 12.0 : 0.0;
+        gust += 0.3 * (w * gaussian() * 2.0 - gust);
+
+        trace->time_us[i] = (int64_t)i * SYNTH_STEP_US;
+        trace->clean[i] = p + gust;
+        trace->reading[i] = (int32_t)lround(p + gust + NOISE_PA * gaussian());
+        trace->active[i] = windy;
+    }
+
+    /* Active where the clean signal moves faster than ACTIVE_SLOPE */
+    for (size_t i = 1; i < count; i++)
+    {
+        double slope = fabs(trace->clean[i] - trace->clean[i - 1]) / (SYNTH_STEP_US / 1e6);
+        trace->active[i] = trace->active[i] || slope > ACTIVE_SLOPE;
+    }
+}
+
+static int trace_csv(trace_t *trace, const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    size_t capacity = 1 << 16;
+    trace_alloc(trace, capacity);
+    trace->count = 0;
+    trace->labelled = false;
+
+    char line[256];
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        /* time_us,time_utc,temperature_c,pressure_pa,battery_mv */
+        char *field = line;
+        int64_t time_us = strtoll(field, &field, 10);
+        if (field == line || *field != ',')
+        {
+            continue; /* header */
+        }
+        for (int skip = 0; skip < 2 && field != NULL; skip++)
+        {
+            field = strchr(field + 1, ',');
+        }
+        if (field == NULL || (trace->count > 0 && time_us <= trace->time_us[trace->count - 1]))
+        {
+            continue;
+        }
+        if (trace->count == capacity)
+        {
+            capacity *= 2;
+            trace->time_us = realloc(trace->time_us, capacity * sizeof(int64_t));
+            trace->clean = realloc(trace->clean, capacity * sizeof(double));
+            trace->reading = realloc(trace->reading, capacity * sizeof(int32_t));
+            trace->active = realloc(trace->active, capacity * sizeof(bool));
+        }
+        size_t i = trace->count++;
+        trace->time_us[i] = time_us;
+        trace->reading[i] = (int32_t)strtol(field + 1, NULL, 10);
+        trace->clean[i] = trace->reading[i];
+        trace->active[i] = false;
+    }
+    fclose(f);
+    return trace->count >= 2 ? 0 : -1;
+}
+
+/**
+ * @brief Sample the trace with a policy, then rebuild it and measure the error
+ */
+static void run(const trace_t *trace, const policy_t *policy, result_t *result)
+{
+    size_t *stored = malloc(trace->count * sizeof(size_t));
+    memset(result, 0, sizeof(*result));
+
+    adaptive_rate_t rate = {
+        .config = ADAPTIVE_RATE_DEFAULT(),
+        .period_ms = 1000,
+    };
+    adaptive_rate_init(&rate);
+
+    /* Take readings on the policy's schedule, snapped to the trace */
+    size_t n = 0;
+    int64_t event_us = -1;
+    for (size_t i = 0; i < trace->count;)
+    {
+        stored[n++] = i;
+        uint32_t period_ms = policy->period_ms;
+        if (period_ms == 0)
+        {
+            if (adaptive_rate_update(&rate, trace->time_us[i], trace->reading[i]))
+            {
+                result->changes++;
+            }
+            period_ms = rate.period_ms;
+
+            /* Reaction: from the start of an active stretch to the shortest period */
+            if (trace->active[i] && event_us < 0)
+            {
+                event_us = trace->time_us[i];
+            }
+            if (event_us >= 0 && period_ms == rate.config.min_period_ms)
+            {
+                uint32_t react = (uint32_t)((trace->time_us[i] - event_us) / 1000);
+                result->react_ms = react > result->react_ms ? react : result->react_ms;
+                event_us = -1;
+            }
+            if (!trace->active[i] && period_ms != rate.config.min_period_ms && event_us >= 0 &&
+                trace->time_us[i] - event_us > 600000000)
+            {
+                event_us = -1; /* never reacted, counted as 10 minutes */
+                result->react_ms = 600000;
+            }
+        }
+
+        int64_t next = trace->time_us[i] + (int64_t)period_ms * 1000;
+        while (i < trace->count && trace->time_us[i] < next)
+        {
+            i++;
+        }
+    }
+    result->stored = n;
+
+    /* Linear interpolation between stored readings */
+    for (size_t k = 0; k + 1 < n; k++)
+    {
+        size_t a = stored[k], b = stored[k + 1];
+        double span = (double)(trace->time_us[b] - trace->time_us[a]);
+        for (size_t i = a; i < b; i++)
+        {
+            double f = (double)(trace->time_us[i] - trace->time_us[a]) / span;
+            double value = trace->reading[a] + f * (trace->reading[b] - trace->reading[a]);
+            double e = value - trace->clean[i];
+            result->sq_all += e * e;
+            if (trace->active[i])
+            {
+                result->sq_active += e * e;
+                result->n_active++;
+                result->max_active = fabs(e) > result->max_active ? fabs(e) : result->max_active;
+            }
+            else
+            {
+                result->sq_calm += e * e;
+                result->n_calm++;
+            }
+        }
+    }
+    free(stored);
+}
+
+static double rms(double sq, size_t n)
+{
+    return n > 0 ? sqrt(sq / n) : 0;
+}
+
+int main(int argc, char **argv)
+{
+    trace_t trace;
+    if (argc > 1)
+    {
+        if (trace_csv(&trace, argv[1]) != 0)
+        {
+            fprintf(stderr, "%s: no usable rows\n", argv[1]);
+            return 1;
+        }
+    }
+    else
+    {
+        trace_synth(&trace);
+    }
+
+    static const policy_t policies[] = {
+        {"fixed 250ms", 250},
+        {"fixed 1s", 1000},
+        {"fixed 8s", 8000},
+        {"adaptive", 0},
+    };
+    enum
+    {
+        FAST,
+        ONE_HZ,
+        SLOW,
+        ADAPTIVE,
+        POLICIES
+    };
+    result_t results[POLICIES];
+
+    double hours = (trace.time_us[trace.count - 1] - trace.time_us[0]) / 3.6e9;
+    printf("%zu readings over %.1f h, %s\n\n", trace.count, hours,
+           trace.labelled ? "errors against the noise-free signal" : "errors against the recorded readings");
+    printf("%-12s %8s %8s %8s %9s %9s %9s %9s\n", "policy", "stored", "vs 1s", "changes", "rms", "rms act",
+           "max act", "rms calm");
+    for (int p = 0; p < POLICIES; p++)
+    {
+        run(&trace, &policies[p], &results[p]);
+    }
+    for (int p = 0; p < POLICIES; p++)
+    {
+        const result_t *r = &results[p];
+        size_t records = r->stored + r->changes;
+        printf("%-12s %8zu %7.1f%% %8" PRIu32 " %9.2f %9.2f %9.1f %9.2f\n", policies[p].name, records,
+               100.0 * records / results[ONE_HZ].stored, r->changes,
+               rms(r->sq_all, r->n_active + r->n_calm), rms(r->sq_active, r->n_active), r->max_active,
+               rms(r->sq_calm, r->n_calm));
+    }
+
+    if (!trace.labelled)
+    {
+        free(trace.time_us);
+        free(trace.clean);
+        free(trace.reading);
+        free(trace.active);
+        return 0;
+    }
+
+    const result_t *a = &results[ADAPTIVE];
+    const result_t *one = &results[ONE_HZ];
+    bool ok_saved = a->stored + a->changes < one->stored / 2;
+    bool ok_active = rms(a->sq_active, a->n_active) <= rms(one->sq_active, one->n_active);
+    bool ok_calm = rms(a->sq_calm, a->n_calm) <= rms(one->sq_calm, one->n_calm) + 1.0;
+    printf("\nslowest reaction to an event %.1f s\n", a->react_ms / 1000.0);
+    printf("saved %s, active error %s, calm error %s\n", ok_saved ? "ok" : "FAIL", ok_active ? "ok" : "FAIL",
+           ok_calm ? "ok" : "FAIL");
+    bool ok = ok_saved && ok_active && ok_calm;
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+    free(trace.time_us);
+    free(trace.clean);
+    free(trace.reading);
+    free(trace.active);
+    return ok ? 0 : 1;
+}
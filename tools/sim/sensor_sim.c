@@ -0,0 +1,215 @@
+/**
+ * @file sensor_sim.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Run the sensor executor against fake sensors on a virtual clock
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Fake sensors cover the cases the executor has to handle: overlapping
+ * conversions, a slower interval, failing reads and a sensor that never
+ * initializes. Every sample is checked against the value the fake produced.
+ *
+ * ### Example
+ * ~~~
+ * sensor_sim          # 1000 ticks
+ * sensor_sim 100000
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sensor/sensor_exec.h"
+
+#define TICK_US 1000000 /* Sampling period */
+
+/**
+ * @struct fake_t
+ * @brief Fake device: value = base + read count, every fail_every-th read fails
+ */
+typedef struct
+{
+    int32_t base;        /* first value */
+    uint32_t fail_every; /* 0 never fails */
+    int init_result;     /* returned by init() */
+    uint32_t reads;      /* read() calls */
+    uint32_t starts;     /* start() calls */
+    int32_t last;        /* last good value */
+} fake_t;
+
+static int64_t clock_us; /* Virtual time */
+static uint32_t waits;   /* wait_us() calls */
+
+static int fake_init(void *ctx)
+{
+    return ((fake_t *)ctx)->init_result;
+}
+
+static int fake_start(void *ctx)
+{
+    ((fake_t *)ctx)->starts++;
+    return 0;
+}
+
+static int fake_read(void *ctx, void *raw)
+{
+    fake_t *fake = ctx;
+    uint32_t n = ++fake->reads;
+
+    clock_us += 200; /* bus transfer */
+    if (fake->fail_every != 0 && n % fake->fail_every == 0)
+    {
+        return -1;
+    }
+    fake->last = fake->base + (int32_t)n;
+    *(int32_t *)raw = fake->last;
+    return 0;
+}
+
+static void fake_decode(void *ctx, const void *raw, int32_t *values)
+{
+    (void)ctx;
+    values[0] = *(const int32_t *)raw;
+    values[1] = -values[0];
+}
+
+static const sensor_channel_t fake_channels[] = {
+    {"value", "", 1},
+    {"negated", "", 1},
+};
+
+/* Converts in read(), like the BMP180 driver */
+static const sensor_driver_t fake_blocking = {
+    .name = "blocking",
+    .channels = fake_channels,
+    .channel_count = 2,
+    .raw_size = sizeof(int32_t),
+    .init = fake_init,
+    .read = fake_read,
+    .decode = fake_decode,
+};
+
+/* Triggered conversions of different length */
+static const sensor_driver_t fake_fast = {
+    .name = "fast",
+    .channels = fake_channels,
+    .channel_count = 2,
+    .raw_size = sizeof(int32_t),
+    .conversion_us = 5000,
+    .init = fake_init,
+    .start = fake_start,
+    .read = fake_read,
+    .decode = fake_decode,
+};
+
+static const sensor_driver_t fake_slow = {
+    .name = "slow",
+    .channels = fake_channels,
+    .channel_count = 2,
+    .raw_size = sizeof(int32_t),
+    .conversion_us = 12000,
+    .init = fake_init,
+    .start = fake_start,
+    .read = fake_read,
+    .decode = fake_decode,
+};
+
+static fake_t devices[] = {
+    {.base = 1000},                     /* blocking, every tick */
+    {.base = 2000, .fail_every = 7},    /* fast, every tick, some reads fail */
+    {.base = 3000},                     /* slow, every 4 ticks */
+    {.base = 4000, .init_result = -1},  /* never initializes */
+};
+
+static const sensor_t table[] = {
+    {&fake_blocking, &devices[0], 1},
+    {&fake_fast, &devices[1], 1},
+    {&fake_slow, &devices[2], 4},
+    {&fake_fast, &devices[3], 1},
+};
+
+#define SENSORS (sizeof(table) / sizeof(table[0]))
+
+static uint32_t received[SENSORS]; /* samples per sensor */
+static uint32_t mismatches;        /* samples with a wrong value, seq or stamp */
+static uint32_t current_seq;       /* seq of the running tick */
+static int64_t current_tick;       /* stamp of the running tick */
+
+static void emit(void *arg, const sensor_sample_t *sample)
+{
+    const fake_t *fake = table[sample->sensor].ctx;
+    (void)arg;
+
+    received[sample->sensor]++;
+    if (sample->count != 2 || sample->value[0] != fake->last || sample->value[1] != -fake->last ||
+        sample->seq != current_seq || sample->stamp != current_tick)
+    {
+        mismatches++;
+    }
+}
+
+static void wait_us(void *arg, uint32_t us)
+{
+    (void)arg;
+    waits++;
+    clock_us += us;
+}
+
+static int64_t now_us(void *arg)
+{
+    (void)arg;
+    return clock_us;
+}
+
+static int check(const char *what, uint64_t got, uint64_t want)
+{
+    printf("%-28s %10" PRIu64 " %10" PRIu64 "  %s\n", what, got, want, got == want ? "ok" : "FAIL");
+    return got == want;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ticks = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 1000;
+    sensor_exec_t exec = {
+        .sensors = table,
+        .count = SENSORS,
+        .emit = emit,
+        .wait_us = wait_us,
+        .now_us = now_us,
+    };
+
+    int enabled = sensor_exec_init(&exec);
+    int64_t busy = 0;
+    for (uint32_t seq = 0; seq < ticks; seq++)
+    {
+        current_seq = seq;
+        current_tick = clock_us = (int64_t)seq * TICK_US;
+        sensor_exec_tick(&exec, seq, current_tick);
+        busy += clock_us - current_tick;
+    }
+
+    /* What the same sensors cost with one task each: conversions add up */
+    uint32_t slow_ticks = (ticks + 3) / 4;
+    int64_t sequential = (int64_t)ticks * (200 + 5000 + 200) + (int64_t)slow_ticks * (12000 + 200);
+
+    uint32_t fast_fail = devices[1].reads / 7;
+    int ok = 1;
+    printf("%-28s %10s %10s\n", "", "got", "expected");
+    ok &= check("enabled sensors", (uint64_t)enabled, 3);
+    ok &= check("blocking samples", received[0], ticks);
+    ok &= check("fast samples", received[1], ticks - fast_fail);
+    ok &= check("fast errors", exec.status[1].errors, fast_fail);
+    ok &= check("slow samples", received[2], slow_ticks);
+    ok &= check("slow starts", devices[2].starts, slow_ticks);
+    ok &= check("disabled samples", received[3], 0);
+    ok &= check("waits (one per tick)", waits, ticks);
+    ok &= check("sample mismatches", mismatches, 0);
+    printf("\nacquisition time per tick: %.1f us executor, %.1f us one task per sensor\n",
+           (double)busy / ticks, (double)sequential / ticks);
+    printf("blocking latency: mean %" PRId64 " us, slow latency: mean %" PRId64 " us\n",
+           stats_mean(&exec.status[0].latency), stats_mean(&exec.status[2].latency));
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
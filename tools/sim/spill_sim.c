@@ -0,0 +1,376 @@
+/**
+ * @file spill_sim.c
+ * @author Jesus Minjares (https://github.com/jminjares4)
+ * @brief Card failover to the flash spill ring and drain back, on a RAM flash
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Drives logger/spill_sink.c the way logger_run() does, one block per
+ * simulated second, against a card that comes and goes and a NOR flash
+ * region in RAM (nor_flash.c). Each lap of the script:
+ *
+ * - card present
+ * - card removed, the ring takes the blocks, card back and the ring drains
+ * - every 5th card write fails
+ * - card removed and power cut in the middle of a ring write: the ring is
+ *   reopened from flash as after a reboot, then the card comes back
+ * - card removed for longer than the ring holds, oldest blocks overwritten
+ *
+ * Checks: every block reaches the card exactly once, except the ones the
+ * ring overwrote and the ones in the write cut by the power loss; each card
+ * file is in block order and every block on it verifies; no erase or
+ * program breaks NOR rules; erases per unit differ by at most one.
+ *
+ * ### Example
+ * ~~~
+ * spill_sim           # 16 units of 4 KB, 3 laps
+ * spill_sim 96 20     # the firmware's 384 KB partition, 20 laps
+ * ~~~
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "logger/spill_sink.h"
+#include "nor_flash.h"
+
+#define ERASE_SIZE 4096
+#define BLOCK_MS 1000      /* one sealed block per second */
+#define STEP_MS 10         /* simulation step */
+#define BATCH 4            /* blocks per write call */
+#define SYNC_BLOCKS 8      /* blocks between syncs */
+#define RETRY_MS 5000      /* card attach attempts */
+#define FLAKY_EVERY 5      /* failed card write period while flaky */
+#define DRAIN_BLOCKS (ERASE_SIZE / LOG_BLOCK_SIZE - 1)
+
+typedef enum
+{
+    CARD_OK,
+    CARD_MISSING,
+    CARD_FLAKY,
+} card_state_t;
+
+typedef struct
+{
+    uint32_t at; /* block in the lap */
+    card_state_t state;
+    const char *name;
+} phase_t;
+
+/* Lap script; the outage at 500 is longer than any ring below 300 blocks */
+static const phase_t phases[] = {
+    {0, CARD_OK, "card present"},
+    {100, CARD_MISSING, "card removed"},
+    {180, CARD_OK, "card back"},
+    {300, CARD_FLAKY, "card flaky"},
+    {400, CARD_MISSING, "card removed, power cut"},
+    {460, CARD_OK, "card back"},
+    {500, CARD_MISSING, "card removed"},
+    {800, CARD_OK, "card back"},
+};
+#define LAP_BLOCKS 900
+#define CUT_AT 450 /* block in the lap whose write loses power */
+
+struct card;
+
+typedef struct
+{
+    struct card *card;
+    uint32_t last; /* newest seq in the file */
+    bool any;
+} card_file_t;
+
+typedef struct card
+{
+    card_state_t state;
+    uint32_t writes;
+    card_file_t log;   /* file of new blocks, reopened at every attach */
+    card_file_t drain; /* file of drained blocks, reopened at every attach */
+    uint8_t *delivered;
+    uint32_t blocks;
+    uint32_t order_errors;
+    uint32_t bad_blocks;
+} card_t;
+
+static esp_err_t card_write(void *ctx, const log_block_t *blocks, size_t count)
+{
+    card_file_t *file = ctx;
+    card_t *card = file->card;
+
+    if (card->state == CARD_MISSING || (card->state == CARD_FLAKY && ++card->writes % FLAKY_EVERY == 0))
+    {
+        return ESP_FAIL;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t seq = blocks[i].header.seq;
+        if (!log_block_verify(&blocks[i]) || seq >= card->blocks)
+        {
+            card->bad_blocks++;
+            continue;
+        }
+        if (file->any && seq <= file->last)
+        {
+            card->order_errors++;
+        }
+        file->last = seq;
+        file->any = true;
+        card->delivered[seq]++;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t card_sync(void *ctx)
+{
+    card_file_t *file = ctx;
+    return file->card->state == CARD_MISSING ? ESP_FAIL : ESP_OK;
+}
+
+static esp_err_t card_attach(void *ctx, log_sink_t *log, log_sink_t *drain)
+{
+    card_t *card = ctx;
+
+    if (card->state == CARD_MISSING)
+    {
+        return ESP_FAIL;
+    }
+    card->log = (card_file_t){.card = card};
+    card->drain = (card_file_t){.card = card};
+    *log = (log_sink_t){.ctx = &card->log, .write = card_write, .sync = card_sync};
+    *drain = (log_sink_t){.ctx = &card->drain, .write = card_write, .sync = card_sync};
+    return ESP_OK;
+}
+
+static void card_detach(void *ctx)
+{
+    (void)ctx;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t units = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 16;
+    uint32_t laps = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 3;
+
+    nor_flash_t flash;
+    if (units < 2 || laps == 0 || nor_flash_init(&flash, units * ERASE_SIZE, ERASE_SIZE) != 0)
+    {
+        fprintf(stderr, "usage: spill_sim [units >= 2] [laps >= 1]\n");
+        return 1;
+    }
+
+    card_t card = {.state = CARD_OK, .blocks = laps * LAP_BLOCKS};
+    card.delivered = calloc(card.blocks, 1);
+    uint8_t *cut = calloc(card.blocks, 1);
+    spill_ring_t ring;
+    spill_sink_t spill;
+    log_sink_t sink;
+    static log_block_t buffer[DRAIN_BLOCKS];
+
+    if (spill_ring_open(&ring, &flash.dev) != 0)
+    {
+        fprintf(stderr, "unsupported geometry\n");
+        return 1;
+    }
+    spill = (spill_sink_t){
+        .ring = &ring,
+        .buffer = buffer,
+        .buffer_blocks = DRAIN_BLOCKS,
+        .retry_ms = RETRY_MS,
+        .attach = card_attach,
+        .detach = card_detach,
+        .ctx = &card,
+    };
+    spill_sink_init(&spill, &sink);
+
+    printf("ring %" PRIu32 " units, %" PRIu32 " blocks, %" PRIu32 " laps of %u blocks\n\n", units,
+           spill_ring_capacity(&ring), laps, LAP_BLOCKS);
+    printf("%-6s %-24s %8s %8s %8s %8s\n", "block", "phase", "pending", "spilled", "drained", "overwr.");
+
+    /* Counters carried over reboots */
+    spill_sink_stats_t total = {0};
+    uint32_t overwritten = 0;
+    uint32_t reopened = 0;
+    uint32_t recovered_ok = 0;
+
+    log_block_t pending[BATCH];
+    uint32_t npending = 0;
+    uint32_t seq = 0;
+    uint32_t unsynced = 0;
+    uint32_t now = 0;
+    uint32_t service_ms = 0;
+    size_t phase = 0;
+    bool cut_armed = false;
+    uint32_t drain_deadline = 0;
+
+    while (true)
+    {
+        /* Producer: one sealed block per second, phases switch the card */
+        if (now % BLOCK_MS == 0 && seq < card.blocks)
+        {
+            uint32_t in_lap = seq % LAP_BLOCKS;
+            if (in_lap == 0)
+            {
+                phase = 0;
+            }
+            if (phase < sizeof(phases) / sizeof(phases[0]) && phases[phase].at == in_lap)
+            {
+                card.state = phases[phase].state;
+                printf("%-6" PRIu32 " %-24s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 "\n", seq,
+                       phases[phase].name, ring.count, total.spilled + spill.stats.spilled,
+                       total.drained + spill.stats.drained, overwritten + ring.stats.overwritten);
+                phase++;
+            }
+            if (in_lap == CUT_AT)
+            {
+                cut_armed = true;
+            }
+            log_block_init(&pending[npending], seq);
+            pending[npending].header.count = 1;
+            pending[npending].header.first_us = (int64_t)now * 1000;
+            pending[npending].header.last_us = pending[npending].header.first_us;
+            memset(pending[npending].payload, (int)(seq & 0xFF), LOG_BLOCK_PAYLOAD);
+            log_block_seal(&pending[npending]);
+            npending++;
+            seq++;
+        }
+
+        /* Writer: batches and syncs like logger_run() */
+        bool wrote = false;
+        if (npending == BATCH || (seq == card.blocks && npending > 0))
+        {
+            if (cut_armed)
+            {
+                /* One block programmed, the next one torn */
+                flash.cut_after = LOG_BLOCK_SIZE + LOG_BLOCK_SIZE / 3;
+                cut_armed = false;
+            }
+            sink.write(sink.ctx, pending, npending);
+            if (flash.off)
+            {
+                /* Power lost: the batch in RAM is gone, the ring is rebuilt from flash */
+                uint32_t pending_before = ring.count;
+                for (uint32_t i = 0; i < npending; i++)
+                {
+                    cut[pending[i].header.seq] = 1;
+                }
+                total.spilled += spill.stats.spilled;
+                total.drained += spill.stats.drained;
+                total.corrupt += spill.stats.corrupt;
+                total.failures += spill.stats.failures;
+                total.attaches += spill.stats.attaches;
+                overwritten += ring.stats.overwritten;
+                nor_flash_reboot(&flash);
+                if (spill_ring_open(&ring, &flash.dev) != 0)
+                {
+                    fprintf(stderr, "reopen failed\n");
+                    return 1;
+                }
+                reopened++;
+                /* The complete block and the torn one are found again */
+                recovered_ok += ring.count == pending_before + 2;
+                spill_sink_init(&spill, &sink);
+                unsynced = 0;
+                printf("%-6" PRIu32 " %-24s %8" PRIu32 "\n", seq, "reboot, ring reopened", ring.count);
+            }
+            npending = 0;
+            unsynced += BATCH;
+            wrote = true;
+        }
+        if (unsynced >= SYNC_BLOCKS)
+        {
+            sink.sync(sink.ctx);
+            unsynced = 0;
+        }
+
+        /* Background work, called after every wake */
+        if (wrote || now >= service_ms)
+        {
+            uint32_t wait = sink.service(sink.ctx, now);
+            service_ms = wait == FLUSH_WAIT_FOREVER ? UINT32_MAX : now + wait;
+        }
+
+        now += STEP_MS;
+        if (seq == card.blocks && npending == 0)
+        {
+            if (drain_deadline == 0)
+            {
+                drain_deadline = now + 2 * spill_ring_capacity(&ring) * SPILL_DRAIN_PAUSE_MS + 2 * RETRY_MS;
+            }
+            if (ring.count == 0 || now >= drain_deadline)
+            {
+                break;
+            }
+        }
+    }
+    sink.sync(sink.ctx);
+
+    total.spilled += spill.stats.spilled;
+    total.drained += spill.stats.drained;
+    total.corrupt += spill.stats.corrupt;
+    total.lost += spill.stats.lost;
+    total.failures += spill.stats.failures;
+    total.attaches += spill.stats.attaches;
+    overwritten += ring.stats.overwritten;
+
+    /* Every block once, unless overwritten or cut */
+    uint32_t delivered = 0, duplicates = 0, missing = 0, missing_cut = 0;
+    for (uint32_t i = 0; i < card.blocks; i++)
+    {
+        delivered += card.delivered[i] > 0;
+        duplicates += card.delivered[i] > 1 ? card.delivered[i] - 1 : 0;
+        if (card.delivered[i] == 0)
+        {
+            if (cut[i])
+            {
+                missing_cut++;
+            }
+            else
+            {
+                missing++;
+            }
+        }
+    }
+
+    uint32_t min_erases = UINT32_MAX, max_erases = 0;
+    for (uint32_t unit = 0; unit < units; unit++)
+    {
+        min_erases = flash.erases[unit] < min_erases ? flash.erases[unit] : min_erases;
+        max_erases = flash.erases[unit] > max_erases ? flash.erases[unit] : max_erases;
+    }
+
+    bool ok_blocks = missing == overwritten && duplicates == 0 && card.bad_blocks == 0 && card.order_errors == 0;
+    bool ok_reboot = reopened == laps && recovered_ok == laps && total.corrupt == laps;
+    bool ok_flash = flash.violations == 0 && max_erases - min_erases <= 1 && ring.count == 0;
+
+    printf("\n%-22s %10s\n", "", "count");
+    printf("%-22s %10" PRIu32 "\n", "blocks", card.blocks);
+    printf("%-22s %10" PRIu32 "\n", "delivered", delivered);
+    printf("%-22s %10" PRIu32 "\n", "missing, overwritten", missing);
+    printf("%-22s %10" PRIu32 "\n", "missing, power cut", missing_cut);
+    printf("%-22s %10" PRIu32 "\n", "duplicates", duplicates);
+    printf("%-22s %10" PRIu32 "\n", "out of order", card.order_errors);
+    printf("%-22s %10" PRIu32 "\n", "bad on card", card.bad_blocks);
+    printf("%-22s %10" PRIu32 "\n", "spilled", total.spilled);
+    printf("%-22s %10" PRIu32 "\n", "drained", total.drained);
+    printf("%-22s %10" PRIu32 "\n", "overwritten", overwritten);
+    printf("%-22s %10" PRIu32 "\n", "torn, skipped", total.corrupt);
+    printf("%-22s %10" PRIu32 "\n", "card attaches", total.attaches);
+    printf("%-22s %10" PRIu32 "\n", "card failures", total.failures);
+    printf("%-22s %10" PRIu32 "\n", "reboots recovered", recovered_ok);
+    printf("%-22s %10" PRIu32 "\n", "NOR violations", flash.violations);
+    printf("%-22s %6" PRIu32 "..%" PRIu32 "\n", "erases per unit", min_erases, max_erases);
+    printf("%-22s %10" PRIu32 "\n", "left in ring", ring.count);
+
+    printf("\nblocks %s, reboot %s, flash %s\n", ok_blocks ? "ok" : "FAIL", ok_reboot ? "ok" : "FAIL",
+           ok_flash ? "ok" : "FAIL");
+    bool ok = ok_blocks && ok_reboot && ok_flash;
+    printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+    free(card.delivered);
+    free(cut);
+    nor_flash_free(&flash);
+    return ok ? 0 : 1;
+}
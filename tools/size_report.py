@@ -0,0 +1,238 @@
+"""
+Author: Jesus Minjares
+Date:   10-19-2026
+GitHub: https://github.com/jminjares4
+Brief:  Flash, IRAM and DRAM footprint per component from the linker map of a firmware build
+"""
+import json
+import os
+import re
+import sys
+
+import click
+
+# memory type of the output sections, ESP32 linker scripts first, then plain GNU ld ones
+SECTION_TYPES = [
+    (re.compile(r'^\.iram0\.'), 'iram'),
+    (re.compile(r'^\.dram0\.bss$|^\.dram0\.noinit$|^\.noinit$|^\.bss$|^\.tbss$'), 'dram_bss'),
+    (re.compile(r'^\.dram0\.'), 'dram_data'),
+    (re.compile(r'^\.flash\.text$|^\.text$|^\.init$|^\.fini$|^\.plt'), 'flash_code'),
+    (re.compile(r'^\.flash\.|^\.rodata|^\.eh_frame|^\.gcc_except_table|^\.init_array$|^\.fini_array$'),
+     'flash_rodata'),
+    (re.compile(r'^\.rtc\.'), 'rtc'),
+    (re.compile(r'^\.data|^\.tdata$'), 'dram_data'),
+]
+
+TYPES = ['flash_code', 'flash_rodata', 'iram', 'dram_data', 'dram_bss', 'rtc']
+
+# input section: " .text.foo  0x400d1234  0x40 path/libfoo.a(bar.c.obj)", the name may sit on a line of its own
+INPUT = re.compile(r'^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+NAME_ONLY = re.compile(r'^ (\S+)$')
+OUTPUT = re.compile(r'^(\.\S+|/DISCARD/)(\s+0x[0-9a-fA-F]+\s+0x[0-9a-fA-F]+)?')
+OBJECT = re.compile(r'^(.*?)(?:\(([^()]*)\))?$')
+
+
+def section_type(name):
+    """
+    Memory type of an output section, None for sections not loaded
+
+    name (str) : output section name
+    """
+    for pattern, kind in SECTION_TYPES:
+        if pattern.search(name):
+            return kind
+    return None
+
+
+def split_object(path):
+    """
+    Component and object file of an input section's source
+
+    path (str) : "dir/libcomponent.a(file.c.obj)" or "dir/file.c.obj"
+    """
+    archive, member = OBJECT.match(path.strip()).groups()
+    if member is None:
+        return '(objects)', os.path.basename(archive)
+    name = os.path.basename(archive)
+    if name.startswith('lib'):
+        name = name[3:]
+    if name.endswith('.a'):
+        name = name[:-2]
+    return name, member
+
+
+def parse_map(path):
+    """
+    Bytes per memory type for every component and object file
+
+    Only the memory map part counts, the discarded input sections listed
+    before it never reach the image. Fill between input sections is not
+    attributed to anyone.
+
+    path (str) : GNU ld map file, -Wl,-Map
+    """
+    components = {}
+    files = {}
+    in_map = False
+    output = None
+    pending = None
+    with open(path, errors='replace') as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if not in_map:
+                in_map = line.startswith('Linker script and memory map')
+                continue
+
+            m = OUTPUT.match(line)
+            if m:
+                output = m.group(1)
+                pending = None
+                continue
+            if output is None or output == '/DISCARD/':
+                continue
+
+            m = NAME_ONLY.match(line)
+            if m and not m.group(1).startswith('*'):
+                pending = m.group(1)
+                continue
+            m = INPUT.match(line)
+            if m is None:
+                pending = None
+                continue
+            name = m.group(1) or pending
+            pending = None
+            size = int(m.group(3), 16)
+            source = m.group(4)
+            # symbol lines carry an address and a name only, fill has no source
+            if name is None or name.startswith('*') or size == 0 or ' ' in source.strip():
+                continue
+            kind = section_type(output)
+            if kind is None:
+                continue
+
+            component, member = split_object(source)
+            for table, key in ((components, component), (files, (component, member))):
+                entry = table.setdefault(key, dict.fromkeys(TYPES, 0))
+                entry[kind] += size
+    return components, files
+
+
+def totals(entry):
+    """
+    Footprint of one entry: image bytes in flash, IRAM, and DRAM used
+
+    Initialized data and IRAM code are loaded from the flash image, so
+    they count in flash as well.
+
+    entry (dict) : bytes per memory type
+    """
+    return {
+        'flash': entry['flash_code'] + entry['flash_rodata'] + entry['iram'] + entry['dram_data'] + entry['rtc'],
+        'iram': entry['iram'],
+        'dram': entry['dram_data'] + entry['dram_bss'],
+    }
+
+
+def table(rows, title):
+    """
+    Text table of entries, largest flash first
+
+    rows (dict)   : name to bytes per memory type
+    title (str)   : first column header
+    """
+    lines = ['%-32s %9s %9s %9s %9s %9s %9s %9s %9s' %
+             (title, 'flash', 'iram', 'dram', 'code', 'rodata', 'data', 'bss', 'rtc')]
+    order = sorted(rows.items(), key=lambda item: -totals(item[1])['flash'])
+    for name, entry in order:
+        total = totals(entry)
+        lines.append('%-32s %9d %9d %9d %9d %9d %9d %9d %9d' %
+                     (name[:32], total['flash'], total['iram'], total['dram'], entry['flash_code'],
+                      entry['flash_rodata'], entry['dram_data'], entry['dram_bss'], entry['rtc']))
+    return lines
+
+
+@click.group()
+def main():
+    """
+    Firmware footprint from the linker map
+    """
+
+
+# examples:
+# python3 size_report.py report firmware/build/main.map --detail components
+# python3 size_report.py report firmware/build/main.map --json size.json --baseline size_before.json --threshold 256
+@main.command()
+@click.argument('map_path', type=click.Path(exists=True))
+@click.option('--detail', '-d', multiple=True, help='Also list the object files of this component, repeatable')
+@click.option('--json', 'json_path', default=None, help='Write the report, usable as a later baseline')
+@click.option('--baseline', default=None, type=click.Path(exists=True), help='Report of an earlier build to compare to')
+@click.option('--threshold', default=0, help='Allowed growth per component and memory in bytes')
+@click.option('--quiet', '-q', is_flag=True, help='Print the comparison only')
+def report(map_path, detail, json_path, baseline, threshold, quiet):
+    """
+    Footprint per component, and growth over a baseline
+
+    flash is what the component adds to the image: code, read-only data,
+    IRAM code and initialized data. iram and dram are the internal RAM it
+    takes. Exits 1 when a component, or the total, grows any of the three
+    by more than the threshold over the baseline.
+
+    map_path (str)      : linker map, build/<project>.map of an ESP-IDF build
+    detail (tuple)      : components to list per object file
+    json_path (str)     : report output
+    baseline (str)      : JSON written by an earlier --json
+    threshold (int)     : allowed growth in bytes
+    quiet (bool)        : no tables
+    """
+    components, files = parse_map(map_path)
+    if not components:
+        print('%s: no input sections found, not a GNU ld map file?' % map_path)
+        sys.exit(1)
+    total = dict.fromkeys(TYPES, 0)
+    for entry in components.values():
+        for kind in TYPES:
+            total[kind] += entry[kind]
+
+    if not quiet:
+        for line in table(components, 'component'):
+            print(line)
+        for name in detail:
+            rows = {member: entry for (component, member), entry in files.items() if component == name}
+            print()
+            for line in table(rows, name):
+                print(line)
+        print()
+        summary = totals(total)
+        print('total: flash %d, iram %d, dram %d bytes' % (summary['flash'], summary['iram'], summary['dram']))
+
+    ok = True
+    if baseline:
+        with open(baseline) as f:
+            reference = json.load(f)
+        before = dict(reference['components'], **{'(total)': reference['total']})
+        after = dict(components, **{'(total)': total})
+        print()
+        print('%-32s %9s %9s %9s' % ('growth over baseline', 'flash', 'iram', 'dram'))
+        for name in sorted(set(before) | set(after)):
+            old = totals(before.get(name, dict.fromkeys(TYPES, 0)))
+            new = totals(after.get(name, dict.fromkeys(TYPES, 0)))
+            delta = {key: new[key] - old[key] for key in new}
+            if not any(delta.values()):
+                continue
+            over = [key for key in delta if delta[key] > threshold]
+            print('%-32s %+9d %+9d %+9d%s' % (name[:32], delta['flash'], delta['iram'], delta['dram'],
+                                              '  over %d bytes' % threshold if over else ''))
+            ok = ok and not over
+        print('PASS' if ok else 'FAIL')
+
+    if json_path:
+        with open(json_path, 'w') as f:
+            json.dump({'map': os.path.abspath(map_path), 'total': total, 'components': components,
+                       'files': {'%s/%s' % key: entry for key, entry in files.items()}}, f, indent=2)
+
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    # Call main function
+    main()
@@ -0,0 +1,317 @@
+"""
+Author: Jesus Minjares
+Date:   10-19-2026
+GitHub: https://github.com/jminjares4
+Brief:  Decode the binary telemetry stream (COBS frames + CRC-32) sent by the logger
+"""
+import os
+import select
+import struct
+import sys
+import threading
+import time
+import tty
+import zlib
+
+import click
+
+# record types, see firmware/components/telemetry/telemetry.h
+TELEMETRY_SAMPLE = 1
+TELEMETRY_BATTERY = 2
+TELEMETRY_TEXT = 3
+TELEMETRY_TRACE = 4  # decoded by trace.py
+TELEMETRY_BOOT = 5   # decoded by boot.py
+TELEMETRY_SEGMENT = 6  # range reads, decoded by range.py
+TELEMETRY_SPAN = 7
+TELEMETRY_CHUNK = 8
+TELEMETRY_CAPTURE = 9  # raw sensor readings, replayed by tools/replay
+
+SAMPLE = struct.Struct('<qBBHiI')   # log_record_t
+BATTERY = struct.Struct('<HHB')     # telemetry_battery_t
+CAPTURE = struct.Struct('<BBBBIqI')  # sensor_capture_t, raw bytes follow
+CRC = struct.Struct('<I')
+
+
+def cobs_encode(data):
+    """
+    Encode bytes with COBS, the result contains no zero byte
+
+    data (bytes) : raw bytes
+    """
+    out = bytearray()
+    for block in data.split(b'\x00'):
+        # split blocks longer than 254 bytes
+        while len(block) >= 254:
+            out.append(0xFF)
+            out += block[:254]
+            block = block[254:]
+        out.append(len(block) + 1)
+        out += block
+    return bytes(out)
+
+
+def cobs_decode(data):
+    """
+    Decode one COBS block, raise ValueError if malformed
+
+    data (bytes) : encoded bytes without delimiters (never contains zero)
+    """
+    out = bytearray()
+    i = 0
+    n = len(data)
+    while i < n:
+        code = data[i]
+        end = i + code
+        if end > n:
+            raise ValueError('truncated block')
+        out += data[i + 1:end]
+        i = end
+        if code != 0xFF and i < n:
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(rtype, seq, payload):
+    """
+    Encode one frame exactly like frame_encode() on the device
+
+    rtype (int)     : record type
+    seq (int)       : sequence number, wraps at 256
+    payload (bytes) : record payload
+    """
+    raw = bytes((rtype, seq & 0xFF)) + payload
+    raw += CRC.pack(zlib.crc32(raw))
+    return b'\x00' + cobs_encode(raw) + b'\x00'
+
+
+class FrameDecoder:
+    """
+    Incremental stream decoder
+
+    Feed it any chunk of bytes; complete frames are returned as
+    (type, seq, payload). Anything between delimiters that is not a valid
+    frame is kept as console text.
+    """
+
+    def __init__(self):
+        self.pending = b''
+        self.frames = 0
+        self.errors = 0
+        self.lost = 0
+        self.last_seq = None
+
+    def feed(self, data):
+        chunks = (self.pending + data).split(b'\x00')
+        self.pending = chunks.pop()
+        frames = []
+        for chunk in chunks:
+            if not chunk:
+                continue
+            try:
+                raw = cobs_decode(chunk)
+            except ValueError:
+                raw = b''
+            if len(raw) < 6 or zlib.crc32(raw[:-4]) != CRC.unpack_from(raw, len(raw) - 4)[0]:
+                # not a frame: console output sharing the port
+                self.errors += 1
+                frames.append((None, None, chunk))
+                continue
+            seq = raw[1]
+            if self.last_seq is not None:
+                self.lost += (seq - self.last_seq - 1) & 0xFF
+            self.last_seq = seq
+            self.frames += 1
+            frames.append((raw[0], seq, raw[2:-4]))
+        return frames
+
+
+def utc_text(time_us):
+    """
+    "YYYY-MM-DD hh:mm:ss.mmm" of a record time, like logdecode's time_utc column
+
+    time_us (int) : microseconds since 1970
+    """
+    return time.strftime('%Y-%m-%d %H:%M:%S', time.gmtime(time_us // 1000000)) + '.%03d' % (time_us % 1000000 // 1000)
+
+
+def format_frame(rtype, payload):
+    """
+    Human readable line for a decoded frame
+
+    rtype (int)     : record type, None for console text
+    payload (bytes) : record payload
+    """
+    if rtype == TELEMETRY_SAMPLE:
+        time_us, _, _, battery, temp, pressure = SAMPLE.unpack(payload)
+        return '%s, %.2f deg Cel, %d Pa' % (utc_text(time_us), temp / 100.0, pressure)
+    if rtype == TELEMETRY_BATTERY:
+        raw, voltage, percentage = BATTERY.unpack(payload)
+        return 'Battery: %d mV (%d%%), raw %d' % (voltage, percentage, raw)
+    if rtype == TELEMETRY_TRACE:
+        return 'Trace: %d bytes, decode with trace.py' % len(payload)
+    if rtype == TELEMETRY_BOOT:
+        return 'Boot: %d bytes, decode with boot.py' % len(payload)
+    if rtype in (TELEMETRY_SEGMENT, TELEMETRY_SPAN, TELEMETRY_CHUNK):
+        return 'Range read: %d bytes, use range.py' % len(payload)
+    if rtype == TELEMETRY_CAPTURE:
+        sensor, result, size, _, seq, tick_us, latency_us = CAPTURE.unpack_from(payload)
+        return 'Capture: sensor %d, tick %d, %s, %d us' % (sensor, seq, 'failed' if result else '%d bytes' % size,
+                                                         latency_us)
+    # text record or console output
+    return payload.decode('utf-8', errors='replace').rstrip('\r\n')
+
+
+@click.group()
+def main():
+    """
+    Decode the logger telemetry stream
+    """
+
+
+# default example
+# python3 telemetry.py monitor --port="serial-port"
+#
+# custom example:
+# python3 telemetry.py monitor --port="serial-port" --baudrate=2000000 --timeout=30 --csv=log.csv
+@main.command()
+@click.option('--port', '-p', required=True, help='Serial Port Number')
+@click.option('--baudrate', '-b', default=921600, help='Serial Baudrate')
+@click.option('--timeout', '-t', default=60, help='Serial loop timeout in seconds')
+@click.option('--csv', 'csv_path', default=None, help='Append samples to a CSV file')
+def monitor(port, baudrate, timeout, csv_path):
+    """
+    Read and decode telemetry from a serial port
+
+    port (str)      : serial/COM port
+    baudrate (int)  : baudrate of serial port: bit/sec
+    timeout (int)   : serial timeout in seconds
+    csv_path (str)  : optional CSV output
+    """
+    import serial
+
+    decoder = FrameDecoder()
+    csv = open(csv_path, 'a') if csv_path else None
+    with serial.Serial(port, baudrate, timeout=0.05) as ser:  # open serial port
+        start_time = time.time()
+        while (time.time() - start_time) < timeout:
+            # read everything available, at least one byte
+            data = ser.read(max(1, ser.in_waiting))
+            for rtype, _, payload in decoder.feed(data):
+                if csv and rtype == TELEMETRY_SAMPLE:
+                    time_us, _, _, battery, temp, pressure = SAMPLE.unpack(payload)
+                    csv.write('%d,%s,%.2f,%d,%d\n' % (time_us, utc_text(time_us), temp / 100.0, pressure, battery))
+                else:
+                    print(format_frame(rtype, payload))
+    if csv:
+        csv.close()
+    print('frames: %d, lost: %d, invalid: %d' % (decoder.frames, decoder.lost, decoder.errors))
+
+
+# example:
+# python3 telemetry.py capture --port="serial-port" --timeout=3600 field.cap
+@main.command()
+@click.argument('path')
+@click.option('--port', '-p', required=True, help='Serial Port Number')
+@click.option('--baudrate', '-b', default=921600, help='Serial Baudrate')
+@click.option('--timeout', '-t', default=60, help='Capture length in seconds')
+def capture(path, port, baudrate, timeout):
+    """
+    Save raw sensor readings for tools/replay
+
+    Needs CONFIG_LOGGER_SENSOR_CAPTURE. The file is the TELEMETRY_CAPTURE
+    payloads back to back; lost frames leave gaps that replay skips.
+
+    path (str)      : capture file
+    port (str)      : serial/COM port
+    baudrate (int)  : baudrate of serial port: bit/sec
+    timeout (int)   : capture length in seconds
+    """
+    import serial
+
+    decoder = FrameDecoder()
+    records = 0
+    with serial.Serial(port, baudrate, timeout=0.05) as ser, open(path, 'wb') as out:
+        start_time = time.time()
+        while (time.time() - start_time) < timeout:
+            for rtype, _, payload in decoder.feed(ser.read(max(1, ser.in_waiting))):
+                if rtype == TELEMETRY_CAPTURE and len(payload) >= CAPTURE.size:
+                    out.write(payload)
+                    records += 1
+    print('%s: %d readings, frames lost: %d, invalid: %d' % (path, records, decoder.lost, decoder.errors))
+
+
+# example:
+# python3 telemetry.py loopback --seconds=5 --baudrate=921600
+@main.command()
+@click.option('--baudrate', '-b', default=921600, help='Emulated link baudrate, 0 for unpaced')
+@click.option('--seconds', '-s', default=5, help='Test duration in seconds')
+def loopback(baudrate, seconds):
+    """
+    Push device-format frames through a pseudo-terminal and check the decoder keeps up
+
+    baudrate (int)  : emulated baudrate, 8N1 (10 bits per byte)
+    seconds (int)   : duration in seconds
+    """
+    master, slave = os.openpty()
+    tty.setraw(slave)  # binary safe: no echo, no newline translation
+
+    record = SAMPLE.pack(1666811220000000, 0, 0, 3900, 2150, 101325)
+    sent = [0, 0]  # frames, bytes
+    done = threading.Event()
+
+    def writer():
+        seq = 0
+        rate = baudrate / 10.0
+        start = time.perf_counter()
+        while time.perf_counter() - start < seconds:
+            # a burst of frames, paced to the emulated link rate
+            burst = b''.join(encode_frame(TELEMETRY_SAMPLE, seq + i, record) for i in range(64))
+            os.write(master, burst)
+            seq += 64
+            sent[0] += 64
+            sent[1] += len(burst)
+            if rate:
+                delay = start + sent[1] / rate - time.perf_counter()
+                if delay > 0:
+                    time.sleep(delay)
+        done.set()
+
+    decoder = FrameDecoder()
+    thread = threading.Thread(target=writer, daemon=True)
+    start = time.perf_counter()
+    busy = 0.0
+    last = start
+    thread.start()
+    received = 0
+    while not done.is_set() or decoder.frames < sent[0]:
+        # wait for data, give up once the writer is done and the pty is idle
+        if not select.select([slave], [], [], 1.0)[0]:
+            if done.is_set():
+                break
+            continue
+        data = os.read(slave, 65536)
+        t0 = time.perf_counter()
+        decoder.feed(data)
+        last = time.perf_counter()
+        busy += last - t0
+        received += len(data)
+    elapsed = last - start
+    os.close(master)
+    os.close(slave)
+
+    link = baudrate / 10.0 if baudrate else float('nan')
+    print('sent      : %d frames, %d bytes' % (sent[0], sent[1]))
+    print('decoded   : %d frames, lost %d, invalid %d' % (decoder.frames, decoder.lost, decoder.errors))
+    print('throughput: %.0f B/s (link %.0f B/s)' % (received / elapsed, link))
+    print('capacity  : %.0f frames/s, %.0f B/s decoder CPU bound' %
+          (decoder.frames / busy if busy else 0, received / busy if busy else 0))
+    ok = decoder.frames == sent[0] and decoder.errors == 0 and decoder.lost == 0
+    if baudrate and busy and received / busy < link:
+        ok = False
+    print('PASS' if ok else 'FAIL')
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    # Call main function
+    main()
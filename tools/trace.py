@@ -0,0 +1,243 @@
+"""
+Author: Jesus Minjares
+Date:   10-19-2026
+GitHub: https://github.com/jminjares4
+Brief:  Turn deferred trace records back into text with the format strings from the firmware ELF
+"""
+import re
+import struct
+import sys
+import time
+
+import click
+
+from telemetry import TELEMETRY_TRACE, FrameDecoder, format_frame
+
+# one record, see firmware/components/trace/trace_ring.h
+RECORD = struct.Struct('<IIBB')
+ARG = struct.Struct('<I')
+
+# printf conversion: flags, width, precision, length, conversion
+SPEC = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|j|z|t)?([diouxXcsp%])')
+
+
+def elf_sections(path):
+    """
+    Loadable sections with contents, as (address, bytes)
+
+    Uses pyelftools when installed, otherwise reads the section headers directly.
+
+    path (str) : firmware ELF
+    """
+    SHF_ALLOC = 0x2
+    SHT_NOBITS = 8
+    try:
+        from elftools.elf.elffile import ELFFile
+    except ImportError:
+        ELFFile = None
+
+    sections = []
+    with open(path, 'rb') as f:
+        if ELFFile:
+            for section in ELFFile(f).iter_sections():
+                header = section.header
+                if header.sh_flags & SHF_ALLOC and section['sh_type'] != 'SHT_NOBITS' and header.sh_size:
+                    sections.append((header.sh_addr, section.data()))
+            return sections
+
+        image = f.read()
+    if image[:4] != b'\x7fELF':
+        raise click.ClickException('%s: not an ELF file' % path)
+    wide = image[4] == 2
+    order = '<' if image[5] == 1 else '>'
+    if wide:
+        shoff, = struct.unpack_from(order + 'Q', image, 0x28)
+        shentsize, shnum = struct.unpack_from(order + 'HH', image, 0x3A)
+        entry = struct.Struct(order + 'IIQQQQ')
+    else:
+        shoff, = struct.unpack_from(order + 'I', image, 0x20)
+        shentsize, shnum = struct.unpack_from(order + 'HH', image, 0x2E)
+        entry = struct.Struct(order + 'IIIIII')
+    for i in range(shnum):
+        _, sh_type, flags, addr, offset, size = entry.unpack_from(image, shoff + i * shentsize)
+        if flags & SHF_ALLOC and sh_type != SHT_NOBITS and size:
+            sections.append((addr, image[offset:offset + size]))
+    return sections
+
+
+class ElfStrings:
+    """
+    Null terminated strings by address in the firmware image
+    """
+
+    def __init__(self, path):
+        self.sections = elf_sections(path)
+        self.cache = {}
+
+    def string(self, address):
+        """
+        String at an address, None if the address is outside the image
+
+        address (int) : 32-bit address
+        """
+        if address in self.cache:
+            return self.cache[address]
+        text = None
+        for base, data in self.sections:
+            if base <= address < base + len(data):
+                offset = address - base
+                end = data.find(b'\x00', offset)
+                text = data[offset:end if end >= 0 else len(data)].decode('utf-8', errors='replace')
+                break
+        self.cache[address] = text
+        return text
+
+
+def render(fmt, args, strings):
+    """
+    Expand a printf format with raw 32-bit arguments
+
+    fmt (str)             : format string
+    args (list)           : raw arguments
+    strings (ElfStrings)  : resolves %s arguments
+    """
+    values = iter(args)
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        value = next(values, None)
+        if value is None:
+            return '<missing>'
+        spec = '%' + flags + width + ('.' + precision if precision else '')
+        if conv in 'di':
+            return (spec + 'd') % (value - (1 << 32) if value & 0x80000000 else value)
+        if conv in 'ouxX':
+            return (spec + conv) % value
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 's':
+            text = strings.string(value)
+            return (spec + 's') % (text if text is not None else '<0x%08x>' % value)
+        return (spec + 's') % ('0x%08x' % value)  # %p
+
+    return SPEC.sub(convert, fmt)
+
+
+class TraceDecoder:
+    """
+    Records from TELEMETRY_TRACE payloads, with 32-bit stamps unwrapped per core
+    """
+
+    def __init__(self, strings):
+        self.strings = strings
+        self.last = {}
+        self.records = 0
+        self.unknown = 0
+
+    def feed(self, payload):
+        """
+        Decode one frame payload into (time in us, core, text)
+
+        payload (bytes) : TELEMETRY_TRACE payload
+        """
+        out = []
+        offset = 0
+        while offset + RECORD.size <= len(payload):
+            fmt_address, stamp, core, nargs = RECORD.unpack_from(payload, offset)
+            offset += RECORD.size
+            args = [ARG.unpack_from(payload, offset + 4 * i)[0] for i in range(nargs)]
+            offset += 4 * nargs
+
+            # stamps wrap every ~71 minutes
+            previous = self.last.get(core)
+            if previous is not None:
+                stamp += previous - (previous & 0xFFFFFFFF)
+                if stamp < previous - (1 << 31):
+                    stamp += 1 << 32
+            self.last[core] = stamp
+
+            fmt = self.strings.string(fmt_address)
+            if fmt is None:
+                self.unknown += 1
+                text = '<unknown format 0x%08x> %s' % (fmt_address, ' '.join('0x%x' % a for a in args))
+            else:
+                text = render(fmt, args, self.strings)
+            self.records += 1
+            out.append((stamp, core, text))
+        return out
+
+
+def show(record, plain):
+    stamp, core, text = record
+    print(text if plain else '%14.6f %-2s  %s' % (stamp / 1e6, 'C%d' % core if core >= 0 else '', text))
+
+
+@click.group()
+def main():
+    """
+    Decode deferred trace records
+    """
+
+
+# examples:
+# python3 trace.py decode --elf build/sensor-logger.elf --port="serial-port"
+# python3 trace.py decode --elf build/sensor-logger.elf --file capture.bin
+@main.command()
+@click.option('--elf', '-e', required=True, type=click.Path(exists=True), help='Firmware ELF the device runs')
+@click.option('--port', '-p', default=None, help='Serial Port Number')
+@click.option('--file', '-f', 'path', default=None, type=click.Path(exists=True), help='Captured telemetry stream')
+@click.option('--baudrate', '-b', default=921600, help='Serial Baudrate')
+@click.option('--timeout', '-t', default=60, help='Serial loop timeout in seconds')
+@click.option('--plain', is_flag=True, help='Messages only, no time and core')
+@click.option('--all', 'show_all', is_flag=True, help='Also print the other telemetry records')
+def decode(elf, port, path, baudrate, timeout, plain, show_all):
+    """
+    Print trace records from a serial port or a capture file
+
+    Records from a file are sorted by time across cores; from a port they
+    are printed as they arrive, one drain period per core at a time.
+
+    elf (str)       : firmware ELF, must match the running firmware
+    port (str)      : serial/COM port
+    path (str)      : capture of the raw telemetry stream
+    baudrate (int)  : baudrate of serial port: bit/sec
+    timeout (int)   : serial timeout in seconds
+    """
+    if (port is None) == (path is None):
+        raise click.UsageError('give exactly one of --port and --file')
+
+    frames = FrameDecoder()
+    traces = TraceDecoder(ElfStrings(elf))
+
+    if path:
+        records = []
+        with open(path, 'rb') as f:
+            for rtype, _, payload in frames.feed(f.read() + b'\x00'):
+                if rtype == TELEMETRY_TRACE:
+                    records += traces.feed(payload)
+                elif show_all:
+                    records.append((records[-1][0] if records else 0, -1, format_frame(rtype, payload)))
+        for record in sorted(records, key=lambda r: r[0]):
+            show(record, plain)
+    else:
+        import serial
+
+        with serial.Serial(port, baudrate, timeout=0.05) as ser:
+            start_time = time.time()
+            while (time.time() - start_time) < timeout:
+                for rtype, _, payload in frames.feed(ser.read(max(1, ser.in_waiting))):
+                    if rtype == TELEMETRY_TRACE:
+                        for record in traces.feed(payload):
+                            show(record, plain)
+                    elif show_all:
+                        print(format_frame(rtype, payload))
+
+    print('records: %d, unknown formats: %d, frames lost: %d, invalid: %d' %
+          (traces.records, traces.unknown, frames.lost, frames.errors), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    # Call main function
+    main()